@@ -0,0 +1,173 @@
+/*
+  File:   APBenchmark.cpp
+
+  Contains: Times a plug-in callback over many calls inside Acrobat and
+            reports the cost per call.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "APReport.h"
+#include "APTiming.h"
+#include "APBenchmark.h"
+
+// --------------------------
+
+APBenchmark::APBenchmark()
+  : mAllocationCounter( NULL )
+  {
+  } // end APBenchmark
+
+// --------------------------
+// The warm-up calls fill the caches and let the callback build anything it
+// builds lazily; they are not counted.  A run of fewer than
+// kBenchmarkWarmUpCalls calls warms up with as many calls as it times, and
+// so always makes an even number of calls in all.  A longer run warms up
+// with kBenchmarkWarmUpCalls calls, an even number, so it makes an even
+// number in all only when inCalls is even; a benchmark that undoes itself
+// on odd calls must ask for an even number.
+
+const APBenchmarkResult & APBenchmark::Run( const char * inName, ASInt32 inCalls, APBenchmarkProc inProc, void * inData )
+  {
+    if ( inCalls < 1 )
+      inCalls = 1 ;
+
+    return Measure( inName, inCalls, ( inCalls < kBenchmarkWarmUpCalls ) ? inCalls : kBenchmarkWarmUpCalls, inProc, inData ) ;
+
+  } // end Run
+
+// --------------------------
+// A recording is played once, in order: iteration 0 is the first recorded
+// call and every call is timed, since a warm-up would play the start of the
+// recording ahead of itself.
+
+const APBenchmarkResult & APBenchmark::Replay( const char * inName, ASInt32 inCalls, APBenchmarkProc inProc, void * inData )
+  {
+    if ( inCalls < 1 )
+      inCalls = 1 ;
+
+    return Measure( inName, inCalls, 0, inProc, inData ) ;
+
+  } // end Replay
+
+// --------------------------
+// inWarmUpCalls untimed calls, then inCalls timed ones; the iteration
+// number runs on from the warm-up calls into the timed ones.
+
+const APBenchmarkResult & APBenchmark::Measure( const char * inName, ASInt32 inCalls, ASInt32 inWarmUpCalls,
+                                                APBenchmarkProc inProc, void * inData )
+  {
+    APBenchmarkResult   theResult ;
+    ASUns64             theStart ;
+    ASUns64             theAllocations  = 0 ;
+
+    memset( &theResult, 0, sizeof( theResult ) ) ;
+    theResult.fName = inName ;
+
+    for ( ASInt32 index = 0 ; index < inWarmUpCalls ; index++ )
+      inProc( inData, index ) ;
+
+    mSamples.resize( inCalls ) ;
+
+    if ( mAllocationCounter != NULL )
+      theAllocations = mAllocationCounter() ;
+
+    for ( ASInt32 index = 0 ; index < inCalls ; index++ )
+      {
+        theStart = APTiming::GetNanoseconds() ;
+        inProc( inData, inWarmUpCalls + index ) ;
+        mSamples[ index ] = APTiming::GetNanoseconds() - theStart ;
+
+        theResult.fTotal += mSamples[ index ] ;
+      }
+
+    if ( mAllocationCounter != NULL )
+      theResult.fAllocations = mAllocationCounter() - theAllocations ;
+
+    theResult.fCalls = inCalls ;
+
+    std::sort( mSamples.begin(), mSamples.end() ) ;
+    theResult.fMedian = mSamples[ inCalls / 2 ] ;
+    theResult.fP99    = mSamples[ ( ( size_t )inCalls * 99 ) / 100 ] ;
+    theResult.fMax    = mSamples[ inCalls - 1 ] ;
+
+    mResults.push_back( theResult ) ;
+
+    return mResults.back() ;
+
+  } // end Measure
+
+// --------------------------
+
+void APBenchmark::Add( const char * inName, ASInt32 inCalls, ASUns64 inTotal )
+  {
+    APBenchmarkResult   theResult ;
+
+    memset( &theResult, 0, sizeof( theResult ) ) ;
+    theResult.fName   = inName ;
+    theResult.fCalls  = ( inCalls < 1 ) ? 1 : inCalls ;
+    theResult.fTotal  = inTotal ;
+
+    mResults.push_back( theResult ) ;
+
+  } // end Add
+
+// --------------------------
+// One line per benchmark; the median, 99th percentile and maximum are left
+// blank for results added as a single total, and the allocations per call
+// are only given when they were counted.
+
+void APBenchmark::Write( APReport * inReport ) const
+  {
+    char    theString[ 512 ] ;
+    char    theAllocations[ 32 ] ;
+
+    if ( inReport == NULL )
+      return ;
+
+    snprintf( theString, sizeof( theString ), "%-48s  %8s  %12s  %12s  %12s  %12s%s\r\n",
+              "benchmark", "calls", "mean (ns)", "median (ns)", "p99 (ns)", "max (ns)",
+              ( mAllocationCounter != NULL ) ? "   allocs/call" : "" ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
+
+    for ( size_t index = 0 ; index < mResults.size() ; index++ )
+      {
+        const APBenchmarkResult & theResult = mResults[ index ] ;
+
+        theAllocations[ 0 ] = 0 ;
+        if ( ( mAllocationCounter != NULL ) && ( theResult.fMax != 0 ) )
+          snprintf( theAllocations, sizeof( theAllocations ), "  %12.2f", ( double )theResult.fAllocations / theResult.fCalls ) ;
+
+        if ( theResult.fMax == 0 )
+          snprintf( theString, sizeof( theString ), "%-48s  %8d  %12.1f\r\n",
+                    theResult.fName, ( int )theResult.fCalls, ( double )theResult.fTotal / theResult.fCalls ) ;
+        else
+          snprintf( theString, sizeof( theString ), "%-48s  %8d  %12.1f  %12llu  %12llu  %12llu%s\r\n",
+                    theResult.fName, ( int )theResult.fCalls, ( double )theResult.fTotal / theResult.fCalls,
+                    ( unsigned long long )theResult.fMedian, ( unsigned long long )theResult.fP99,
+                    ( unsigned long long )theResult.fMax, theAllocations ) ;
+        inReport->Write( theString, strlen( theString ) ) ;
+      }
+
+  } // end Write
+
+// --------------------------
@@ -0,0 +1,102 @@
+/*
+  File:   APBenchmark.h
+
+  Contains: Times a plug-in callback over many calls inside Acrobat and
+            reports the cost per call.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      static void BenchPageViewScroll( void * inData, ASInt32 inIteration )
+        {
+          DoAVPageViewDidChange( ( AVPageView )inData, PAGEVIEW_UPDATE_SCROLL, NULL ) ;
+        }
+
+      APBenchmark   theBenchmark ;
+
+      theBenchmark.Run( "AVPageViewDidChange, scroll", 10000, &BenchPageViewScroll, thePageView ) ;
+      ...
+      theBenchmark.Write( theLog ) ;
+
+    A benchmark must leave the host as it found it, e.g. by pairing each
+    forward step with a step back on odd iterations.  A recording is fed in
+    with Replay instead, which makes each call once and in order.
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+
+#include <vector>
+
+class APReport ;
+
+// --------------------------
+
+#define kBenchmarkWarmUpCalls   16
+
+typedef void ( * APBenchmarkProc )( void * inData, ASInt32 inIteration ) ;
+typedef ASUns64 ( * APCounterProc )( void ) ;
+
+struct APBenchmarkResult
+  {
+    const char *    fName ;
+    ASInt32         fCalls ;
+    ASUns64         fTotal ;        // nanoseconds
+    ASUns64         fMedian ;
+    ASUns64         fP99 ;
+    ASUns64         fMax ;
+    ASUns64         fAllocations ;  // over fCalls, when an allocation counter is set
+  } ;
+
+// --------------------------
+// Each call is timed on its own so the median and 99th percentile can be
+// given as well as the mean; the clock read adds a few tens of nanoseconds
+// to every call, so for very cheap callbacks the mean is the better figure.
+
+class APBenchmark
+  {
+    public:
+      APBenchmark() ;
+
+      const APBenchmarkResult &   Run( const char * inName, ASInt32 inCalls, APBenchmarkProc inProc, void * inData ) ;
+
+      // exactly inCalls calls, iterations 0 to inCalls - 1 in that order and
+      // with no warm-up, for replaying a recording whose calls must happen
+      // once each and in the order they were recorded
+      const APBenchmarkResult &   Replay( const char * inName, ASInt32 inCalls, APBenchmarkProc inProc, void * inData ) ;
+
+      // a result measured some other way, e.g. a batch whose parts cannot be timed one by one
+      void          Add( const char * inName, ASInt32 inCalls, ASUns64 inTotal ) ;
+
+      void          Write( APReport * inReport ) const ;
+
+      // Acrobat's allocator cannot be counted; a build outside Acrobat that
+      // replaces operator new can give its count, and Write then adds the
+      // allocations per call
+      void          SetAllocationCounter( APCounterProc inCounter ) { mAllocationCounter = inCounter ; }
+
+    private:
+      std::vector< APBenchmarkResult >  mResults ;
+      std::vector< ASUns64 >            mSamples ;
+      APCounterProc                     mAllocationCounter ;
+
+      const APBenchmarkResult &   Measure( const char * inName, ASInt32 inCalls, ASInt32 inWarmUpCalls,
+                                           APBenchmarkProc inProc, void * inData ) ;
+
+      APBenchmark( const APBenchmark & ) ;
+      APBenchmark & operator=( const APBenchmark & ) ;
+  } ;
+
+// --------------------------
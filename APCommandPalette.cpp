@@ -0,0 +1,347 @@
+/*
+  File:   APCommandPalette.cpp
+
+  Contains: Trigram index over menu item titles and names for fuzzy,
+            keyboard-driven command lookup.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <ctype.h>
+#include <string.h>
+#include <algorithm>
+
+#include "APCommandPalette.h"
+
+// --------------------------
+
+#define kTrigramLength          3
+#define kMaxMenuItemTitle       256
+
+// --------------------------
+
+static ASUns32 MakeTrigram( const char * inText )
+  {
+    return ( ( ASUns32 )( unsigned char )inText[ 0 ] << 16 ) |
+           ( ( ASUns32 )( unsigned char )inText[ 1 ] << 8 ) |
+             ( ASUns32 )( unsigned char )inText[ 2 ] ;
+
+  } // end MakeTrigram
+
+// --------------------------
+// Lower-case the text and drop the '&' mnemonic markers used in Windows menu titles.
+
+static std::string FoldText( const char * inText )
+  {
+    std::string theResult ;
+
+    for ( const char * thePtr = inText ; *thePtr != 0 ; thePtr++ )
+      {
+        if ( *thePtr == '&' )
+          continue ;
+        theResult += ( char )tolower( ( unsigned char )*thePtr ) ;
+      }
+
+    return theResult ;
+
+  } // end FoldText
+
+// --------------------------
+// The distinct trigrams of a folded string, in no particular order.
+
+static void CollectTrigrams( const std::string & inText, std::vector< ASUns32 > & outTrigrams )
+  {
+    outTrigrams.clear() ;
+
+    if ( inText.size() < kTrigramLength )
+      return ;
+
+    for ( size_t index = 0 ; index + kTrigramLength <= inText.size() ; index++ )
+      outTrigrams.push_back( MakeTrigram( inText.c_str() + index ) ) ;
+
+    std::sort( outTrigrams.begin(), outTrigrams.end() ) ;
+    outTrigrams.erase( std::unique( outTrigrams.begin(), outTrigrams.end() ), outTrigrams.end() ) ;
+
+  } // end CollectTrigrams
+
+// --------------------------
+
+APCommandPalette::APCommandPalette()
+  : mBuilt( false ),
+    mLiveCount( 0 )
+  {
+  } // end APCommandPalette
+
+// --------------------------
+
+APCommandPalette::~APCommandPalette()
+  {
+    Clear() ;
+
+  } // end ~APCommandPalette
+
+// --------------------------
+// Release every menu item held by the palette.
+
+void APCommandPalette::Clear( void )
+  {
+    mCommands.clear() ;
+    mCommandByItem.clear() ;
+    mPostings.clear() ;
+    mHits.clear() ;
+    mTouched.clear() ;
+    mLiveCount = 0 ;
+    mBuilt = false ;
+
+  } // end Clear
+
+// --------------------------
+// Add a menu item as a command.  Separators and items that only open a
+// sub-menu cannot be executed and are left out.
+
+void APCommandPalette::AddCommand( AVMenuItem inAVMenuItem )
+  {
+    char        theTitle[ kMaxMenuItemTitle ] ;
+    AVMenu      theSubAVMenu ;
+    Command     theCommand ;
+
+    if ( ( inAVMenuItem == NULL ) || ( mCommandByItem.find( inAVMenuItem ) != mCommandByItem.end() ) )
+      return ;
+
+    theSubAVMenu = AVMenuItemAcquireSubmenu( inAVMenuItem ) ;
+    if ( theSubAVMenu != NULL )
+      {
+        AVMenuRelease( theSubAVMenu ) ;
+        return ;
+      }
+
+    memset( theTitle, 0, sizeof( theTitle ) ) ;
+    AVMenuItemGetTitle( inAVMenuItem, theTitle, sizeof( theTitle ) - 1 ) ;
+    if ( ( theTitle[ 0 ] == 0 ) || ( strcmp( theTitle, "-" ) == 0 ) )
+      return ;
+
+    theCommand.fAVMenuItem.Reset( AVMenuItemAcquire( inAVMenuItem ) ) ;
+    theCommand.fLive        = true ;
+
+    for ( const char * thePtr = theTitle ; *thePtr != 0 ; thePtr++ )
+      if ( *thePtr != '&' )
+        theCommand.fTitle += *thePtr ;
+
+    theCommand.fText = FoldText( theTitle ) ;
+    theCommand.fText += ' ' ;
+    theCommand.fText += FoldText( ASAtomGetString( AVMenuItemGetName( inAVMenuItem ) ) ) ;
+
+    mCommands.push_back( std::move( theCommand ) ) ;
+    mCommandByItem[ inAVMenuItem ] = ( ASInt32 )( mCommands.size() - 1 ) ;
+    mLiveCount += 1 ;
+
+    IndexCommand( ( ASInt32 )( mCommands.size() - 1 ) ) ;
+
+  } // end AddCommand
+
+// --------------------------
+// Commands are only ever appended, so every posting list stays sorted.
+
+void APCommandPalette::IndexCommand( ASInt32 inCommand )
+  {
+    std::vector< ASUns32 >  theTrigrams ;
+
+    CollectTrigrams( mCommands[ inCommand ].fText, theTrigrams ) ;
+
+    for ( size_t index = 0 ; index < theTrigrams.size() ; index++ )
+      mPostings[ theTrigrams[ index ] ].push_back( inCommand ) ;
+
+  } // end IndexCommand
+
+// --------------------------
+
+void APCommandPalette::RemoveCommand( AVMenuItem inAVMenuItem )
+  {
+    std::unordered_map< AVMenuItem, ASInt32 >::iterator theIter = mCommandByItem.find( inAVMenuItem ) ;
+    if ( theIter == mCommandByItem.end() )
+      return ;
+
+    Command & theCommand = mCommands[ theIter->second ] ;
+
+    theCommand.fAVMenuItem.Reset( NULL ) ;
+    theCommand.fLive        = false ;
+
+    mCommandByItem.erase( theIter ) ;
+    mLiveCount -= 1 ;
+
+    if ( mLiveCount * 2 < ( ASInt32 )mCommands.size() )
+      Compact() ;
+
+  } // end RemoveCommand
+
+// --------------------------
+// Drop the dead commands and rebuild the postings from the survivors.
+
+void APCommandPalette::Compact( void )
+  {
+    std::vector< Command >  theCommands ;
+
+    theCommands.reserve( mLiveCount ) ;
+
+    for ( size_t index = 0 ; index < mCommands.size() ; index++ )
+      if ( mCommands[ index ].fLive )
+        theCommands.push_back( std::move( mCommands[ index ] ) ) ;
+
+    mCommands.swap( theCommands ) ;
+    mCommandByItem.clear() ;
+    mPostings.clear() ;
+
+    for ( size_t index = 0 ; index < mCommands.size() ; index++ )
+      {
+        mCommandByItem[ mCommands[ index ].fAVMenuItem ] = ( ASInt32 )index ;
+        IndexCommand( ( ASInt32 )index ) ;
+      }
+
+  } // end Compact
+
+// --------------------------
+// Shared trigrams carry the score; an exact substring, a title prefix and a
+// shorter title each move a command up.
+
+ASInt32 APCommandPalette::ScoreCommand( const Command & inCommand, const std::string & inQuery, ASInt32 inHits ) const
+  {
+    ASInt32     theScore ;
+    size_t      thePosition ;
+
+    theScore = inHits * 16 ;
+
+    thePosition = inCommand.fText.find( inQuery ) ;
+    if ( thePosition == 0 )
+      theScore += 512 ;
+    else if ( thePosition != std::string::npos )
+      theScore += 256 ;
+
+    theScore -= ( ASInt32 )( inCommand.fTitle.size() / 4 ) ;
+
+    return theScore ;
+
+  } // end ScoreCommand
+
+// --------------------------
+// Fill outMatches with up to inMaxMatches commands, best first, and return
+// how many were found.  Queries shorter than a trigram fall back to a
+// substring scan, which is cheap at that length.
+
+ASInt32 APCommandPalette::Query( const char * inText, Match * outMatches, ASInt32 inMaxMatches )
+  {
+    std::string               theQuery ;
+    std::vector< ASUns32 >    theTrigrams ;
+    ASInt32                   theCount = 0 ;
+    ASInt32                   theThreshold ;
+    Match                     theMatch ;
+
+    if ( ( inText == NULL ) || ( outMatches == NULL ) || ( inMaxMatches <= 0 ) )
+      return 0 ;
+
+    theQuery = FoldText( inText ) ;
+    if ( theQuery.empty() )
+      return 0 ;
+
+    CollectTrigrams( theQuery, theTrigrams ) ;
+
+    mHits.resize( mCommands.size(), 0 ) ;
+
+    if ( theTrigrams.empty() )
+      {
+        for ( size_t index = 0 ; index < mCommands.size() ; index++ )
+          if ( mCommands[ index ].fLive && ( mCommands[ index ].fText.find( theQuery ) != std::string::npos ) )
+            mTouched.push_back( ( ASInt32 )index ) ;
+        theThreshold = 0 ;
+      }
+    else
+      {
+        for ( size_t index = 0 ; index < theTrigrams.size() ; index++ )
+          {
+            std::unordered_map< ASUns32, std::vector< ASInt32 > >::const_iterator theIter = mPostings.find( theTrigrams[ index ] ) ;
+            if ( theIter == mPostings.end() )
+              continue ;
+
+            const std::vector< ASInt32 > & thePostings = theIter->second ;
+            for ( size_t entry = 0 ; entry < thePostings.size() ; entry++ )
+              if ( mHits[ thePostings[ entry ] ]++ == 0 )
+                mTouched.push_back( thePostings[ entry ] ) ;
+          }
+
+        // tolerate a typo or two: half of the query's trigrams must be present
+        theThreshold = ( ASInt32 )( theTrigrams.size() + 1 ) / 2 ;
+      }
+
+    for ( size_t index = 0 ; index < mTouched.size() ; index++ )
+      {
+        ASInt32 theCommand = mTouched[ index ] ;
+        ASInt32 theHits = mHits[ theCommand ] ;
+
+        mHits[ theCommand ] = 0 ;
+
+        if ( ( mCommands[ theCommand ].fLive == false ) || ( theHits < theThreshold ) )
+          continue ;
+
+        theMatch.fCommand = theCommand ;
+        theMatch.fScore = ScoreCommand( mCommands[ theCommand ], theQuery, theHits ) ;
+
+        // insertion into the short, sorted result list
+        ASInt32 thePosition = theCount ;
+        while ( ( thePosition > 0 ) && ( outMatches[ thePosition - 1 ].fScore < theMatch.fScore ) )
+          {
+            if ( thePosition < inMaxMatches )
+              outMatches[ thePosition ] = outMatches[ thePosition - 1 ] ;
+            thePosition-- ;
+          }
+
+        if ( thePosition < inMaxMatches )
+          {
+            outMatches[ thePosition ] = theMatch ;
+            if ( theCount < inMaxMatches )
+              theCount++ ;
+          }
+      }
+
+    mTouched.clear() ;
+
+    return theCount ;
+
+  } // end Query
+
+// --------------------------
+
+AVMenuItem APCommandPalette::GetMenuItem( ASInt32 inCommand ) const
+  {
+    if ( ( inCommand < 0 ) || ( inCommand >= ( ASInt32 )mCommands.size() ) )
+      return ( AVMenuItem )NULL ;
+
+    return mCommands[ inCommand ].fAVMenuItem ;
+
+  } // end GetMenuItem
+
+// --------------------------
+
+const char * APCommandPalette::GetTitle( ASInt32 inCommand ) const
+  {
+    if ( ( inCommand < 0 ) || ( inCommand >= ( ASInt32 )mCommands.size() ) )
+      return "" ;
+
+    return mCommands[ inCommand ].fTitle.c_str() ;
+
+  } // end GetTitle
+
+// --------------------------
@@ -0,0 +1,90 @@
+/*
+  File:   APCommandPalette.h
+
+  Contains: Trigram index over menu item titles and names for fuzzy,
+            keyboard-driven command lookup.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "APHandle.h"
+
+// --------------------------
+// Every command is indexed once under each distinct three character sequence
+// of its lower-cased "title name" text.  A query looks up only the posting
+// lists of its own trigrams and scores commands by how many of them they
+// share, so the cost of a keystroke follows the size of those lists rather
+// than the number of commands.  Commands are appended as menu items are added
+// and tombstoned as they are removed; the postings are compacted once more
+// than half of the commands are dead.
+
+class APCommandPalette
+  {
+    public:
+      struct Match
+        {
+          ASInt32       fCommand ;
+          ASInt32       fScore ;
+        } ;
+
+      APCommandPalette() ;
+      ~APCommandPalette() ;
+
+      void          Clear( void ) ;
+      ASBool        IsBuilt( void ) const { return mBuilt ; }
+      void          SetBuilt( void ) { mBuilt = true ; }
+
+      void          AddCommand( AVMenuItem inAVMenuItem ) ;
+      void          RemoveCommand( AVMenuItem inAVMenuItem ) ;
+
+      ASInt32       Query( const char * inText, Match * outMatches, ASInt32 inMaxMatches ) ;
+
+      AVMenuItem    GetMenuItem( ASInt32 inCommand ) const ;
+      const char *  GetTitle( ASInt32 inCommand ) const ;
+      ASInt32       GetNumCommands( void ) const { return mLiveCount ; }
+
+    private:
+      struct Command
+        {
+          APMenuItemRef fAVMenuItem ;     // NULL once the command is dead
+          std::string   fTitle ;
+          std::string   fText ;
+          ASBool        fLive ;
+        } ;
+
+      void          IndexCommand( ASInt32 inCommand ) ;
+      void          Compact( void ) ;
+      ASInt32       ScoreCommand( const Command & inCommand, const std::string & inQuery, ASInt32 inHits ) const ;
+
+      ASBool                                              mBuilt ;
+      std::vector< Command >                              mCommands ;
+      ASInt32                                             mLiveCount ;
+      std::unordered_map< AVMenuItem, ASInt32 >           mCommandByItem ;
+      std::unordered_map< ASUns32, std::vector< ASInt32 > > mPostings ;
+      std::vector< ASUns16 >                              mHits ;
+      std::vector< ASInt32 >                              mTouched ;
+
+      APCommandPalette( const APCommandPalette & ) ;
+      APCommandPalette & operator=( const APCommandPalette & ) ;
+  } ;
+
+// --------------------------
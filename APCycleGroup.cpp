@@ -0,0 +1,255 @@
+/*
+  File:   APCycleGroup.cpp
+
+  Contains: Replaces a group of Acrobat toolbar buttons with a single button
+            that cycles through the group's states, driven by a table.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include "TASUtils.h"
+#include "TAVUtils.h"
+
+#include "APTiming.h"
+#include "APIconCache.h"
+#include "APDiagnostics.h"
+#include "APTrace.h"
+#include "APCycleGroup.h"
+
+// --------------------------
+
+APCycleGroup::APCycleGroup()
+  : mGroupDef( NULL ),
+    mAVToolBar( NULL ),
+    mEndGroupButton( NULL ),
+    mButton( NULL ),
+    mCurrent( 0 ),
+    mApplied( 0 ),
+    mTransitionCount( 0 ),
+    mTransitionTime( 0 ),
+    mSelectStart( 0 )
+  {
+  } // end APCycleGroup
+
+// --------------------------
+// Find the group's Acrobat buttons, put the group's button showing the first
+// state in their place and remove them.  Returns false, leaving the toolbar untouched, when
+// any of the buttons is missing.
+
+ASBool APCycleGroup::Install( AVToolBar inAVToolBar, const APCycleGroupDef * inGroupDef )
+  {
+    StateRec      theStateRec ;
+
+    if ( ( inAVToolBar == NULL ) || ( inGroupDef == NULL ) || ( inGroupDef->fNumStates < 2 ) )
+      return false ;
+
+    mEndGroupButton = AVToolBarGetButtonByName( inAVToolBar, ASAtomFromString( inGroupDef->fEndGroupName ) ) ;
+    if ( mEndGroupButton == NULL )
+      return false ;
+
+    mStates.clear() ;
+    mStates.reserve( inGroupDef->fNumStates ) ;   // the execute procs keep pointers into mStates
+    mIndexOfState.clear() ;
+
+    for ( ASInt32 index = 0 ; index < inGroupDef->fNumStates ; index++ )
+      {
+        theStateRec.fGroup          = this ;
+        theStateRec.fIndex          = index ;
+        theStateRec.fOriginalButton = AVToolBarGetButtonByName( inAVToolBar, ASAtomFromString( inGroupDef->fStates[ index ].fButtonName ) ) ;
+
+        if ( theStateRec.fOriginalButton == NULL )
+          {
+            mStates.clear() ;
+            return false ;
+          }
+
+        mStates.push_back( theStateRec ) ;
+        mIndexOfState[ inGroupDef->fStates[ index ].fState ] = index ;
+      }
+
+    mButton = AVToolButtonNew( ASAtomFromString( inGroupDef->fNewButtonName ),
+                               APIconCache::Shared().GetIcon( inGroupDef->fStates[ 0 ].fIconID ), false, false ) ;
+    AVToolButtonSetExecuteProc( mButton, ASCallbackCreateProto( AVExecuteProc, &DoButtonExecute ), this ) ;
+    AVToolButtonSetComputeEnabledProc( mButton, ASCallbackCreateProto( AVComputeEnabledProc, TAVUtils::ComputeEnabled ), NULL ) ;
+    AVToolButtonSetHelpText( mButton, inGroupDef->fStates[ 0 ].fHelpText ) ;
+
+    mGroupDef   = inGroupDef ;
+    mAVToolBar  = inAVToolBar ;
+    mCurrent    = 0 ;
+    mApplied    = inGroupDef->fStates[ 0 ].fState ;
+
+    AVToolBarAddButton( inAVToolBar, mButton, true, mEndGroupButton ) ;
+
+    for ( ASInt32 index = 0 ; index < inGroupDef->fNumStates ; index++ )
+      AVToolButtonRemove( mStates[ index ].fOriginalButton ) ;
+
+    return true ;
+
+  } // end Install
+
+// --------------------------
+// Route the Acrobat menu items named in the table through the group, so the
+// button follows when the state is chosen from a menu.
+
+void APCycleGroup::AttachMenuItems( AVMenubar inAVMenubar )
+  {
+    AVMenuItem    theAVMenuItem ;
+
+    if ( ( inAVMenubar == NULL ) || ( mGroupDef == NULL ) )
+      return ;
+
+    for ( ASInt32 index = 0 ; index < mGroupDef->fNumStates ; index++ )
+      {
+        if ( mGroupDef->fStates[ index ].fMenuItemName == NULL )
+          continue ;
+
+        theAVMenuItem = AVMenubarAcquireMenuItemByName( inAVMenubar, mGroupDef->fStates[ index ].fMenuItemName ) ;
+        if ( theAVMenuItem == NULL )
+          continue ;
+
+        AVMenuItemSetExecuteProc( theAVMenuItem, ASCallbackCreateProto( AVExecuteProc, &DoMenuItemExecute ), &mStates[ index ] ) ;
+
+        AVMenuItemRelease( theAVMenuItem ) ;
+      }
+
+  } // end AttachMenuItems
+
+// --------------------------
+// Read the group's state from a document; with no document, or before the
+// group is installed, this is the state already applied.
+
+ASInt32 APCycleGroup::Probe( AVDoc inAVDoc ) const
+  {
+    if ( ( mGroupDef == NULL ) || ( inAVDoc == NULL ) )
+      return mApplied ;
+
+    return mGroupDef->fProbe( inAVDoc ) ;
+
+  } // end Probe
+
+// --------------------------
+// Bring the button in line with a state, either probed or remembered.
+// Returns true when the toolbar had to change.
+
+ASBool APCycleGroup::Apply( ASInt32 inState )
+  {
+    if ( ( mGroupDef == NULL ) || ( inState == mApplied ) )
+      return false ;
+
+    mApplied = inState ;
+
+    std::unordered_map< ASInt32, ASInt32 >::const_iterator theFound = mIndexOfState.find( inState ) ;
+    if ( ( theFound == mIndexOfState.end() ) || ( theFound->second == mCurrent ) )
+      return false ;
+
+    Show( theFound->second ) ;
+
+    return true ;
+
+  } // end Apply
+
+// --------------------------
+// Switch the document to a state by executing the Acrobat button for it.
+
+void APCycleGroup::Select( ASInt32 inIndex )
+  {
+    if ( ( mGroupDef == NULL ) || ( inIndex < 0 ) || ( inIndex >= mGroupDef->fNumStates ) )
+      return ;
+
+    mSelectStart = APTiming::GetNanoseconds() ;
+
+    AVToolButtonExecute( mStates[ inIndex ].fOriginalButton ) ;
+
+    Show( inIndex ) ;
+    mApplied = mGroupDef->fStates[ inIndex ].fState ;
+
+    if ( mGroupDef->fStates[ inIndex ].fFlags & kCycleUpdateButtonStates )
+      AVToolBarUpdateButtonStates( mAVToolBar ) ;
+
+    if ( mGroupDef->fDidSelect != NULL )
+      mGroupDef->fDidSelect( mApplied ) ;
+
+  } // end Select
+
+// --------------------------
+
+void APCycleGroup::SelectNext( void )
+  {
+    if ( mGroupDef == NULL )
+      return ;
+
+    Select( ( mCurrent + 1 ) % mGroupDef->fNumStates ) ;
+
+  } // end SelectNext
+
+// --------------------------
+// Only the button's own face is redrawn; the execute proc needs no new data
+// since it reads the current state from the group.
+
+void APCycleGroup::Show( ASInt32 inIndex )
+  {
+    ASUns64   theStart ;
+
+    if ( inIndex == mCurrent )
+      return ;
+
+    theStart = APTiming::GetNanoseconds() ;
+
+    AVToolButtonSetIcon( mButton, APIconCache::Shared().GetIcon( mGroupDef->fStates[ inIndex ].fIconID ) ) ;
+    AVToolButtonSetHelpText( mButton, mGroupDef->fStates[ inIndex ].fHelpText ) ;
+    mCurrent = inIndex ;
+
+    mTransitionTime  += APTiming::GetNanoseconds() - theStart ;
+    mTransitionCount += 1 ;
+
+  } // end Show
+
+// --------------------------
+// The button always shows the current state, so a click moves to the next one.
+
+ACCB1 void ACCB2 APCycleGroup::DoButtonExecute( void * inData )
+  {
+    APCycleGroup *  theGroup = ( APCycleGroup * )inData ;
+    APTraceScope    theTraceScope( theGroup->GetName() ) ;
+
+    DURING
+      theGroup->SelectNext() ;
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "switching the toolbar button" ) ;
+      APDiagnostics::Shared().ShowSummary() ;
+    END_HANDLER
+
+  } // end DoButtonExecute
+
+// --------------------------
+
+ACCB1 void ACCB2 APCycleGroup::DoMenuItemExecute( void * inData )
+  {
+    StateRec *      theRec = ( StateRec * )inData ;
+    APTraceScope    theTraceScope( theRec->fGroup->GetName() ) ;
+
+    DURING
+      theRec->fGroup->Select( theRec->fIndex ) ;
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "switching from the menu" ) ;
+      APDiagnostics::Shared().ShowSummary() ;
+    END_HANDLER
+
+  } // end DoMenuItemExecute
+
+// --------------------------
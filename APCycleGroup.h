@@ -0,0 +1,142 @@
+/*
+  File:   APCycleGroup.h
+
+  Contains: Replaces a group of Acrobat toolbar buttons with a single button
+            that cycles through the group's states, driven by a table.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    Describe each group with a constant table and install it once:
+
+      static const APCycleState gPageModeStates[] =
+        {
+          { PDUseNone,      kUseNoneIcon,      "UseNone",      "Page Only",  NULL,             0 },
+          { PDUseBookmarks, kUseBookmarksIcon, "UseBookmarks", "Bookmarks",  "ShowBookmarks",  0 },
+          ...
+        } ;
+
+      static const APCycleGroupDef gPageModeGroup =
+        { "DGAP:PageMode", "endPageModeGroup", &ProbePageMode, NULL, APCycleCount( gPageModeStates ), gPageModeStates } ;
+
+      gPageModeCycle.Install( AVAppGetToolBar(), &gPageModeGroup ) ;
+
+    and call Update with the front document whenever its state may have changed.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+#include <vector>
+#include <unordered_map>
+
+// --------------------------
+
+#define APCycleCount( inTable )   ( ( ASInt32 )( sizeof( inTable ) / sizeof( ( inTable )[ 0 ] ) ) )
+
+// refresh the enabled state of every toolbar button after switching to this state
+#define kCycleUpdateButtonStates  0x0001
+
+// returns the document's current value for the group, e.g. its PDPageMode
+typedef ASInt32 ( * APCycleProbeProc )( AVDoc inAVDoc ) ;
+
+// called after the user switched the group to a new state
+typedef void ( * APCycleDidSelectProc )( ASInt32 inState ) ;
+
+struct APCycleState
+  {
+    ASInt32         fState ;          // value the probe reports for this state
+    ASInt32         fIconID ;         // icon resource shown while in this state
+    const char *    fButtonName ;     // the Acrobat button this state stands in for
+    const char *    fHelpText ;       // tool tip shown while in this state
+    const char *    fMenuItemName ;   // Acrobat menu item that selects this state, or NULL
+    ASUns32         fFlags ;
+  } ;
+
+struct APCycleGroupDef
+  {
+    const char *            fNewButtonName ;  // name of the group's button
+    const char *            fEndGroupName ;   // separator the group's button is placed before
+    APCycleProbeProc        fProbe ;
+    APCycleDidSelectProc    fDidSelect ;      // may be NULL
+    ASInt32                 fNumStates ;
+    const APCycleState *    fStates ;
+  } ;
+
+// --------------------------
+// Clicking the button moves to the next state in the table by executing the
+// original Acrobat button for it.  Update only touches the toolbar when the
+// probed value differs from the one last applied, and finds the state for a
+// value through a hash table rather than a switch.
+// The group keeps one button on the toolbar for its whole life; a state change
+// swaps the icon and tool tip in place, so the toolbar is never laid out again.
+// A state's icon is taken from APIconCache the first time it is shown.
+
+class APCycleGroup
+  {
+    public:
+      APCycleGroup() ;
+
+      ASBool        Install( AVToolBar inAVToolBar, const APCycleGroupDef * inGroupDef ) ;
+      void          AttachMenuItems( AVMenubar inAVMenubar ) ;
+      ASBool        IsInstalled( void ) const { return mGroupDef != NULL ; }
+
+      ASInt32       Probe( AVDoc inAVDoc ) const ;
+      ASBool        Apply( ASInt32 inState ) ;
+      ASBool        Update( AVDoc inAVDoc ) { return Apply( Probe( inAVDoc ) ) ; }
+      void          Select( ASInt32 inIndex ) ;
+      void          SelectNext( void ) ;
+
+      ASInt32       GetCurrentIndex( void ) const { return mCurrent ; }
+      ASInt32       GetAppliedState( void ) const { return mApplied ; }
+      const char *  GetName( void ) const { return ( mGroupDef != NULL ) ? mGroupDef->fNewButtonName : "" ; }
+
+      // state changes shown on the toolbar and the time spent showing them
+      ASInt32       GetTransitionCount( void ) const { return mTransitionCount ; }
+      ASUns64       GetTransitionTime( void ) const { return mTransitionTime ; }
+
+      // when the last Select started, for timing what the change set off
+      ASUns64       GetSelectStart( void ) const { return mSelectStart ; }
+
+    private:
+      struct StateRec
+        {
+          APCycleGroup *  fGroup ;
+          ASInt32         fIndex ;
+          AVToolButton    fOriginalButton ;
+        } ;
+
+      void          Show( ASInt32 inIndex ) ;
+
+      static ACCB1 void ACCB2 DoButtonExecute( void * inData ) ;
+      static ACCB1 void ACCB2 DoMenuItemExecute( void * inData ) ;
+
+      const APCycleGroupDef *                 mGroupDef ;
+      AVToolBar                               mAVToolBar ;
+      AVToolButton                            mEndGroupButton ;
+      AVToolButton                            mButton ;
+      ASInt32                                 mCurrent ;
+      ASInt32                                 mApplied ;
+      ASInt32                                 mTransitionCount ;
+      ASUns64                                 mTransitionTime ;
+      ASUns64                                 mSelectStart ;
+      std::vector< StateRec >                 mStates ;
+      std::unordered_map< ASInt32, ASInt32 >  mIndexOfState ;
+
+      APCycleGroup( const APCycleGroup & ) ;
+      APCycleGroup & operator=( const APCycleGroup & ) ;
+  } ;
+
+// --------------------------
@@ -0,0 +1,168 @@
+/*
+  File:   APDiagnostics.cpp
+
+  Contains: Collects errors without stopping for the user: each one goes to
+            an in-memory ring and a log file, and a single summary can be
+            shown when an operation is finished.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "APReport.h"
+#include "APTiming.h"
+#include "APDiagnostics.h"
+
+// --------------------------
+
+APDiagnostics::APDiagnostics()
+  : mNext( 0 ),
+    mReported( 0 ),
+    mSinceSummary( 0 ),
+    mStartTime( APTiming::GetNanoseconds() ),
+    mLog( NULL ),
+    mLogFailed( false )
+  {
+    snprintf( mLogName, sizeof( mLogName ), "Diagnostics.txt" ) ;
+
+  } // end APDiagnostics
+
+// --------------------------
+
+APDiagnostics::~APDiagnostics()
+  {
+    Close() ;
+
+  } // end ~APDiagnostics
+
+// --------------------------
+// One set of diagnostics per plug-in.
+
+APDiagnostics & APDiagnostics::Shared( void )
+  {
+    static APDiagnostics  sDiagnostics ;
+
+    return sDiagnostics ;
+
+  } // end Shared
+
+// --------------------------
+// Name the log before the first problem is reported, e.g. "ReversePagesDiagnostics.txt".
+
+void APDiagnostics::SetLogName( const char * inLogName )
+  {
+    if ( inLogName != NULL )
+      snprintf( mLogName, sizeof( mLogName ), "%s", inLogName ) ;
+
+  } // end SetLogName
+
+// --------------------------
+
+void APDiagnostics::Close( void )
+  {
+    if ( mLog != NULL )
+      delete( mLog ) ;
+
+    mLog = NULL ;
+
+  } // end Close
+
+// --------------------------
+
+void APDiagnostics::FormatEntry( const Entry & inEntry, ASBool inWithTime, char * outString, size_t inStringSize ) const
+  {
+    char    theErrorString[ 256 ] ;
+
+    theErrorString[ 0 ] = 0 ;
+    if ( inEntry.fError != 0 )
+      ASGetErrorString( inEntry.fError, theErrorString, sizeof( theErrorString ) ) ;
+
+    if ( inWithTime == true )
+      snprintf( outString, inStringSize, "%10.3f s  %08X  %s%s%s",
+                APTiming::ToMilliseconds( inEntry.fTime - mStartTime ) / 1000.0, ( unsigned int )inEntry.fError,
+                inEntry.fContext, ( theErrorString[ 0 ] != 0 ) ? ": " : "", theErrorString ) ;
+    else
+      snprintf( outString, inStringSize, "%s%s%s",
+                inEntry.fContext, ( theErrorString[ 0 ] != 0 ) ? ": " : "", theErrorString ) ;
+
+  } // end FormatEntry
+
+// --------------------------
+// Never shows anything; safe to call from notifications, idle procs and batch
+// runs.  The oldest entry in the ring is overwritten once it is full, but
+// every problem is written to the log.
+
+void APDiagnostics::Report( ASInt32 inError, const char * inContext )
+  {
+    char    theString[ 512 ] ;
+    Entry & theEntry = mEntries[ mNext ] ;
+
+    theEntry.fTime  = APTiming::GetNanoseconds() ;
+    theEntry.fError = inError ;
+    snprintf( theEntry.fContext, sizeof( theEntry.fContext ), "%s", ( inContext != NULL ) ? inContext : "" ) ;
+
+    mNext          = ( mNext + 1 ) % kMaxDiagnostics ;
+    mReported     += 1 ;
+    mSinceSummary += 1 ;
+
+    if ( ( mLog == NULL ) && ( mLogFailed == false ) )
+      {
+        mLog = new APReport( mLogName ) ;
+        mLogFailed = ( mLog == NULL ) ;
+      }
+
+    if ( mLog != NULL )
+      {
+        FormatEntry( theEntry, true, theString, sizeof( theString ) - 2 ) ;
+        strcat( theString, "\r\n" ) ;
+        mLog->Write( theString, strlen( theString ) ) ;
+      }
+
+  } // end Report
+
+// --------------------------
+// A single alert covering everything reported since the last summary, or
+// nothing at all when there were no problems.
+
+void APDiagnostics::ShowSummary( void )
+  {
+    char    theString[ 512 ] ;
+    char    theLast[ 384 ] ;
+
+    if ( mSinceSummary == 0 )
+      return ;
+
+    FormatEntry( mEntries[ ( mNext + kMaxDiagnostics - 1 ) % kMaxDiagnostics ], false, theLast, sizeof( theLast ) ) ;
+
+    if ( mSinceSummary == 1 )
+      snprintf( theString, sizeof( theString ), "A problem occurred:\r%s", theLast ) ;
+    else
+      snprintf( theString, sizeof( theString ), "%d problems occurred; the last was:\r%s", ( int )mSinceSummary, theLast ) ;
+
+    if ( mLog != NULL )
+      snprintf( theString + strlen( theString ), sizeof( theString ) - strlen( theString ), "\r\rDetails are in %s.", mLogName ) ;
+
+    mSinceSummary = 0 ;
+
+    AVAlert( ALERT_CAUTION, theString, "OK", ( const char * )NULL, ( const char * )NULL, false ) ;
+
+  } // end ShowSummary
+
+// --------------------------
@@ -0,0 +1,83 @@
+/*
+  File:   APDiagnostics.h
+
+  Contains: Collects errors without stopping for the user: each one goes to
+            an in-memory ring and a log file, and a single summary can be
+            shown when an operation is finished.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      HANDLER
+        APDiagnostics::Shared().Report( ERRORCODE, "reversing pages" ) ;
+      END_HANDLER
+
+      APDiagnostics::Shared().ShowSummary() ;   // at the end of a command the user chose
+
+    Notification, idle and batch code only reports; whatever it reported is
+    included in the next summary.
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+
+class APReport ;
+
+// --------------------------
+
+#define kMaxDiagnostics         64    // the most recent problems kept in memory
+#define kMaxDiagnosticContext   96
+
+class APDiagnostics
+  {
+    public:
+      APDiagnostics() ;
+      ~APDiagnostics() ;
+
+      static APDiagnostics &  Shared( void ) ;
+
+      void          SetLogName( const char * inLogName ) ;
+      void          Close( void ) ;
+
+      // inError may be 0 for a problem that has no error code
+      void          Report( ASInt32 inError, const char * inContext ) ;
+      void          ShowSummary( void ) ;
+
+      ASInt32       GetNumReported( void ) const { return mReported ; }
+
+    private:
+      struct Entry
+        {
+          ASUns64       fTime ;
+          ASInt32       fError ;
+          char          fContext[ kMaxDiagnosticContext ] ;
+        } ;
+
+      void          FormatEntry( const Entry & inEntry, ASBool inWithTime, char * outString, size_t inStringSize ) const ;
+
+      Entry         mEntries[ kMaxDiagnostics ] ;
+      ASInt32       mNext ;
+      ASInt32       mReported ;
+      ASInt32       mSinceSummary ;
+      ASUns64       mStartTime ;
+      APReport *    mLog ;
+      ASBool        mLogFailed ;
+      char          mLogName[ 64 ] ;
+
+      APDiagnostics( const APDiagnostics & ) ;
+      APDiagnostics & operator=( const APDiagnostics & ) ;
+  } ;
+
+// --------------------------
@@ -0,0 +1,235 @@
+/*
+  File:   APEventLog.cpp
+
+  Contains: Records the notifications and clicks a plug-in receives to a
+            compact binary file so the same sequence can be replayed into
+            its callbacks later.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "APTiming.h"
+#include "APEventLog.h"
+
+// --------------------------
+
+APEventLog::APEventLog()
+  : mRecording( false ),
+    mLastTime( 0 ),
+    mDropped( 0 ),
+    mNumDocs( 0 )
+  {
+  } // end APEventLog
+
+// --------------------------
+// Start a new recording, discarding the last one.
+
+void APEventLog::Start( void )
+  {
+    mEvents.clear() ;
+    mEvents.reserve( 4096 ) ;
+    mDocNumbers.clear() ;
+
+    mNumDocs    = 0 ;
+    mDropped    = 0 ;
+    mLastTime   = APTiming::GetNanoseconds() ;
+    mRecording  = true ;
+
+  } // end Start
+
+// --------------------------
+
+void APEventLog::Record( ASUns8 inKind, AVDoc inAVDoc, ASInt16 inArg, ASInt16 inClickNumber, ASInt16 inX, ASInt16 inY )
+  {
+    APLoggedEvent   theEvent ;
+    ASUns64         theTime ;
+
+    if ( mRecording == false )
+      return ;
+
+    if ( mEvents.size() >= kMaxLoggedEvents )
+      {
+        mDropped += 1 ;
+        return ;
+      }
+
+    std::unordered_map< AVDoc, ASUns8 >::const_iterator theFound = mDocNumbers.find( inAVDoc ) ;
+    if ( inAVDoc == NULL )
+      theEvent.fDoc = kLoggedNoDoc ;
+    else if ( theFound != mDocNumbers.end() )
+      theEvent.fDoc = theFound->second ;
+    else
+      {
+        theEvent.fDoc = ( ASUns8 )( mNumDocs % kLoggedNoDoc ) ;
+        mDocNumbers[ inAVDoc ] = theEvent.fDoc ;
+        mNumDocs += 1 ;
+      }
+
+    theTime = APTiming::GetNanoseconds() ;
+
+    theEvent.fDelta       = ( ASUns32 )( ( theTime - mLastTime ) / 1000 ) ;
+    theEvent.fKind        = inKind ;
+    theEvent.fArg         = inArg ;
+    theEvent.fClickNumber = inClickNumber ;
+    theEvent.fX           = inX ;
+    theEvent.fY           = inY ;
+    theEvent.fReserved    = 0 ;
+
+    mLastTime = theTime ;
+
+    mEvents.push_back( theEvent ) ;
+
+  } // end Record
+
+// --------------------------
+// APReport does not read files back, so the log is kept in the temporary
+// directory where a later session can find it.
+
+void APEventLog::GetFilePath( const char * inFileName, char * outPath, size_t inPathSize )
+  {
+#if WIN_ENV
+    const char *  theDirectory = getenv( "TEMP" ) ;
+    const char *  theSeparator = "\\" ;
+#else
+    const char *  theDirectory = getenv( "TMPDIR" ) ;
+    const char *  theSeparator = "/" ;
+
+    if ( theDirectory == NULL )
+      theDirectory = "/tmp" ;
+#endif
+
+    if ( ( theDirectory == NULL ) || ( theDirectory[ 0 ] == 0 ) )
+      theDirectory = "." ;
+
+    snprintf( outPath, inPathSize, "%s%s%s", theDirectory,
+              ( theDirectory[ strlen( theDirectory ) - 1 ] == theSeparator[ 0 ] ) ? "" : theSeparator, inFileName ) ;
+
+  } // end GetFilePath
+
+// --------------------------
+
+ASBool APEventLog::Save( const char * inFileName ) const
+  {
+    char                thePath[ 1024 ] ;
+    APEventLogHeader    theHeader ;
+    FILE *              theFile ;
+    ASBool              theResult ;
+
+    GetFilePath( inFileName, thePath, sizeof( thePath ) ) ;
+
+    theFile = fopen( thePath, "wb" ) ;
+    if ( theFile == NULL )
+      return false ;
+
+    theHeader.fMagic      = kEventLogMagic ;
+    theHeader.fVersion    = kEventLogVersion ;
+    theHeader.fNumEvents  = ( ASUns32 )mEvents.size() ;
+    theHeader.fNumDocs    = mNumDocs ;
+
+    theResult = ( fwrite( &theHeader, sizeof( theHeader ), 1, theFile ) == 1 ) ;
+
+    if ( ( theResult == true ) && ( mEvents.empty() == false ) )
+      theResult = ( fwrite( &mEvents[ 0 ], sizeof( APLoggedEvent ), mEvents.size(), theFile ) == mEvents.size() ) ;
+
+    if ( fclose( theFile ) != 0 )
+      theResult = false ;
+
+    return theResult ;
+
+  } // end Save
+
+// --------------------------
+// A file that is short, or from another version, leaves the log empty.
+
+ASBool APEventLog::Load( const char * inFileName )
+  {
+    char                thePath[ 1024 ] ;
+    APEventLogHeader    theHeader ;
+    FILE *              theFile ;
+    ASBool              theResult ;
+
+    mRecording = false ;
+    mEvents.clear() ;
+    mDocNumbers.clear() ;
+    mNumDocs = 0 ;
+
+    GetFilePath( inFileName, thePath, sizeof( thePath ) ) ;
+
+    theFile = fopen( thePath, "rb" ) ;
+    if ( theFile == NULL )
+      return false ;
+
+    theResult = ( fread( &theHeader, sizeof( theHeader ), 1, theFile ) == 1 )
+                && ( theHeader.fMagic == kEventLogMagic ) && ( theHeader.fVersion == kEventLogVersion )
+                && ( theHeader.fNumEvents <= kMaxLoggedEvents ) ;
+
+    if ( ( theResult == true ) && ( theHeader.fNumEvents != 0 ) )
+      {
+        mEvents.resize( theHeader.fNumEvents ) ;
+        theResult = ( fread( &mEvents[ 0 ], sizeof( APLoggedEvent ), theHeader.fNumEvents, theFile ) == theHeader.fNumEvents ) ;
+      }
+
+    fclose( theFile ) ;
+
+    if ( theResult == false )
+      mEvents.clear() ;
+    else
+      mNumDocs = theHeader.fNumDocs ;
+
+    return theResult ;
+
+  } // end Load
+
+// --------------------------
+
+ACCB1 ASBool ACCB2 APEventLog::CollectDoc( AVDoc inAVDoc, void * inClientData )
+  {
+    ( ( std::vector< AVDoc > * )inClientData )->push_back( inAVDoc ) ;
+
+    return true ;
+
+  } // end CollectDoc
+
+// --------------------------
+
+ASInt32 APEventLog::BeginReplay( void )
+  {
+    mReplayDocs.clear() ;
+
+    AVAppEnumDocs( ASCallbackCreateProto( AVDocEnumProc, &CollectDoc ), &mReplayDocs ) ;
+
+    return ( ASInt32 )mReplayDocs.size() ;
+
+  } // end BeginReplay
+
+// --------------------------
+
+AVDoc APEventLog::GetReplayDoc( ASUns8 inDoc ) const
+  {
+    if ( ( inDoc == kLoggedNoDoc ) || mReplayDocs.empty() )
+      return ( AVDoc )NULL ;
+
+    return mReplayDocs[ inDoc % mReplayDocs.size() ] ;
+
+  } // end GetReplayDoc
+
+// --------------------------
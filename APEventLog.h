@@ -0,0 +1,127 @@
+/*
+  File:   APEventLog.h
+
+  Contains: Records the notifications and clicks a plug-in receives to a
+            compact binary file so the same sequence can be replayed into
+            its callbacks later.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    In each callback:
+
+      if ( gEventLog.IsRecording() )
+        gEventLog.Record( kLoggedPageViewDidChange, AVPageViewGetAVDoc( inAVPageView ), inHowChanged, 0, 0, 0 ) ;
+
+    Stop and Save to keep the sequence; later, Load it and replay it through
+    APBenchmark, one event per call:
+
+      static void ReplayEvent( void * inData, ASInt32 inIteration )
+        {
+          const APLoggedEvent & theEvent = gEventLog.GetEvent( inIteration % gEventLog.GetNumEvents() ) ;
+          AVDoc theAVDoc = gEventLog.GetReplayDoc( theEvent.fDoc ) ;
+          ...
+        }
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+#include <vector>
+#include <unordered_map>
+
+// --------------------------
+
+#define kMaxLoggedEvents    ( 1 << 20 )     // 16 MB of events; later events are dropped
+#define kEventLogMagic      0x4150454C      // 'APEL'
+#define kEventLogVersion    1
+#define kLoggedNoDoc        0xFF            // fDoc for a notification that had no document
+
+enum
+  {
+    kLoggedPageViewDidChange = 1,     // fArg is inHowChanged
+    kLoggedFrontDocDidChange,
+    kLoggedDocDidOpen,
+    kLoggedIdleUpdate,                // an idle proc that found work to do
+    kLoggedPageViewClick              // fArg is the modifier flags, fClickNumber the click count
+  } ;
+
+// Written to the file as is, after an APEventLogHeader; both are 16 bytes
+// and hold only fixed-size fields.
+struct APLoggedEvent
+  {
+    ASUns32     fDelta ;          // microseconds since the previous event
+    ASUns8      fKind ;
+    ASUns8      fDoc ;            // documents are numbered in the order they first appear
+    ASInt16     fArg ;
+    ASInt16     fClickNumber ;
+    ASInt16     fX ;
+    ASInt16     fY ;
+    ASUns16     fReserved ;
+  } ;
+
+struct APEventLogHeader
+  {
+    ASUns32     fMagic ;
+    ASUns32     fVersion ;
+    ASUns32     fNumEvents ;
+    ASUns32     fNumDocs ;
+  } ;
+
+// --------------------------
+// Documents are logged as small numbers rather than handles, which mean
+// nothing in another session.  On replay document n is the nth document open
+// at the time, wrapping around when fewer are open than were recorded.
+
+class APEventLog
+  {
+    public:
+      APEventLog() ;
+
+      void          Start( void ) ;
+      void          Stop( void ) { mRecording = false ; }
+      ASBool        IsRecording( void ) const { return mRecording ; }
+
+      void          Record( ASUns8 inKind, AVDoc inAVDoc, ASInt16 inArg, ASInt16 inClickNumber, ASInt16 inX, ASInt16 inY ) ;
+
+      // the file goes in the temporary directory; false when it cannot be written or read
+      ASBool        Save( const char * inFileName ) const ;
+      ASBool        Load( const char * inFileName ) ;
+
+      ASInt32       GetNumEvents( void ) const { return ( ASInt32 )mEvents.size() ; }
+      const APLoggedEvent & GetEvent( ASInt32 inIndex ) const { return mEvents[ inIndex ] ; }
+      ASInt32       GetNumDropped( void ) const { return mDropped ; }
+
+      // collects the documents open now; call before replaying
+      ASInt32       BeginReplay( void ) ;
+      AVDoc         GetReplayDoc( ASUns8 inDoc ) const ;
+
+    private:
+      static void   GetFilePath( const char * inFileName, char * outPath, size_t inPathSize ) ;
+      static ACCB1 ASBool ACCB2 CollectDoc( AVDoc inAVDoc, void * inClientData ) ;
+
+      ASBool                                  mRecording ;
+      ASUns64                                 mLastTime ;
+      ASInt32                                 mDropped ;
+      ASUns32                                 mNumDocs ;
+      std::vector< APLoggedEvent >            mEvents ;
+      std::unordered_map< AVDoc, ASUns8 >     mDocNumbers ;
+      std::vector< AVDoc >                    mReplayDocs ;
+
+      APEventLog( const APEventLog & ) ;
+      APEventLog & operator=( const APEventLog & ) ;
+  } ;
+
+// --------------------------
@@ -0,0 +1,59 @@
+/*
+  File:   APHandle.cpp
+
+  Contains: Owning wrappers for acquired Acrobat objects that release them
+            when they go out of scope.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "PDCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+
+#include "APDiagnostics.h"
+#include "APHandle.h"
+
+// --------------------------
+
+#if DEBUG
+ASInt32   gLiveHandles[ kNumHandleTypes ] = { 0 } ;
+#endif
+
+// --------------------------
+// Called from UnloadPlugIn once every wrapper kept for the session, such as
+// those in the menu index, has been cleared; any count left is a leak.
+
+void APHandleReportLeaks( void )
+  {
+#if DEBUG
+    static const char * const   sTypeNames[ kNumHandleTypes ] = { "AVMenu", "AVMenuItem", "PDDoc", "PDPage" } ;
+    char                        theString[ 96 ] ;
+
+    for ( ASInt32 index = 0 ; index < kNumHandleTypes ; index++ )
+      {
+        if ( gLiveHandles[ index ] == 0 )
+          continue ;
+
+        snprintf( theString, sizeof( theString ), "%d %s handles were never released", ( int )gLiveHandles[ index ], sTypeNames[ index ] ) ;
+        APDiagnostics::Shared().Report( 0, theString ) ;
+      }
+#endif
+
+  } // end APHandleReportLeaks
+
+// --------------------------
@@ -0,0 +1,174 @@
+/*
+  File:   APHandle.h
+
+  Contains: Owning wrappers for acquired Acrobat objects that release them
+            when they go out of scope.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    An exception raised inside DURING longjmps to the HANDLER without
+    running destructors, so declare the wrapper before DURING, in the
+    function that has the HANDLER, and fill it inside:
+
+      APPDDocRef  thePDDoc ;
+
+      DURING
+        PDDocAcquire( AVDocGetPDDoc( theAVDoc ) ) ;
+        thePDDoc.Reset( AVDocGetPDDoc( theAVDoc ) ) ;
+        ...
+      HANDLER
+        ...
+      END_HANDLER
+
+      // released here, whether or not the HANDLER ran
+
+    Outside DURING, e.g. in a loop, a wrapper can simply take the result of
+    an Acquire call:
+
+      APMenuItemRef theAVMenuItem( AVMenuAcquireMenuItemByIndex( theAVMenu, index ) ) ;
+
+*/
+
+#pragma once
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "PDCalls.h"
+
+// --------------------------
+// Debug builds count the objects each wrapper type holds so anything still
+// held when the plug-in unloads can be reported; release builds keep no
+// counts and a wrapper is just the handle.
+
+enum
+  {
+    kHandleAVMenu = 0,
+    kHandleAVMenuItem,
+    kHandlePDDoc,
+    kHandlePDPage,
+    kNumHandleTypes
+  } ;
+
+#if DEBUG
+extern ASInt32  gLiveHandles[ kNumHandleTypes ] ;
+#endif
+
+// reports each type with handles still held to APDiagnostics; does nothing in release builds
+void APHandleReportLeaks( void ) ;
+
+// --------------------------
+
+struct APAVMenuTraits
+  {
+    typedef AVMenu        Handle ;
+    enum { kType = kHandleAVMenu } ;
+    static void Release( AVMenu inHandle ) { AVMenuRelease( inHandle ) ; }
+  } ;
+
+struct APAVMenuItemTraits
+  {
+    typedef AVMenuItem    Handle ;
+    enum { kType = kHandleAVMenuItem } ;
+    static void Release( AVMenuItem inHandle ) { AVMenuItemRelease( inHandle ) ; }
+  } ;
+
+struct APPDDocTraits
+  {
+    typedef PDDoc         Handle ;
+    enum { kType = kHandlePDDoc } ;
+    static void Release( PDDoc inHandle ) { PDDocRelease( inHandle ) ; }
+  } ;
+
+struct APPDPageTraits
+  {
+    typedef PDPage        Handle ;
+    enum { kType = kHandlePDPage } ;
+    static void Release( PDPage inHandle ) { PDPageRelease( inHandle ) ; }
+  } ;
+
+// --------------------------
+// Holds one acquired object and releases it once.  It can be moved but not
+// copied, so exactly one wrapper is responsible for each acquire.
+
+template< class Traits >
+class APAcquired
+  {
+    public:
+      typedef typename Traits::Handle   Handle ;
+
+      APAcquired() : mHandle( NULL ) {}
+      explicit APAcquired( Handle inHandle ) : mHandle( NULL ) { Reset( inHandle ) ; }
+      APAcquired( APAcquired && ioOther ) : mHandle( ioOther.Detach() ) {}
+      ~APAcquired() { Reset( NULL ) ; }
+
+      APAcquired & operator=( APAcquired && ioOther )
+        {
+          if ( this != &ioOther )
+            {
+              Reset( NULL ) ;
+              mHandle = ioOther.Detach() ;
+            }
+          return *this ;
+        }
+
+      Handle      Get( void ) const { return mHandle ; }
+      operator    Handle( void ) const { return mHandle ; }
+
+      // release what is held, then take ownership of an already acquired handle
+      void        Reset( Handle inHandle )
+        {
+          if ( mHandle != NULL )
+            {
+              Traits::Release( mHandle ) ;
+#if DEBUG
+              gLiveHandles[ Traits::kType ] -= 1 ;
+#endif
+            }
+
+          mHandle = inHandle ;
+
+#if DEBUG
+          if ( mHandle != NULL )
+            gLiveHandles[ Traits::kType ] += 1 ;
+#endif
+        }
+
+      // give up ownership without releasing
+      Handle      Detach( void )
+        {
+          Handle theHandle = mHandle ;
+#if DEBUG
+          if ( mHandle != NULL )
+            gLiveHandles[ Traits::kType ] -= 1 ;
+#endif
+          mHandle = NULL ;
+          return theHandle ;
+        }
+
+    private:
+      // volatile: a wrapper declared before DURING is filled inside it and
+      // released after a longjmp out of it, when a copy the compiler kept in
+      // a register would be stale
+      Handle volatile   mHandle ;
+
+      APAcquired( const APAcquired & ) ;
+      APAcquired & operator=( const APAcquired & ) ;
+  } ;
+
+typedef APAcquired< APAVMenuTraits >      APMenuRef ;
+typedef APAcquired< APAVMenuItemTraits >  APMenuItemRef ;
+typedef APAcquired< APPDDocTraits >       APPDDocRef ;
+typedef APAcquired< APPDPageTraits >      APPDPageRef ;
+
+// --------------------------
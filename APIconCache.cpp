@@ -0,0 +1,74 @@
+/*
+  File:   APIconCache.cpp
+
+  Contains: Toolbar icons loaded on first use and kept for the life of the
+            plug-in.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include "TAVUtils.h"
+
+#include "APTiming.h"
+#include "APIconCache.h"
+
+// --------------------------
+
+APIconCache::APIconCache()
+  : mLoads( 0 ),
+    mHits( 0 ),
+    mLoadTime( 0 )
+  {
+  } // end APIconCache
+
+// --------------------------
+
+APIconCache & APIconCache::Shared( void )
+  {
+    static APIconCache  sIconCache ;
+
+    return sIconCache ;
+
+  } // end Shared
+
+// --------------------------
+
+AVIcon APIconCache::GetIcon( ASInt32 inIconID )
+  {
+    AVIcon    theAVIcon ;
+    ASUns64   theStart ;
+
+    std::unordered_map< ASInt32, AVIcon >::const_iterator theFound = mIcons.find( inIconID ) ;
+    if ( theFound != mIcons.end() )
+      {
+        mHits += 1 ;
+        return theFound->second ;
+      }
+
+    theStart  = APTiming::GetNanoseconds() ;
+    theAVIcon = TAVUtils::GetButtonIcon( inIconID ) ;
+    mLoadTime += APTiming::GetNanoseconds() - theStart ;
+    mLoads    += 1 ;
+
+    mIcons[ inIconID ] = theAVIcon ;
+
+    return theAVIcon ;
+
+  } // end GetIcon
+
+// --------------------------
@@ -0,0 +1,57 @@
+/*
+  File:   APIconCache.h
+
+  Contains: Toolbar icons loaded on first use and kept for the life of the
+            plug-in.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+#include <unordered_map>
+
+// --------------------------
+// Icons are loaded from the plug-in's own resources, so there is one cache
+// per plug-in, shared by everything in it through APIconCache::Shared().
+// An icon is only loaded the first time it is asked for, normally when it is
+// about to be shown, and never loaded twice.
+
+class APIconCache
+  {
+    public:
+      APIconCache() ;
+
+      static APIconCache &  Shared( void ) ;
+
+      AVIcon        GetIcon( ASInt32 inIconID ) ;
+
+      ASInt32       GetNumIcons( void ) const { return ( ASInt32 )mIcons.size() ; }
+      ASInt32       GetNumLoads( void ) const { return mLoads ; }
+      ASInt32       GetNumHits( void ) const { return mHits ; }
+      ASUns64       GetLoadTime( void ) const { return mLoadTime ; }
+
+    private:
+      std::unordered_map< ASInt32, AVIcon >  mIcons ;
+      ASInt32                                 mLoads ;
+      ASInt32                                 mHits ;
+      ASUns64                                 mLoadTime ;
+
+      APIconCache( const APIconCache & ) ;
+      APIconCache & operator=( const APIconCache & ) ;
+  } ;
+
+// --------------------------
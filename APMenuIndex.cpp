@@ -0,0 +1,420 @@
+/*
+  File:   APMenuIndex.cpp
+
+  Contains: Hash index from menu and menu item name atoms to the live AVMenu,
+            AVMenuItem and item index, kept current through menu notifications.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <vector>
+
+#include "APMenuIndex.h"
+
+// --------------------------
+
+#define kMenuIndexUnknown   -1      // not yet resolved for the parent menu's current stamp
+
+// --------------------------
+
+APMenuIndex::APMenuIndex()
+  : mBuilt( false )
+  {
+  } // end APMenuIndex
+
+// --------------------------
+
+APMenuIndex::~APMenuIndex()
+  {
+    Clear() ;
+
+  } // end ~APMenuIndex
+
+// --------------------------
+// Walk the whole menubar once, recording every menu, sub-menu and menu item.
+
+void APMenuIndex::Build( AVMenubar inAVMenubar )
+  {
+    APMenuRef   theAVMenu ;       // outside DURING so it is released before a raise is passed on
+    ASInt32     theMenuCount ;
+
+    Clear() ;
+
+    if ( inAVMenubar == NULL )
+      return ;
+
+    DURING
+
+      theMenuCount = AVMenubarGetNumMenus( inAVMenubar ) ;
+
+      mMenuItems.reserve( theMenuCount * 32 ) ;
+      mMenus.reserve( theMenuCount * 4 ) ;
+      mMenuStamps.reserve( theMenuCount * 4 ) ;
+
+      for ( ASInt32 index = 0 ; index < theMenuCount ; index++ )
+        {
+          theAVMenu.Reset( AVMenubarAcquireMenuByIndex( inAVMenubar, index ) ) ;
+          if ( theAVMenu == NULL )
+            continue ;
+
+          AddMenuTree( theAVMenu ) ;
+
+        } // end for
+
+    HANDLER
+      theAVMenu.Reset( NULL ) ;
+      RERAISE() ;
+    END_HANDLER
+
+    mBuilt = true ;
+
+  } // end Build
+
+// --------------------------
+// Release every reference held by the index.
+
+void APMenuIndex::Clear( void )
+  {
+    mMenuItems.clear() ;
+    mMenus.clear() ;
+    mMenuStamps.clear() ;
+
+    mBuilt = false ;
+
+  } // end Clear
+
+// --------------------------
+// Record a menu, all of its items and, recursively, any of their sub-menus.
+
+void APMenuIndex::AddMenuTree( AVMenu inAVMenu )
+  {
+    APMenuItemRef   theAVMenuItem ;     // outside DURING so they are released before a raise is passed on
+    APMenuRef       theSubAVMenu ;
+    ASAtom          theMenuName ;
+    ASInt32         theMenuItemCount ;
+
+    DURING
+
+      theMenuName = AVMenuGetName( inAVMenu ) ;
+      if ( mMenus.find( theMenuName ) == mMenus.end() )
+        mMenus[ theMenuName ].Reset( AVMenuAcquire( inAVMenu ) ) ;
+
+      theMenuItemCount = AVMenuGetNumMenuItems( inAVMenu ) ;
+
+      for ( ASInt32 index = 0 ; index < theMenuItemCount ; index++ )
+        {
+          theAVMenuItem.Reset( AVMenuAcquireMenuItemByIndex( inAVMenu, index ) ) ;
+          if ( theAVMenuItem == NULL )
+            continue ;
+
+          AddMenuItem( theAVMenuItem, inAVMenu, index ) ;
+
+          theSubAVMenu.Reset( AVMenuItemAcquireSubmenu( theAVMenuItem ) ) ;
+          if ( theSubAVMenu != NULL )
+            AddMenuTree( theSubAVMenu ) ;
+
+        } // end for
+
+    HANDLER
+      theSubAVMenu.Reset( NULL ) ;
+      theAVMenuItem.Reset( NULL ) ;
+      RERAISE() ;
+    END_HANDLER
+
+  } // end AddMenuTree
+
+// --------------------------
+// Record a single menu item at inIndex, or kMenuIndexUnknown to find its
+// position on the first lookup; the index takes its own reference.
+
+void APMenuIndex::AddMenuItem( AVMenuItem inAVMenuItem, AVMenu inParentAVMenu, ASInt32 inIndex )
+  {
+    ASAtom      theMenuItemName ;
+    ItemEntry   theEntry ;
+
+    theMenuItemName = AVMenuItemGetName( inAVMenuItem ) ;
+
+    std::unordered_map< ASAtom, ItemEntry >::iterator theIter = mMenuItems.find( theMenuItemName ) ;
+    if ( theIter != mMenuItems.end() )
+      {
+        if ( theIter->second.fAVMenuItem != inAVMenuItem )
+          theIter->second.fAVMenuItem.Reset( AVMenuItemAcquire( inAVMenuItem ) ) ;
+        theIter->second.fParentAVMenu = inParentAVMenu ;
+        theIter->second.fIndex        = inIndex ;
+        theIter->second.fStamp        = GetMenuStamp( inParentAVMenu ) ;
+        return ;
+      }
+
+    theEntry.fAVMenuItem.Reset( AVMenuItemAcquire( inAVMenuItem ) ) ;
+    theEntry.fParentAVMenu  = inParentAVMenu ;
+    theEntry.fIndex         = inIndex ;
+    theEntry.fStamp         = GetMenuStamp( inParentAVMenu ) ;
+
+    mMenuItems[ theMenuItemName ] = std::move( theEntry ) ;
+
+  } // end AddMenuItem
+
+// --------------------------
+// Mark every recorded item position in the given menu as stale.
+
+void APMenuIndex::TouchMenu( AVMenu inAVMenu )
+  {
+    mMenuStamps[ inAVMenu ] += 1 ;
+
+  } // end TouchMenu
+
+// --------------------------
+
+ASUns32 APMenuIndex::GetMenuStamp( AVMenu inAVMenu ) const
+  {
+    std::unordered_map< AVMenu, ASUns32 >::const_iterator theIter = mMenuStamps.find( inAVMenu ) ;
+
+    return ( theIter == mMenuStamps.end() ) ? 0 : theIter->second ;
+
+  } // end GetMenuStamp
+
+// --------------------------
+// Record the position of every indexed item in inAVMenu with one walk of
+// the menu.  The positions hold until the menu's stamp next changes.
+
+void APMenuIndex::ResolveMenu( AVMenu inAVMenu )
+  {
+    APMenuItemRef   theAVMenuItem ;     // outside DURING so it is released before a raise is passed on
+    ASUns32         theStamp = GetMenuStamp( inAVMenu ) ;
+    ASInt32         theMenuItemCount ;
+
+    DURING
+
+      theMenuItemCount = AVMenuGetNumMenuItems( inAVMenu ) ;
+
+      for ( ASInt32 index = 0 ; index < theMenuItemCount ; index++ )
+        {
+          theAVMenuItem.Reset( AVMenuAcquireMenuItemByIndex( inAVMenu, index ) ) ;
+          if ( theAVMenuItem == NULL )
+            continue ;
+
+          std::unordered_map< ASAtom, ItemEntry >::iterator theIter = mMenuItems.find( AVMenuItemGetName( theAVMenuItem ) ) ;
+          if ( ( theIter == mMenuItems.end() ) || ( theIter->second.fAVMenuItem.Get() != theAVMenuItem.Get() ) )
+            continue ;
+
+          theIter->second.fParentAVMenu = inAVMenu ;
+          theIter->second.fIndex        = index ;
+          theIter->second.fStamp        = theStamp ;
+        }
+
+    HANDLER
+      theAVMenuItem.Reset( NULL ) ;
+      RERAISE() ;
+    END_HANDLER
+
+  } // end ResolveMenu
+
+// --------------------------
+// Called from the AVMenuItemWasAddedToMenu notification.  Menus are filled
+// an item at a time during startup, so nothing here walks the parent menu:
+// the item's position is left unknown until it is first looked up.
+
+void APMenuIndex::MenuItemAdded( AVMenuItem inAVMenuItem, AVMenu inParentAVMenu )
+  {
+    APMenuRef   theSubAVMenu ;      // outside DURING so it is released before a raise is passed on
+
+    if ( ( mBuilt == false ) || ( inAVMenuItem == NULL ) || ( inParentAVMenu == NULL ) )
+      return ;
+
+    // the siblings following the new item have all moved down by one
+    TouchMenu( inParentAVMenu ) ;
+
+    AddMenuItem( inAVMenuItem, inParentAVMenu, kMenuIndexUnknown ) ;
+
+    DURING
+      theSubAVMenu.Reset( AVMenuItemAcquireSubmenu( inAVMenuItem ) ) ;
+      if ( theSubAVMenu != NULL )
+        AddMenuTree( theSubAVMenu ) ;
+    HANDLER
+      theSubAVMenu.Reset( NULL ) ;
+      RERAISE() ;
+    END_HANDLER
+
+  } // end MenuItemAdded
+
+// --------------------------
+// Called from the AVMenuItemWasRemoved notification.
+
+void APMenuIndex::MenuItemRemoved( AVMenuItem inAVMenuItem )
+  {
+    if ( ( mBuilt == false ) || ( inAVMenuItem == NULL ) )
+      return ;
+
+    std::unordered_map< ASAtom, ItemEntry >::iterator theIter = mMenuItems.find( AVMenuItemGetName( inAVMenuItem ) ) ;
+    if ( ( theIter == mMenuItems.end() ) || ( theIter->second.fAVMenuItem != inAVMenuItem ) )
+      return ;
+
+    TouchMenu( theIter->second.fParentAVMenu ) ;
+
+    mMenuItems.erase( theIter ) ;
+
+  } // end MenuItemRemoved
+
+// --------------------------
+// Called from the AVMenuWasAddedToMenubar notification.
+
+void APMenuIndex::MenuAdded( AVMenu inAVMenu )
+  {
+    if ( ( mBuilt == false ) || ( inAVMenu == NULL ) )
+      return ;
+
+    AddMenuTree( inAVMenu ) ;
+
+  } // end MenuAdded
+
+// --------------------------
+// Called from the AVMenuWasRemoved notification.  The menu's items, and the
+// items of its sub-menus, go with it, so none of them can be looked up
+// afterwards pointing into a menu that is gone.
+
+void APMenuIndex::MenuRemoved( AVMenu inAVMenu )
+  {
+    if ( ( mBuilt == false ) || ( inAVMenu == NULL ) )
+      return ;
+
+    std::unordered_map< ASAtom, APMenuRef >::iterator theIter = mMenus.find( AVMenuGetName( inAVMenu ) ) ;
+    if ( ( theIter == mMenus.end() ) || ( theIter->second != inAVMenu ) )
+      return ;
+
+    RemoveMenuTree( inAVMenu ) ;
+
+  } // end MenuRemoved
+
+// --------------------------
+// Drop a menu, all of its items and, recursively, any of their sub-menus.
+
+void APMenuIndex::RemoveMenuTree( AVMenu inAVMenu )
+  {
+    std::vector< APMenuItemRef >  theAVMenuItems ;    // outside DURING so they are released before a raise is passed on
+    APMenuRef                     theSubAVMenu ;
+
+    std::unordered_map< ASAtom, ItemEntry >::iterator theItemIter ;
+    for ( theItemIter = mMenuItems.begin() ; theItemIter != mMenuItems.end() ; )
+      {
+        if ( theItemIter->second.fParentAVMenu == inAVMenu )
+          {
+            // the index's reference passes to theAVMenuItems
+            theAVMenuItems.push_back( std::move( theItemIter->second.fAVMenuItem ) ) ;
+            theItemIter = mMenuItems.erase( theItemIter ) ;
+          }
+        else
+          ++theItemIter ;
+      }
+
+    DURING
+
+      for ( size_t index = 0 ; index < theAVMenuItems.size() ; index++ )
+        {
+          theSubAVMenu.Reset( AVMenuItemAcquireSubmenu( theAVMenuItems[ index ] ) ) ;
+          if ( theSubAVMenu != NULL )
+            RemoveMenuTree( theSubAVMenu ) ;
+
+          theSubAVMenu.Reset( NULL ) ;
+          theAVMenuItems[ index ].Reset( NULL ) ;
+        }
+
+    HANDLER
+      theSubAVMenu.Reset( NULL ) ;
+      std::vector< APMenuItemRef >().swap( theAVMenuItems ) ;
+      RERAISE() ;
+    END_HANDLER
+
+    std::unordered_map< ASAtom, APMenuRef >::iterator theMenuIter = mMenus.find( AVMenuGetName( inAVMenu ) ) ;
+    if ( ( theMenuIter != mMenus.end() ) && ( theMenuIter->second == inAVMenu ) )
+      mMenus.erase( theMenuIter ) ;
+
+    mMenuStamps.erase( inAVMenu ) ;
+
+  } // end RemoveMenuTree
+
+// --------------------------
+// Return the menu item with the given name, its parent menu and its index in
+// that menu.  The returned menu item has not been acquired for the caller.
+// The first lookup in a menu after it changes walks that menu once and
+// resolves every sibling's index; later lookups are constant time until the
+// menu changes again.
+
+AVMenuItem APMenuIndex::FindMenuItem( ASAtom inName, AVMenu * outParentAVMenu, ASInt32 * outIndex )
+  {
+    AVMenu    theParentAVMenu ;
+
+    std::unordered_map< ASAtom, ItemEntry >::iterator theIter = mMenuItems.find( inName ) ;
+    if ( theIter == mMenuItems.end() )
+      return ( AVMenuItem )NULL ;
+
+    ItemEntry & theEntry = theIter->second ;
+
+    if ( ( theEntry.fIndex == kMenuIndexUnknown ) || ( theEntry.fStamp != GetMenuStamp( theEntry.fParentAVMenu ) ) )
+      {
+        theEntry.fIndex = kMenuIndexUnknown ;
+
+        theParentAVMenu = AVMenuItemGetParentMenu( theEntry.fAVMenuItem ) ;
+        if ( theParentAVMenu != NULL )
+          ResolveMenu( theParentAVMenu ) ;
+
+        if ( theEntry.fIndex == kMenuIndexUnknown )   // no longer in any menu
+          {
+            mMenuItems.erase( theIter ) ;
+            return ( AVMenuItem )NULL ;
+          }
+      }
+
+    if ( outParentAVMenu != NULL )
+      *outParentAVMenu = theEntry.fParentAVMenu ;
+    if ( outIndex != NULL )
+      *outIndex = theEntry.fIndex ;
+
+    return theEntry.fAVMenuItem ;
+
+  } // end FindMenuItem
+
+// --------------------------
+// Return the menu with the given name.  The returned menu has not been acquired for the caller.
+
+AVMenu APMenuIndex::FindMenu( ASAtom inName )
+  {
+    std::unordered_map< ASAtom, APMenuRef >::iterator theIter = mMenus.find( inName ) ;
+    if ( theIter == mMenus.end() )
+      return ( AVMenu )NULL ;
+
+    return theIter->second ;
+
+  } // end FindMenu
+
+// --------------------------
+// Call inEnumProc for every recorded menu item.  The items are not acquired
+// for the callback, which must not add or remove menu items.
+
+void APMenuIndex::EnumMenuItems( APMenuIndexEnumProc inEnumProc, void * inClientData )
+  {
+    std::unordered_map< ASAtom, ItemEntry >::iterator theIter ;
+
+    if ( inEnumProc == NULL )
+      return ;
+
+    for ( theIter = mMenuItems.begin() ; theIter != mMenuItems.end() ; ++theIter )
+      ( *inEnumProc )( theIter->second.fAVMenuItem, theIter->second.fParentAVMenu, inClientData ) ;
+
+  } // end EnumMenuItems
+
+// --------------------------
@@ -0,0 +1,92 @@
+/*
+  File:   APMenuIndex.h
+
+  Contains: Hash index from menu and menu item name atoms to the live AVMenu,
+            AVMenuItem and item index, kept current through menu notifications.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+#include <unordered_map>
+
+#include "APHandle.h"
+
+// --------------------------
+// The index is built with a single walk of the menubar and is then updated
+// from the AVMenuItemWasAddedToMenu, AVMenuItemWasRemoved, AVMenuWasAddedToMenubar
+// and AVMenuWasRemoved notifications, so a lookup never walks the menubar again.
+// Item positions shift when a sibling is inserted or removed; rather than renumber
+// every sibling on each change, each menu carries a stamp that is bumped on change.
+// An added item is recorded with no position at all, so filling a menu costs no
+// walk of it; the first lookup in a changed menu walks it once and resolves the
+// position of every item in it for the new stamp.  Lookups are constant time
+// only between changes to a menu.
+// The index holds a reference on every menu and menu item it records, in
+// APHandle wrappers so that debug builds count them.
+
+typedef void ( * APMenuIndexEnumProc )( AVMenuItem inAVMenuItem, AVMenu inParentAVMenu, void * inClientData ) ;
+
+class APMenuIndex
+  {
+    public:
+      APMenuIndex() ;
+      ~APMenuIndex() ;
+
+      void          Build( AVMenubar inAVMenubar ) ;
+      void          Clear( void ) ;
+      ASBool        IsBuilt( void ) const { return mBuilt ; }
+
+      void          MenuItemAdded( AVMenuItem inAVMenuItem, AVMenu inParentAVMenu ) ;
+      void          MenuItemRemoved( AVMenuItem inAVMenuItem ) ;
+      void          MenuAdded( AVMenu inAVMenu ) ;
+      void          MenuRemoved( AVMenu inAVMenu ) ;
+
+      AVMenuItem    FindMenuItem( ASAtom inName, AVMenu * outParentAVMenu, ASInt32 * outIndex ) ;
+      AVMenu        FindMenu( ASAtom inName ) ;
+
+      void          EnumMenuItems( APMenuIndexEnumProc inEnumProc, void * inClientData ) ;
+
+      ASInt32       GetNumMenuItems( void ) const { return ( ASInt32 )mMenuItems.size() ; }
+      ASInt32       GetNumMenus( void ) const { return ( ASInt32 )mMenus.size() ; }
+
+    private:
+      struct ItemEntry
+        {
+          APMenuItemRef fAVMenuItem ;
+          AVMenu        fParentAVMenu ;
+          ASInt32       fIndex ;          // valid while fStamp is the parent menu's stamp
+          ASUns32       fStamp ;
+        } ;
+
+      void          AddMenuTree( AVMenu inAVMenu ) ;
+      void          AddMenuItem( AVMenuItem inAVMenuItem, AVMenu inParentAVMenu, ASInt32 inIndex ) ;
+      void          RemoveMenuTree( AVMenu inAVMenu ) ;
+      void          ResolveMenu( AVMenu inAVMenu ) ;
+      void          TouchMenu( AVMenu inAVMenu ) ;
+      ASUns32       GetMenuStamp( AVMenu inAVMenu ) const ;
+
+      ASBool                                  mBuilt ;
+      std::unordered_map< ASAtom, ItemEntry > mMenuItems ;
+      std::unordered_map< ASAtom, APMenuRef > mMenus ;
+      std::unordered_map< AVMenu, ASUns32 >   mMenuStamps ;
+
+      APMenuIndex( const APMenuIndex & ) ;
+      APMenuIndex & operator=( const APMenuIndex & ) ;
+  } ;
+
+// --------------------------
@@ -0,0 +1,233 @@
+/*
+  File:   APMenuInstaller.cpp
+
+  Contains: Installs a plug-in's menu items from a table in one pass,
+            looking up each menu and anchor item only once.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "APTiming.h"
+#include "APMenuInstaller.h"
+
+// --------------------------
+
+struct MenuPlacement
+  {
+    AVMenu      fAVMenu ;
+    ASInt32     fIndex ;    // the anchor's index, or APPEND_MENUITEM
+    ASInt32     fSpec ;
+  } ;
+
+struct MenuAnchor
+  {
+    AVMenu      fAVMenu ;   // NULL when the anchor was not found
+    ASInt32     fIndex ;
+  } ;
+
+// --------------------------
+// Lowest in the menu first, so inserting an item never moves an anchor that
+// is still to be used; items after the same anchor go in last to first so
+// each one pushes the previous down and the table order comes out.
+
+static bool IsLaterPlacement( const MenuPlacement & inFirst, const MenuPlacement & inSecond )
+  {
+    if ( inFirst.fAVMenu != inSecond.fAVMenu )
+      return inFirst.fAVMenu < inSecond.fAVMenu ;
+
+    if ( inFirst.fIndex != inSecond.fIndex )
+      return inFirst.fIndex > inSecond.fIndex ;
+
+    return inFirst.fSpec > inSecond.fSpec ;
+
+  } // end IsLaterPlacement
+
+// --------------------------
+
+static bool IsAppended( const MenuPlacement & inPlacement )
+  {
+    return inPlacement.fIndex == APPEND_MENUITEM ;
+
+  } // end IsAppended
+
+// --------------------------
+
+static void AddSpecMenuItem( const APMenuItemSpec & inSpec, AVMenu inAVMenu, ASInt32 inIndex )
+  {
+    AVMenuItem  theAVMenuItem ;
+
+    theAVMenuItem = AVMenuItemNew( inSpec.fTitle, inSpec.fMenuItemName, ( AVMenu )NULL, false,
+                                   inSpec.fShortcut, inSpec.fFlags, NULL, gExtensionID ) ;
+
+    if ( inSpec.fComputeEnabled != NULL )
+      AVMenuItemSetComputeEnabledProc( theAVMenuItem, ASCallbackCreateProto( AVComputeEnabledProc, inSpec.fComputeEnabled ), inSpec.fComputeEnabledData ) ;
+
+    if ( inSpec.fComputeMarked != NULL )
+      AVMenuItemSetComputeMarkedProc( theAVMenuItem, ASCallbackCreateProto( AVComputeMarkedProc, inSpec.fComputeMarked ), NULL ) ;
+
+    if ( inSpec.fExecute != NULL )
+      AVMenuItemSetExecuteProc( theAVMenuItem, ASCallbackCreateProto( AVExecuteProc, inSpec.fExecute ), inSpec.fExecuteData ) ;
+
+    AVMenuAddMenuItem( inAVMenu, theAVMenuItem, inIndex ) ;
+
+    AVMenuItemRelease( theAVMenuItem ) ;
+
+  } // end AddSpecMenuItem
+
+// --------------------------
+// Every menu and anchor is resolved before the first item is added, then all
+// of the items go in.  The menus acquired along the way are released even
+// when adding an item raises; the error is then raised again for the caller.
+
+ASInt32 APMenuInstaller::Install( const APMenuItemSpec * inSpecs, ASInt32 inNumSpecs,
+                                  APMenuAnchorProc inAnchorProc, APMenuInstallStats * outStats )
+  {
+    AVMenubar                                   theAVMenubar ;
+    AVMenuItem                                  theAnchorAVMenuItem ;
+    MenuPlacement                               thePlacement ;
+    MenuAnchor                                  theAnchor ;
+    std::unordered_map< ASAtom, AVMenu >        theMenus ;
+    std::unordered_map< ASAtom, MenuAnchor >    theAnchors ;
+    std::vector< MenuPlacement >                thePlacements ;
+    volatile ASInt32                            theInstalled  = 0 ;     // volatile: changed in DURING and read after a raise
+    volatile ASInt32                            theLookups    = 0 ;
+    ASInt32                                     theError      = 0 ;
+    ASUns64                                     theStart      = APTiming::GetNanoseconds() ;
+
+    theAVMenubar = AVAppGetMenubar() ;
+    if ( ( theAVMenubar == NULL ) || ( inSpecs == NULL ) )
+      return 0 ;
+
+    thePlacements.reserve( inNumSpecs ) ;
+
+    DURING
+
+      for ( ASInt32 index = 0 ; index < inNumSpecs ; index++ )
+        {
+          const APMenuItemSpec &  theSpec = inSpecs[ index ] ;
+
+          thePlacement.fAVMenu  = NULL ;
+          thePlacement.fIndex   = APPEND_MENUITEM ;
+          thePlacement.fSpec    = index ;
+
+          if ( theSpec.fAfterMenuItemName != NULL )
+            {
+              ASAtom theName = ASAtomFromString( theSpec.fAfterMenuItemName ) ;
+
+              std::unordered_map< ASAtom, MenuAnchor >::const_iterator theFound = theAnchors.find( theName ) ;
+              if ( theFound != theAnchors.end() )
+                theAnchor = theFound->second ;
+              else
+                {
+                  theAnchor.fAVMenu   = NULL ;
+                  theAnchor.fIndex    = 0 ;
+                  theAnchorAVMenuItem = NULL ;
+                  theLookups         += 1 ;
+
+                  if ( inAnchorProc != NULL )
+                    theAnchorAVMenuItem = inAnchorProc( theSpec.fAfterMenuItemName, &theAnchor.fAVMenu, &theAnchor.fIndex ) ;
+
+                  if ( theAnchorAVMenuItem == NULL )
+                    {
+                      theAnchorAVMenuItem = AVMenubarAcquireMenuItemByName( theAVMenubar, theSpec.fAfterMenuItemName ) ;
+                      if ( theAnchorAVMenuItem != NULL )
+                        {
+                          theAnchor.fAVMenu = AVMenuItemGetParentMenu( theAnchorAVMenuItem ) ;
+                          theAnchor.fIndex  = AVMenuGetMenuItemIndex( theAnchor.fAVMenu, theAnchorAVMenuItem ) ;
+                        }
+                    }
+
+                  if ( theAnchorAVMenuItem != NULL )
+                    AVMenuItemRelease( theAnchorAVMenuItem ) ;
+
+                  theAnchors[ theName ] = theAnchor ;
+                }
+
+              thePlacement.fAVMenu  = theAnchor.fAVMenu ;
+              thePlacement.fIndex   = theAnchor.fIndex + 1 ;
+            }
+
+          if ( ( thePlacement.fAVMenu == NULL ) && ( theSpec.fMenuName != NULL ) )
+            {
+              ASAtom theName = ASAtomFromString( theSpec.fMenuName ) ;
+
+              std::unordered_map< ASAtom, AVMenu >::const_iterator theFound = theMenus.find( theName ) ;
+              if ( theFound != theMenus.end() )
+                thePlacement.fAVMenu = theFound->second ;
+              else
+                {
+                  thePlacement.fAVMenu = AVMenubarAcquireMenuByName( theAVMenubar, theSpec.fMenuName ) ;
+                  theMenus[ theName ]  = thePlacement.fAVMenu ;
+                  theLookups          += 1 ;
+                }
+
+              thePlacement.fIndex = APPEND_MENUITEM ;
+            }
+
+          if ( thePlacement.fAVMenu != NULL )
+            thePlacements.push_back( thePlacement ) ;
+        }
+
+      // appended items first, in table order; they cannot move an anchor
+      for ( size_t index = 0 ; index < thePlacements.size() ; index++ )
+        {
+          if ( thePlacements[ index ].fIndex != APPEND_MENUITEM )
+            continue ;
+
+          AddSpecMenuItem( inSpecs[ thePlacements[ index ].fSpec ], thePlacements[ index ].fAVMenu, APPEND_MENUITEM ) ;
+          theInstalled += 1 ;
+        }
+
+      thePlacements.erase( std::remove_if( thePlacements.begin(), thePlacements.end(), IsAppended ), thePlacements.end() ) ;
+      std::sort( thePlacements.begin(), thePlacements.end(), IsLaterPlacement ) ;
+
+      for ( size_t index = 0 ; index < thePlacements.size() ; index++ )
+        {
+          AddSpecMenuItem( inSpecs[ thePlacements[ index ].fSpec ], thePlacements[ index ].fAVMenu, thePlacements[ index ].fIndex ) ;
+          theInstalled += 1 ;
+        }
+
+    HANDLER
+      theError = ERRORCODE ;
+    END_HANDLER
+
+    for ( std::unordered_map< ASAtom, AVMenu >::iterator theIter = theMenus.begin() ; theIter != theMenus.end() ; ++theIter )
+      {
+        if ( theIter->second != NULL )
+          AVMenuRelease( theIter->second ) ;
+      }
+
+    if ( outStats != NULL )
+      {
+        outStats->fMenuItems  = theInstalled ;
+        outStats->fLookups    = theLookups ;
+        outStats->fTime       = APTiming::GetNanoseconds() - theStart ;
+      }
+
+    if ( theError != 0 )
+      ASRaise( theError ) ;
+
+    return theInstalled ;
+
+  } // end Install
+
+// --------------------------
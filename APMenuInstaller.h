@@ -0,0 +1,80 @@
+/*
+  File:   APMenuInstaller.h
+
+  Contains: Installs a plug-in's menu items from a table in one pass,
+            looking up each menu and anchor item only once.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      static const APMenuItemSpec gMenuItemSpecs[] =
+        {
+          // title              name                   menu               after           key          flags  enabled            data   marked  execute         data
+          { "Reverse Pages...", "DGAP:AboutReverse",   "AboutExtensions", NULL,           NO_SHORTCUT, 0,     NULL,              NULL,  NULL,   &DoAbout,       NULL },
+          { "Reverse Pages",    "DGAP:ReversePages",   "Document",        "ReplacePages", NO_SHORTCUT, 0,     &DoComputeEnabled, NULL,  NULL,   &DoReverse,     NULL }
+        } ;
+
+      APMenuInstaller::Install( gMenuItemSpecs, APMenuItemCount( gMenuItemSpecs ), NULL, NULL ) ;
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+// --------------------------
+
+#define APMenuItemCount( inTable )  ( ( ASInt32 )( sizeof( inTable ) / sizeof( ( inTable )[ 0 ] ) ) )
+
+// An item with fAfterMenuItemName goes directly after that item, in whatever
+// menu holds it; when the anchor cannot be found it is appended to fMenuName
+// instead, if given.  Items without an anchor are appended to fMenuName.
+// Items with the same anchor keep their table order.
+
+struct APMenuItemSpec
+  {
+    const char *            fTitle ;
+    const char *            fMenuItemName ;
+    const char *            fMenuName ;
+    const char *            fAfterMenuItemName ;
+    char                    fShortcut ;
+    AVFlagBits16            fFlags ;
+    AVComputeEnabledProc    fComputeEnabled ;
+    void *                  fComputeEnabledData ;
+    AVComputeMarkedProc     fComputeMarked ;
+    AVExecuteProc           fExecute ;
+    void *                  fExecuteData ;
+  } ;
+
+// Finds an anchor item faster than the menubar can, e.g. through the
+// ListMenuNames HFT; returns an acquired item, or NULL to use the menubar.
+typedef AVMenuItem ( * APMenuAnchorProc )( const char * inMenuItemName, AVMenu * outParentAVMenu, ASInt32 * outIndex ) ;
+
+struct APMenuInstallStats
+  {
+    ASInt32                 fMenuItems ;      // items installed
+    ASInt32                 fLookups ;        // menu and anchor lookups made
+    ASUns64                 fTime ;           // nanoseconds for the whole batch
+  } ;
+
+// --------------------------
+
+class APMenuInstaller
+  {
+    public:
+      // returns the number of items installed; outStats may be NULL
+      static ASInt32  Install( const APMenuItemSpec * inSpecs, ASInt32 inNumSpecs,
+                               APMenuAnchorProc inAnchorProc, APMenuInstallStats * outStats ) ;
+  } ;
+
+// --------------------------
@@ -0,0 +1,190 @@
+/*
+  File:   APMenuWatch.cpp
+
+  Contains: Records menu changes, as deltas against a single baseline walk,
+            while watching is turned on.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "APReport.h"
+#include "APTiming.h"
+#include "APMenuWatch.h"
+
+// --------------------------
+// By convention menu item names start with the owning extension's developer
+// prefix, e.g. "DGAP:ListMenuNames"; Acrobat's own items have no prefix.
+
+void APMenuWatch::GetOwnerPrefix( const char * inName, char * outOwner, size_t inOwnerSize )
+  {
+    const char *  theColon = strchr( inName, ':' ) ;
+
+    if ( ( theColon == NULL ) || ( theColon == inName ) || ( ( size_t )( theColon - inName ) >= inOwnerSize ) )
+      {
+        snprintf( outOwner, inOwnerSize, "Acrobat" ) ;
+        return ;
+      }
+
+    memcpy( outOwner, inName, theColon - inName ) ;
+    outOwner[ theColon - inName ] = 0 ;
+
+  } // end GetOwnerPrefix
+
+// --------------------------
+
+APMenuWatch::APMenuWatch()
+  : mWatching( false ),
+    mStartTime( 0 ),
+    mBaselineMenus( 0 ),
+    mBaselineMenuItems( 0 ),
+    mDropped( 0 )
+  {
+  } // end APMenuWatch
+
+// --------------------------
+// The caller takes the baseline walk, normally by building the menu index,
+// and passes in what it found.
+
+void APMenuWatch::Start( ASInt32 inBaselineMenus, ASInt32 inBaselineMenuItems )
+  {
+    mChanges.clear() ;
+    mChanges.reserve( 1024 ) ;
+    mRemoved.clear() ;
+
+    mBaselineMenus      = inBaselineMenus ;
+    mBaselineMenuItems  = inBaselineMenuItems ;
+    mDropped            = 0 ;
+    mStartTime          = APTiming::GetNanoseconds() ;
+    mWatching           = true ;
+
+  } // end Start
+
+// --------------------------
+// Stop recording; the changes are kept until the next Start.
+
+void APMenuWatch::Stop( void )
+  {
+    mWatching = false ;
+
+  } // end Stop
+
+// --------------------------
+
+void APMenuWatch::Record( ASInt32 inKind, ASAtom inMenuItemName, ASAtom inMenuName )
+  {
+    Change  theChange ;
+
+    if ( mChanges.size() >= kMaxMenuChanges )
+      {
+        mDropped += 1 ;
+        return ;
+      }
+
+    theChange.fTime         = APTiming::GetNanoseconds() ;
+    theChange.fMenuItemName = inMenuItemName ;
+    theChange.fMenuName     = inMenuName ;
+    theChange.fKind         = inKind ;
+
+    mChanges.push_back( theChange ) ;
+
+  } // end Record
+
+// --------------------------
+
+void APMenuWatch::MenuItemAdded( AVMenuItem inAVMenuItem, AVMenu inParentAVMenu )
+  {
+    ASAtom  theMenuItemName ;
+
+    if ( ( mWatching == false ) || ( inAVMenuItem == NULL ) )
+      return ;
+
+    theMenuItemName = AVMenuItemGetName( inAVMenuItem ) ;
+
+    Record( ( mRemoved.erase( theMenuItemName ) != 0 ) ? kMenuItemReAdded : kMenuItemAdded,
+            theMenuItemName, ( inParentAVMenu != NULL ) ? AVMenuGetName( inParentAVMenu ) : ASAtomNull ) ;
+
+  } // end MenuItemAdded
+
+// --------------------------
+
+void APMenuWatch::MenuItemRemoved( AVMenuItem inAVMenuItem )
+  {
+    ASAtom  theMenuItemName ;
+
+    if ( ( mWatching == false ) || ( inAVMenuItem == NULL ) )
+      return ;
+
+    theMenuItemName = AVMenuItemGetName( inAVMenuItem ) ;
+
+    mRemoved.insert( theMenuItemName ) ;
+
+    Record( kMenuItemRemoved, theMenuItemName, ASAtomNull ) ;
+
+  } // end MenuItemRemoved
+
+// --------------------------
+// One line per change: milliseconds since the baseline, kind, item, menu and owner.
+
+void APMenuWatch::Write( APReport * inReport ) const
+  {
+    char          theString[ 512 ] ;
+    char          theOwner[ 64 ] ;
+    const char *  theKind ;
+    const char *  theMenuItemName ;
+
+    if ( inReport == NULL )
+      return ;
+
+    snprintf( theString, sizeof( theString ), "Baseline: %d menus, %d menu items\r\n%d changes recorded%s\r\n\r\n",
+              ( int )mBaselineMenus, ( int )mBaselineMenuItems, ( int )mChanges.size(), mWatching ? ", still watching" : "" ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
+
+    for ( size_t index = 0 ; index < mChanges.size() ; index++ )
+      {
+        const Change & theChange = mChanges[ index ] ;
+
+        switch ( theChange.fKind )
+          {
+            case kMenuItemAdded :     theKind = "added" ;       break ;
+            case kMenuItemRemoved :   theKind = "removed" ;     break ;
+            default :                 theKind = "re-added" ;    break ;
+          }
+
+        theMenuItemName = ASAtomGetString( theChange.fMenuItemName ) ;
+        GetOwnerPrefix( theMenuItemName, theOwner, sizeof( theOwner ) ) ;
+
+        snprintf( theString, sizeof( theString ), "%10.3f ms  %-10s  %s%s%s  [%s]\r\n",
+                  APTiming::ToMilliseconds( theChange.fTime - mStartTime ), theKind, theMenuItemName,
+                  ( theChange.fMenuName != ASAtomNull ) ? "  in " : "",
+                  ( theChange.fMenuName != ASAtomNull ) ? ASAtomGetString( theChange.fMenuName ) : "",
+                  theOwner ) ;
+        inReport->Write( theString, strlen( theString ) ) ;
+      }
+
+    if ( mDropped != 0 )
+      {
+        snprintf( theString, sizeof( theString ), "\r\n%d further changes were not recorded\r\n", ( int )mDropped ) ;
+        inReport->Write( theString, strlen( theString ) ) ;
+      }
+
+  } // end Write
+
+// --------------------------
@@ -0,0 +1,82 @@
+/*
+  File:   APMenuWatch.h
+
+  Contains: Records menu changes, as deltas against a single baseline walk,
+            while watching is turned on.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+#include <vector>
+#include <unordered_set>
+
+class APReport ;
+
+// --------------------------
+// Each change is a few words: the kind, the item and menu name atoms and a
+// timestamp.  Nothing is looked up or formatted until the report is written.
+// Acrobat has no notification for an item becoming enabled, so enabling is
+// not watched; an item that is removed and later added again while watching
+// is reported as re-added.
+
+#define kMaxMenuChanges   65536
+
+enum
+  {
+    kMenuItemAdded = 0,
+    kMenuItemRemoved,
+    kMenuItemReAdded
+  } ;
+
+class APMenuWatch
+  {
+    public:
+      APMenuWatch() ;
+
+      void          Start( ASInt32 inBaselineMenus, ASInt32 inBaselineMenuItems ) ;
+      void          Stop( void ) ;
+      ASBool        IsWatching( void ) const { return mWatching ; }
+
+      void          MenuItemAdded( AVMenuItem inAVMenuItem, AVMenu inParentAVMenu ) ;
+      void          MenuItemRemoved( AVMenuItem inAVMenuItem ) ;
+
+      void          Write( APReport * inReport ) const ;
+
+      static void   GetOwnerPrefix( const char * inName, char * outOwner, size_t inOwnerSize ) ;
+
+    private:
+      struct Change
+        {
+          ASUns64       fTime ;
+          ASAtom        fMenuItemName ;
+          ASAtom        fMenuName ;
+          ASInt32       fKind ;
+        } ;
+
+      void          Record( ASInt32 inKind, ASAtom inMenuItemName, ASAtom inMenuName ) ;
+
+      ASBool                        mWatching ;
+      ASUns64                       mStartTime ;
+      ASInt32                       mBaselineMenus ;
+      ASInt32                       mBaselineMenuItems ;
+      ASInt32                       mDropped ;
+      std::vector< Change >         mChanges ;
+      std::unordered_set< ASAtom >  mRemoved ;
+  } ;
+
+// --------------------------
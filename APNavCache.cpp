@@ -0,0 +1,176 @@
+/*
+  File:   APNavCache.cpp
+
+  Contains: What a presenter needs to move through a document, kept per
+            page view: the page count and a ring of the pages visited.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "PDCalls.h"
+
+#include "APNavCache.h"
+
+// --------------------------
+
+APNavHistory::APNavHistory()
+  {
+    Clear() ;
+
+  } // end APNavHistory
+
+// --------------------------
+
+void APNavHistory::Clear( void )
+  {
+    mFirst  = 0 ;
+    mCount  = 0 ;
+    mCursor = -1 ;
+
+  } // end Clear
+
+// --------------------------
+
+ASInt32 APNavHistory::GetCurrent( void ) const
+  {
+    if ( mCount == 0 )
+      return -1 ;
+
+    return mPages[ ( mFirst + mCursor ) % kNavHistorySize ] ;
+
+  } // end GetCurrent
+
+// --------------------------
+
+void APNavHistory::Visit( ASInt32 inPage )
+  {
+    if ( GetCurrent() == inPage )
+      return ;
+
+    mCount = mCursor + 1 ;      // forget the pages forward of the cursor
+
+    if ( mCount == kNavHistorySize )
+      {
+        mFirst  = ( mFirst + 1 ) % kNavHistorySize ;
+        mCount -= 1 ;
+      }
+
+    mPages[ ( mFirst + mCount ) % kNavHistorySize ] = inPage ;
+    mCount += 1 ;
+    mCursor = mCount - 1 ;
+
+  } // end Visit
+
+// --------------------------
+
+ASBool APNavHistory::Back( ASInt32 & outPage )
+  {
+    if ( mCursor <= 0 )
+      return false ;
+
+    mCursor -= 1 ;
+    outPage  = GetCurrent() ;
+
+    return true ;
+
+  } // end Back
+
+// --------------------------
+
+ASBool APNavHistory::Forward( ASInt32 & outPage )
+  {
+    if ( mCursor + 1 >= mCount )
+      return false ;
+
+    mCursor += 1 ;
+    outPage  = GetCurrent() ;
+
+    return true ;
+
+  } // end Forward
+
+// --------------------------
+
+APNavCache::APNavCache()
+  : mLookups( 0 ),
+    mRefreshes( 0 )
+  {
+  } // end APNavCache
+
+// --------------------------
+// The first call for a page view, and the first after its document's pages
+// changed, asks Acrobat for the page count; every other call is a table
+// lookup and one AVPageViewGetAVDoc.  Acrobat can give a new document's
+// page view the address of one that closed without a DocWillClose reaching
+// the cache, so a record whose document is not the page view's own is
+// started again rather than trusted.
+
+APNavRecord & APNavCache::Get( AVPageView inAVPageView )
+  {
+    APNavRecord & theRecord = mRecords[ inAVPageView ] ;
+    AVDoc         theAVDoc  = AVPageViewGetAVDoc( inAVPageView ) ;
+
+    mLookups += 1 ;
+
+    if ( theRecord.fAVDoc != theAVDoc )
+      {
+        theRecord.fAVDoc    = theAVDoc ;
+        theRecord.fPDDoc    = AVDocGetPDDoc( theAVDoc ) ;
+        theRecord.fNumPages = kNavUnknownPages ;
+        theRecord.fHistory.Clear() ;
+      }
+
+    if ( theRecord.fNumPages == kNavUnknownPages )
+      {
+        theRecord.fNumPages = PDDocGetNumPages( theRecord.fPDDoc ) ;
+        mRefreshes += 1 ;
+      }
+
+    return theRecord ;
+
+  } // end Get
+
+// --------------------------
+// Only a handful of documents are ever open, so a walk of the table is as
+// quick as keeping a second one by document.
+
+void APNavCache::PagesChanged( PDDoc inPDDoc )
+  {
+    for ( std::unordered_map< AVPageView, APNavRecord >::iterator theIter = mRecords.begin() ; theIter != mRecords.end() ; ++theIter )
+      {
+        if ( theIter->second.fPDDoc == inPDDoc )
+          theIter->second.fNumPages = kNavUnknownPages ;
+      }
+
+  } // end PagesChanged
+
+// --------------------------
+
+void APNavCache::DocWillClose( AVDoc inAVDoc )
+  {
+    std::unordered_map< AVPageView, APNavRecord >::iterator theIter = mRecords.begin() ;
+
+    while ( theIter != mRecords.end() )
+      {
+        if ( theIter->second.fAVDoc == inAVDoc )
+          theIter = mRecords.erase( theIter ) ;
+        else
+          ++theIter ;
+      }
+
+  } // end DocWillClose
+
+// --------------------------
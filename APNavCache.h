@@ -0,0 +1,98 @@
+/*
+  File:   APNavCache.h
+
+  Contains: What a presenter needs to move through a document, kept per
+            page view: the page count and a ring of the pages visited.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+#include "PDCalls.h"
+
+#include <unordered_map>
+
+// --------------------------
+
+#define kNavHistorySize     64
+#define kNavUnknownPages    -1
+
+// --------------------------
+// The pages a presenter went to, oldest first, with a cursor on the one
+// being shown.  Going to a new page drops anything forward of the cursor,
+// as a browser does; when the ring is full the oldest page is dropped.
+
+class APNavHistory
+  {
+    public:
+      APNavHistory() ;
+
+      void          Clear( void ) ;
+      void          Visit( ASInt32 inPage ) ;
+
+      // false when there is nothing further in that direction
+      ASBool        Back( ASInt32 & outPage ) ;
+      ASBool        Forward( ASInt32 & outPage ) ;
+
+      ASInt32       GetCurrent( void ) const ;
+      ASInt32       GetNumPages( void ) const { return mCount ; }
+
+    private:
+      ASInt32       mPages[ kNavHistorySize ] ;
+      ASInt32       mFirst ;          // slot of the oldest page
+      ASInt32       mCount ;
+      ASInt32       mCursor ;         // 0 is the oldest page, mCount - 1 the newest
+  } ;
+
+// --------------------------
+
+struct APNavRecord
+  {
+    AVDoc           fAVDoc ;
+    PDDoc           fPDDoc ;
+    ASInt32         fNumPages ;       // kNavUnknownPages after pages were inserted or deleted
+    APNavHistory    fHistory ;
+  } ;
+
+// --------------------------
+// A page view's document and page count are looked up the first time it is
+// clicked and again only after pages are inserted or deleted, so a click
+// finds its target without asking Acrobat for them.
+
+class APNavCache
+  {
+    public:
+      APNavCache() ;
+
+      APNavRecord & Get( AVPageView inAVPageView ) ;
+
+      // from the page and document notifications
+      void          PagesChanged( PDDoc inPDDoc ) ;
+      void          DocWillClose( AVDoc inAVDoc ) ;
+
+      ASInt32       GetNumLookups( void ) const { return mLookups ; }
+      ASInt32       GetNumRefreshes( void ) const { return mRefreshes ; }
+
+    private:
+      std::unordered_map< AVPageView, APNavRecord >   mRecords ;
+      ASInt32                                         mLookups ;
+      ASInt32                                         mRefreshes ;
+
+      APNavCache( const APNavCache & ) ;
+      APNavCache & operator=( const APNavCache & ) ;
+  } ;
+
+// --------------------------
@@ -0,0 +1,419 @@
+/*
+  File:   APNotifier.cpp
+
+  Contains: Registers for each Acrobat notification once and passes it on
+            to the subscribers whose change mask it matches, timing each.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "PDCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "APReport.h"
+#include "APTiming.h"
+#include "APDiagnostics.h"
+#include "APNotifier.h"
+
+// --------------------------
+
+static const char * const   sNotifyTypeNames[ kNumNotifyTypes ] =
+  {
+    "AVDocDidOpen",
+    "AVDocWillClose",
+    "AVAppFrontDocDidChange",
+    "AVPageViewDidChange",
+    "AVMenuItemWasAddedToMenu",
+    "AVMenuItemWasRemoved",
+    "AVMenuWasAddedToMenubar",
+    "AVMenuWasRemoved",
+    "PDDocDidInsertPages",
+    "PDDocDidDeletePages"
+  } ;
+
+// --------------------------
+
+static void NewNotification( APNotification & outNotification, ASInt32 inType, ASUns32 inChanges )
+  {
+    memset( &outNotification, 0, sizeof( outNotification ) ) ;
+
+    outNotification.fType     = inType ;
+    outNotification.fChanges  = inChanges ;
+
+  } // end NewNotification
+
+// --------------------------
+
+APNotifier::APNotifier()
+  {
+    memset( mCallbacks, 0, sizeof( mCallbacks ) ) ;
+    memset( mReceived, 0, sizeof( mReceived ) ) ;
+
+  } // end APNotifier
+
+// --------------------------
+
+APNotifier & APNotifier::Shared( void )
+  {
+    static APNotifier   sNotifier ;
+
+    return sNotifier ;
+
+  } // end Shared
+
+// --------------------------
+// The first subscriber to a notification registers the notifier for it;
+// later ones only join the table.  Returns the subscriber's index.
+
+ASInt32 APNotifier::Subscribe( ASInt32 inType, ASUns32 inMask, const char * inName, APNotifyProc inProc, void * inData )
+  {
+    APSubscriber  theSubscriber ;
+
+    if ( ( inType < 0 ) || ( inType >= kNumNotifyTypes ) || ( inProc == NULL ) )
+      return -1 ;
+
+    theSubscriber.fName     = ( inName != NULL ) ? inName : sNotifyTypeNames[ inType ] ;
+    theSubscriber.fType     = inType ;
+    theSubscriber.fMask     = inMask ;
+    theSubscriber.fProc     = inProc ;
+    theSubscriber.fData     = inData ;
+    theSubscriber.fCalls    = 0 ;
+    theSubscriber.fSkipped  = 0 ;
+    theSubscriber.fTime     = 0 ;
+
+    mSubscribers.push_back( theSubscriber ) ;
+    mByType[ inType ].push_back( ( ASInt32 )mSubscribers.size() - 1 ) ;
+
+    if ( mCallbacks[ inType ] == NULL )
+      Register( inType ) ;
+
+    return ( ASInt32 )mSubscribers.size() - 1 ;
+
+  } // end Subscribe
+
+// --------------------------
+
+void APNotifier::Register( ASInt32 inType )
+  {
+    switch ( inType )
+      {
+        case kNotifyDocDidOpen :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( AVDocDidOpen, ( void * )DocDidOpen ) ;
+          AVAppRegisterNotification( AVDocDidOpenNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyDocWillClose :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( AVDocWillClose, ( void * )DocWillClose ) ;
+          AVAppRegisterNotification( AVDocWillCloseNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyFrontDocDidChange :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( AVAppFrontDocDidChange, ( void * )FrontDocDidChange ) ;
+          AVAppRegisterNotification( AVAppFrontDocDidChangeNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyPageViewDidChange :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( AVPageViewDidChange, ( void * )PageViewDidChange ) ;
+          AVAppRegisterNotification( AVPageViewDidChangeNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyMenuItemWasAddedToMenu :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( AVMenuItemWasAddedToMenu, ( void * )MenuItemWasAddedToMenu ) ;
+          AVAppRegisterNotification( AVMenuItemWasAddedToMenuNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyMenuItemWasRemoved :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( AVMenuItemWasRemoved, ( void * )MenuItemWasRemoved ) ;
+          AVAppRegisterNotification( AVMenuItemWasRemovedNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyMenuWasAddedToMenubar :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( AVMenuWasAddedToMenubar, ( void * )MenuWasAddedToMenubar ) ;
+          AVAppRegisterNotification( AVMenuWasAddedToMenubarNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyMenuWasRemoved :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( AVMenuWasRemoved, ( void * )MenuWasRemoved ) ;
+          AVAppRegisterNotification( AVMenuWasRemovedNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyPDDocDidInsertPages :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( PDDocDidInsertPages, ( void * )PDDocDidInsertPages ) ;
+          AVAppRegisterNotification( PDDocDidInsertPagesNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+
+        case kNotifyPDDocDidDeletePages :
+          mCallbacks[ inType ] = ASCallbackCreateNotification( PDDocDidDeletePages, ( void * )PDDocDidDeletePages ) ;
+          AVAppRegisterNotification( PDDocDidDeletePagesNSEL, gExtensionID, mCallbacks[ inType ], NULL ) ;
+          break ;
+      }
+
+  } // end Register
+
+// --------------------------
+// Called from UnloadPlugIn.  The subscribers and their counts are kept.
+
+void APNotifier::UnregisterAll( void )
+  {
+    static const NSelector  sSelectors[ kNumNotifyTypes ] =
+      {
+        AVDocDidOpenNSEL,
+        AVDocWillCloseNSEL,
+        AVAppFrontDocDidChangeNSEL,
+        AVPageViewDidChangeNSEL,
+        AVMenuItemWasAddedToMenuNSEL,
+        AVMenuItemWasRemovedNSEL,
+        AVMenuWasAddedToMenubarNSEL,
+        AVMenuWasRemovedNSEL,
+        PDDocDidInsertPagesNSEL,
+        PDDocDidDeletePagesNSEL
+      } ;
+
+    for ( ASInt32 index = 0 ; index < kNumNotifyTypes ; index++ )
+      {
+        if ( mCallbacks[ index ] == NULL )
+          continue ;
+
+        AVAppUnregisterNotification( sSelectors[ index ], gExtensionID, mCallbacks[ index ], NULL ) ;
+        ASCallbackDestroy( mCallbacks[ index ] ) ;
+        mCallbacks[ index ] = NULL ;
+      }
+
+  } // end UnregisterAll
+
+// --------------------------
+// Each subscriber runs in its own DURING so one that raises is reported and
+// the rest are still called.
+
+void APNotifier::Dispatch( const APNotification & inNotification )
+  {
+    ASUns64   theStart ;
+
+    if ( ( inNotification.fType < 0 ) || ( inNotification.fType >= kNumNotifyTypes ) )
+      return ;
+
+    mReceived[ inNotification.fType ] += 1 ;
+
+    const std::vector< ASInt32 > &  theIndexes = mByType[ inNotification.fType ] ;
+
+    for ( size_t index = 0 ; index < theIndexes.size() ; index++ )
+      {
+        APSubscriber &  theSubscriber = mSubscribers[ theIndexes[ index ] ] ;
+
+        // a change of no kind at all, inHowChanged == 0, still goes to kNotifyAllChanges subscribers
+        if ( ( theSubscriber.fMask != kNotifyAllChanges ) && ( ( theSubscriber.fMask & inNotification.fChanges ) == 0 ) )
+          {
+            theSubscriber.fSkipped += 1 ;
+            continue ;
+          }
+
+        theStart = APTiming::GetNanoseconds() ;
+
+        DURING
+          theSubscriber.fProc( inNotification, theSubscriber.fData ) ;
+        HANDLER
+          APDiagnostics::Shared().Report( ERRORCODE, theSubscriber.fName ) ;
+        END_HANDLER
+
+        theSubscriber.fTime  += APTiming::GetNanoseconds() - theStart ;
+        theSubscriber.fCalls += 1 ;
+      }
+
+  } // end Dispatch
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::DocDidOpen( AVDoc inAVDoc, ASInt32 inError, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyDocDidOpen, kNotifyAllChanges ) ;
+    theNotification.fAVDoc  = inAVDoc ;
+    theNotification.fError  = inError ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end DocDidOpen
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::DocWillClose( AVDoc inAVDoc, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyDocWillClose, kNotifyAllChanges ) ;
+    theNotification.fAVDoc = inAVDoc ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end DocWillClose
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::FrontDocDidChange( AVDoc inAVDoc, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyFrontDocDidChange, kNotifyAllChanges ) ;
+    theNotification.fAVDoc = inAVDoc ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end FrontDocDidChange
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::PageViewDidChange( AVPageView inAVPageView, ASInt16 inHowChanged, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyPageViewDidChange, ( ASUns16 )inHowChanged ) ;
+    theNotification.fAVPageView = inAVPageView ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end PageViewDidChange
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::MenuItemWasAddedToMenu( AVMenuItem inAVMenuItem, AVMenu inAVMenu, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyMenuItemWasAddedToMenu, kNotifyAllChanges ) ;
+    theNotification.fAVMenuItem = inAVMenuItem ;
+    theNotification.fAVMenu     = inAVMenu ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end MenuItemWasAddedToMenu
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::MenuItemWasRemoved( AVMenuItem inAVMenuItem, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyMenuItemWasRemoved, kNotifyAllChanges ) ;
+    theNotification.fAVMenuItem = inAVMenuItem ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end MenuItemWasRemoved
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::MenuWasAddedToMenubar( AVMenu inAVMenu, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyMenuWasAddedToMenubar, kNotifyAllChanges ) ;
+    theNotification.fAVMenu = inAVMenu ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end MenuWasAddedToMenubar
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::MenuWasRemoved( AVMenu inAVMenu, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyMenuWasRemoved, kNotifyAllChanges ) ;
+    theNotification.fAVMenu = inAVMenu ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end MenuWasRemoved
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::PDDocDidInsertPages( PDDoc inPDDoc, ASInt32 inInsertAfterThisPage, ASInt32 inNumPagesInserted,
+                                                  PDDoc inSourcePDDoc, ASInt32 inSourceFromPage, ASInt32 inSourceToPage,
+                                                  ASInt32 inError, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyPDDocDidInsertPages, kNotifyAllChanges ) ;
+    theNotification.fPDDoc    = inPDDoc ;
+    theNotification.fFromPage = inInsertAfterThisPage + 1 ;
+    theNotification.fToPage   = inInsertAfterThisPage + inNumPagesInserted ;
+    theNotification.fError    = inError ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end PDDocDidInsertPages
+
+// --------------------------
+
+ACCB1 void ACCB2 APNotifier::PDDocDidDeletePages( PDDoc inPDDoc, ASInt32 inFromPage, ASInt32 inToPage, ASInt32 inError, void * inClientData )
+  {
+    APNotification  theNotification ;
+
+    NewNotification( theNotification, kNotifyPDDocDidDeletePages, kNotifyAllChanges ) ;
+    theNotification.fPDDoc    = inPDDoc ;
+    theNotification.fFromPage = inFromPage ;
+    theNotification.fToPage   = inToPage ;
+    theNotification.fError    = inError ;
+
+    Shared().Dispatch( theNotification ) ;
+
+  } // end PDDocDidDeletePages
+
+// --------------------------
+// How many of each notification arrived, then one line per subscriber.
+
+void APNotifier::Write( APReport * inReport ) const
+  {
+    char    theString[ 512 ] ;
+
+    if ( inReport == NULL )
+      return ;
+
+    strcpy( theString, "Notifications\r\n\r\n  received  notification\r\n" ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
+
+    for ( ASInt32 index = 0 ; index < kNumNotifyTypes ; index++ )
+      {
+        if ( mByType[ index ].empty() )
+          continue ;
+
+        snprintf( theString, sizeof( theString ), "  %8d  %s\r\n", ( int )mReceived[ index ], sNotifyTypeNames[ index ] ) ;
+        inReport->Write( theString, strlen( theString ) ) ;
+      }
+
+    strcpy( theString, "\r\n     calls   skipped  total (ms)  per call (us)  mask      subscriber\r\n" ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
+
+    for ( size_t index = 0 ; index < mSubscribers.size() ; index++ )
+      {
+        const APSubscriber &  theSubscriber = mSubscribers[ index ] ;
+
+        snprintf( theString, sizeof( theString ), "  %8d  %8d  %10.3f  %13.2f  %08X  %s, %s\r\n",
+                  ( int )theSubscriber.fCalls, ( int )theSubscriber.fSkipped,
+                  APTiming::ToMilliseconds( theSubscriber.fTime ),
+                  ( theSubscriber.fCalls != 0 ) ? APTiming::ToMicroseconds( theSubscriber.fTime ) / theSubscriber.fCalls : 0.0,
+                  ( unsigned int )theSubscriber.fMask, sNotifyTypeNames[ theSubscriber.fType ], theSubscriber.fName ) ;
+        inReport->Write( theString, strlen( theString ) ) ;
+      }
+
+  } // end Write
+
+// --------------------------
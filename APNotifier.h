@@ -0,0 +1,144 @@
+/*
+  File:   APNotifier.h
+
+  Contains: Registers for each Acrobat notification once and passes it on
+            to the subscribers whose change mask it matches, timing each.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    In PreInitPlugIn:
+
+      APNotifier::Shared().Subscribe( kNotifyPageViewDidChange, PAGEVIEW_UPDATE_PAGESIZE | PAGEVIEW_UPDATE_ZOOM,
+                                      "DoAVPageViewDidChange", &DoAVPageViewDidChange, NULL ) ;
+
+    and in UnloadPlugIn:
+
+      APNotifier::Shared().UnregisterAll() ;
+
+    A subscriber is only called when the notification's changes and its mask
+    have a bit in common.  Notifications that carry no change flags match
+    any mask other than 0.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+#include "PDCalls.h"
+
+#include <vector>
+
+class APReport ;
+
+// --------------------------
+
+enum
+  {
+    kNotifyDocDidOpen = 0,
+    kNotifyDocWillClose,
+    kNotifyFrontDocDidChange,
+    kNotifyPageViewDidChange,
+    kNotifyMenuItemWasAddedToMenu,
+    kNotifyMenuItemWasRemoved,
+    kNotifyMenuWasAddedToMenubar,
+    kNotifyMenuWasRemoved,
+    kNotifyPDDocDidInsertPages,
+    kNotifyPDDocDidDeletePages,
+    kNumNotifyTypes
+  } ;
+
+#define kNotifyAllChanges   0xFFFFFFFF
+
+// The arguments of every supported notification; only those of fType are set.
+struct APNotification
+  {
+    ASInt32       fType ;
+    ASUns32       fChanges ;        // inHowChanged for kNotifyPageViewDidChange, otherwise kNotifyAllChanges
+    AVDoc         fAVDoc ;
+    AVPageView    fAVPageView ;
+    AVMenuItem    fAVMenuItem ;
+    AVMenu        fAVMenu ;
+    PDDoc         fPDDoc ;
+    ASInt32       fFromPage ;       // the pages inserted or deleted, inclusive
+    ASInt32       fToPage ;
+    ASInt32       fError ;          // kNotifyDocDidOpen and the page notifications
+  } ;
+
+typedef void ( * APNotifyProc )( const APNotification & inNotification, void * inData ) ;
+
+struct APSubscriber
+  {
+    const char *    fName ;
+    ASInt32         fType ;
+    ASUns32         fMask ;
+    APNotifyProc    fProc ;
+    void *          fData ;
+    ASInt32         fCalls ;
+    ASInt32         fSkipped ;      // notifications the mask filtered out
+    ASUns64         fTime ;         // nanoseconds, over fCalls
+  } ;
+
+// --------------------------
+// One per plug-in, through APNotifier::Shared().  Acrobat calls the notifier
+// once per notification however many subscribers there are, and a subscriber
+// that raises is reported to APDiagnostics without keeping the ones after it
+// from being called.  Subscribe before any notification arrives, normally
+// from PreInitPlugIn; the subscriber table is not meant to change while a
+// notification is being passed on.
+
+class APNotifier
+  {
+    public:
+      APNotifier() ;
+
+      static APNotifier &   Shared( void ) ;
+
+      ASInt32       Subscribe( ASInt32 inType, ASUns32 inMask, const char * inName, APNotifyProc inProc, void * inData ) ;
+      void          UnregisterAll( void ) ;
+
+      void          Dispatch( const APNotification & inNotification ) ;
+
+      ASInt32       GetNumReceived( ASInt32 inType ) const { return mReceived[ inType ] ; }
+      ASInt32       GetNumSubscribers( void ) const { return ( ASInt32 )mSubscribers.size() ; }
+      const APSubscriber &  GetSubscriber( ASInt32 inIndex ) const { return mSubscribers[ inIndex ] ; }
+
+      void          Write( APReport * inReport ) const ;
+
+      // what Acrobat calls; public so a replay or benchmark takes the same path
+      static ACCB1 void ACCB2 DocDidOpen( AVDoc inAVDoc, ASInt32 inError, void * inClientData ) ;
+      static ACCB1 void ACCB2 DocWillClose( AVDoc inAVDoc, void * inClientData ) ;
+      static ACCB1 void ACCB2 FrontDocDidChange( AVDoc inAVDoc, void * inClientData ) ;
+      static ACCB1 void ACCB2 PageViewDidChange( AVPageView inAVPageView, ASInt16 inHowChanged, void * inClientData ) ;
+      static ACCB1 void ACCB2 MenuItemWasAddedToMenu( AVMenuItem inAVMenuItem, AVMenu inAVMenu, void * inClientData ) ;
+      static ACCB1 void ACCB2 MenuItemWasRemoved( AVMenuItem inAVMenuItem, void * inClientData ) ;
+      static ACCB1 void ACCB2 MenuWasAddedToMenubar( AVMenu inAVMenu, void * inClientData ) ;
+      static ACCB1 void ACCB2 MenuWasRemoved( AVMenu inAVMenu, void * inClientData ) ;
+      static ACCB1 void ACCB2 PDDocDidInsertPages( PDDoc inPDDoc, ASInt32 inInsertAfterThisPage, ASInt32 inNumPagesInserted,
+                                                   PDDoc inSourcePDDoc, ASInt32 inSourceFromPage, ASInt32 inSourceToPage,
+                                                   ASInt32 inError, void * inClientData ) ;
+      static ACCB1 void ACCB2 PDDocDidDeletePages( PDDoc inPDDoc, ASInt32 inFromPage, ASInt32 inToPage, ASInt32 inError, void * inClientData ) ;
+
+    private:
+      void          Register( ASInt32 inType ) ;
+
+      std::vector< APSubscriber >   mSubscribers ;
+      std::vector< ASInt32 >        mByType[ kNumNotifyTypes ] ;   // indexes into mSubscribers
+      ASCallback                    mCallbacks[ kNumNotifyTypes ] ;
+      ASInt32                       mReceived[ kNumNotifyTypes ] ;
+
+      APNotifier( const APNotifier & ) ;
+      APNotifier & operator=( const APNotifier & ) ;
+  } ;
+
+// --------------------------
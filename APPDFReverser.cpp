@@ -0,0 +1,1076 @@
+/*
+  File:   APPDFReverser.cpp
+
+  Contains: Reverses the page order of a PDF file without Acrobat, reading
+            it through a memory map and writing the change as an
+            incremental update, so files larger than memory can be handled.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "APPDFReverser.h"
+
+// --------------------------
+
+#define kBadPos             ( ( size_t )-1 )
+#define kStartXrefWindow    1024                    // startxref must be this close to the end
+#define kMaxXrefSections    4096                    // guards against a Prev chain that loops
+#define kCopyChunk          ( 8 * 1024 * 1024 )     // mapped input released after each chunk is copied
+#define kMaxTempNames       100                     // "<output>.<n>.part" tried before giving up
+
+// --------------------------
+
+static bool IsWhite( char inChar )
+  {
+    return ( inChar == ' ' ) || ( inChar == '\n' ) || ( inChar == '\r' ) || ( inChar == '\t' ) || ( inChar == '\f' ) || ( inChar == 0 ) ;
+
+  } // end IsWhite
+
+// --------------------------
+
+static bool IsDelimiter( char inChar )
+  {
+    return ( strchr( "()<>[]{}/%", inChar ) != NULL ) && ( inChar != 0 ) ;
+
+  } // end IsDelimiter
+
+// --------------------------
+
+static bool IsDigit( char inChar )
+  {
+    return ( inChar >= '0' ) && ( inChar <= '9' ) ;
+
+  } // end IsDigit
+
+// --------------------------
+
+#if defined( _WIN32 )
+
+// inPath, which is UTF-8, for the wide file calls
+static std::wstring ToWidePath( const char * inPath )
+  {
+    std::wstring  theWidePath ;
+    int           theLength = MultiByteToWideChar( CP_UTF8, 0, inPath, -1, NULL, 0 ) ;
+
+    if ( theLength > 1 )
+      {
+        theWidePath.resize( ( size_t )theLength ) ;
+        MultiByteToWideChar( CP_UTF8, 0, inPath, -1, &theWidePath[ 0 ], theLength ) ;
+        theWidePath.resize( ( size_t )theLength - 1 ) ;
+      }
+
+    return theWidePath ;
+
+  } // end ToWidePath
+
+#endif
+
+// --------------------------
+// Whether anything, even a dangling symbolic link, is at inPath.
+
+static bool FileExists( const char * inPath )
+  {
+#if defined( _WIN32 )
+    return GetFileAttributesW( ToWidePath( inPath ).c_str() ) != INVALID_FILE_ATTRIBUTES ;
+#else
+    struct stat   theStat ;
+
+    return lstat( inPath, &theStat ) == 0 ;
+#endif
+
+  } // end FileExists
+
+// --------------------------
+
+static void RemoveFile( const char * inPath )
+  {
+#if defined( _WIN32 )
+    _wremove( ToWidePath( inPath ).c_str() ) ;
+#else
+    remove( inPath ) ;
+#endif
+
+  } // end RemoveFile
+
+// --------------------------
+
+APPDFReverser::APPDFReverser()
+  : mData( NULL ),
+    mSize( 0 ),
+#if defined( _WIN32 )
+    mFile( INVALID_HANDLE_VALUE ),
+    mMapping( NULL ),
+#else
+    mFile( -1 ),
+#endif
+    mStartXref( 0 ),
+    mOutputPos( 0 ),
+    mUpdateSize( 0 ),
+    mNumPages( 0 ),
+    mCancelProc( NULL ),
+    mCancelData( NULL ),
+    mReplaceExisting( true )
+  {
+    mMessage[ 0 ] = 0 ;
+
+  } // end APPDFReverser
+
+// --------------------------
+
+APPDFReverser::~APPDFReverser()
+  {
+    Unmap() ;
+
+  } // end ~APPDFReverser
+
+// --------------------------
+
+int APPDFReverser::Fail( int inResult, const char * inFormat, ... )
+  {
+    va_list   theArgs ;
+
+    va_start( theArgs, inFormat ) ;
+    vsnprintf( mMessage, sizeof( mMessage ), inFormat, theArgs ) ;
+    va_end( theArgs ) ;
+
+    return inResult ;
+
+  } // end Fail
+
+// --------------------------
+
+bool APPDFReverser::Map( const char * inPath )
+  {
+#if defined( _WIN32 )
+    LARGE_INTEGER   theSize ;
+
+    mFile = CreateFileW( ToWidePath( inPath ).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL ) ;
+    if ( mFile == INVALID_HANDLE_VALUE )
+      return false ;
+
+    if ( ( GetFileSizeEx( mFile, &theSize ) == 0 ) || ( theSize.QuadPart == 0 ) )
+      return false ;
+
+    mMapping = CreateFileMappingA( mFile, NULL, PAGE_READONLY, 0, 0, NULL ) ;
+    if ( mMapping == NULL )
+      return false ;
+
+    mData = ( const char * )MapViewOfFile( mMapping, FILE_MAP_READ, 0, 0, 0 ) ;
+    mSize = ( size_t )theSize.QuadPart ;
+#else
+    struct stat   theStat ;
+    void *        theData ;
+
+    mFile = open( inPath, O_RDONLY ) ;
+    if ( mFile < 0 )
+      return false ;
+
+    if ( ( fstat( mFile, &theStat ) != 0 ) || ( theStat.st_size == 0 ) )
+      return false ;
+
+    theData = mmap( NULL, ( size_t )theStat.st_size, PROT_READ, MAP_PRIVATE, mFile, 0 ) ;
+    if ( theData == MAP_FAILED )
+      return false ;
+
+    mData = ( const char * )theData ;
+    mSize = ( size_t )theStat.st_size ;
+#endif
+
+    return ( mData != NULL ) ;
+
+  } // end Map
+
+// --------------------------
+
+void APPDFReverser::Unmap( void )
+  {
+#if defined( _WIN32 )
+    if ( mData != NULL )
+      UnmapViewOfFile( mData ) ;
+    if ( mMapping != NULL )
+      CloseHandle( mMapping ) ;
+    if ( mFile != INVALID_HANDLE_VALUE )
+      CloseHandle( mFile ) ;
+
+    mMapping  = NULL ;
+    mFile     = INVALID_HANDLE_VALUE ;
+#else
+    if ( mData != NULL )
+      munmap( ( void * )mData, mSize ) ;
+    if ( mFile >= 0 )
+      close( mFile ) ;
+
+    mFile = -1 ;
+#endif
+
+    mData = NULL ;
+    mSize = 0 ;
+
+  } // end Unmap
+
+// --------------------------
+// Whether inPath names the mapped file, through whatever path, symbolic link
+// or hard link; comparing the path strings cannot tell.  A path that cannot
+// be opened is not the mapped file.
+
+bool APPDFReverser::IsMappedFile( const char * inPath ) const
+  {
+#if defined( _WIN32 )
+    BY_HANDLE_FILE_INFORMATION  theMapped ;
+    BY_HANDLE_FILE_INFORMATION  theOther ;
+    HANDLE                      theFile ;
+    bool                        theSame = false ;
+
+    // no access asked for, only the file's identity, so the input's sharing mode does not matter
+    theFile = CreateFileW( ToWidePath( inPath ).c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, 0, NULL ) ;
+    if ( theFile == INVALID_HANDLE_VALUE )
+      return false ;
+
+    if ( GetFileInformationByHandle( mFile, &theMapped ) && GetFileInformationByHandle( theFile, &theOther ) )
+      theSame = ( theMapped.dwVolumeSerialNumber == theOther.dwVolumeSerialNumber ) &&
+                ( theMapped.nFileIndexHigh == theOther.nFileIndexHigh ) &&
+                ( theMapped.nFileIndexLow == theOther.nFileIndexLow ) ;
+
+    CloseHandle( theFile ) ;
+
+    return theSame ;
+#else
+    struct stat   theMapped ;
+    struct stat   theOther ;
+
+    if ( ( fstat( mFile, &theMapped ) != 0 ) || ( stat( inPath, &theOther ) != 0 ) )
+      return false ;
+
+    return ( theMapped.st_dev == theOther.st_dev ) && ( theMapped.st_ino == theOther.st_ino ) ;
+#endif
+
+  } // end IsMappedFile
+
+// --------------------------
+// A new file next to inOutputPath, so the finished output can be renamed
+// over it without crossing volumes.  An existing file is never opened.
+
+static FILE * CreateTempFile( const char * inOutputPath, std::string & outTempPath )
+  {
+    char      theSuffix[ 32 ] ;
+    FILE *    theFile ;
+
+    for ( int index = 0 ; index < kMaxTempNames ; index++ )
+      {
+        snprintf( theSuffix, sizeof( theSuffix ), ".%d.part", index ) ;
+        outTempPath = std::string( inOutputPath ) + theSuffix ;
+
+#if defined( _WIN32 )
+        theFile = _wfopen( ToWidePath( outTempPath.c_str() ).c_str(), L"wbx" ) ;
+#else
+        theFile = fopen( outTempPath.c_str(), "wbx" ) ;
+#endif
+        if ( theFile != NULL )
+          return theFile ;
+
+        if ( errno != EEXIST )
+          break ;
+      }
+
+    outTempPath.clear() ;
+
+    return NULL ;
+
+  } // end CreateTempFile
+
+// --------------------------
+// Put the finished temporary file in place of inOutputPath in one step, so
+// inOutputPath is only ever the old file or the complete new one.  Unless
+// inReplace, a file that appeared at inOutputPath meanwhile is left alone.
+
+static bool MoveIntoPlace( const char * inTempPath, const char * inOutputPath, bool inReplace )
+  {
+#if defined( _WIN32 )
+    return MoveFileExW( ToWidePath( inTempPath ).c_str(), ToWidePath( inOutputPath ).c_str(),
+                        MOVEFILE_WRITE_THROUGH | ( inReplace ? MOVEFILE_REPLACE_EXISTING : 0 ) ) != 0 ;
+#else
+    if ( inReplace )
+      return rename( inTempPath, inOutputPath ) == 0 ;
+
+    // a hard link fails rather than replace; volumes without them fall back to checking first
+    if ( link( inTempPath, inOutputPath ) == 0 )
+      {
+        unlink( inTempPath ) ;
+        return true ;
+      }
+
+    if ( ( errno == EEXIST ) || FileExists( inOutputPath ) )
+      return false ;
+
+    return rename( inTempPath, inOutputPath ) == 0 ;
+#endif
+
+  } // end MoveIntoPlace
+
+// --------------------------
+//
+// Lexing
+//
+// --------------------------
+// Whitespace and comments.
+
+size_t APPDFReverser::SkipWhite( size_t inPos ) const
+  {
+    while ( inPos < mSize )
+      {
+        if ( mData[ inPos ] == '%' )
+          {
+            while ( ( inPos < mSize ) && ( mData[ inPos ] != '\n' ) && ( mData[ inPos ] != '\r' ) )
+              inPos++ ;
+          }
+        else if ( IsWhite( mData[ inPos ] ) )
+          inPos++ ;
+        else
+          break ;
+      }
+
+    return inPos ;
+
+  } // end SkipWhite
+
+// --------------------------
+// The end of the single token at inPos: a name, number, keyword, string,
+// or one of the brackets.
+
+size_t APPDFReverser::SkipToken( size_t inPos ) const
+  {
+    if ( inPos >= mSize )
+      return kBadPos ;
+
+    switch ( mData[ inPos ] )
+      {
+        case '[' :
+        case ']' :
+        case '{' :
+        case '}' :
+          return inPos + 1 ;
+
+        case '>' :
+          return ( ( inPos + 1 < mSize ) && ( mData[ inPos + 1 ] == '>' ) ) ? inPos + 2 : kBadPos ;
+
+        case '<' :
+          if ( ( inPos + 1 < mSize ) && ( mData[ inPos + 1 ] == '<' ) )
+            return inPos + 2 ;
+          while ( ( inPos < mSize ) && ( mData[ inPos ] != '>' ) )
+            inPos++ ;
+          return ( inPos < mSize ) ? inPos + 1 : kBadPos ;
+
+        case '(' :
+          {
+            int   theDepth = 0 ;
+
+            for ( ; inPos < mSize ; inPos++ )
+              {
+                if ( mData[ inPos ] == '\\' )
+                  inPos++ ;
+                else if ( mData[ inPos ] == '(' )
+                  theDepth++ ;
+                else if ( ( mData[ inPos ] == ')' ) && ( --theDepth == 0 ) )
+                  return inPos + 1 ;
+              }
+            return kBadPos ;
+          }
+
+        case '/' :
+          inPos++ ;
+          break ;
+      }
+
+    while ( ( inPos < mSize ) && ( IsWhite( mData[ inPos ] ) == false ) && ( IsDelimiter( mData[ inPos ] ) == false ) )
+      inPos++ ;
+
+    return inPos ;
+
+  } // end SkipToken
+
+// --------------------------
+// The end of the whole value at inPos; an indirect reference "12 0 R" is one
+// value, as are a dictionary and an array with everything in them.
+
+size_t APPDFReverser::SkipValue( size_t inPos ) const
+  {
+    size_t    thePos ;
+
+    if ( inPos >= mSize )
+      return kBadPos ;
+
+    if ( ( mData[ inPos ] == '[' ) || ( ( mData[ inPos ] == '<' ) && ( inPos + 1 < mSize ) && ( mData[ inPos + 1 ] == '<' ) ) )
+      {
+        char  theClose = ( mData[ inPos ] == '[' ) ? ']' : '>' ;
+
+        thePos = SkipToken( inPos ) ;
+        while ( thePos != kBadPos )
+          {
+            thePos = SkipWhite( thePos ) ;
+            if ( thePos >= mSize )
+              return kBadPos ;
+            if ( mData[ thePos ] == theClose )
+              return SkipToken( thePos ) ;
+            thePos = SkipValue( thePos ) ;
+          }
+        return kBadPos ;
+      }
+
+    thePos = SkipToken( inPos ) ;
+
+    if ( ( thePos != kBadPos ) && IsDigit( mData[ inPos ] ) )
+      {
+        size_t  theGeneration = SkipWhite( thePos ) ;
+
+        if ( ( theGeneration < mSize ) && IsDigit( mData[ theGeneration ] ) )
+          {
+            size_t  theR = SkipWhite( SkipToken( theGeneration ) ) ;
+
+            if ( IsKeyword( theR, "R" ) )
+              return theR + 1 ;
+          }
+      }
+
+    return thePos ;
+
+  } // end SkipValue
+
+// --------------------------
+
+bool APPDFReverser::IsKeyword( size_t inPos, const char * inKeyword ) const
+  {
+    size_t  theLength = strlen( inKeyword ) ;
+
+    if ( ( inPos == kBadPos ) || ( inPos + theLength > mSize ) || ( memcmp( mData + inPos, inKeyword, theLength ) != 0 ) )
+      return false ;
+
+    return ( inPos + theLength == mSize ) || IsWhite( mData[ inPos + theLength ] ) || IsDelimiter( mData[ inPos + theLength ] ) ;
+
+  } // end IsKeyword
+
+// --------------------------
+
+bool APPDFReverser::ReadNumber( size_t & ioPos, long long & outNumber ) const
+  {
+    size_t  thePos = SkipWhite( ioPos ) ;
+
+    if ( ( thePos >= mSize ) || ( IsDigit( mData[ thePos ] ) == false ) )
+      return false ;
+
+    outNumber = 0 ;
+    while ( ( thePos < mSize ) && IsDigit( mData[ thePos ] ) )
+      outNumber = outNumber * 10 + ( mData[ thePos++ ] - '0' ) ;
+
+    ioPos = thePos ;
+
+    return true ;
+
+  } // end ReadNumber
+
+// --------------------------
+
+bool APPDFReverser::ReadReference( size_t & ioPos, long long & outNumber, int & outGeneration ) const
+  {
+    size_t      thePos = ioPos ;
+    long long   theGeneration ;
+
+    if ( ( ReadNumber( thePos, outNumber ) == false ) || ( ReadNumber( thePos, theGeneration ) == false ) )
+      return false ;
+
+    thePos = SkipWhite( thePos ) ;
+    if ( IsKeyword( thePos, "R" ) == false )
+      return false ;
+
+    outGeneration = ( int )theGeneration ;
+    ioPos         = thePos + 1 ;
+
+    return true ;
+
+  } // end ReadReference
+
+// --------------------------
+// The keys and value spans of the dictionary whose "<<" is at inPos; nothing
+// in it is decoded or copied.
+
+bool APPDFReverser::ScanDict( size_t inPos, std::vector< DictEntry > & outEntries, size_t & outEnd ) const
+  {
+    DictEntry   theEntry ;
+    size_t      thePos ;
+
+    outEntries.clear() ;
+
+    if ( ( inPos + 1 >= mSize ) || ( mData[ inPos ] != '<' ) || ( mData[ inPos + 1 ] != '<' ) )
+      return false ;
+
+    thePos = inPos + 2 ;
+
+    for ( ;; )
+      {
+        thePos = SkipWhite( thePos ) ;
+        if ( thePos + 1 >= mSize )
+          return false ;
+
+        if ( ( mData[ thePos ] == '>' ) && ( mData[ thePos + 1 ] == '>' ) )
+          break ;
+
+        if ( mData[ thePos ] != '/' )
+          return false ;
+
+        theEntry.fKey.fStart    = thePos + 1 ;
+        theEntry.fKey.fEnd      = SkipToken( thePos ) ;
+        theEntry.fValue.fStart  = SkipWhite( theEntry.fKey.fEnd ) ;
+        theEntry.fValue.fEnd    = SkipValue( theEntry.fValue.fStart ) ;
+
+        if ( theEntry.fValue.fEnd == kBadPos )
+          return false ;
+
+        outEntries.push_back( theEntry ) ;
+        thePos = theEntry.fValue.fEnd ;
+      }
+
+    outEnd = thePos + 2 ;
+
+    return true ;
+
+  } // end ScanDict
+
+// --------------------------
+
+const APPDFReverser::DictEntry * APPDFReverser::FindKey( const std::vector< DictEntry > & inEntries, const char * inKey ) const
+  {
+    size_t  theLength = strlen( inKey ) ;
+
+    for ( size_t index = 0 ; index < inEntries.size() ; index++ )
+      {
+        const Span &  theKey = inEntries[ index ].fKey ;
+
+        if ( ( theKey.fEnd - theKey.fStart == theLength ) && ( memcmp( mData + theKey.fStart, inKey, theLength ) == 0 ) )
+          return &inEntries[ index ] ;
+      }
+
+    return NULL ;
+
+  } // end FindKey
+
+// --------------------------
+//
+// Cross-reference tables
+//
+// --------------------------
+// Only the positions of each subsection are kept; an object's entry is read
+// from the mapped file when it is looked up, since classic entries all have
+// the same length.
+
+int APPDFReverser::ReadXrefSection( size_t inPos, long long & outPrev )
+  {
+    std::vector< DictEntry >  theTrailer ;
+    Subsection                theSubsection ;
+    size_t                    thePos    = SkipWhite( inPos ) ;
+    size_t                    theEnd ;
+    long long                 theNumber ;
+
+    outPrev = -1 ;
+
+    if ( IsKeyword( thePos, "xref" ) == false )
+      {
+        // "12 0 obj" here is a cross-reference stream
+        if ( ReadNumber( thePos, theNumber ) && ReadNumber( thePos, theNumber ) && IsKeyword( SkipWhite( thePos ), "obj" ) )
+          return Fail( kReverserXrefStream, "the file uses a compressed cross-reference stream; reverse it in Acrobat instead" ) ;
+
+        return Fail( kReverserBadXref, "no cross-reference table at offset %lld", ( long long )inPos ) ;
+      }
+
+    thePos += 4 ;
+
+    for ( ;; )
+      {
+        thePos = SkipWhite( thePos ) ;
+
+        if ( IsKeyword( thePos, "trailer" ) )
+          break ;
+
+        if ( ( ReadNumber( thePos, theSubsection.fFirst ) == false ) || ( ReadNumber( thePos, theSubsection.fCount ) == false ) )
+          return Fail( kReverserBadXref, "a bad cross-reference subsection near offset %lld", ( long long )thePos ) ;
+
+        thePos = SkipWhite( thePos ) ;
+
+        theSubsection.fOffset     = thePos ;
+        theSubsection.fEntrySize  = 20 ;
+
+        if ( theSubsection.fCount != 0 )
+          {
+            // "oooooooooo ggggg n" then one to three end of line characters
+            size_t  theEOL = thePos + 18 ;
+
+            while ( ( theEOL < mSize ) && ( theEOL < thePos + 21 ) && IsWhite( mData[ theEOL ] ) )
+              theEOL++ ;
+
+            theSubsection.fEntrySize = theEOL - thePos ;
+
+            if ( ( theSubsection.fEntrySize < 19 ) || ( thePos + theSubsection.fEntrySize * ( size_t )theSubsection.fCount > mSize ) )
+              return Fail( kReverserBadXref, "a bad cross-reference subsection near offset %lld", ( long long )thePos ) ;
+          }
+
+        mSubsections.push_back( theSubsection ) ;
+
+        thePos += theSubsection.fEntrySize * ( size_t )theSubsection.fCount ;
+      }
+
+    if ( ScanDict( SkipWhite( thePos + 7 ), theTrailer, theEnd ) == false )
+      return Fail( kReverserBadXref, "a bad trailer near offset %lld", ( long long )thePos ) ;
+
+    if ( mTrailer.empty() )
+      mTrailer = theTrailer ;
+
+    const DictEntry * thePrev = FindKey( theTrailer, "Prev" ) ;
+    if ( thePrev != NULL )
+      {
+        size_t  theValue = thePrev->fValue.fStart ;
+
+        if ( ReadNumber( theValue, outPrev ) == false )
+          return Fail( kReverserBadXref, "a bad Prev in the trailer near offset %lld", ( long long )thePos ) ;
+      }
+
+    return kReverserOK ;
+
+  } // end ReadXrefSection
+
+// --------------------------
+// Follow startxref, then each trailer's Prev, back to the original table.
+
+int APPDFReverser::ReadXref( void )
+  {
+    size_t      thePos ;
+    long long   theOffset ;
+    int         theResult ;
+
+    mSubsections.clear() ;
+    mTrailer.clear() ;
+
+    thePos = mSize ;
+
+    while ( ( thePos > 0 ) && ( mSize - thePos < kStartXrefWindow ) )
+      {
+        thePos-- ;
+        if ( IsKeyword( thePos, "startxref" ) )
+          break ;
+      }
+
+    if ( IsKeyword( thePos, "startxref" ) == false )
+      return Fail( kReverserNotPDF, "no startxref at the end of the file" ) ;
+
+    thePos += 9 ;
+    if ( ( ReadNumber( thePos, theOffset ) == false ) || ( ( size_t )theOffset >= mSize ) )
+      return Fail( kReverserBadXref, "a bad startxref offset" ) ;
+
+    mStartXref = ( size_t )theOffset ;
+
+    for ( int theSections = 0 ; theOffset >= 0 ; theSections++ )
+      {
+        if ( ( theSections == kMaxXrefSections ) || ( ( size_t )theOffset >= mSize ) )
+          return Fail( kReverserBadXref, "the cross-reference sections do not end" ) ;
+
+        theResult = ReadXrefSection( ( size_t )theOffset, theOffset ) ;
+        if ( theResult != kReverserOK )
+          return theResult ;
+      }
+
+    return kReverserOK ;
+
+  } // end ReadXref
+
+// --------------------------
+// The newest entry for an object wins; a free entry means it was deleted.
+
+bool APPDFReverser::FindObject( long long inNumber, size_t & outOffset, int & outGeneration ) const
+  {
+    for ( size_t index = 0 ; index < mSubsections.size() ; index++ )
+      {
+        const Subsection &  theSubsection = mSubsections[ index ] ;
+
+        if ( ( inNumber < theSubsection.fFirst ) || ( inNumber >= theSubsection.fFirst + theSubsection.fCount ) )
+          continue ;
+
+        size_t      theEntry  = theSubsection.fOffset + ( size_t )( inNumber - theSubsection.fFirst ) * theSubsection.fEntrySize ;
+        size_t      thePos    = theEntry ;
+        long long   theOffset ;
+        long long   theGeneration ;
+
+        if ( ( ReadNumber( thePos, theOffset ) == false ) || ( ReadNumber( thePos, theGeneration ) == false ) )
+          return false ;
+
+        if ( mData[ theEntry + 17 ] != 'n' )
+          return false ;
+
+        outOffset     = ( size_t )theOffset ;
+        outGeneration = ( int )theGeneration ;
+
+        return ( outOffset < mSize ) ;
+      }
+
+    return false ;
+
+  } // end FindObject
+
+// --------------------------
+
+int APPDFReverser::ReadObjectDict( long long inNumber, int inGeneration, std::vector< DictEntry > & outEntries,
+                                   size_t & outDictStart, size_t & outDictEnd )
+  {
+    size_t      thePos ;
+    int         theGeneration ;
+    long long   theNumber ;
+    long long   theObjGeneration ;
+
+    if ( FindObject( inNumber, thePos, theGeneration ) == false )
+      return Fail( kReverserMissingObject, "object %lld is not in a cross-reference table; it may be in a compressed object stream", inNumber ) ;
+
+    if ( ( ReadNumber( thePos, theNumber ) == false ) || ( ReadNumber( thePos, theObjGeneration ) == false )
+         || ( theNumber != inNumber ) || ( theObjGeneration != inGeneration ) || ( IsKeyword( SkipWhite( thePos ), "obj" ) == false ) )
+      return Fail( kReverserBadObject, "object %lld %d is not where the cross-reference table puts it", inNumber, inGeneration ) ;
+
+    outDictStart = SkipWhite( SkipWhite( thePos ) + 3 ) ;
+
+    if ( ScanDict( outDictStart, outEntries, outDictEnd ) == false )
+      return Fail( kReverserBadObject, "object %lld %d is not a dictionary", inNumber, inGeneration ) ;
+
+    return kReverserOK ;
+
+  } // end ReadObjectDict
+
+// --------------------------
+//
+// Writing
+//
+// --------------------------
+
+bool APPDFReverser::Emit( FILE * inOutput, const char * inBytes, size_t inLength )
+  {
+    if ( fwrite( inBytes, 1, inLength, inOutput ) != inLength )
+      return false ;
+
+    mOutputPos += ( long long )inLength ;
+
+    return true ;
+
+  } // end Emit
+
+// --------------------------
+// The original file goes out unchanged, a chunk at a time; each chunk's
+// mapped pages are handed back once written so the copy never holds more
+// than one chunk of the input.
+
+bool APPDFReverser::CopyInput( FILE * inOutput )
+  {
+    for ( size_t thePos = 0 ; thePos < mSize ; thePos += kCopyChunk )
+      {
+        if ( IsCancelled() )
+          return false ;
+
+        size_t  theLength = std::min( ( size_t )kCopyChunk, mSize - thePos ) ;
+
+        if ( Emit( inOutput, mData + thePos, theLength ) == false )
+          return false ;
+
+#if !defined( _WIN32 )
+        madvise( ( void * )( mData + thePos ), theLength, MADV_DONTNEED ) ;
+#endif
+      }
+
+    // the update must start on a line of its own
+    if ( ( mData[ mSize - 1 ] != '\n' ) && ( mData[ mSize - 1 ] != '\r' ) )
+      return Emit( inOutput, "\n", 1 ) ;
+
+    return true ;
+
+  } // end CopyInput
+
+// --------------------------
+// Walk the page tree from the root, writing each Pages node again with its
+// Kids in reverse order; every kid is read to tell a Pages node from a page.
+// The walk keeps a stack of nodes still to visit rather than recursing, so a
+// deep tree cannot exhaust the stack.
+
+int APPDFReverser::WritePageTree( FILE * inOutput, long long inRootNumber, int inRootGeneration )
+  {
+    std::vector< std::pair< long long, int > >  theStack ;
+    std::vector< std::pair< long long, int > >  theKids ;
+    std::vector< DictEntry >                    theEntries ;
+    std::vector< DictEntry >                    theKidEntries ;
+    char                                        theString[ 64 ] ;
+    size_t                                      theDictStart ;
+    size_t                                      theDictEnd ;
+    size_t                                      thePos ;
+    long long                                   theNumber ;
+    int                                         theGeneration ;
+    int                                         theResult ;
+
+    theStack.push_back( std::make_pair( inRootNumber, inRootGeneration ) ) ;
+    mVisited.insert( inRootNumber ) ;
+
+    while ( theStack.empty() == false )
+      {
+        if ( IsCancelled() )
+          return Fail( kReverserCancelled, "cancelled" ) ;
+
+        std::pair< long long, int >   theNode = theStack.back() ;
+        theStack.pop_back() ;
+
+        theResult = ReadObjectDict( theNode.first, theNode.second, theEntries, theDictStart, theDictEnd ) ;
+        if ( theResult != kReverserOK )
+          return theResult ;
+
+        const DictEntry * theKidsEntry = FindKey( theEntries, "Kids" ) ;
+        if ( ( theKidsEntry == NULL ) || ( mData[ theKidsEntry->fValue.fStart ] != '[' ) )
+          return Fail( kReverserBadPageTree, "Pages node %lld has no Kids array", theNode.first ) ;
+
+        theKids.clear() ;
+        thePos = theKidsEntry->fValue.fStart + 1 ;
+
+        for ( ;; )
+          {
+            thePos = SkipWhite( thePos ) ;
+            if ( ( thePos < mSize ) && ( mData[ thePos ] == ']' ) )
+              break ;
+
+            if ( ReadReference( thePos, theNumber, theGeneration ) == false )
+              return Fail( kReverserBadPageTree, "Pages node %lld has a kid that is not a reference", theNode.first ) ;
+
+            if ( mVisited.insert( theNumber ).second == false )
+              return Fail( kReverserBadPageTree, "object %lld appears twice in the page tree", theNumber ) ;
+
+            theKids.push_back( std::make_pair( theNumber, theGeneration ) ) ;
+          }
+
+        for ( size_t index = 0 ; index < theKids.size() ; index++ )
+          {
+            theResult = ReadObjectDict( theKids[ index ].first, theKids[ index ].second, theKidEntries, thePos, thePos ) ;
+            if ( theResult != kReverserOK )
+              return theResult ;
+
+            if ( FindKey( theKidEntries, "Kids" ) != NULL )
+              theStack.push_back( theKids[ index ] ) ;
+            else
+              mNumPages += 1 ;
+          }
+
+        Written   theWritten = { theNode.first, theNode.second, mOutputPos } ;
+        mWritten.push_back( theWritten ) ;
+
+        snprintf( theString, sizeof( theString ), "%lld %d obj\n", theNode.first, theNode.second ) ;
+        if ( ( Emit( inOutput, theString, strlen( theString ) ) == false )
+             || ( Emit( inOutput, mData + theDictStart, theKidsEntry->fValue.fStart - theDictStart ) == false )
+             || ( Emit( inOutput, "[", 1 ) == false ) )
+          return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+
+        for ( size_t index = theKids.size() ; index > 0 ; index-- )
+          {
+            snprintf( theString, sizeof( theString ), ( index > 1 ) ? "%lld %d R " : "%lld %d R", theKids[ index - 1 ].first, theKids[ index - 1 ].second ) ;
+            if ( Emit( inOutput, theString, strlen( theString ) ) == false )
+              return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+          }
+
+        if ( ( Emit( inOutput, "]", 1 ) == false )
+             || ( Emit( inOutput, mData + theKidsEntry->fValue.fEnd, theDictEnd - theKidsEntry->fValue.fEnd ) == false )
+             || ( Emit( inOutput, "\nendobj\n", 8 ) == false ) )
+          return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+      }
+
+    return kReverserOK ;
+
+  } // end WritePageTree
+
+// --------------------------
+// A cross-reference section for the rewritten nodes and a trailer that
+// carries over the original's Root, Info, ID and Encrypt and points back to
+// the original section with Prev.
+
+int APPDFReverser::WriteUpdate( FILE * inOutput )
+  {
+    static const char * const   sCopiedKeys[] = { "Size", "Root", "Info", "ID", "Encrypt" } ;
+    char                        theString[ 64 ] ;
+    long long                   theXrefPos  = mOutputPos ;
+    size_t                      theRun ;
+
+    std::sort( mWritten.begin(), mWritten.end(), []( const Written & inA, const Written & inB ) { return inA.fNumber < inB.fNumber ; } ) ;
+
+    if ( Emit( inOutput, "xref\n", 5 ) == false )
+      return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+
+    for ( size_t index = 0 ; index < mWritten.size() ; index = theRun )
+      {
+        for ( theRun = index + 1 ; theRun < mWritten.size() ; theRun++ )
+          {
+            if ( mWritten[ theRun ].fNumber != mWritten[ theRun - 1 ].fNumber + 1 )
+              break ;
+          }
+
+        snprintf( theString, sizeof( theString ), "%lld %lld\n", mWritten[ index ].fNumber, ( long long )( theRun - index ) ) ;
+        if ( Emit( inOutput, theString, strlen( theString ) ) == false )
+          return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+
+        for ( size_t theEntry = index ; theEntry < theRun ; theEntry++ )
+          {
+            snprintf( theString, sizeof( theString ), "%010lld %05d n\r\n", mWritten[ theEntry ].fOffset, mWritten[ theEntry ].fGeneration ) ;
+            if ( Emit( inOutput, theString, 20 ) == false )
+              return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+          }
+      }
+
+    if ( Emit( inOutput, "trailer\n<<", 10 ) == false )
+      return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+
+    for ( size_t index = 0 ; index < sizeof( sCopiedKeys ) / sizeof( sCopiedKeys[ 0 ] ) ; index++ )
+      {
+        const DictEntry * theEntry = FindKey( mTrailer, sCopiedKeys[ index ] ) ;
+        if ( theEntry == NULL )
+          continue ;
+
+        snprintf( theString, sizeof( theString ), " /%s ", sCopiedKeys[ index ] ) ;
+        if ( ( Emit( inOutput, theString, strlen( theString ) ) == false )
+             || ( Emit( inOutput, mData + theEntry->fValue.fStart, theEntry->fValue.fEnd - theEntry->fValue.fStart ) == false ) )
+          return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+      }
+
+    snprintf( theString, sizeof( theString ), " /Prev %lld >>\nstartxref\n%lld\n%%%%EOF\n", ( long long )mStartXref, theXrefPos ) ;
+    if ( Emit( inOutput, theString, strlen( theString ) ) == false )
+      return Fail( kReverserCannotWrite, "writing the output failed" ) ;
+
+    return kReverserOK ;
+
+  } // end WriteUpdate
+
+// --------------------------
+
+int APPDFReverser::Reverse( const char * inInputPath, const char * inOutputPath )
+  {
+    std::vector< DictEntry >  theCatalog ;
+    size_t                    theDictStart ;
+    size_t                    theDictEnd ;
+    size_t                    thePos ;
+    long long                 theNumber ;
+    int                       theGeneration ;
+    int                       theResult ;
+    FILE *                    theOutput ;
+    std::string               theTempPath ;
+    long long                 theUpdateStart ;
+
+    Unmap() ;
+    mWritten.clear() ;
+    mVisited.clear() ;
+    mNumPages   = 0 ;
+    mOutputPos  = 0 ;
+    mUpdateSize = 0 ;
+    mMessage[ 0 ] = 0 ;
+
+    if ( ( mReplaceExisting == false ) && FileExists( inOutputPath ) )
+      return Fail( kReverserOutputExists, "%s already exists", inOutputPath ) ;
+
+    if ( Map( inInputPath ) == false )
+      return Fail( kReverserCannotOpen, "cannot open and map %s", inInputPath ) ;
+
+    // the header may follow a little junk, as Acrobat allows
+    for ( thePos = 0 ; ( thePos + 5 <= mSize ) && ( thePos < kStartXrefWindow ) ; thePos++ )
+      {
+        if ( memcmp( mData + thePos, "%PDF-", 5 ) == 0 )
+          break ;
+      }
+
+    if ( ( thePos + 5 > mSize ) || ( thePos == kStartXrefWindow ) )
+      return Fail( kReverserNotPDF, "%s is not a PDF file", inInputPath ) ;
+
+    theResult = ReadXref() ;
+    if ( theResult != kReverserOK )
+      return theResult ;
+
+    // the catalog's Pages entry is the root of the page tree
+    const DictEntry * theRoot = FindKey( mTrailer, "Root" ) ;
+    thePos = ( theRoot != NULL ) ? theRoot->fValue.fStart : kBadPos ;
+    if ( ( theRoot == NULL ) || ( ReadReference( thePos, theNumber, theGeneration ) == false ) )
+      return Fail( kReverserBadXref, "the trailer has no Root" ) ;
+
+    theResult = ReadObjectDict( theNumber, theGeneration, theCatalog, theDictStart, theDictEnd ) ;
+    if ( theResult != kReverserOK )
+      return theResult ;
+
+    const DictEntry * thePages = FindKey( theCatalog, "Pages" ) ;
+    thePos = ( thePages != NULL ) ? thePages->fValue.fStart : kBadPos ;
+    if ( ( thePages == NULL ) || ( ReadReference( thePos, theNumber, theGeneration ) == false ) )
+      return Fail( kReverserBadPageTree, "the catalog has no Pages" ) ;
+
+    if ( IsMappedFile( inOutputPath ) )
+      return Fail( kReverserCannotWrite, "%s is the input file; the output must be a different file", inOutputPath ) ;
+
+    // written beside the output and renamed over it once complete, so a
+    // failure part way through never leaves a truncated file at inOutputPath
+    theOutput = CreateTempFile( inOutputPath, theTempPath ) ;
+    if ( theOutput == NULL )
+      return Fail( kReverserCannotWrite, "cannot create a file next to %s", inOutputPath ) ;
+
+    if ( CopyInput( theOutput ) )
+      theResult = kReverserOK ;
+    else if ( IsCancelled() )
+      theResult = Fail( kReverserCancelled, "cancelled" ) ;
+    else
+      theResult = Fail( kReverserCannotWrite, "copying %s failed", inInputPath ) ;
+
+    theUpdateStart = mOutputPos ;
+
+    if ( theResult == kReverserOK )
+      theResult = WritePageTree( theOutput, theNumber, theGeneration ) ;
+    if ( theResult == kReverserOK )
+      theResult = WriteUpdate( theOutput ) ;
+
+    if ( ( fclose( theOutput ) != 0 ) && ( theResult == kReverserOK ) )
+      theResult = Fail( kReverserCannotWrite, "writing %s failed", theTempPath.c_str() ) ;
+
+    if ( ( theResult == kReverserOK ) && ( MoveIntoPlace( theTempPath.c_str(), inOutputPath, mReplaceExisting ) == false ) )
+      {
+        if ( ( mReplaceExisting == false ) && FileExists( inOutputPath ) )
+          theResult = Fail( kReverserOutputExists, "%s already exists", inOutputPath ) ;
+        else
+          theResult = Fail( kReverserCannotWrite, "cannot replace %s", inOutputPath ) ;
+      }
+
+    if ( theResult != kReverserOK )
+      {
+        RemoveFile( theTempPath.c_str() ) ;
+        return theResult ;
+      }
+
+    mUpdateSize = mOutputPos - theUpdateStart ;
+
+    return kReverserOK ;
+
+  } // end Reverse
+
+// --------------------------
@@ -0,0 +1,174 @@
+/*
+  File:   APPDFReverser.h
+
+  Contains: Reverses the page order of a PDF file without Acrobat, reading
+            it through a memory map and writing the change as an
+            incremental update, so files larger than memory can be handled.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      APPDFReverser   theReverser ;
+
+      if ( theReverser.Reverse( "in.pdf", "out.pdf" ) != kReverserOK )
+        fprintf( stderr, "%s\n", theReverser.GetMessage() ) ;
+
+    Paths are UTF-8.  On Windows they are converted for the wide file
+    calls, so names outside the system code page work there too.
+
+    Uses only the C and C++ libraries, not the Acrobat SDK; see
+    ReversePagesCLI.cpp.
+
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <vector>
+#include <unordered_set>
+
+// --------------------------
+
+enum
+  {
+    kReverserOK = 0,
+    kReverserCannotOpen,
+    kReverserCannotWrite,
+    kReverserNotPDF,
+    kReverserXrefStream,      // cross-reference streams are compressed; not read here
+    kReverserBadXref,
+    kReverserMissingObject,   // not in a classic xref table, e.g. in an object stream
+    kReverserBadObject,
+    kReverserBadPageTree,
+    kReverserCancelled,
+    kReverserOutputExists     // and SetReplaceExisting( false ) was called
+  } ;
+
+// true to stop; checked between chunks of the copy and between Pages nodes
+typedef bool ( * APReverserCancelProc )( void * inData ) ;
+
+// --------------------------
+// Every Pages node in the page tree has its Kids array reversed, which
+// reverses the order of the leaf pages while each page keeps its Parent and
+// so everything it inherits.  The input is copied to the output byte for
+// byte, with no object decoded, and only the Pages nodes are appended in an
+// incremental update.  Memory use depends on the number of Pages nodes, not
+// the size of the file.
+
+class APPDFReverser
+  {
+    public:
+      APPDFReverser() ;
+      ~APPDFReverser() ;
+
+      int           Reverse( const char * inInputPath, const char * inOutputPath ) ;
+      void          SetCancelProc( APReverserCancelProc inProc, void * inData ) { mCancelProc = inProc ; mCancelData = inData ; }
+
+      // true by default; when false an existing output file is never replaced
+      void          SetReplaceExisting( bool inReplace ) { mReplaceExisting = inReplace ; }
+
+      const char *  GetMessage( void ) const { return mMessage ; }
+      long long     GetNumPages( void ) const { return mNumPages ; }
+      long long     GetNumNodes( void ) const { return ( long long )mWritten.size() ; }
+      long long     GetInputSize( void ) const { return ( long long )mSize ; }
+      long long     GetUpdateSize( void ) const { return mUpdateSize ; }
+
+    private:
+      struct Span
+        {
+          size_t    fStart ;
+          size_t    fEnd ;
+        } ;
+
+      struct DictEntry
+        {
+          Span      fKey ;          // the name without its slash
+          Span      fValue ;
+        } ;
+
+      struct Subsection
+        {
+          long long fFirst ;
+          long long fCount ;
+          size_t    fOffset ;       // of the first entry
+          size_t    fEntrySize ;    // 20 by the specification; some writers use 19 or 21
+        } ;
+
+      struct Written
+        {
+          long long fNumber ;
+          int       fGeneration ;
+          long long fOffset ;
+        } ;
+
+      int           Fail( int inResult, const char * inFormat, ... ) ;
+      bool          Emit( FILE * inOutput, const char * inBytes, size_t inLength ) ;
+      bool          CopyInput( FILE * inOutput ) ;
+      bool          IsCancelled( void ) const { return ( mCancelProc != NULL ) && mCancelProc( mCancelData ) ; }
+
+      bool          Map( const char * inPath ) ;
+      void          Unmap( void ) ;
+      bool          IsMappedFile( const char * inPath ) const ;
+
+      // lexing, over the mapped bytes
+      size_t        SkipWhite( size_t inPos ) const ;
+      size_t        SkipToken( size_t inPos ) const ;
+      size_t        SkipValue( size_t inPos ) const ;
+      bool          IsKeyword( size_t inPos, const char * inKeyword ) const ;
+      bool          ReadNumber( size_t & ioPos, long long & outNumber ) const ;
+      bool          ReadReference( size_t & ioPos, long long & outNumber, int & outGeneration ) const ;
+      bool          ScanDict( size_t inPos, std::vector< DictEntry > & outEntries, size_t & outEnd ) const ;
+      const DictEntry * FindKey( const std::vector< DictEntry > & inEntries, const char * inKey ) const ;
+
+      // cross-reference tables
+      int           ReadXref( void ) ;
+      int           ReadXrefSection( size_t inPos, long long & outPrev ) ;
+      bool          FindObject( long long inNumber, size_t & outOffset, int & outGeneration ) const ;
+      int           ReadObjectDict( long long inNumber, int inGeneration, std::vector< DictEntry > & outEntries,
+                                    size_t & outDictStart, size_t & outDictEnd ) ;
+
+      int           WritePageTree( FILE * inOutput, long long inRootNumber, int inRootGeneration ) ;
+      int           WriteUpdate( FILE * inOutput ) ;
+
+      const char *                    mData ;
+      size_t                          mSize ;
+#if defined( _WIN32 )
+      void *                          mFile ;
+      void *                          mMapping ;
+#else
+      int                             mFile ;
+#endif
+
+      std::vector< Subsection >       mSubsections ;    // newest section first
+      std::vector< DictEntry >        mTrailer ;        // of the newest section
+      size_t                          mStartXref ;
+
+      std::vector< Written >          mWritten ;
+      std::unordered_set< long long > mVisited ;
+      long long                       mOutputPos ;
+      long long                       mUpdateSize ;
+      long long                       mNumPages ;
+
+      char                            mMessage[ 512 ] ;
+
+      APReverserCancelProc            mCancelProc ;
+      void *                          mCancelData ;
+      bool                            mReplaceExisting ;
+
+      APPDFReverser( const APPDFReverser & ) ;
+      APPDFReverser & operator=( const APPDFReverser & ) ;
+  } ;
+
+// --------------------------
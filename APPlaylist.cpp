@@ -0,0 +1,455 @@
+/*
+  File:   APPlaylist.cpp
+
+  Contains: A list of PDF files presented one after another, each opened
+            and its first page drawn at idle time before it is needed.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "PDCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "APPlaylist.h"
+#include "APHandle.h"
+#include "APDiagnostics.h"
+#include "APTiming.h"
+
+// --------------------------
+
+#define kMaxPlaylistLine    1024
+#define kMaxPreloadHeight   ( 4 * kPreloadWidth )   // a very long page is drawn only this far down
+
+// --------------------------
+
+APPlaylist::APPlaylist()
+  {
+    mFileSys          = NULL ;
+    mSwitches[ 0 ]    = mSwitches[ 1 ]    = 0 ;
+    mSwitchTime[ 0 ]  = mSwitchTime[ 1 ]  = 0 ;
+
+  } // end APPlaylist
+
+// --------------------------
+// Decks that were shown stay open; only the documents opened ahead of time,
+// which have no window, are closed.  Every deck's path name is released.
+
+void APPlaylist::Clear( void )
+  {
+    for ( size_t index = 0 ; index < mDecks.size() ; index++ )
+      {
+        if ( mDecks[ index ].fPDDoc != NULL )
+          PDDocClose( mDecks[ index ].fPDDoc ) ;
+
+        ASFileSysReleasePath( mFileSys, mDecks[ index ].fPathName ) ;
+      }
+
+    mDecks.clear() ;
+
+  } // end Clear
+
+// --------------------------
+// A line of the list as a device-independent path: backslashes become
+// slashes and a drive letter becomes the first part, so C:\Talks\intro.pdf
+// is /C/Talks/intro.pdf.
+
+static std::string ToDIPath( const char * inLine )
+  {
+    std::string   theDIPath ;
+
+    if ( ( inLine[ 0 ] != 0 ) && ( inLine[ 1 ] == ':' ) )
+      {
+        theDIPath  = "/" ;
+        theDIPath += inLine[ 0 ] ;
+        inLine    += 2 ;
+      }
+
+    theDIPath += inLine ;
+
+    for ( size_t index = 0 ; index < theDIPath.size() ; index++ )
+      {
+        if ( theDIPath[ index ] == '\\' )
+          theDIPath[ index ] = '/' ;
+      }
+
+    return theDIPath ;
+
+  } // end ToDIPath
+
+// --------------------------
+// inPathName as a full device-independent path, or empty when the file
+// system cannot give one; two path names for the same file compare equal.
+
+static std::string GetDIPath( ASFileSys inFileSys, ASPathName inPathName )
+  {
+    std::string   theDIPath ;
+    char *        theString = ASFileSysDIPathFromPath( inFileSys, inPathName, NULL ) ;
+
+    if ( theString != NULL )
+      {
+        theDIPath = theString ;
+        ASfree( theString ) ;
+      }
+
+    return theDIPath ;
+
+  } // end GetDIPath
+
+// --------------------------
+// The whole of inFileName in inFolder, ending in a 0, or false when it
+// cannot be opened.
+
+static ASBool ReadListFile( ASFileSys inFileSys, ASPathName inFolder, const char * inFileName, std::vector< char > & outText )
+  {
+    ASPathName  thePathName = ASFileSysCreatePathFromDIPath( inFileSys, inFileName, inFolder ) ;
+    ASFile      theASFile   = NULL ;
+    ASInt32     theLength ;
+
+    if ( thePathName == NULL )
+      return false ;
+
+    if ( ( ASFileSysOpenFile( inFileSys, thePathName, ASFILE_READ, &theASFile ) != 0 ) || ( theASFile == NULL ) )
+      {
+        ASFileSysReleasePath( inFileSys, thePathName ) ;
+        return false ;
+      }
+
+    DURING
+      outText.resize( ( size_t )ASFileGetEOF( theASFile ) + 1 ) ;
+      theLength = ASFileRead( theASFile, &outText[ 0 ], ( ASInt32 )outText.size() - 1 ) ;
+      outText.resize( ( size_t )theLength + 1 ) ;
+      outText.back() = 0 ;
+    HANDLER
+      ASFileClose( theASFile ) ;
+      ASFileSysReleasePath( inFileSys, thePathName ) ;
+      RERAISE() ;
+    END_HANDLER
+
+    ASFileClose( theASFile ) ;
+    ASFileSysReleasePath( inFileSys, thePathName ) ;
+
+    return true ;
+
+  } // end ReadListFile
+
+// --------------------------
+// Read inFileName from inAVDoc's folder through inAVDoc's own file system,
+// so decks are found by path name rather than by a display string.  inAVDoc
+// is the deck of the same file in the list, or goes in front of the list
+// when it is not in it.
+
+ASInt32 APPlaylist::Load( AVDoc inAVDoc, const char * inFileName )
+  {
+    APPlaylistDeck        theDeck ;
+    std::vector< char >   theText ;
+    std::string           theDocDIPath ;
+    char *                theLine ;
+    char *                theString ;
+    size_t                theLength ;
+    ASFile                theASFile       = PDDocGetFile( AVDocGetPDDoc( inAVDoc ) ) ;
+    ASPathName            theDocPathName ;
+    ASPathName            theFolder       = NULL ;
+    volatile ASBool       theRead         = false ;
+    volatile ASInt32      theDocDeck      = kPlaylistNoDeck ;
+
+    Clear() ;
+
+    mFileSys       = ASFileGetFileSys( theASFile ) ;
+    theDocPathName = ASFileAcquirePathName( theASFile ) ;
+    if ( theDocPathName == NULL )
+      return 0 ;
+
+    theDocDIPath = GetDIPath( mFileSys, theDocPathName ) ;
+
+    if ( theDocDIPath.empty() || ( ASFileSysAcquireParent( mFileSys, theDocPathName, &theFolder ) != 0 ) || ( theFolder == NULL ) )
+      {
+        ASFileSysReleasePath( mFileSys, theDocPathName ) ;
+        return 0 ;
+      }
+
+    theDeck.fAVDoc      = NULL ;
+    theDeck.fPDDoc      = NULL ;
+    theDeck.fPreloaded  = false ;
+    theDeck.fOpenedHere = false ;
+
+    DURING
+
+      theRead = ReadListFile( mFileSys, theFolder, inFileName, theText ) ;
+
+      for ( theLine = theRead ? &theText[ 0 ] : NULL ; ( theLine != NULL ) && ( *theLine != 0 ) ; theLine = theString )
+        {
+          theLength = strcspn( theLine, "\r\n" ) ;
+          theString = theLine + theLength + strspn( theLine + theLength, "\r\n" ) ;
+          theLine[ theLength ] = 0 ;
+
+          theLine  += strspn( theLine, " \t" ) ;
+          theLength = strlen( theLine ) ;
+
+          while ( ( theLength > 0 ) && ( ( theLine[ theLength - 1 ] == ' ' ) || ( theLine[ theLength - 1 ] == '\t' ) ) )
+            theLength-- ;
+
+          theLine[ theLength ] = 0 ;
+          if ( ( theLength == 0 ) || ( theLength >= kMaxPlaylistLine ) || ( theLine[ 0 ] == '#' ) )
+            continue ;
+
+          // relative to the list's folder unless it starts at a root
+          theDeck.fPathName = ASFileSysCreatePathFromDIPath( mFileSys, ToDIPath( theLine ).c_str(), theFolder ) ;
+          if ( theDeck.fPathName == NULL )
+            {
+              APDiagnostics::Shared().Report( 0, "finding a deck named in the playlist" ) ;
+              continue ;
+            }
+
+          if ( ( theDocDeck == kPlaylistNoDeck ) && ( GetDIPath( mFileSys, theDeck.fPathName ) == theDocDIPath ) )
+            theDocDeck = ( ASInt32 )mDecks.size() ;
+
+          mDecks.push_back( theDeck ) ;
+        }
+
+    HANDLER
+      ASFileSysReleasePath( mFileSys, theFolder ) ;
+      ASFileSysReleasePath( mFileSys, theDocPathName ) ;
+      RERAISE() ;
+    END_HANDLER
+
+    ASFileSysReleasePath( mFileSys, theFolder ) ;
+
+    if ( theRead == false )
+      {
+        ASFileSysReleasePath( mFileSys, theDocPathName ) ;
+        return 0 ;
+      }
+
+    if ( theDocDeck == kPlaylistNoDeck )
+      {
+        theDeck.fPathName = theDocPathName ;      // the deck list owns it now
+        mDecks.insert( mDecks.begin(), theDeck ) ;
+        theDocDeck = 0 ;
+      }
+    else
+      ASFileSysReleasePath( mFileSys, theDocPathName ) ;
+
+    mDecks[ theDocDeck ].fAVDoc     = inAVDoc ;
+    mDecks[ theDocDeck ].fPreloaded = true ;
+
+    return ( ASInt32 )mDecks.size() ;
+
+  } // end Load
+
+// --------------------------
+
+ASInt32 APPlaylist::Find( AVDoc inAVDoc ) const
+  {
+    if ( inAVDoc == NULL )
+      return kPlaylistNoDeck ;
+
+    for ( size_t index = 0 ; index < mDecks.size() ; index++ )
+      {
+        if ( mDecks[ index ].fAVDoc == inAVDoc )
+          return ( ASInt32 )index ;
+      }
+
+    return kPlaylistNoDeck ;
+
+  } // end Find
+
+// --------------------------
+
+PDDoc APPlaylist::OpenPDDoc( ASPathName inPathName )
+  {
+    return PDDocOpen( inPathName, mFileSys, NULL, true ) ;
+
+  } // end OpenPDDoc
+
+// --------------------------
+// Draw the first page into a buffer that is thrown away; what is kept is
+// everything Acrobat decoded and cached to draw it.
+
+void APPlaylist::DrawFirstPage( PDDoc inPDDoc )
+  {
+    std::vector< char >   theBuffer ;
+    ASFixedRect           theCropBox ;
+    ASFixedMatrix         theMatrix ;
+    ASFixed               theScale ;
+    ASInt32               theHeight ;
+    ASInt32               theRowBytes ;
+    APPDPageRef           thePDPageRef ;      // outside DURING so it is released even if drawing raises
+
+    DURING
+
+      thePDPageRef.Reset( PDDocAcquirePage( inPDDoc, 0 ) ) ;
+      PDPageGetCropBox( thePDPageRef, &theCropBox ) ;
+
+      if ( ( theCropBox.right > theCropBox.left ) && ( theCropBox.top > theCropBox.bottom ) )
+        {
+          theScale    = ASFixedDiv( ASInt32ToFixed( kPreloadWidth ), theCropBox.right - theCropBox.left ) ;
+          theHeight   = ASFixedRoundToInt32( ASFixedMul( theCropBox.top - theCropBox.bottom, theScale ) ) ;
+          theRowBytes = ( kPreloadWidth * 3 + 3 ) & ~3 ;
+
+          if ( theHeight > kMaxPreloadHeight )
+            theHeight = kMaxPreloadHeight ;
+
+          // user space to the buffer, with y running down from the top of the crop box
+          theMatrix.a = theScale ;
+          theMatrix.b = 0 ;
+          theMatrix.c = 0 ;
+          theMatrix.d = -theScale ;
+          theMatrix.h = -ASFixedMul( theCropBox.left, theScale ) ;
+          theMatrix.v = ASFixedMul( theCropBox.top, theScale ) ;
+
+          theBuffer.resize( ( size_t )theRowBytes * theHeight ) ;
+
+          PDPageDrawContentsToMemory( thePDPageRef, kPDPageDoLazyErase | kPDPageUseAnnotFaces, &theMatrix, NULL, 0,
+                                      ASAtomFromString( "DeviceRGB" ), 8, &theBuffer[ 0 ], ( ASInt32 )theBuffer.size(), NULL, NULL ) ;
+        }
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "drawing the next deck's first page ahead of time" ) ;
+    END_HANDLER
+
+  } // end DrawFirstPage
+
+// --------------------------
+// One step of getting inDeck ready: open it, then on the next call draw its
+// first page.  A deck that cannot be opened is left for Show to report.
+
+ASBool APPlaylist::Preload( ASInt32 inDeck )
+  {
+    if ( ( inDeck < 0 ) || ( inDeck >= ( ASInt32 )mDecks.size() ) )
+      return false ;
+
+    APPlaylistDeck &  theDeck = mDecks[ inDeck ] ;
+
+    if ( ( theDeck.fPreloaded == true ) || ( theDeck.fAVDoc != NULL ) )
+      return false ;
+
+    if ( theDeck.fPDDoc == NULL )
+      {
+        DURING
+          theDeck.fPDDoc = OpenPDDoc( theDeck.fPathName ) ;
+        HANDLER
+          theDeck.fPreloaded = true ;
+        END_HANDLER
+
+        return ( theDeck.fPreloaded == false ) ;
+      }
+
+    DrawFirstPage( theDeck.fPDDoc ) ;
+    theDeck.fPreloaded = true ;
+
+    return false ;
+
+  } // end Preload
+
+// --------------------------
+// Close what the playlist opened for decks other than the one before
+// inDeck, inDeck and the one after, so a long playlist does not keep every
+// deck open.  A deck with unsaved changes is left open.
+
+void APPlaylist::CloseOutside( ASInt32 inDeck )
+  {
+    for ( ASInt32 index = 0 ; index < ( ASInt32 )mDecks.size() ; index++ )
+      {
+        APPlaylistDeck &  theDeck = mDecks[ index ] ;
+
+        if ( ( index >= inDeck - 1 ) && ( index <= inDeck + 1 ) )
+          continue ;
+
+        if ( theDeck.fPDDoc != NULL )
+          {
+            PDDocClose( theDeck.fPDDoc ) ;
+            theDeck.fPDDoc      = NULL ;
+            theDeck.fPreloaded  = false ;
+          }
+
+        if ( ( theDeck.fAVDoc != NULL ) && ( theDeck.fOpenedHere == true )
+             && ( ( PDDocGetFlags( AVDocGetPDDoc( theDeck.fAVDoc ) ) & PDDocNeedsSave ) == 0 ) )
+          {
+            AVDocClose( theDeck.fAVDoc, true ) ;
+            theDeck.fAVDoc      = NULL ;
+            theDeck.fOpenedHere = false ;
+            theDeck.fPreloaded  = false ;
+          }
+      }
+
+  } // end CloseOutside
+
+// --------------------------
+// Give inDeck a window, or bring its window to the front, and go to
+// inPageNum.  Full screen mode carries over to the new window, and the page
+// is drawn before returning so the time recorded is the time to the first
+// frame.
+
+AVDoc APPlaylist::Show( ASInt32 inDeck, ASInt32 inPageNum )
+  {
+    APPlaylistDeck &  theDeck         = mDecks[ inDeck ] ;
+    ASUns64           theStartTime    = APTiming::GetNanoseconds() ;
+    ASBool            thePreloaded    = ( theDeck.fAVDoc != NULL ) || ( theDeck.fPDDoc != NULL ) ;
+    ASBool            theFullScreen   = AVAppDoingFullScreen() ;
+    AVPageView        theAVPageView ;
+
+    if ( theDeck.fAVDoc == NULL )
+      {
+        if ( theDeck.fPDDoc == NULL )
+          theDeck.fPDDoc = OpenPDDoc( theDeck.fPathName ) ;
+
+        theDeck.fAVDoc      = AVDocOpenFromPDDoc( theDeck.fPDDoc, NULL ) ;
+        theDeck.fPDDoc      = NULL ;      // the window owns it now
+        theDeck.fOpenedHere = true ;
+        theDeck.fPreloaded  = true ;
+      }
+    else
+      AVWindowBringToFront( AVDocGetAVWindow( theDeck.fAVDoc ) ) ;
+
+    if ( ( theFullScreen == true ) && ( AVAppDoingFullScreen() == false ) )
+      AVAppBeginFullScreen( NULL ) ;
+
+    if ( inPageNum == kPlaylistLastPage )
+      inPageNum = PDDocGetNumPages( AVDocGetPDDoc( theDeck.fAVDoc ) ) - 1 ;
+
+    theAVPageView = AVDocGetPageView( theDeck.fAVDoc ) ;
+    AVPageViewGoTo( theAVPageView, inPageNum ) ;
+    AVPageViewDrawNow( theAVPageView ) ;
+
+    mSwitches[ thePreloaded ? 1 : 0 ]   += 1 ;
+    mSwitchTime[ thePreloaded ? 1 : 0 ] += APTiming::GetNanoseconds() - theStartTime ;
+
+    return theDeck.fAVDoc ;
+
+  } // end Show
+
+// --------------------------
+
+void APPlaylist::DocWillClose( AVDoc inAVDoc )
+  {
+    ASInt32   theDeck = Find( inAVDoc ) ;
+
+    if ( theDeck == kPlaylistNoDeck )
+      return ;
+
+    mDecks[ theDeck ].fAVDoc      = NULL ;
+    mDecks[ theDeck ].fOpenedHere = false ;
+    mDecks[ theDeck ].fPreloaded  = false ;
+
+  } // end DocWillClose
+
+// --------------------------
@@ -0,0 +1,94 @@
+/*
+  File:   APPlaylist.h
+
+  Contains: A list of PDF files presented one after another, each opened
+            and its first page drawn at idle time before it is needed.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  The list is a text file next to the first deck, one file per line,
+  relative to that folder unless given in full.  Paths are read as
+  device-independent paths, with / between folders, though \ and a
+  Windows drive letter are also accepted.  Blank lines and lines starting
+  with # are skipped.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+#include "PDCalls.h"
+
+#include <vector>
+
+// --------------------------
+
+#define kPlaylistNoDeck     -1
+#define kPlaylistLastPage   -1
+#define kPreloadWidth       1024    // pixels the first page is drawn across ahead of time
+
+struct APPlaylistDeck
+  {
+    ASPathName    fPathName ;       // in the playlist's file system, released by Clear
+    AVDoc         fAVDoc ;          // NULL until shown
+    PDDoc         fPDDoc ;          // opened ahead of time, with no window yet
+    ASBool        fPreloaded ;      // opened and drawn ahead of time, or tried and failed
+    ASBool        fOpenedHere ;     // the playlist gave it its window, so may close it again
+  } ;
+
+// --------------------------
+// Acrobat's document calls must be made on the main thread, so "ahead of
+// time" means in idle procs: Preload does one step per call, opening the
+// file or drawing its first page off screen, and Show then gives the opened
+// document a window.  The drawing leaves the first page's fonts and images
+// in Acrobat's caches, which is most of the cost of showing it.
+
+class APPlaylist
+  {
+    public:
+      APPlaylist() ;
+
+      // the number of decks, or 0 when inFileName cannot be read next to inAVDoc
+      ASInt32       Load( AVDoc inAVDoc, const char * inFileName ) ;
+      void          Clear( void ) ;
+
+      ASBool        IsActive( void ) const { return ( mDecks.empty() == false ) ; }
+      ASInt32       GetNumDecks( void ) const { return ( ASInt32 )mDecks.size() ; }
+      ASInt32       Find( AVDoc inAVDoc ) const ;
+
+      // false when there is nothing left to do for inDeck
+      ASBool        Preload( ASInt32 inDeck ) ;
+      void          CloseOutside( ASInt32 inDeck ) ;
+
+      // brings inDeck to the front on inPageNum, kPlaylistLastPage for its last page
+      AVDoc         Show( ASInt32 inDeck, ASInt32 inPageNum ) ;
+
+      void          DocWillClose( AVDoc inAVDoc ) ;
+
+      ASInt32       GetNumSwitches( ASBool inPreloaded ) const { return mSwitches[ inPreloaded ? 1 : 0 ] ; }
+      ASUns64       GetSwitchTime( ASBool inPreloaded ) const { return mSwitchTime[ inPreloaded ? 1 : 0 ] ; }
+
+    private:
+      PDDoc         OpenPDDoc( ASPathName inPathName ) ;
+      void          DrawFirstPage( PDDoc inPDDoc ) ;
+
+      std::vector< APPlaylistDeck >   mDecks ;
+      ASFileSys     mFileSys ;                // the first deck's, used for every deck
+      ASInt32       mSwitches[ 2 ] ;          // cold, preloaded
+      ASUns64       mSwitchTime[ 2 ] ;        // nanoseconds, over mSwitches
+
+      APPlaylist( const APPlaylist & ) ;
+      APPlaylist & operator=( const APPlaylist & ) ;
+  } ;
+
+// --------------------------
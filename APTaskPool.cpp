@@ -0,0 +1,490 @@
+/*
+  File:   APTaskPool.cpp
+
+  Contains: Runs work that does not touch Acrobat on a pool of worker
+            threads, and hands each finished task back to the main thread
+            from an idle proc.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "APReport.h"
+#include "APTiming.h"
+#include "APDiagnostics.h"
+#include "APTaskPool.h"
+
+// --------------------------
+
+#define kDrainTicks     1                       // 1/60 second, about one frame
+#define kDrainBudget    ( 4 * 1000 * 1000 )     // nanoseconds of done procs per idle
+#define kDrainAll       ( ( ASUns64 )-1 )
+
+// the index of the worker this thread is, -1 on the main thread
+static thread_local ASInt32   sWorker = -1 ;
+
+// --------------------------
+
+APTaskPool::APTaskPool()
+  : mNextWorker( 0 ),
+    mPending( 0 ),
+    mQueued( 0 ),
+    mStopping( false ),
+    mStopped( false ),
+    mIdleProc( NULL )
+  {
+  } // end APTaskPool
+
+// --------------------------
+// Only reached without Stop when the plug-in is torn down some other way;
+// the threads must still be joined, but no done proc is called this late.
+
+APTaskPool::~APTaskPool()
+  {
+    {
+      std::lock_guard< std::mutex >   theLock( mWakeLock ) ;
+      mStopping = true ;
+    }
+    mWake.notify_all() ;
+
+    for ( size_t index = 0 ; index < mWorkers.size() ; index++ )
+      {
+        if ( mWorkers[ index ]->fThread.joinable() )
+          mWorkers[ index ]->fThread.join() ;
+
+        for ( size_t theTask = 0 ; theTask < mWorkers[ index ]->fTasks.size() ; theTask++ )
+          delete mWorkers[ index ]->fTasks[ theTask ] ;
+      }
+
+    for ( size_t index = 0 ; index < mDone.size() ; index++ )
+      delete mDone[ index ] ;
+
+  } // end ~APTaskPool
+
+// --------------------------
+
+APTaskPool & APTaskPool::Shared( void )
+  {
+    static APTaskPool   sTaskPool ;
+
+    return sTaskPool ;
+
+  } // end Shared
+
+// --------------------------
+
+ASBool APTaskPool::Start( ASInt32 inNumWorkers )
+  {
+    if ( mWorkers.empty() == false )
+      return true ;
+
+    if ( inNumWorkers <= 0 )
+      inNumWorkers = ( ASInt32 )std::thread::hardware_concurrency() - 1 ;
+    if ( inNumWorkers <= 0 )
+      inNumWorkers = 1 ;
+
+    mStopping = false ;
+    mStopped  = false ;
+    mQueued   = 0 ;
+
+    for ( ASInt32 index = 0 ; index < inNumWorkers ; index++ )
+      {
+        mWorkers.push_back( std::unique_ptr< Worker >( new Worker ) ) ;
+        mWorkers.back()->fRan     = 0 ;
+        mWorkers.back()->fStolen  = 0 ;
+      }
+
+    // started once every queue exists, since a worker looks in all of them
+    for ( ASInt32 index = 0 ; index < inNumWorkers ; index++ )
+      mWorkers[ index ]->fThread = std::thread( &APTaskPool::Run, this, index ) ;
+
+    mIdleProc = ASCallbackCreateProto( AVIdleProc, &DoIdle ) ;
+    AVAppRegisterIdleProc( mIdleProc, this, kDrainTicks ) ;
+
+    return true ;
+
+  } // end Start
+
+// --------------------------
+// Tasks still queued are not started, apart from any a worker takes as Stop
+// begins, and the running ones are waited for.  Every done proc is then
+// called so each can free its data, with kTaskCancelled for the tasks that
+// never ran and kTaskUnloading for those that finished, since nothing
+// should be opened or shown during an unload.
+//
+// mStopping is set before the queues are emptied, so a task submitted from
+// a worker meanwhile is refused by Push rather than left in a queue.
+
+void APTaskPool::Stop( void )
+  {
+    mStopped = true ;
+
+    if ( mWorkers.empty() )
+      return ;
+
+    {
+      std::lock_guard< std::mutex >   theLock( mWakeLock ) ;
+      mStopping = true ;
+    }
+    mWake.notify_all() ;
+
+    CancelQueued() ;
+
+    for ( size_t index = 0 ; index < mWorkers.size() ; index++ )
+      mWorkers[ index ]->fThread.join() ;
+
+    // nothing can be pushed once mStopping is set; this only makes sure
+    CancelQueued() ;
+
+    mWorkers.clear() ;
+
+    {
+      std::lock_guard< std::mutex >   theLock( mDoneLock ) ;
+
+      for ( size_t index = 0 ; index < mDone.size() ; index++ )
+        {
+          if ( mDone[ index ]->fStatus == kTaskDone )
+            mDone[ index ]->fStatus = kTaskUnloading ;
+        }
+    }
+
+    AVAppUnregisterIdleProc( mIdleProc, this ) ;
+    ASCallbackDestroy( mIdleProc ) ;
+    mIdleProc = NULL ;
+
+    Drain( kDrainAll ) ;
+
+  } // end Stop
+
+// --------------------------
+// Moves every queued task to the completion queue as cancelled.  mQueued
+// comes down by the number taken, under mWakeLock as in Take, so a worker
+// taking a task at the same time still leaves it right.
+
+void APTaskPool::CancelQueued( void )
+  {
+    APTask *  theTask ;
+    ASInt32   theCount = 0 ;
+
+    for ( size_t index = 0 ; index < mWorkers.size() ; index++ )
+      {
+        std::lock_guard< std::mutex >   theLock( mWorkers[ index ]->fLock ) ;
+
+        while ( mWorkers[ index ]->fTasks.empty() == false )
+          {
+            theTask = mWorkers[ index ]->fTasks.front() ;
+            mWorkers[ index ]->fTasks.pop_front() ;
+
+            theTask->fStatus    = kTaskCancelled ;
+            theTask->fStarted   = APTiming::GetNanoseconds() ;
+            theTask->fFinished  = theTask->fStarted ;
+            Finish( theTask ) ;
+            theCount += 1 ;
+          }
+      }
+
+    if ( theCount != 0 )
+      {
+        std::lock_guard< std::mutex >   theLock( mWakeLock ) ;
+        mQueued -= theCount ;
+      }
+
+  } // end CancelQueued
+
+// --------------------------
+// The first task submitted starts the pool, so a plug-in that never uses it
+// never starts its threads.  A task submitted after Stop is passed straight
+// to its done proc as cancelled.
+
+void APTaskPool::Submit( const char * inName, APTaskProc inProc, APTaskDoneProc inDoneProc, void * inData,
+                         const APCancelToken & inToken )
+  {
+    APTask *  theTask = new APTask ;
+    ASInt32   theWorker ;
+
+    theTask->fName      = inName ;
+    theTask->fProc      = inProc ;
+    theTask->fDoneProc  = inDoneProc ;
+    theTask->fData      = inData ;
+    theTask->fToken     = inToken ;
+    theTask->fStatus    = kTaskCancelled ;
+    theTask->fWorker    = -1 ;
+    theTask->fQueued    = APTiming::GetNanoseconds() ;
+    theTask->fStarted   = theTask->fQueued ;
+    theTask->fFinished  = theTask->fQueued ;
+
+    mPending += 1 ;
+
+    if ( mWorkers.empty() && ( mStopped == false ) )
+      Start( 0 ) ;
+
+    if ( mWorkers.empty() )
+      {
+        Finish( theTask ) ;
+        return ;
+      }
+
+    if ( sWorker >= 0 )
+      theWorker = sWorker ;
+    else
+      theWorker = ( mNextWorker++ & 0x7FFFFFFF ) % ( ASInt32 )mWorkers.size() ;
+
+    Push( theWorker, theTask ) ;
+
+  } // end Submit
+
+// --------------------------
+// The task is queued and the count raised together under mWakeLock, so a
+// worker that found every queue empty cannot then miss the wake up, and
+// Stop cannot set mStopping between the check and the push.  A task pushed
+// while the pool stops goes straight to its done proc as cancelled.
+
+void APTaskPool::Push( ASInt32 inWorker, APTask * inTask )
+  {
+    {
+      std::lock_guard< std::mutex >   theLock( mWakeLock ) ;
+
+      if ( mStopping )
+        {
+          Finish( inTask ) ;
+          return ;
+        }
+
+      {
+        std::lock_guard< std::mutex >   theQueueLock( mWorkers[ inWorker ]->fLock ) ;
+        mWorkers[ inWorker ]->fTasks.push_back( inTask ) ;
+      }
+
+      mQueued += 1 ;
+    }
+    mWake.notify_one() ;
+
+  } // end Push
+
+// --------------------------
+// The newest task on inWorker's own queue, otherwise the oldest task on
+// another worker's queue, starting with the next worker along so the
+// workers do not all steal from the same one.
+
+APTask * APTaskPool::Take( ASInt32 inWorker )
+  {
+    ASInt32   theNumWorkers = ( ASInt32 )mWorkers.size() ;
+    APTask *  theTask       = NULL ;
+    Worker &  theWorker     = *mWorkers[ inWorker ] ;
+
+    {
+      std::lock_guard< std::mutex >   theLock( theWorker.fLock ) ;
+
+      if ( theWorker.fTasks.empty() == false )
+        {
+          theTask = theWorker.fTasks.back() ;
+          theWorker.fTasks.pop_back() ;
+        }
+    }
+
+    for ( ASInt32 index = 1 ; ( theTask == NULL ) && ( index < theNumWorkers ) ; index++ )
+      {
+        Worker &                        theVictim = *mWorkers[ ( inWorker + index ) % theNumWorkers ] ;
+        std::lock_guard< std::mutex >   theLock( theVictim.fLock ) ;
+
+        if ( theVictim.fTasks.empty() == false )
+          {
+            theTask = theVictim.fTasks.front() ;
+            theVictim.fTasks.pop_front() ;
+            theWorker.fStolen += 1 ;
+          }
+      }
+
+    if ( theTask != NULL )
+      {
+        std::lock_guard< std::mutex >   theLock( mWakeLock ) ;
+        mQueued -= 1 ;
+      }
+
+    return theTask ;
+
+  } // end Take
+
+// --------------------------
+
+void APTaskPool::Finish( APTask * inTask )
+  {
+    std::lock_guard< std::mutex >   theLock( mDoneLock ) ;
+
+    mDone.push_back( inTask ) ;
+
+  } // end Finish
+
+// --------------------------
+// A worker thread.  A task whose token was cancelled while it waited is not
+// started; one cancelled while it ran is reported as cancelled too, since
+// it may have stopped part way.
+
+void APTaskPool::Run( ASInt32 inWorker )
+  {
+    APTask *  theTask ;
+
+    sWorker = inWorker ;
+
+    for ( ;; )
+      {
+        theTask = Take( inWorker ) ;
+
+        if ( theTask == NULL )
+          {
+            std::unique_lock< std::mutex >  theLock( mWakeLock ) ;
+
+            if ( mStopping )
+              return ;
+
+            if ( mQueued == 0 )
+              mWake.wait( theLock ) ;
+
+            continue ;
+          }
+
+        theTask->fWorker  = inWorker ;
+        theTask->fStarted = APTiming::GetNanoseconds() ;
+
+        if ( theTask->fToken.IsCancelled() == false )
+          {
+            theTask->fProc( theTask->fData, theTask->fToken ) ;
+            theTask->fStatus = theTask->fToken.IsCancelled() ? kTaskCancelled : kTaskDone ;
+            mWorkers[ inWorker ]->fRan += 1 ;
+          }
+
+        theTask->fFinished = APTiming::GetNanoseconds() ;
+
+        Finish( theTask ) ;
+      }
+
+  } // end Run
+
+// --------------------------
+// Main thread only.  At least one task is passed on per call however long
+// its done proc takes, so the queue always moves.
+
+ASInt32 APTaskPool::Drain( ASUns64 inBudget )
+  {
+    ASUns64   theStartTime = APTiming::GetNanoseconds() ;
+    ASUns64   theDoneStart ;
+    ASInt32   theCount     = 0 ;
+    APTask *  theTask ;
+
+    for ( ;; )
+      {
+        if ( ( theCount != 0 ) && ( APTiming::GetNanoseconds() - theStartTime >= inBudget ) )
+          break ;
+
+        {
+          std::lock_guard< std::mutex >   theLock( mDoneLock ) ;
+
+          if ( mDone.empty() )
+            break ;
+
+          theTask = mDone.front() ;
+          mDone.pop_front() ;
+        }
+
+        APTaskStats & theStats = mStats[ theTask->fName ] ;
+
+        theDoneStart = APTiming::GetNanoseconds() ;
+
+        if ( theTask->fDoneProc != NULL )
+          {
+            DURING
+              theTask->fDoneProc( theTask->fData, theTask->fStatus ) ;
+            HANDLER
+              APDiagnostics::Shared().Report( ERRORCODE, "finishing a background task" ) ;
+            END_HANDLER
+          }
+
+        if ( theTask->fStatus != kTaskCancelled )
+          {
+            theStats.fDone      += 1 ;
+            theStats.fWaitTime  += theTask->fStarted - theTask->fQueued ;
+            theStats.fRunTime   += theTask->fFinished - theTask->fStarted ;
+
+            if ( theTask->fFinished - theTask->fStarted > theStats.fWorstRunTime )
+              theStats.fWorstRunTime = theTask->fFinished - theTask->fStarted ;
+          }
+        else
+          theStats.fCancelled += 1 ;
+
+        theStats.fDoneTime += APTiming::GetNanoseconds() - theDoneStart ;
+
+        delete theTask ;
+        mPending  -= 1 ;
+        theCount  += 1 ;
+      }
+
+    return theCount ;
+
+  } // end Drain
+
+// --------------------------
+
+ACCB1 void ACCB2 APTaskPool::DoIdle( void * inClientData )
+  {
+    APTaskPool *  theTaskPool = ( APTaskPool * )inClientData ;
+
+    if ( theTaskPool->GetNumPending() != 0 )
+      theTaskPool->Drain( kDrainBudget ) ;
+
+  } // end DoIdle
+
+// --------------------------
+
+void APTaskPool::Write( APReport * inReport ) const
+  {
+    char    theString[ 512 ] ;
+
+    if ( inReport == NULL )
+      return ;
+
+    strcpy( theString, "Background tasks\r\n\r\n  worker       ran    stolen\r\n" ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
+
+    for ( size_t index = 0 ; index < mWorkers.size() ; index++ )
+      {
+        snprintf( theString, sizeof( theString ), "  %6d  %8d  %8d\r\n", ( int )index,
+                  ( int )mWorkers[ index ]->fRan, ( int )mWorkers[ index ]->fStolen ) ;
+        inReport->Write( theString, strlen( theString ) ) ;
+      }
+
+    strcpy( theString, "\r\n      done  cancelled  wait (ms)  run (ms)  worst run (ms)  done proc (ms)  task\r\n" ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
+
+    for ( std::map< std::string, APTaskStats >::const_iterator theIter = mStats.begin() ; theIter != mStats.end() ; ++theIter )
+      {
+        const APTaskStats &   theStats = theIter->second ;
+
+        snprintf( theString, sizeof( theString ), "  %8d  %9d  %9.3f  %8.3f  %14.3f  %14.3f  %s\r\n",
+                  ( int )theStats.fDone, ( int )theStats.fCancelled,
+                  ( theStats.fDone != 0 ) ? APTiming::ToMilliseconds( theStats.fWaitTime ) / theStats.fDone : 0.0,
+                  ( theStats.fDone != 0 ) ? APTiming::ToMilliseconds( theStats.fRunTime ) / theStats.fDone : 0.0,
+                  APTiming::ToMilliseconds( theStats.fWorstRunTime ),
+                  APTiming::ToMilliseconds( theStats.fDoneTime ), theIter->first.c_str() ) ;
+        inReport->Write( theString, strlen( theString ) ) ;
+      }
+
+  } // end Write
+
+// --------------------------
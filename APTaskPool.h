@@ -0,0 +1,192 @@
+/*
+  File:   APTaskPool.h
+
+  Contains: Runs work that does not touch Acrobat on a pool of worker
+            threads, and hands each finished task back to the main thread
+            from an idle proc.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    To run a task:
+
+      APTaskPool::Shared().Submit( "hash a file", &DoHashFile, &DoHashDone, theData, theToken ) ;
+
+    The first Submit starts the pool with Start( 0 ), so nothing runs at
+    launch; call Start yourself to choose the number of workers.
+
+    In UnloadPlugIn:
+
+      APTaskPool::Shared().Stop() ;
+
+    The done procs Stop calls get kTaskCancelled or kTaskUnloading and
+    should only free their data; the plug-in is going away.
+
+    A task proc runs on a worker thread and must not call the Acrobat SDK
+    at all: no AV, PD, Cos or AS calls, no DURING/HANDLER and no
+    APDiagnostics, since none of them are thread safe.  It must not throw
+    either.  Anything it finds out goes in its data for the done proc, which
+    runs on the main thread and may use the SDK as usual.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class APReport ;
+
+// --------------------------
+
+enum
+  {
+    kTaskDone = 0,
+    kTaskCancelled,             // cancelled before it started, or while running if the task checked
+    kTaskUnloading              // finished, but passed on by Stop; its result must not be acted on
+  } ;
+
+// --------------------------
+// Shared by every copy, so the code that submitted some tasks can cancel
+// them all with one call while the tasks check it from their threads.
+
+class APCancelToken
+  {
+    public:
+      APCancelToken() : mCancelled( std::make_shared< std::atomic< bool > >( false ) ) {}
+
+      void          Cancel( void ) { mCancelled->store( true ) ; }
+      bool          IsCancelled( void ) const { return mCancelled->load() ; }
+
+    private:
+      std::shared_ptr< std::atomic< bool > >    mCancelled ;
+  } ;
+
+// --------------------------
+
+typedef void ( * APTaskProc )( void * inData, const APCancelToken & inToken ) ;     // on a worker thread
+typedef void ( * APTaskDoneProc )( void * inData, ASInt32 inStatus ) ;              // on the main thread
+
+struct APTask
+  {
+    const char *      fName ;         // a literal; tasks are timed together by name
+    APTaskProc        fProc ;
+    APTaskDoneProc    fDoneProc ;
+    void *            fData ;
+    APCancelToken     fToken ;
+    ASInt32           fStatus ;
+    ASInt32           fWorker ;       // that ran it, -1 when it never ran
+    ASUns64           fQueued ;       // nanoseconds, APTiming
+    ASUns64           fStarted ;
+    ASUns64           fFinished ;
+  } ;
+
+struct APTaskStats
+  {
+    ASInt32           fDone ;
+    ASInt32           fCancelled ;
+    ASUns64           fWaitTime ;     // queued until started, over fDone
+    ASUns64           fRunTime ;      // started until finished, over fDone
+    ASUns64           fWorstRunTime ;
+    ASUns64           fDoneTime ;     // in the done proc, over fDone + fCancelled
+  } ;
+
+// --------------------------
+// One per plug-in, through APTaskPool::Shared().  Each worker has its own
+// queue: tasks submitted from the main thread are dealt to the queues in
+// turn, a task submitted from a worker goes on that worker's queue, and a
+// worker whose queue is empty takes the oldest task from another's.  A
+// worker runs its own newest task first, as that one's data is most likely
+// still in its cache.
+//
+// Finished tasks wait in a completion queue until the idle proc passes them
+// to their done procs on the main thread, a few milliseconds' worth per
+// idle so a burst of completions cannot make Acrobat stutter.
+
+class APTaskPool
+  {
+    public:
+      APTaskPool() ;
+      ~APTaskPool() ;
+
+      static APTaskPool &   Shared( void ) ;
+
+      // 0 workers is one fewer than the number of processors, and at least one;
+      // Submit calls Start( 0 ) when the pool has not been started
+      ASBool        Start( ASInt32 inNumWorkers ) ;
+      void          Stop( void ) ;
+
+      void          Submit( const char * inName, APTaskProc inProc, APTaskDoneProc inDoneProc, void * inData,
+                            const APCancelToken & inToken ) ;
+
+      // passes finished tasks to their done procs until inBudget nanoseconds have gone; the number passed
+      ASInt32       Drain( ASUns64 inBudget ) ;
+
+      ASInt32       GetNumWorkers( void ) const { return ( ASInt32 )mWorkers.size() ; }
+      ASInt32       GetNumPending( void ) const { return mPending.load() ; }
+
+      // true from the start of Stop, while the last done procs are called
+      ASBool        IsStopped( void ) const { return mStopped ; }
+
+      void          Write( APReport * inReport ) const ;
+
+      static ACCB1 void ACCB2 DoIdle( void * inClientData ) ;
+
+    private:
+      struct Worker
+        {
+          std::mutex              fLock ;
+          std::deque< APTask * >  fTasks ;
+          std::thread             fThread ;
+          std::atomic< ASInt32 >  fRan ;
+          std::atomic< ASInt32 >  fStolen ;     // tasks taken from another worker's queue
+        } ;
+
+      void          Push( ASInt32 inWorker, APTask * inTask ) ;
+      APTask *      Take( ASInt32 inWorker ) ;
+      void          CancelQueued( void ) ;
+      void          Finish( APTask * inTask ) ;
+      void          Run( ASInt32 inWorker ) ;
+
+      std::vector< std::unique_ptr< Worker > >  mWorkers ;
+      std::atomic< ASInt32 >                    mNextWorker ;
+      std::atomic< ASInt32 >                    mPending ;      // submitted and not yet passed to its done proc
+
+      // workers with nothing to do wait here
+      std::mutex                                mWakeLock ;
+      std::condition_variable                   mWake ;
+      ASInt32                                   mQueued ;       // under mWakeLock
+      bool                                      mStopping ;     // under mWakeLock
+      bool                                      mStopped ;      // main thread only; Submit no longer starts the pool
+
+      std::mutex                                mDoneLock ;
+      std::deque< APTask * >                    mDone ;
+
+      // main thread only
+      std::map< std::string, APTaskStats >      mStats ;
+      AVIdleProc                                mIdleProc ;
+
+      APTaskPool( const APTaskPool & ) ;
+      APTaskPool & operator=( const APTaskPool & ) ;
+  } ;
+
+// --------------------------
@@ -0,0 +1,49 @@
+/*
+  File:   APTiming.h
+
+  Contains: Monotonic high resolution clock used to time plug-in operations.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include <chrono>
+
+// --------------------------
+// ASGetSecs only has a resolution of one second, which is far too coarse for
+// timing callbacks, so the plug-ins use the C++ steady clock instead.
+
+class APTiming
+  {
+    public:
+      // nanoseconds from an arbitrary, fixed origin
+      static ASUns64 GetNanoseconds( void )
+        {
+          return ( ASUns64 )std::chrono::duration_cast< std::chrono::nanoseconds >(
+                                std::chrono::steady_clock::now().time_since_epoch() ).count() ;
+        }
+
+      static double ToMilliseconds( ASUns64 inNanoseconds )
+        {
+          return ( double )inNanoseconds / 1000000.0 ;
+        }
+
+      static double ToMicroseconds( ASUns64 inNanoseconds )
+        {
+          return ( double )inNanoseconds / 1000.0 ;
+        }
+  } ;
+
+// --------------------------
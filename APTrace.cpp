@@ -0,0 +1,112 @@
+/*
+  File:   APTrace.cpp
+
+  Contains: In-memory event tracer built on a fixed-size ring buffer.
+            Callbacks record begin and end events; the ring is written as
+            a Chrome trace (chrome://tracing, Perfetto) on demand.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "APReport.h"
+#include "APTiming.h"
+#include "APTrace.h"
+
+// --------------------------
+
+APTrace::APTrace()
+  : mNext( 0 )
+  {
+    memset( mEvents, 0, sizeof( mEvents ) ) ;
+
+  } // end APTrace
+
+// --------------------------
+// One ring per plug-in.
+
+APTrace & APTrace::Shared( void )
+  {
+    static APTrace  sTrace ;
+
+    return sTrace ;
+
+  } // end Shared
+
+// --------------------------
+
+ASUns32 APTrace::GetThreadIndex( void )
+  {
+    static std::atomic< ASUns32 >   sNumThreads( 0 ) ;
+    static thread_local ASUns32     sThreadIndex = 0 ;
+
+    if ( sThreadIndex == 0 )
+      sThreadIndex = sNumThreads.fetch_add( 1, std::memory_order_relaxed ) + 1 ;
+
+    return sThreadIndex ;
+
+  } // end GetThreadIndex
+
+// --------------------------
+// The Chrome trace event format: one object per event, times in microseconds
+// from the oldest event written.  A metadata event names the process after
+// the plug-in so traces from several plug-ins can be loaded side by side.
+
+ASBool APTrace::Write( const char * inFileName, const char * inProcessName ) const
+  {
+    char          theString[ 256 ] ;
+    ASUns32       theEnd    = mNext.load( std::memory_order_acquire ) ;
+    ASUns32       theFirst  = ( theEnd > kTraceCapacity ) ? theEnd - kTraceCapacity : 0 ;
+    ASUns64       theOrigin = ( theEnd != 0 ) ? mEvents[ theFirst & ( kTraceCapacity - 1 ) ].fTime : 0 ;
+
+    APReport *  theLog = new APReport( inFileName ) ;
+    if ( theLog == NULL )
+      return false ;
+
+    snprintf( theString, sizeof( theString ),
+              "{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"%s\"}}",
+              inProcessName ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    for ( ASUns32 index = theFirst ; index != theEnd ; index++ )
+      {
+        const Event & theEvent = mEvents[ index & ( kTraceCapacity - 1 ) ] ;
+
+        if ( theEvent.fName == NULL )
+          continue ;
+
+        snprintf( theString, sizeof( theString ), ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                  theEvent.fName, theEvent.fPhase,
+                  APTiming::ToMicroseconds( ( theEvent.fTime > theOrigin ) ? theEvent.fTime - theOrigin : 0 ),
+                  ( unsigned int )theEvent.fThread ) ;
+        theLog->Write( theString, strlen( theString ) ) ;
+      }
+
+    snprintf( theString, sizeof( theString ), "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"recorded\":%u,\"capacity\":%u}}\n",
+              ( unsigned int )theEnd, ( unsigned int )kTraceCapacity ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    delete( theLog ) ;
+
+    return true ;
+
+  } // end Write
+
+// --------------------------
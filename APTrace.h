@@ -0,0 +1,123 @@
+/*
+  File:   APTrace.h
+
+  Contains: In-memory event tracer built on a fixed-size ring buffer.
+            Callbacks record begin and end events; the ring is written as
+            a Chrome trace (chrome://tracing, Perfetto) on demand.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    Put a scope at the top of a callback, outside any DURING block, so the
+    end event is recorded however the function returns:
+
+      static ACCB1 void ACCB2 DoAVDocDidOpen( AVDoc inAVDoc, ASInt32 outError, void *data )
+        {
+          APTraceScope  theTraceScope( "AVDocDidOpen" ) ;
+          ...
+        }
+
+    and write the ring from a menu command:
+
+      APTrace::Shared().Write( "TriStateTrace.json", "TriState" ) ;
+
+    Names are kept by pointer, so they must be string literals or otherwise
+    live for as long as the plug-in.
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+
+#include <atomic>
+
+#include "APTiming.h"
+
+// --------------------------
+
+#define kTraceCapacity    16384   // events kept; must be a power of two
+
+#define kTracePhaseBegin  'B'
+#define kTracePhaseEnd    'E'
+
+// --------------------------
+// Recording takes one relaxed atomic increment and a clock read, with no lock
+// and no allocation, so it may be called from any thread.  Once the ring is
+// full the oldest events are overwritten.  Write is meant for the main thread;
+// an event being recorded on another thread while the ring is written may
+// come out half updated.
+
+class APTrace
+  {
+    public:
+      APTrace() ;
+
+      static APTrace &  Shared( void ) ;
+
+      void          Begin( const char * inName ) { Record( inName, kTracePhaseBegin ) ; }
+      void          End( const char * inName ) { Record( inName, kTracePhaseEnd ) ; }
+
+      void          Record( const char * inName, char inPhase )
+        {
+          Event & theEvent = mEvents[ mNext.fetch_add( 1, std::memory_order_relaxed ) & ( kTraceCapacity - 1 ) ] ;
+
+          theEvent.fTime    = APTiming::GetNanoseconds() ;
+          theEvent.fName    = inName ;
+          theEvent.fThread  = GetThreadIndex() ;
+          theEvent.fPhase   = inPhase ;
+        }
+
+      // writes the events still in the ring; false when the file could not be created
+      ASBool        Write( const char * inFileName, const char * inProcessName ) const ;
+
+      ASUns32       GetNumRecorded( void ) const { return mNext.load( std::memory_order_relaxed ) ; }
+
+      // small, stable number for the calling thread; the first thread to ask is 1
+      static ASUns32  GetThreadIndex( void ) ;
+
+    private:
+      struct Event
+        {
+          ASUns64         fTime ;
+          const char *    fName ;
+          ASUns32         fThread ;
+          char            fPhase ;
+        } ;
+
+      std::atomic< ASUns32 >  mNext ;
+      Event                   mEvents[ kTraceCapacity ] ;
+
+      APTrace( const APTrace & ) ;
+      APTrace & operator=( const APTrace & ) ;
+  } ;
+
+// --------------------------
+// Records a begin event when created and the matching end event when it goes
+// out of scope.  A longjmp out of the function, i.e. an exception that is not
+// caught in the same function, skips the end event.
+
+class APTraceScope
+  {
+    public:
+      explicit APTraceScope( const char * inName ) : mName( inName ) { APTrace::Shared().Begin( inName ) ; }
+      ~APTraceScope() { APTrace::Shared().End( mName ) ; }
+
+    private:
+      const char *  mName ;
+
+      APTraceScope( const APTraceScope & ) ;
+      APTraceScope & operator=( const APTraceScope & ) ;
+  } ;
+
+// --------------------------
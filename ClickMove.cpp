@@ -44,6 +44,41 @@ extern HINSTANCE gHINSTANCE ;
 #include "TASUtils.h"
 #include "TAVUtils.h"
 
+#include <stdio.h>
+#include <string.h>
+
+#include "APTiming.h"
+#include "APMenuInstaller.h"
+#include "APDiagnostics.h"
+#include "APTrace.h"
+#include "APBenchmark.h"
+#include "APEventLog.h"
+#include "APNotifier.h"
+#include "APNavCache.h"
+#include "APPlaylist.h"
+#include "APReport.h"
+#include "LoadProfilerHFT.h"
+
+// --------------------------
+
+HFT       gLoadProfilerHFT  = NULL ;
+ASUns64   gHandshakeTime    = 0 ;
+
+// clicks recorded for replay; a replay runs as if in full screen mode
+#define kEventLogFileName   "ClickMoveEvents.bin"
+
+APEventLog  gEventLog ;
+ASBool      gReplaying        = false ;
+
+// each page view's page count and the pages the presenter went to
+APNavCache  gNavCache ;
+
+// decks presented one after another, the next one made ready at idle time
+#define kPlaylistFileName   "ClickMovePlaylist.txt"
+#define kPreloadTicks       10      // 1/6 second
+
+APPlaylist  gPlaylist ;
+
 // --------------------------
 // Display the About box for the ClickMove plug-in
 
@@ -57,98 +92,448 @@ static ACCB1 void ACCB2 DoAboutClickMove( void * data )
   } // end DoAboutClickMove
 
 // --------------------------
+// In playlist mode the last page of a deck goes on to the first page of the
+// next deck, and the first page back to the last page of the deck before.
+// False when inAVPageView is not showing a deck with one in that direction.
+
+static ASBool GoToDeck( AVPageView inAVPageView, ASInt32 inStep )
+  {
+    ASInt32   theDeck ;
+
+    if ( ( gPlaylist.IsActive() == false ) || ( gReplaying == true ) )
+      return false ;
+
+    theDeck = gPlaylist.Find( AVPageViewGetAVDoc( inAVPageView ) ) ;
+    if ( ( theDeck == kPlaylistNoDeck ) || ( theDeck + inStep < 0 ) || ( theDeck + inStep >= gPlaylist.GetNumDecks() ) )
+      return false ;
+
+    gPlaylist.Show( theDeck + inStep, ( inStep > 0 ) ? 0 : kPlaylistLastPage ) ;
+
+    return true ;
+
+  } // end GoToDeck
+
+// --------------------------
+// The page count comes from the navigation cache; only the current page is
+// asked for, since the presenter may also have moved with the keyboard.
+// Shift-click and Shift-double-click step through the pages ClickMove went
+// to, rather than through every view change Acrobat keeps.
 
 static ACCB1 ASBool ACCB2 DoAVPageViewClickProc ( AVPageView inAVPageView, ASInt16 x, ASInt16 y, 
                                                   ASInt16 inFlags, ASInt16 inClickNumber, void * data )
   {
-    AVDoc         theAVDoc ;
-    PDDoc         thePDDoc ;
     ASInt32       thePageNumber ;
     ASInt32       theTotalPages ;
+    ASBool        theFromHistory  = false ;
     ASBool        bResult ;
+    APTraceScope  theTraceScope( "AVPageViewClick" ) ;
     
     if ( inAVPageView == NULL )
       return false ;
     
     DURING
     
-      bResult = AVAppDoingFullScreen() ;
+      bResult = gReplaying || AVAppDoingFullScreen() ;
       if ( bResult == false )
         E_RETURN( false ) ;
+
+      if ( gEventLog.IsRecording() )
+        gEventLog.Record( kLoggedPageViewClick, AVPageViewGetAVDoc ( inAVPageView ), inFlags, inClickNumber, x, y ) ;
         
+      APNavRecord & theRecord = gNavCache.Get( inAVPageView ) ;
+
       thePageNumber = AVPageViewGetPageNum ( inAVPageView ) ;
-      
-      theAVDoc = AVPageViewGetAVDoc ( inAVPageView ) ;
-      thePDDoc = AVDocGetPDDoc( theAVDoc ) ;
-      
-      theTotalPages = PDDocGetNumPages ( thePDDoc ) ;
+      theTotalPages = theRecord.fNumPages ;
+
+      // a page reached some other way joins the history before moving on from it
+      theRecord.fHistory.Visit( thePageNumber ) ;
       
       switch ( inClickNumber )
         {
           case 1 :
             if ( inFlags & AV_SHIFT )
-              AVPageViewGoForward ( inAVPageView ) ;
-            else
               {
-                if ( thePageNumber + 1 == theTotalPages )
-                  thePageNumber = 0 ;
-                else
-                  thePageNumber += 1 ;
-                AVPageViewGoTo ( inAVPageView, thePageNumber ) ;
+                if ( theRecord.fHistory.Forward( thePageNumber ) == false )
+                  E_RETURN( true ) ;
+                theFromHistory = true ;
               }
-            E_RETURN( true ) ;
+            else if ( thePageNumber + 1 == theTotalPages )
+              {
+                if ( GoToDeck( inAVPageView, 1 ) )
+                  E_RETURN( true ) ;
+                thePageNumber = 0 ;
+              }
+            else
+              thePageNumber += 1 ;
             break ;
       
           case 2 :
             if ( inFlags & AV_SHIFT )
-              AVPageViewGoBack ( inAVPageView ) ;
-            else
               {
-                if ( thePageNumber == 0 )
-                  thePageNumber = theTotalPages - 1 ;
-                else
-                  thePageNumber -= 1 ;
-                AVPageViewGoTo ( inAVPageView, thePageNumber ) ;
+                if ( theRecord.fHistory.Back( thePageNumber ) == false )
+                  E_RETURN( true ) ;
+                theFromHistory = true ;
+              }
+            else if ( thePageNumber == 0 )
+              {
+                if ( GoToDeck( inAVPageView, -1 ) )
+                  E_RETURN( true ) ;
+                thePageNumber = theTotalPages - 1 ;
               }
-            E_RETURN( true ) ;
+            else
+              thePageNumber -= 1 ;
             break ;
             
           case 3 :
             if ( inFlags & AV_SHIFT )
-              AVPageViewGoTo ( inAVPageView, 0 ) ;
+              thePageNumber = 0 ;
             else
-              AVPageViewGoTo ( inAVPageView, theTotalPages - 1 ) ;
-            E_RETURN( true ) ;
+              thePageNumber = theTotalPages - 1 ;
             break ;
 
+          default :
+            E_RETURN( false ) ;
+
         } // end switch
 
+      // a page in the history may have been deleted since it was visited
+      if ( thePageNumber >= theTotalPages )
+        thePageNumber = theTotalPages - 1 ;
+
+      if ( theFromHistory == false )
+        theRecord.fHistory.Visit( thePageNumber ) ;
+
+      AVPageViewGoTo ( inAVPageView, thePageNumber ) ;
+
+      E_RETURN( true ) ;
+
     HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "moving to the clicked page" ) ;
     END_HANDLER
   
     return false ;
     
   } // end DoAVPageViewClickProc
 
+// --------------------------
+// Pages inserted or deleted, here or by another plug-in, change the count.
+
+static void DoPagesChanged( const APNotification & inNotification, void * data )
+  {
+    gNavCache.PagesChanged( inNotification.fPDDoc ) ;
+
+  } // end DoPagesChanged
+
+// --------------------------
+
+static void DoAVDocWillClose( const APNotification & inNotification, void * data )
+  {
+    gNavCache.DocWillClose( inNotification.fAVDoc ) ;
+    gPlaylist.DocWillClose( inNotification.fAVDoc ) ;
+
+  } // end DoAVDocWillClose
+
+// -------------------------
+#pragma mark -- playlist
+// -------------------------
+// Turn playlist mode on for the front document, reading the decks that
+// follow it from ClickMovePlaylist.txt in its folder, or turn it off.
+
+static ACCB1 void ACCB2 DoPlaylist( void * data )
+  {
+    if ( gPlaylist.IsActive() )
+      {
+        gPlaylist.Clear() ;
+        return ;
+      }
+
+    DURING
+      if ( gPlaylist.Load( AVAppGetActiveDoc(), kPlaylistFileName ) == 0 )
+        APDiagnostics::Shared().Report( 0, "reading " kPlaylistFileName " from the front document's folder" ) ;
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "starting the playlist" ) ;
+    END_HANDLER
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoPlaylist
+
+// --------------------------
+
+static ACCB1 ASBool ACCB2 IsPlaylistActive( void * data )
+  {
+    return gPlaylist.IsActive() ;
+
+  } // end IsPlaylistActive
+
+// --------------------------
+// Idle proc: while a deck is in front, close what is no longer near it and
+// take one step towards having the next deck open with its first page drawn,
+// so the click that moves on only has to give it a window.
+
+static ACCB1 void ACCB2 DoPlaylistIdle( void * data )
+  {
+    ASInt32   theDeck ;
+
+    if ( ( gPlaylist.IsActive() == false ) || ( gReplaying == true ) )
+      return ;
+
+    theDeck = gPlaylist.Find( AVAppGetActiveDoc() ) ;
+    if ( theDeck == kPlaylistNoDeck )
+      return ;
+
+    APTraceScope  theTraceScope( "PlaylistIdle" ) ;
+
+    DURING
+      gPlaylist.CloseOutside( theDeck ) ;
+      gPlaylist.Preload( theDeck + 1 ) ;
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "getting the next deck ready" ) ;
+    END_HANDLER
+
+  } // end DoPlaylistIdle
+
+// -------------------------
+#pragma mark -- event recording
+// -------------------------
+// Turn recording on before going to full screen; every click ClickMove acts
+// on is recorded until it is turned off again.
+
+static ACCB1 void ACCB2 DoRecordClicks( void * data )
+  {
+    if ( gEventLog.IsRecording() == false )
+      {
+        gEventLog.Start() ;
+        return ;
+      }
+
+    gEventLog.Stop() ;
+
+    if ( gEventLog.Save( kEventLogFileName ) == false )
+      APDiagnostics::Shared().Report( 0, "saving the recorded clicks to " kEventLogFileName ) ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoRecordClicks
+
+// --------------------------
+
+static ACCB1 ASBool ACCB2 IsRecordingClicks( void * data )
+  {
+    return gEventLog.IsRecording() ;
+
+  } // end IsRecordingClicks
+
+// --------------------------
+// Called through APBenchmark::Replay, so inIteration is the event's place
+// in the recording and each event is fed in once, in order.
+
+static void ReplayClick( void * inData, ASInt32 inIteration )
+  {
+    const APLoggedEvent &   theEvent  = gEventLog.GetEvent( inIteration ) ;
+    AVDoc                   theAVDoc  = gEventLog.GetReplayDoc( theEvent.fDoc ) ;
+
+    if ( ( theEvent.fKind != kLoggedPageViewClick ) || ( theAVDoc == NULL ) )
+      return ;
+
+    DoAVPageViewClickProc( AVDocGetPageView( theAVDoc ), theEvent.fX, theEvent.fY, theEvent.fArg, theEvent.fClickNumber, NULL ) ;
+
+  } // end ReplayClick
+
+// --------------------------
+// Feed the last recording into the click proc as fast as it takes it, as if
+// in full screen mode, and write the time each click took to
+// ClickMoveReplay.txt.  The front document is put back on its page afterwards.
+
+static ACCB1 void ACCB2 DoReplayClicks( void * data )
+  {
+    APBenchmark   theBenchmark ;
+    char          theString[ 256 ] ;
+    AVDoc         theAVDoc      = AVAppGetActiveDoc() ;
+    ASInt32       thePageNumber ;
+    ASInt32       theNumDocs ;
+
+    if ( theAVDoc == NULL )
+      return ;
+
+    thePageNumber = AVPageViewGetPageNum( AVDocGetPageView( theAVDoc ) ) ;
+
+    DURING
+
+      if ( gEventLog.Load( kEventLogFileName ) == false )
+        APDiagnostics::Shared().Report( 0, "reading the recorded clicks from " kEventLogFileName ) ;
+      else if ( gEventLog.GetNumEvents() == 0 )
+        APDiagnostics::Shared().Report( 0, "no clicks were recorded" ) ;
+      else if ( ( theNumDocs = gEventLog.BeginReplay() ) != 0 )
+        {
+          gReplaying = true ;
+          theBenchmark.Replay( "replayed click", gEventLog.GetNumEvents(), &ReplayClick, NULL ) ;
+          gReplaying = false ;
+
+          APReport *  theLog = new APReport( "ClickMoveReplay.txt" ) ;
+          if ( theLog != NULL )
+            {
+              snprintf( theString, sizeof( theString ), "%d clicks replayed against %d open documents\r\n\r\n",
+                        ( int )gEventLog.GetNumEvents(), ( int )theNumDocs ) ;
+              theLog->Write( theString, strlen( theString ) ) ;
+
+              theBenchmark.Write( theLog ) ;
+              delete( theLog ) ;
+            }
+        }
+
+    HANDLER
+      gReplaying = false ;
+      APDiagnostics::Shared().Report( ERRORCODE, "replaying the recorded clicks" ) ;
+    END_HANDLER
+
+    AVPageViewGoTo( AVDocGetPageView( theAVDoc ), thePageNumber ) ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoReplayClicks
+
+// -------------------------
+#pragma mark -- benchmarks
+// -------------------------
+// The menu cannot be reached in full screen mode, where the click proc does
+// its work, so its full screen path is also timed in its two parts: finding
+// the target page and going to it.  Odd calls step back, so every benchmark
+// ends on the page it started on.
+
+static void BenchClick( void * inData, ASInt32 inIteration )
+  {
+    DoAVPageViewClickProc( ( AVPageView )inData, 0, 0, 0, ( inIteration & 1 ) ? 2 : 1, NULL ) ;
+
+  } // end BenchClick
+
+// --------------------------
+
+static void BenchFindTarget( void * inData, ASInt32 inIteration )
+  {
+    AVPageView    theAVPageView = ( AVPageView )inData ;
+    ASInt32       thePageNumber ;
+    ASInt32       theTotalPages ;
+
+    thePageNumber = AVPageViewGetPageNum ( theAVPageView ) ;
+    theTotalPages = PDDocGetNumPages ( AVDocGetPDDoc( AVPageViewGetAVDoc ( theAVPageView ) ) ) ;
+
+    if ( thePageNumber >= theTotalPages )   // keeps the queries from being optimized away
+      AVSysBeep( 0 ) ;
+
+  } // end BenchFindTarget
+
+// --------------------------
+
+static void BenchFindTargetCached( void * inData, ASInt32 inIteration )
+  {
+    AVPageView    theAVPageView = ( AVPageView )inData ;
+    ASInt32       thePageNumber ;
+    ASInt32       theTotalPages ;
+
+    thePageNumber = AVPageViewGetPageNum ( theAVPageView ) ;
+    theTotalPages = gNavCache.Get( theAVPageView ).fNumPages ;
+
+    if ( thePageNumber >= theTotalPages )
+      AVSysBeep( 0 ) ;
+
+  } // end BenchFindTargetCached
+
+// --------------------------
+
+static void BenchGoTo( void * inData, ASInt32 inIteration )
+  {
+    AVPageView    theAVPageView = ( AVPageView )inData ;
+    ASInt32       thePageNumber = AVPageViewGetPageNum ( theAVPageView ) ;
+
+    AVPageViewGoTo ( theAVPageView, ( inIteration & 1 ) ? thePageNumber - 1 : thePageNumber + 1 ) ;
+
+  } // end BenchGoTo
+
+// --------------------------
+// Write the cost per click to ClickMoveBenchmark.txt.
+
+static ACCB1 void ACCB2 DoClickMoveBenchmark( void * data )
+  {
+    APBenchmark   theBenchmark ;
+    char          theString[ 512 ] ;
+    AVDoc         theAVDoc      = AVAppGetActiveDoc() ;
+    AVPageView    theAVPageView ;
+
+    if ( theAVDoc == NULL )
+      return ;
+
+    DURING
+
+      theAVPageView = AVDocGetPageView( theAVDoc ) ;
+
+      theBenchmark.Run( AVAppDoingFullScreen() ? "AVPageViewClick, full screen" : "AVPageViewClick, not full screen",
+                        100000, &BenchClick, theAVPageView ) ;
+      theBenchmark.Run( "find the target page, asking Acrobat", 100000, &BenchFindTarget, theAVPageView ) ;
+      theBenchmark.Run( "find the target page, navigation cache", 100000, &BenchFindTargetCached, theAVPageView ) ;
+
+      if ( PDDocGetNumPages( AVDocGetPDDoc( theAVDoc ) ) > AVPageViewGetPageNum( theAVPageView ) + 1 )
+        theBenchmark.Run( "go to the next or previous page", 1000, &BenchGoTo, theAVPageView ) ;
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "running the ClickMove benchmarks" ) ;
+    END_HANDLER
+
+    APReport *  theLog = new APReport( "ClickMoveBenchmark.txt" ) ;
+    if ( theLog != NULL )
+      {
+        theBenchmark.Write( theLog ) ;
+
+        // switches the presenter made, so only filled in after a playlist was used
+        snprintf( theString, sizeof( theString ), "\r\nPlaylist deck switches, click to first frame\r\n\r\n   switches  mean (ms)\r\n  %9d  %9.3f  opened ahead of time\r\n  %9d  %9.3f  opened on the click\r\n",
+                  ( int )gPlaylist.GetNumSwitches( true ),
+                  ( gPlaylist.GetNumSwitches( true ) != 0 ) ? APTiming::ToMilliseconds( gPlaylist.GetSwitchTime( true ) ) / gPlaylist.GetNumSwitches( true ) : 0.0,
+                  ( int )gPlaylist.GetNumSwitches( false ),
+                  ( gPlaylist.GetNumSwitches( false ) != 0 ) ? APTiming::ToMilliseconds( gPlaylist.GetSwitchTime( false ) ) / gPlaylist.GetNumSwitches( false ) : 0.0 ) ;
+        theLog->Write( theString, strlen( theString ) ) ;
+
+        delete( theLog ) ;
+      }
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoClickMoveBenchmark
+
+// --------------------------
+// Write the events in the trace ring to ClickMoveTrace.json.
+
+static ACCB1 void ACCB2 DoWriteTrace( void * data )
+  {
+    if ( APTrace::Shared().Write( "ClickMoveTrace.json", "ClickMove" ) == false )
+      APDiagnostics::Shared().Report( 0, "writing ClickMoveTrace.json" ) ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoWriteTrace
+
 // -------------------------
 #pragma mark -- init
 // -------------------------
 
+static const APMenuItemSpec gMenuItemSpecs[] =
+  {
+    { "ClickMove...",               "DGAP:DoAboutClickMove",      "AboutExtensions", NULL, NO_SHORTCUT, 0, NULL,                     NULL, NULL,               &DoAboutClickMove,     NULL },
+    { "ClickMove Trace...",         "DGAP:ClickMoveTrace",        "Extensions",      NULL, NO_SHORTCUT, 0, NULL,                     NULL, NULL,               &DoWriteTrace,         NULL },
+    { "ClickMove Benchmark...",     "DGAP:ClickMoveBenchmark",    "Extensions",      NULL, NO_SHORTCUT, 0, TAVUtils::ComputeEnabled, NULL, NULL,               &DoClickMoveBenchmark, NULL },
+    { "ClickMove Record Clicks",    "DGAP:ClickMoveRecordClicks", "Extensions",      NULL, NO_SHORTCUT, 0, NULL,                     NULL, &IsRecordingClicks, &DoRecordClicks,       NULL },
+    { "ClickMove Replay Clicks...", "DGAP:ClickMoveReplayClicks", "Extensions",      NULL, NO_SHORTCUT, 0, TAVUtils::ComputeEnabled, NULL, NULL,               &DoReplayClicks,       NULL },
+    { "ClickMove Playlist",         "DGAP:ClickMovePlaylist",     "Extensions",      NULL, NO_SHORTCUT, 0, TAVUtils::ComputeEnabled, NULL, &IsPlaylistActive,  &DoPlaylist,           NULL }
+  } ;
+
 static ACCB1 boolean ACCB2 InitPlugInMenus( void )
   {
-    AVMenubar     theAVMenubar ;
-    
     DURING
     
-      theAVMenubar  = AVAppGetMenubar() ;   // get the main menu
-      if ( ! theAVMenubar ) 
+      if ( APMenuInstaller::Install( gMenuItemSpecs, APMenuItemCount( gMenuItemSpecs ), NULL, NULL ) == 0 )
         E_RETURN( false ) ;
-        
-      TAVUtils::AppendToAboutMenu( "ClickMove...", "DGAP:DoAboutClickMove", &DoAboutClickMove ) ;
       
     HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "installing the ClickMove menu items" ) ;
     END_HANDLER
     
     return true ;
@@ -161,10 +546,15 @@ static ACCB1 boolean ACCB2 InitPlugIn( void )
   {
     boolean   theResult ;
     
+    LoadProfilerMark( kLoadPhaseInitStart, APTiming::GetNanoseconds() ) ;
+
     theResult = InitPlugInMenus() ;
-    if ( theResult == false )
-      return theResult ;
-      
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+    // on failure too, so a failed init is still ranked by what it cost
+    LoadProfilerMark( kLoadPhaseInitEnd, APTiming::GetNanoseconds() ) ;
+
     return theResult ;
     
   } // end InitPlugIn
@@ -173,6 +563,10 @@ static ACCB1 boolean ACCB2 InitPlugIn( void )
 
 static ACCB1 boolean ACCB2 UnloadPlugIn( void )
   {
+    APNotifier::Shared().UnregisterAll() ;
+    gPlaylist.Clear() ;
+    APDiagnostics::Shared().Close() ;
+
     return true ;
     
   } // end UnloadPlugIn
@@ -187,9 +581,24 @@ static ACCB1 boolean ACCB2 UnloadPlugIn( void )
 
 static ACCB1 boolean ACCB2 PreInitPlugIn( void )
   {
+    ASUns64   theImportStart = APTiming::GetNanoseconds() ;
+
+    APDiagnostics::Shared().SetLogName( "ClickMoveDiagnostics.txt" ) ;
+
+    gLoadProfilerHFT = ASExtensionMgrGetHFT( ASAtomFromString( kLoadProfilerHFTName ), kLoadProfilerHFTVersion ) ;
 
     AVAppRegisterForPageViewClicks ( ASCallbackCreateProto( AVPageViewClickProc, ( void * )DoAVPageViewClickProc ), NULL ) ;
 
+    APNotifier::Shared().Subscribe( kNotifyPDDocDidInsertPages, kNotifyAllChanges, "DoPagesChanged", &DoPagesChanged, NULL ) ;
+    APNotifier::Shared().Subscribe( kNotifyPDDocDidDeletePages, kNotifyAllChanges, "DoPagesChanged", &DoPagesChanged, NULL ) ;
+    APNotifier::Shared().Subscribe( kNotifyDocWillClose,        kNotifyAllChanges, "DoAVDocWillClose", &DoAVDocWillClose, NULL ) ;
+
+    AVAppRegisterIdleProc( ASCallbackCreateProto( AVIdleProc, &DoPlaylistIdle ), NULL, kPreloadTicks ) ;
+
+    LoadProfilerMark( kLoadPhaseHandshake, gHandshakeTime ) ;
+    LoadProfilerMark( kLoadPhaseImportStart, theImportStart ) ;
+    LoadProfilerMark( kLoadPhaseImportEnd, APTiming::GetNanoseconds() ) ;
+
     return true ;
     
   } // end PreInitPlugIn
@@ -198,6 +607,8 @@ static ACCB1 boolean ACCB2 PreInitPlugIn( void )
 
 ACCB1 boolean ACCB2 PIHandshake( Uns32 handshakeVersion, void *handshakeData )
   {
+    gHandshakeTime = APTiming::GetNanoseconds() ;
+
     if ( handshakeVersion == HANDSHAKE_V0200 )
       {
         PIHandshakeData_V0200 *hsData = ( PIHandshakeData_V0200 * )handshakeData ;
@@ -38,12 +38,42 @@ extern HINSTANCE gHINSTANCE ;
 #include "TASUtils.h"
 #include "TAVUtils.h"
 
+#include <stdio.h>
+#include <string.h>
+
 #include "APReport.h"
+#include "APMenuInstaller.h"
+#include "APMenuIndex.h"
+#include "APCommandPalette.h"
+#include "APMenuWatch.h"
+#include "APHandle.h"
+#include "APNotifier.h"
+#include "APDiagnostics.h"
+#include "APTrace.h"
+#include "APBenchmark.h"
+#include "ListMenuNamesHFT.h"
+#include "APTiming.h"
+#include "LoadProfilerHFT.h"
+
+// --------------------------
+
+#define kMaxPaletteMatches      12
+#define kMaxPaletteQuery        64
+#define kPalettePrompt          "Type part of a command's title or name:"
 
 // --------------------------
 
 ASAtom  gProductASAtom ;
 
+HFT               gListMenuNamesHFT   = NULL ;
+HFT               gLoadProfilerHFT    = NULL ;
+ASUns64           gHandshakeTime      = 0 ;
+APMenuIndex       gMenuIndex ;
+APCommandPalette  gCommandPalette ;
+APMenuWatch       gMenuWatch ;
+
+AVMenu            gPaletteAVMenu      = NULL ;    // the pop-up of matches while it is being shown
+
 // --------------------------
 // Display the About box for the Print Page plug-in
 
@@ -61,15 +91,13 @@ static ACCB1 void ACCB2 DoAboutListMenuNames( void * data )
 static ACCB1 void ACCB2 ListMenu( AVMenubar inAVMenubar, const char * inMenuName, APReport* inReport )
   { 
     char            theString[256] ;
-    AVMenu          theAVMenu       = ( AVMenu )NULL ;
-    AVMenuItem      theAVMenuItem ;
     ASAtom          theMenuItemName ;
     ASInt32         theMenuItemCount ;
     
     if ( ! inAVMenubar ) 
       return ;
 
-    theAVMenu = AVMenubarAcquireMenuByName ( inAVMenubar, inMenuName ) ;
+    APMenuRef theAVMenu( AVMenubarAcquireMenuByName ( inAVMenubar, inMenuName ) ) ;
     if ( ! theAVMenu ) 
       return ;
 
@@ -77,13 +105,14 @@ static ACCB1 void ACCB2 ListMenu( AVMenubar inAVMenubar, const char * inMenuName
 
     for ( long index = 0; index < theMenuItemCount; index++ )
       {
-        theAVMenuItem = AVMenuAcquireMenuItemByIndex( theAVMenu, index ) ;
+        APMenuItemRef theAVMenuItem( AVMenuAcquireMenuItemByIndex( theAVMenu, index ) ) ;
+        if ( ! theAVMenuItem )
+          continue ;
 
         theMenuItemName = AVMenuItemGetName ( theAVMenuItem ) ;
         
         const char * theStringPtr = ASAtomGetString ( theMenuItemName ) ;
-        strcpy( theString, theStringPtr ) ;
-        strcat( theString, "\r\n" );
+        snprintf( theString, sizeof( theString ), "%s\r\n", theStringPtr ) ;
         
         inReport->Write( theString, strlen( theString ) ) ;
 
@@ -99,8 +128,6 @@ static ACCB1 void ACCB2 ListAllMenus( APReport* inReport )
   { 
     char            theString[256] ;
     AVMenubar       theAVMenubar    = ( AVMenubar )NULL ;
-    AVMenu          theAVMenu       = ( AVMenu )NULL ;
-    AVMenuItem      theAVMenuItem ;
     ASAtom          theMenuName ;
     ASInt32         theMenuCount ;
     
@@ -112,16 +139,14 @@ static ACCB1 void ACCB2 ListAllMenus( APReport* inReport )
 
     for ( long index = 0; index < theMenuCount; index++ )
       {
-        theAVMenu = AVMenubarAcquireMenuByIndex ( theAVMenubar, index ) ;
+        APMenuRef theAVMenu( AVMenubarAcquireMenuByIndex ( theAVMenubar, index ) ) ;
         if ( ! theAVMenu )
-          return ;
+          continue ;
           
         theMenuName = AVMenuGetName ( theAVMenu ) ;
         
         const char * theStringPtr = ASAtomGetString ( theMenuName ) ;
-        strcpy( theString, "--" ) ;
-        strcat( theString, theStringPtr ) ;
-        strcat( theString, "\r\n" );
+        snprintf( theString, sizeof( theString ), "--%s\r\n", theStringPtr ) ;
         
         inReport->Write( theString, strlen( theString ) ) ;
         
@@ -129,35 +154,29 @@ static ACCB1 void ACCB2 ListAllMenus( APReport* inReport )
           
         strcpy( theString, "\r\n" );
         inReport->Write( theString, strlen( theString ) ) ;   // add blank line
-        
-        AVMenuRelease ( theAVMenu ) ;
                 
       } // end for
     
   } // end ListAllMenus
 
 // --------------------------
-// Display the About box for the Print Page plug-in
+// Write the banner and time stamp that start every report.
 
-static ACCB1 void ACCB2 DoListMenuNames( void * data )
+static void WriteReportHeader( APReport * inReport )
   {
     char        theString[256] ;
     char        theTimeString[256] ;
     ASTimeRec   theASTimeRec ;
     ASInt32     theError ;
 
-    APReport *  theLog = new APReport( "ListMenuNamesReport.txt" ) ;
-    if ( theLog == NULL )
-      return ;
-    
     strcpy( theString, "File generated by the ListMenuNames plug-in for Adobe Acrobat\r\n" ) ;
-    theLog->Write( theString, strlen( theString ) ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
     strcpy( theString, "Written by Mark Gavin, mgavin@appligent.com\r\n" ) ;
-    theLog->Write( theString, strlen( theString ) ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
     strcpy( theString, "Copyrighted 1997-2006 Appligent, Inc., http://www.appligent.com\r\n" ) ;
-    theLog->Write( theString, strlen( theString ) ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
     strcpy( theString, "\r\n" );
-    theLog->Write( theString, strlen( theString ) ) ;   // add blank line
+    inReport->Write( theString, strlen( theString ) ) ;   // add blank line
 
     theError = TASUtils::GetLocalTime( &theASTimeRec ) ;
     
@@ -166,12 +185,27 @@ static ACCB1 void ACCB2 DoListMenuNames( void * data )
     theError = TASUtils::ASTimeRecToString( &theASTimeRec, theString, theTimeString ) ;
 
     strcat( theString, "\r\n" );
-    theLog->Write( theString, strlen( theString ) ) ;
+    inReport->Write( theString, strlen( theString ) ) ;
     strcat( theTimeString, "\r\n" );
-    theLog->Write( theTimeString, strlen( theTimeString ) ) ;
+    inReport->Write( theTimeString, strlen( theTimeString ) ) ;
 
     strcpy( theString, "\r\n" );
-    theLog->Write( theString, strlen( theString ) ) ;   // add blank line
+    inReport->Write( theString, strlen( theString ) ) ;   // add blank line
+
+  } // end WriteReportHeader
+
+// --------------------------
+// Display the About box for the Print Page plug-in
+
+static ACCB1 void ACCB2 DoListMenuNames( void * data )
+  {
+    APTraceScope  theTraceScope( "ListMenuNames" ) ;
+
+    APReport *  theLog = new APReport( "ListMenuNamesReport.txt" ) ;
+    if ( theLog == NULL )
+      return ;
+    
+    WriteReportHeader( theLog ) ;
 
     ListAllMenus( theLog ) ;
 
@@ -181,32 +215,621 @@ static ACCB1 void ACCB2 DoListMenuNames( void * data )
 
   } // end DoListMenuNames
 
+// -------------------------
+#pragma mark -- menu index
+// -------------------------
+// The index is built on the first lookup rather than at load so that it
+// starts from whatever the menubar holds at that moment; the notifications
+// below keep it current from then on.
+
+static APMenuIndex * GetMenuIndex( void )
+  {
+    if ( gMenuIndex.IsBuilt() == false )
+      gMenuIndex.Build( AVAppGetMenubar() ) ;
+
+    return &gMenuIndex ;
+
+  } // end GetMenuIndex
+
+// --------------------------
+
+static ACCB1 AVMenu ACCB2 DoMenuIndexAcquireMenuByName( ASAtom inName )
+  {
+    AVMenu    theAVMenu = ( AVMenu )NULL ;
+
+    DURING
+
+      theAVMenu = GetMenuIndex()->FindMenu( inName ) ;
+      if ( theAVMenu != NULL )
+        AVMenuAcquire( theAVMenu ) ;
+
+    HANDLER
+      gMenuIndex.Clear() ;
+      theAVMenu = ( AVMenu )NULL ;
+    END_HANDLER
+
+    return theAVMenu ;
+
+  } // end DoMenuIndexAcquireMenuByName
+
+// --------------------------
+
+static ACCB1 AVMenuItem ACCB2 DoMenuIndexAcquireMenuItemByName( ASAtom inName, AVMenu * outParentMenu, ASInt32 * outIndex )
+  {
+    AVMenuItem  theAVMenuItem = ( AVMenuItem )NULL ;
+
+    DURING
+
+      theAVMenuItem = GetMenuIndex()->FindMenuItem( inName, outParentMenu, outIndex ) ;
+      if ( theAVMenuItem != NULL )
+        AVMenuItemAcquire( theAVMenuItem ) ;
+
+    HANDLER
+      gMenuIndex.Clear() ;
+      theAVMenuItem = ( AVMenuItem )NULL ;
+    END_HANDLER
+
+    return theAVMenuItem ;
+
+  } // end DoMenuIndexAcquireMenuItemByName
+
+// --------------------------
+// If an update fails the index is dropped and rebuilt on the next lookup.
+
+static void DoAVMenuItemWasAddedToMenu( const APNotification & inNotification, void * data )
+  {
+    AVMenuItem    theAVMenuItem = inNotification.fAVMenuItem ;
+    AVMenu        theAVMenu     = inNotification.fAVMenu ;
+    APTraceScope  theTraceScope( "AVMenuItemWasAddedToMenu" ) ;
+
+    if ( ( theAVMenu != NULL ) && ( theAVMenu == gPaletteAVMenu ) )   // our own pop-up of matches
+      return ;
+
+    DURING
+      gMenuIndex.MenuItemAdded( theAVMenuItem, theAVMenu ) ;
+      gMenuWatch.MenuItemAdded( theAVMenuItem, theAVMenu ) ;
+      if ( gCommandPalette.IsBuilt() )
+        gCommandPalette.AddCommand( theAVMenuItem ) ;
+    HANDLER
+      gMenuIndex.Clear() ;
+      gCommandPalette.Clear() ;
+    END_HANDLER
+
+  } // end DoAVMenuItemWasAddedToMenu
+
+// --------------------------
+
+static void DoAVMenuItemWasRemoved( const APNotification & inNotification, void * data )
+  {
+    AVMenuItem    theAVMenuItem = inNotification.fAVMenuItem ;
+    APTraceScope  theTraceScope( "AVMenuItemWasRemoved" ) ;
+
+    DURING
+      gMenuIndex.MenuItemRemoved( theAVMenuItem ) ;
+      gMenuWatch.MenuItemRemoved( theAVMenuItem ) ;
+      gCommandPalette.RemoveCommand( theAVMenuItem ) ;
+    HANDLER
+      gMenuIndex.Clear() ;
+      gCommandPalette.Clear() ;
+    END_HANDLER
+
+  } // end DoAVMenuItemWasRemoved
+
+// --------------------------
+// Add a menu's items to the palette and, recursively, the items of any of
+// their sub-menus, as the palette's first build from the menu index does.
+
+static void AddPaletteMenuTree( AVMenu inAVMenu )
+  {
+    APMenuItemRef   theAVMenuItem ;     // outside DURING so they can be released before the raise is passed on
+    APMenuRef       theSubAVMenu ;
+    ASInt32         theMenuItemCount ;
+
+    DURING
+
+      theMenuItemCount = AVMenuGetNumMenuItems( inAVMenu ) ;
+
+      for ( ASInt32 index = 0 ; index < theMenuItemCount ; index++ )
+        {
+          theAVMenuItem.Reset( AVMenuAcquireMenuItemByIndex( inAVMenu, index ) ) ;
+          if ( theAVMenuItem == NULL )
+            continue ;
+
+          gCommandPalette.AddCommand( theAVMenuItem ) ;
+
+          theSubAVMenu.Reset( AVMenuItemAcquireSubmenu( theAVMenuItem ) ) ;
+          if ( theSubAVMenu != NULL )
+            AddPaletteMenuTree( theSubAVMenu ) ;
+        }
+
+    HANDLER
+      theSubAVMenu.Reset( NULL ) ;
+      theAVMenuItem.Reset( NULL ) ;
+      RERAISE() ;
+    END_HANDLER
+
+  } // end AddPaletteMenuTree
+
+// --------------------------
+
+static void DoAVMenuWasAddedToMenubar( const APNotification & inNotification, void * data )
+  {
+    AVMenu        theAVMenu     = inNotification.fAVMenu ;
+    APTraceScope  theTraceScope( "AVMenuWasAddedToMenubar" ) ;
+
+    DURING
+      gMenuIndex.MenuAdded( theAVMenu ) ;
+      if ( gCommandPalette.IsBuilt() && ( theAVMenu != NULL ) )    // pick up the items of a menu that was filled before it was added
+        AddPaletteMenuTree( theAVMenu ) ;
+    HANDLER
+      gMenuIndex.Clear() ;
+      gCommandPalette.Clear() ;
+    END_HANDLER
+
+  } // end DoAVMenuWasAddedToMenubar
+
+// --------------------------
+
+static void DoAVMenuWasRemoved( const APNotification & inNotification, void * data )
+  {
+    AVMenu        theAVMenu     = inNotification.fAVMenu ;
+    APTraceScope  theTraceScope( "AVMenuWasRemoved" ) ;
+
+    DURING
+      gMenuIndex.MenuRemoved( theAVMenu ) ;
+    HANDLER
+      gMenuIndex.Clear() ;
+    END_HANDLER
+
+  } // end DoAVMenuWasRemoved
+
+// --------------------------
+
+static ACCB1 HFT ACCB2 ProvideListMenuNamesHFT( HFTServer inHFTServer, ASUns32 inVersion, void * inRock )
+  {
+    if ( inVersion != kListMenuNamesHFTVersion )
+      return ( HFT )NULL ;
+
+    return gListMenuNamesHFT ;
+
+  } // end ProvideListMenuNamesHFT
+
+// -------------------------
+#pragma mark -- command palette
+// -------------------------
+// The palette is fed from the menu index, so building it costs one pass over
+// the index rather than another walk of the menubar.
+
+static void AddPaletteCommand( AVMenuItem inAVMenuItem, AVMenu inParentAVMenu, void * inClientData )
+  {
+    gCommandPalette.AddCommand( inAVMenuItem ) ;
+
+  } // end AddPaletteCommand
+
+// --------------------------
+
+static APCommandPalette * GetCommandPalette( void )
+  {
+    if ( gCommandPalette.IsBuilt() == false )
+      {
+        GetMenuIndex()->EnumMenuItems( &AddPaletteCommand, NULL ) ;
+        gCommandPalette.SetBuilt() ;
+      }
+
+    return &gCommandPalette ;
+
+  } // end GetCommandPalette
+
+// --------------------------
+// Show the matches as a pop-up menu over the page view and execute the one
+// chosen.  The pop-up is titled with the query it answers, and the arrow and
+// return keys work in it, so the whole palette can be driven from the keyboard.
+
+static void ShowPaletteMatches( AVPageView inAVPageView, const char * inQuery,
+                                const APCommandPalette::Match * inMatches, ASInt32 inCount )
+  {
+    char            theTitle[ kMaxPaletteQuery + 32 ] ;
+    char            theMenuItemName[ 64 ] ;
+    ASInt32         theChoice ;
+    AVMenuItem      theAVMenuItem ;
+    AVRect          theAVRect ;
+
+    snprintf( theTitle, sizeof( theTitle ), "Commands matching \"%s\"", inQuery ) ;
+
+    DURING
+
+      gPaletteAVMenu = AVMenuNew( theTitle, "DGAP:CommandPalettePopUp", gExtensionID ) ;
+
+      for ( ASInt32 index = 0 ; index < inCount ; index++ )
+        {
+          snprintf( theMenuItemName, sizeof( theMenuItemName ), "DGAP:CommandPaletteMatch%d", ( int )index ) ;
+          theAVMenuItem = AVMenuItemNew( gCommandPalette.GetTitle( inMatches[ index ].fCommand ), theMenuItemName,
+                                          ( AVMenu )NULL, false, NO_SHORTCUT, 0, NULL, gExtensionID ) ;
+          AVMenuAddMenuItem( gPaletteAVMenu, theAVMenuItem, APPEND_MENUITEM ) ;
+          AVMenuItemRelease( theAVMenuItem ) ;
+        }
+
+      AVPageViewGetAperture( inAVPageView, &theAVRect ) ;
+
+      theChoice = AVMenuDoPopUp( gPaletteAVMenu, ( ASInt16 )( ( theAVRect.left + theAVRect.right ) / 2 ),
+                                  ( ASInt16 )( ( theAVRect.top + theAVRect.bottom ) / 3 ), false, 0 ) ;
+
+    HANDLER
+      if ( gPaletteAVMenu != NULL )
+        AVMenuRelease( gPaletteAVMenu ) ;
+      gPaletteAVMenu = NULL ;
+      RERAISE() ;
+    END_HANDLER
+
+    AVMenuRelease( gPaletteAVMenu ) ;
+    gPaletteAVMenu = NULL ;
+
+    if ( ( theChoice < 0 ) || ( theChoice >= inCount ) )
+      return ;
+
+    theAVMenuItem = gCommandPalette.GetMenuItem( inMatches[ theChoice ].fCommand ) ;
+    if ( ( theAVMenuItem == NULL ) || ( AVMenuItemIsEnabled( theAVMenuItem ) == false ) )
+      {
+        AVSysBeep( 0 ) ;
+        return ;
+      }
+
+    // the command may well change the menus, and so the palette, underneath us
+    AVMenuItemAcquire( theAVMenuItem ) ;
+    AVMenuItemExecute( theAVMenuItem ) ;
+    AVMenuItemRelease( theAVMenuItem ) ;
+
+  } // end ShowPaletteMatches
+
+// --------------------------
+// Ask for the query in a prompt, so what has been typed is always in view,
+// and show its matches.  A query that matches nothing is asked for again,
+// with the dead end said in the prompt and the text left in place to edit.
+
+static ACCB1 void ACCB2 DoCommandPalette( void * data )
+  {
+    APCommandPalette::Match   theMatches[ kMaxPaletteMatches ] ;
+    char                      thePrompt[ kMaxPaletteQuery + 96 ] ;
+    char                      theQuery[ kMaxPaletteQuery ] ;
+    char *                    theAnswer ;
+    ASInt32                   theCount ;
+    APTraceScope              theTraceScope( "CommandPalette" ) ;
+
+    snprintf( thePrompt, sizeof( thePrompt ), "%s", kPalettePrompt ) ;
+    theQuery[ 0 ] = 0 ;
+
+    DURING
+
+      GetCommandPalette() ;
+
+      for ( ;; )
+        {
+          theAnswer = AVAlertGetString( thePrompt, theQuery, false ) ;
+          if ( theAnswer == NULL )      // cancelled
+            break ;
+
+          snprintf( theQuery, sizeof( theQuery ), "%s", theAnswer ) ;
+          ASfree( theAnswer ) ;
+
+          theCount = GetCommandPalette()->Query( theQuery, theMatches, kMaxPaletteMatches ) ;
+          if ( theCount != 0 )
+            {
+              ShowPaletteMatches( AVDocGetPageView( AVAppGetActiveDoc() ), theQuery, theMatches, theCount ) ;
+              break ;
+            }
+
+          AVSysBeep( 0 ) ;
+          snprintf( thePrompt, sizeof( thePrompt ), "No command matches \"%s\".  %s", theQuery, kPalettePrompt ) ;
+        }
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "running the command palette" ) ;
+      APDiagnostics::Shared().ShowSummary() ;
+    END_HANDLER
+
+  } // end DoCommandPalette
+
+// -------------------------
+#pragma mark -- watch mode
+// -------------------------
+// Watching starts from one walk of the menubar, the same one that builds the
+// menu index, and from then on only records what the menu notifications report.
+
+static ACCB1 void ACCB2 DoWatchMenus( void * data )
+  {
+    DURING
+
+      if ( gMenuWatch.IsWatching() )
+        gMenuWatch.Stop() ;
+      else
+        {
+          gMenuIndex.Build( AVAppGetMenubar() ) ;
+          gMenuWatch.Start( gMenuIndex.GetNumMenus(), gMenuIndex.GetNumMenuItems() ) ;
+        }
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "watching menu changes" ) ;
+      APDiagnostics::Shared().ShowSummary() ;
+    END_HANDLER
+
+  } // end DoWatchMenus
+
+// --------------------------
+
+static ACCB1 ASBool ACCB2 IsWatchingMenus( void * data )
+  {
+    return gMenuWatch.IsWatching() ;
+
+  } // end IsWatchingMenus
+
+// --------------------------
+// Write the changes recorded since watching started, and what each menu
+// notification handler has cost.
+
+static ACCB1 void ACCB2 DoListMenuChanges( void * data )
+  {
+    char        theString[ 8 ] ;
+    APReport *  theLog = new APReport( "ListMenuNamesChanges.txt" ) ;
+    if ( theLog == NULL )
+      return ;
+
+    WriteReportHeader( theLog ) ;
+
+    gMenuWatch.Write( theLog ) ;
+
+    strcpy( theString, "\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;   // add blank line
+
+    APNotifier::Shared().Write( theLog ) ;
+
+    delete( theLog ) ;
+
+    return ;
+
+  } // end DoListMenuChanges
+
+// -------------------------
+#pragma mark -- benchmarks
+// -------------------------
+
+#define kBenchMenuItems       48      // half appended to Extensions, half placed after one anchor
+#define kBenchMenuRounds      10
+#define kBenchAnchorName      "DGAP:ListMenuChanges"
+
+static char             gBenchMenuItemNames[ kBenchMenuItems ][ 32 ] ;
+static APMenuItemSpec   gBenchMenuItemSpecs[ kBenchMenuItems ] ;
+
+// --------------------------
+
+static void BenchListAllMenus( void * inData, ASInt32 inIteration )
+  {
+    ListAllMenus( ( APReport * )inData ) ;
+
+  } // end BenchListAllMenus
+
+// --------------------------
+
+static void BenchMenubarLookup( void * inData, ASInt32 inIteration )
+  {
+    AVMenuItem  theAVMenuItem = AVMenubarAcquireMenuItemByName( AVAppGetMenubar(), kBenchAnchorName ) ;
+
+    if ( theAVMenuItem != NULL )
+      AVMenuItemRelease( theAVMenuItem ) ;
+
+  } // end BenchMenubarLookup
+
+// --------------------------
+
+static void BenchMenuIndexLookup( void * inData, ASInt32 inIteration )
+  {
+    AVMenu      theParentAVMenu ;
+    ASInt32     theIndex ;
+    AVMenuItem  theAVMenuItem = DoMenuIndexAcquireMenuItemByName( ( ASAtom )( size_t )inData, &theParentAVMenu, &theIndex ) ;
+
+    if ( theAVMenuItem != NULL )
+      AVMenuItemRelease( theAVMenuItem ) ;
+
+  } // end BenchMenuIndexLookup
+
+// --------------------------
+// The palette matches when the query is submitted, but a keystroke-driven
+// palette would run the same Query on every key, so it is timed against the
+// 1 ms budget per keystroke.
+
+static void BenchPaletteQuery( void * inData, ASInt32 inIteration )
+  {
+    APCommandPalette::Match   theMatches[ kMaxPaletteMatches ] ;
+
+    GetCommandPalette()->Query( ( const char * )inData, theMatches, kMaxPaletteMatches ) ;
+
+  } // end BenchPaletteQuery
+
+// --------------------------
+// How the plug-ins installed their menus before APMenuInstaller: every item
+// looks up its own menu or anchor.
+
+static void InstallBenchMenuItemsOneByOne( void )
+  {
+    AVMenubar     theAVMenubar = AVAppGetMenubar() ;
+    AVMenu        theAVMenu ;
+    AVMenuItem    theAnchorAVMenuItem ;
+    AVMenuItem    theAVMenuItem ;
+    ASInt32       theIndex ;
+
+    for ( ASInt32 index = 0 ; index < kBenchMenuItems ; index++ )
+      {
+        const APMenuItemSpec & theSpec = gBenchMenuItemSpecs[ index ] ;
+
+        theAVMenu = NULL ;
+        theIndex  = APPEND_MENUITEM ;
+
+        if ( theSpec.fAfterMenuItemName != NULL )
+          {
+            theAnchorAVMenuItem = AVMenubarAcquireMenuItemByName( theAVMenubar, theSpec.fAfterMenuItemName ) ;
+            if ( theAnchorAVMenuItem != NULL )
+              {
+                theAVMenu = AVMenuItemGetParentMenu( theAnchorAVMenuItem ) ;
+                theIndex  = AVMenuGetMenuItemIndex( theAVMenu, theAnchorAVMenuItem ) + 1 ;
+                AVMenuAcquire( theAVMenu ) ;
+                AVMenuItemRelease( theAnchorAVMenuItem ) ;
+              }
+          }
+
+        if ( theAVMenu == NULL )
+          theAVMenu = AVMenubarAcquireMenuByName( theAVMenubar, theSpec.fMenuName ) ;
+
+        if ( theAVMenu == NULL )
+          continue ;
+
+        theAVMenuItem = AVMenuItemNew( theSpec.fTitle, theSpec.fMenuItemName, ( AVMenu )NULL, false,
+                                       theSpec.fShortcut, theSpec.fFlags, NULL, gExtensionID ) ;
+        AVMenuAddMenuItem( theAVMenu, theAVMenuItem, theIndex ) ;
+        AVMenuItemRelease( theAVMenuItem ) ;
+        AVMenuRelease( theAVMenu ) ;
+      }
+
+  } // end InstallBenchMenuItemsOneByOne
+
+// --------------------------
+
+static void RemoveBenchMenuItems( void )
+  {
+    AVMenubar     theAVMenubar = AVAppGetMenubar() ;
+    AVMenuItem    theAVMenuItem ;
+
+    for ( ASInt32 index = 0 ; index < kBenchMenuItems ; index++ )
+      {
+        theAVMenuItem = AVMenubarAcquireMenuItemByName( theAVMenubar, gBenchMenuItemNames[ index ] ) ;
+        if ( theAVMenuItem == NULL )
+          continue ;
+
+        AVMenuItemRemove( theAVMenuItem ) ;
+        AVMenuItemRelease( theAVMenuItem ) ;
+      }
+
+  } // end RemoveBenchMenuItems
+
+// --------------------------
+// Only the installs are timed; the items are taken out again between rounds.
+
+static void BenchMenuInstall( APBenchmark * inBenchmark )
+  {
+    ASUns64   theBatched    = 0 ;
+    ASUns64   theOneByOne   = 0 ;
+    ASUns64   theStart ;
+
+    for ( ASInt32 index = 0 ; index < kBenchMenuItems ; index++ )
+      {
+        snprintf( gBenchMenuItemNames[ index ], sizeof( gBenchMenuItemNames[ index ] ), "DGAP:BenchMenuItem%02d", ( int )index ) ;
+
+        memset( &gBenchMenuItemSpecs[ index ], 0, sizeof( gBenchMenuItemSpecs[ index ] ) ) ;
+        gBenchMenuItemSpecs[ index ].fTitle             = gBenchMenuItemNames[ index ] ;
+        gBenchMenuItemSpecs[ index ].fMenuItemName      = gBenchMenuItemNames[ index ] ;
+        gBenchMenuItemSpecs[ index ].fMenuName          = "Extensions" ;
+        gBenchMenuItemSpecs[ index ].fAfterMenuItemName = ( index & 1 ) ? kBenchAnchorName : NULL ;
+        gBenchMenuItemSpecs[ index ].fShortcut          = NO_SHORTCUT ;
+      }
+
+    for ( ASInt32 round = 0 ; round < kBenchMenuRounds ; round++ )
+      {
+        theStart = APTiming::GetNanoseconds() ;
+        APMenuInstaller::Install( gBenchMenuItemSpecs, kBenchMenuItems, NULL, NULL ) ;
+        theBatched += APTiming::GetNanoseconds() - theStart ;
+        RemoveBenchMenuItems() ;
+
+        theStart = APTiming::GetNanoseconds() ;
+        InstallBenchMenuItemsOneByOne() ;
+        theOneByOne += APTiming::GetNanoseconds() - theStart ;
+        RemoveBenchMenuItems() ;
+      }
+
+    inBenchmark->Add( "install 48 menu items, batched, per item", kBenchMenuRounds * kBenchMenuItems, theBatched ) ;
+    inBenchmark->Add( "install 48 menu items, one by one, per item", kBenchMenuRounds * kBenchMenuItems, theOneByOne ) ;
+
+  } // end BenchMenuInstall
+
+// --------------------------
+// Write the cost per call of the menu enumeration, lookups and installs to
+// ListMenuNamesBenchmark.txt.  The menu listings the enumeration writes go to
+// ListMenuNamesBenchmarkScratch.txt.
+
+static ACCB1 void ACCB2 DoListMenuNamesBenchmark( void * data )
+  {
+    APBenchmark   theBenchmark ;
+    APReport *    theScratch ;
+
+    DURING
+
+      theScratch = new APReport( "ListMenuNamesBenchmarkScratch.txt" ) ;
+      if ( theScratch != NULL )
+        {
+          theBenchmark.Run( "ListAllMenus", 20, &BenchListAllMenus, theScratch ) ;
+          delete( theScratch ) ;
+        }
+
+      theBenchmark.Run( "find a menu item, menubar", 10000, &BenchMenubarLookup, NULL ) ;
+      theBenchmark.Run( "find a menu item, menu index", 10000, &BenchMenuIndexLookup, ( void * )( size_t )ASAtomFromString( kBenchAnchorName ) ) ;
+
+      // built first, so only the matching is timed
+      GetCommandPalette() ;
+      theBenchmark.Run( "palette query, short: sav", 1000, &BenchPaletteQuery, ( void * )"sav" ) ;
+      theBenchmark.Run( "palette query, typo: pritn", 1000, &BenchPaletteQuery, ( void * )"pritn" ) ;
+      theBenchmark.Run( "palette query, long: reverse pages to new file", 1000, &BenchPaletteQuery, ( void * )"reverse pages to new file" ) ;
+
+      BenchMenuInstall( &theBenchmark ) ;
+
+    HANDLER
+      RemoveBenchMenuItems() ;
+      APDiagnostics::Shared().Report( ERRORCODE, "running the ListMenuNames benchmarks" ) ;
+    END_HANDLER
+
+    APReport *  theLog = new APReport( "ListMenuNamesBenchmark.txt" ) ;
+    if ( theLog != NULL )
+      {
+        theBenchmark.Write( theLog ) ;
+        delete( theLog ) ;
+      }
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoListMenuNamesBenchmark
+
+// --------------------------
+// Write the events in the trace ring to ListMenuNamesTrace.json.
+
+static ACCB1 void ACCB2 DoWriteTrace( void * data )
+  {
+    if ( APTrace::Shared().Write( "ListMenuNamesTrace.json", "ListMenuNames" ) == false )
+      APDiagnostics::Shared().Report( 0, "writing ListMenuNamesTrace.json" ) ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoWriteTrace
+
 // -------------------------
 #pragma mark -- init
 // -------------------------
 
+static const APMenuItemSpec gMenuItemSpecs[] =
+  {
+    { "List Menu Names...",         "DGAP:AboutListMenuNames",     "AboutExtensions", NULL, NO_SHORTCUT, 0,                     NULL,                     NULL, NULL,             &DoAboutListMenuNames,     NULL },
+    { "List Menu Names...",         "DGAP:ListMenuNames",          "Extensions",      NULL, NO_SHORTCUT, 0,                     NULL,                     NULL, NULL,             &DoListMenuNames,          NULL },
+    { "Command Palette...",         "DGAP:CommandPalette",         "Extensions",      NULL, 'P',         AV_COMMAND | AV_SHIFT, TAVUtils::ComputeEnabled, NULL, NULL,             &DoCommandPalette,         NULL },
+    { "Watch Menu Changes",         "DGAP:WatchMenuChanges",       "Extensions",      NULL, NO_SHORTCUT, 0,                     NULL,                     NULL, &IsWatchingMenus, &DoWatchMenus,             NULL },
+    { "List Menu Changes...",       "DGAP:ListMenuChanges",        "Extensions",      NULL, NO_SHORTCUT, 0,                     NULL,                     NULL, NULL,             &DoListMenuChanges,        NULL },
+    { "ListMenuNames Trace...",     "DGAP:ListMenuNamesTrace",     "Extensions",      NULL, NO_SHORTCUT, 0,                     NULL,                     NULL, NULL,             &DoWriteTrace,             NULL },
+    { "ListMenuNames Benchmark...", "DGAP:ListMenuNamesBenchmark", "Extensions",      NULL, NO_SHORTCUT, 0,                     NULL,                     NULL, NULL,             &DoListMenuNamesBenchmark, NULL }
+  } ;
+
 static ACCB1 boolean ACCB2 InitPlugInMenus( void )
   {
-    AVMenubar     theAVMenubar ;
-    AVMenu        theAVMenu ;
-    ASInt16       theFlags        = 0 ;
-    
     DURING
       
-      theAVMenubar  = AVAppGetMenubar() ;
-      if ( ! theAVMenubar ) 
-        E_RETURN( false ) ;
-        
-      TAVUtils::AppendToAboutMenu( "List Menu Names...", "DGAP:AboutListMenuNames", &DoAboutListMenuNames ) ;
-      
-      theAVMenu = AVMenubarAcquireMenuByName( theAVMenubar, "Extensions" ) ;
-      if ( ! theAVMenu )
+      if ( APMenuInstaller::Install( gMenuItemSpecs, APMenuItemCount( gMenuItemSpecs ), NULL, NULL ) == 0 )
         E_RETURN( false ) ;
-            
-      TAVUtils::AppendMenuItem( theAVMenu, "List Menu Names...", "DGAP:ListMenuNames", NULL, &DoListMenuNames ) ;
       
     HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "installing the ListMenuNames menu items" ) ;
     END_HANDLER
     
     return true ;
@@ -219,10 +842,15 @@ static ACCB1 boolean ACCB2 InitPlugIn( void )
   {
     boolean   theResult = true ;
     
+    LoadProfilerMark( kLoadPhaseInitStart, APTiming::GetNanoseconds() ) ;
+
     theResult = InitPlugInMenus() ;
-    if ( theResult == false )
-      return theResult ;
-    
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+    // on failure too, so a failed init is still ranked by what it cost
+    LoadProfilerMark( kLoadPhaseInitEnd, APTiming::GetNanoseconds() ) ;
+
     return theResult ;
     
   } // end InitPlugIn
@@ -231,23 +859,87 @@ static ACCB1 boolean ACCB2 InitPlugIn( void )
 
 static ACCB1 boolean ACCB2 UnloadPlugIn( void )
   {
+    APNotifier::Shared().UnregisterAll() ;
+
+    // cleared first: they hold their menus and menu items in wrappers for the whole session
+    gCommandPalette.Clear() ;
+    gMenuIndex.Clear() ;
+
+    APHandleReportLeaks() ;
+    APDiagnostics::Shared().Close() ;
+
     return true ;
     
   } // end UnloadPlugIn
 
+// -------------------------
+// Register for the menu notifications that keep the menu index and command
+// palette current.
+
+static ACCB1 boolean ACCB2 PreInitPlugIn( void )
+  {
+    ASUns64   theImportStart = APTiming::GetNanoseconds() ;
+
+    APDiagnostics::Shared().SetLogName( "ListMenuNamesDiagnostics.txt" ) ;
+
+    gLoadProfilerHFT = ASExtensionMgrGetHFT( ASAtomFromString( kLoadProfilerHFTName ), kLoadProfilerHFTVersion ) ;
+
+    APNotifier &  theNotifier = APNotifier::Shared() ;
+
+    theNotifier.Subscribe( kNotifyMenuItemWasAddedToMenu, kNotifyAllChanges, "DoAVMenuItemWasAddedToMenu", &DoAVMenuItemWasAddedToMenu, NULL ) ;
+    theNotifier.Subscribe( kNotifyMenuItemWasRemoved,     kNotifyAllChanges, "DoAVMenuItemWasRemoved", &DoAVMenuItemWasRemoved, NULL ) ;
+    theNotifier.Subscribe( kNotifyMenuWasAddedToMenubar,  kNotifyAllChanges, "DoAVMenuWasAddedToMenubar", &DoAVMenuWasAddedToMenubar, NULL ) ;
+    theNotifier.Subscribe( kNotifyMenuWasRemoved,         kNotifyAllChanges, "DoAVMenuWasRemoved", &DoAVMenuWasRemoved, NULL ) ;
+
+    LoadProfilerMark( kLoadPhaseHandshake, gHandshakeTime ) ;
+    LoadProfilerMark( kLoadPhaseImportStart, theImportStart ) ;
+    LoadProfilerMark( kLoadPhaseImportEnd, APTiming::GetNanoseconds() ) ;
+
+    return true ;
+    
+  } // end PreInitPlugIn
+
+// -------------------------
+// Export the menu index to other plug-ins; see ListMenuNamesHFT.h.
+
+static ACCB1 boolean ACCB2 ExportHFTs( void )
+  {
+    HFTServer   theHFTServer ;
+
+    DURING
+
+      theHFTServer = HFTServerNew( kListMenuNamesHFTName, ASCallbackCreateProto( HFTServerProvideHFTProc, &ProvideListMenuNamesHFT ), NULL, NULL ) ;
+
+      gListMenuNamesHFT = HFTNew( theHFTServer, ListMenuNamesNUMSELECTORS ) ;
+
+      HFTReplaceEntry( gListMenuNamesHFT, MenuIndexAcquireMenuByNameSEL,
+                        ASCallbackCreateReplacement( MenuIndexAcquireMenuByNameSEL, &DoMenuIndexAcquireMenuByName ), 0 ) ;
+      HFTReplaceEntry( gListMenuNamesHFT, MenuIndexAcquireMenuItemByNameSEL,
+                        ASCallbackCreateReplacement( MenuIndexAcquireMenuItemByNameSEL, &DoMenuIndexAcquireMenuItemByName ), 0 ) ;
+
+    HANDLER
+      return false ;
+    END_HANDLER
+
+    return true ;
+
+  } // end ExportHFTs
+
 // -------------------------
 
 ACCB1 ASBool ACCB2 PIHandshake( Uns32 handshakeVersion, void *handshakeData )
   {
+    gHandshakeTime = APTiming::GetNanoseconds() ;
+
     if ( handshakeVersion == HANDSHAKE_V0200 )
       {
         PIHandshakeData_V0200 *hsData = ( PIHandshakeData_V0200 * )handshakeData ;
     
         hsData->extensionName = ASAtomFromString( "DGAP:ListMenuNames" ) ;  
     
-        hsData->exportHFTsCallback = NULL ;
+        hsData->exportHFTsCallback = ASCallbackCreateProto( PIExportHFTsProcType, ( void * )ExportHFTs ) ;
         
-        hsData->importReplaceAndRegisterCallback = NULL ;
+        hsData->importReplaceAndRegisterCallback = ASCallbackCreateProto( PIImportReplaceAndRegisterProcType, ( void * )PreInitPlugIn ) ;
         
         hsData->initCallback = ASCallbackCreateProto( PIInitProcType, ( void * )InitPlugIn ) ;
       
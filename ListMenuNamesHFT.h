@@ -0,0 +1,66 @@
+/*
+  File:   ListMenuNamesHFT.h
+
+  Contains: Host function table exported by the ListMenuNames plug-in.
+            Other plug-ins import it to resolve menus and menu items by name
+            without walking the menubar.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    Import the table from the importReplaceAndRegisterCallback; it is NULL when
+    the ListMenuNames plug-in is not installed, so keep a fallback path.
+
+      gListMenuNamesHFT = ASExtensionMgrGetHFT( ASAtomFromString( kListMenuNamesHFTName ), kListMenuNamesHFTVersion ) ;
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+// --------------------------
+
+#define kListMenuNamesHFTName     "DGAP:ListMenuNames"
+#define kListMenuNamesHFTVersion  0x00010000
+
+extern HFT gListMenuNamesHFT ;
+
+// --------------------------
+
+enum
+  {
+    ListMenuNamesDUMMYBLANKSELECTOR,
+    MenuIndexAcquireMenuByNameSEL,
+    MenuIndexAcquireMenuItemByNameSEL,
+    ListMenuNamesNUMSELECTORSPlusOne
+  } ;
+
+#define ListMenuNamesNUMSELECTORS ( ListMenuNamesNUMSELECTORSPlusOne - 1 )
+
+// --------------------------
+// Same contract as AVMenubarAcquireMenuByName; release the result with AVMenuRelease.
+
+typedef ACCBPROTO1 AVMenu ( ACCBPROTO2 * MenuIndexAcquireMenuByNameSELPROTO )( ASAtom inName ) ;
+#define MenuIndexAcquireMenuByName ( *( ( MenuIndexAcquireMenuByNameSELPROTO )( gListMenuNamesHFT[ MenuIndexAcquireMenuByNameSEL ] ) ) )
+
+// --------------------------
+// Same contract as AVMenubarAcquireMenuItemByName; release the result with AVMenuItemRelease.
+// outParentMenu and outIndex may be NULL; the parent menu is not acquired.
+// A lookup is constant time between changes to the item's menu; the first
+// lookup after an item is added to or removed from that menu walks it once.
+
+typedef ACCBPROTO1 AVMenuItem ( ACCBPROTO2 * MenuIndexAcquireMenuItemByNameSELPROTO )( ASAtom inName, AVMenu * outParentMenu, ASInt32 * outIndex ) ;
+#define MenuIndexAcquireMenuItemByName ( *( ( MenuIndexAcquireMenuItemByNameSELPROTO )( gListMenuNamesHFT[ MenuIndexAcquireMenuItemByNameSEL ] ) ) )
+
+// --------------------------
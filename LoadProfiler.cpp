@@ -0,0 +1,572 @@
+/*
+  File:   LoadProfiler.cpp
+
+  Contains: Measures what each plug-in costs at Acrobat startup and writes a
+            ranked report when Acrobat has finished initializing.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "PDCalls.h"
+#include "CosCalls.h"
+#include "ASCalls.h"
+
+#if MAC_PLATFORM
+
+#include "SafeResources.h"
+#endif
+
+
+#if WIN_ENV
+#include "resource.h"
+extern HINSTANCE gHINSTANCE ;
+#endif
+
+#include "TASUtils.h"
+#include "TAVUtils.h"
+
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "APReport.h"
+#include "APMenuInstaller.h"
+#include "APTiming.h"
+#include "APMenuWatch.h"
+#include "APDiagnostics.h"
+#include "LoadProfilerHFT.h"
+
+// --------------------------
+// Phases reported through the HFT by a plug-in that cooperates.
+
+struct LoadProfile
+  {
+    ASAtom      fExtensionName ;
+    ASUns64     fMarks[ kLoadPhaseCount ] ;
+    ASUns32     fMarked ;
+  } ;
+
+// What a developer prefix installed, and the share of init time estimated for it.
+
+struct OwnerCost
+  {
+    ASAtom      fOwner ;
+    ASInt32     fMenus ;
+    ASInt32     fMenuItems ;
+    ASInt32     fToolButtons ;
+    ASInt32     fEvents ;
+    ASUns64     fEstimated ;
+  } ;
+
+struct MenuEvent
+  {
+    ASUns64     fTime ;
+    ASAtom      fName ;
+  } ;
+
+// --------------------------
+
+HFT       gLoadProfilerHFT        = NULL ;
+
+ASUns64   gHandshakeTime          = 0 ;
+ASUns64   gAppDidInitializeTime   = 0 ;
+ASBool    gLoading                = true ;
+
+std::unordered_map< ASAtom, LoadProfile >   gProfiles ;
+std::unordered_map< ASAtom, OwnerCost >     gOwners ;
+std::vector< MenuEvent >                    gMenuEvents ;
+
+// --------------------------
+// Display the About box for the LoadProfiler plug-in
+
+static ACCB1 void ACCB2 DoAboutLoadProfiler( void * data )
+  {
+
+    AVAlertNote( "LoadProfiler writes LoadProfilerReport.txt, a ranking of what each plug-in costs at startup." ) ;
+
+    return ;
+
+  } // end DoAboutLoadProfiler
+
+// --------------------------
+
+static void MarkPhase( ASAtom inExtensionName, ASInt32 inPhase, ASUns64 inTime )
+  {
+    if ( ( inPhase < 0 ) || ( inPhase >= kLoadPhaseCount ) )
+      return ;
+
+    std::unordered_map< ASAtom, LoadProfile >::iterator theIter = gProfiles.find( inExtensionName ) ;
+    if ( theIter == gProfiles.end() )
+      {
+        LoadProfile theProfile ;
+        memset( &theProfile, 0, sizeof( theProfile ) ) ;
+        theProfile.fExtensionName = inExtensionName ;
+        theIter = gProfiles.insert( std::make_pair( inExtensionName, theProfile ) ).first ;
+      }
+
+    theIter->second.fMarks[ inPhase ] = inTime ;
+    theIter->second.fMarked |= ( 1 << inPhase ) ;
+
+  } // end MarkPhase
+
+// --------------------------
+// LoadProfilerMarkPhase; see LoadProfilerHFT.h.
+
+static ACCB1 void ACCB2 DoLoadProfilerMarkPhase( ASAtom inExtensionName, ASInt32 inPhase, ASUns64 inTime )
+  {
+    MarkPhase( inExtensionName, inPhase, inTime ) ;
+
+  } // end DoLoadProfilerMarkPhase
+
+// --------------------------
+
+static ACCB1 HFT ACCB2 ProvideLoadProfilerHFT( HFTServer inHFTServer, ASUns32 inVersion, void * inRock )
+  {
+    if ( inVersion != kLoadProfilerHFTVersion )
+      return ( HFT )NULL ;
+
+    return gLoadProfilerHFT ;
+
+  } // end ProvideLoadProfilerHFT
+
+// -------------------------
+#pragma mark -- menu activity
+// -------------------------
+// Other plug-ins cannot be timed directly, but during the init phase nearly
+// all of them create menu items; a time stamp and a name atom is all that is
+// kept per event so the profiler itself stays out of the measurement.
+
+static ACCB1 void ACCB2 DoAVMenuItemWasAddedToMenu( AVMenuItem inAVMenuItem, AVMenu inAVMenu, void * data )
+  {
+    MenuEvent   theEvent ;
+
+    if ( ( gLoading == false ) || ( inAVMenuItem == NULL ) )
+      return ;
+
+    theEvent.fTime = APTiming::GetNanoseconds() ;
+    theEvent.fName = AVMenuItemGetName( inAVMenuItem ) ;
+    gMenuEvents.push_back( theEvent ) ;
+
+  } // end DoAVMenuItemWasAddedToMenu
+
+// --------------------------
+
+static ACCB1 void ACCB2 DoAVMenuWasAddedToMenubar( AVMenu inAVMenu, void * data )
+  {
+    MenuEvent   theEvent ;
+
+    if ( ( gLoading == false ) || ( inAVMenu == NULL ) )
+      return ;
+
+    theEvent.fTime = APTiming::GetNanoseconds() ;
+    theEvent.fName = AVMenuGetName( inAVMenu ) ;
+    gMenuEvents.push_back( theEvent ) ;
+
+  } // end DoAVMenuWasAddedToMenubar
+
+// --------------------------
+
+static OwnerCost & GetOwnerCost( const char * inName )
+  {
+    char      theOwner[ 64 ] ;
+    ASAtom    theOwnerASAtom ;
+
+    APMenuWatch::GetOwnerPrefix( inName, theOwner, sizeof( theOwner ) ) ;
+    theOwnerASAtom = ASAtomFromString( theOwner ) ;
+
+    std::unordered_map< ASAtom, OwnerCost >::iterator theIter = gOwners.find( theOwnerASAtom ) ;
+    if ( theIter == gOwners.end() )
+      {
+        OwnerCost theOwnerCost ;
+        memset( &theOwnerCost, 0, sizeof( theOwnerCost ) ) ;
+        theOwnerCost.fOwner = theOwnerASAtom ;
+        theIter = gOwners.insert( std::make_pair( theOwnerASAtom, theOwnerCost ) ).first ;
+      }
+
+    return theIter->second ;
+
+  } // end GetOwnerCost
+
+// --------------------------
+// Charge the gap before each menu event to the owner of that event; the
+// work leading up to creating a menu item belongs to whoever created it.
+// The first gap starts at the end of this plug-in's import phase, after
+// which only init callbacks run.
+
+static void AttributeMenuEvents( void )
+  {
+    ASUns64     thePrevious ;
+
+    std::unordered_map< ASAtom, LoadProfile >::iterator theIter = gProfiles.find( ASExtensionGetRegisteredName( gExtensionID ) ) ;
+    if ( ( theIter != gProfiles.end() ) && ( theIter->second.fMarked & ( 1 << kLoadPhaseImportEnd ) ) )
+      thePrevious = theIter->second.fMarks[ kLoadPhaseImportEnd ] ;
+    else
+      thePrevious = gMenuEvents.empty() ? 0 : gMenuEvents[ 0 ].fTime ;
+
+    for ( size_t index = 0 ; index < gMenuEvents.size() ; index++ )
+      {
+        OwnerCost & theOwnerCost = GetOwnerCost( ASAtomGetString( gMenuEvents[ index ].fName ) ) ;
+
+        if ( gMenuEvents[ index ].fTime > thePrevious )
+          theOwnerCost.fEstimated += gMenuEvents[ index ].fTime - thePrevious ;
+        theOwnerCost.fEvents += 1 ;
+
+        thePrevious = gMenuEvents[ index ].fTime ;
+      }
+
+  } // end AttributeMenuEvents
+
+// --------------------------
+
+static void CountMenuTree( AVMenu inAVMenu )
+  {
+    AVMenuItem  theAVMenuItem ;
+    AVMenu      theSubAVMenu ;
+    ASInt32     theMenuItemCount ;
+
+    GetOwnerCost( ASAtomGetString( AVMenuGetName( inAVMenu ) ) ).fMenus += 1 ;
+
+    theMenuItemCount = AVMenuGetNumMenuItems( inAVMenu ) ;
+
+    for ( ASInt32 index = 0 ; index < theMenuItemCount ; index++ )
+      {
+        theAVMenuItem = AVMenuAcquireMenuItemByIndex( inAVMenu, index ) ;
+        if ( theAVMenuItem == NULL )
+          continue ;
+
+        GetOwnerCost( ASAtomGetString( AVMenuItemGetName( theAVMenuItem ) ) ).fMenuItems += 1 ;
+
+        theSubAVMenu = AVMenuItemAcquireSubmenu( theAVMenuItem ) ;
+        if ( theSubAVMenu != NULL )
+          {
+            CountMenuTree( theSubAVMenu ) ;
+            AVMenuRelease( theSubAVMenu ) ;
+          }
+
+        AVMenuItemRelease( theAVMenuItem ) ;
+      }
+
+  } // end CountMenuTree
+
+// --------------------------
+
+static ACCB1 ASBool ACCB2 CountToolButton( AVToolButton inAVToolButton, void * inClientData )
+  {
+    GetOwnerCost( ASAtomGetString( AVToolButtonGetName( inAVToolButton ) ) ).fToolButtons += 1 ;
+
+    return true ;
+
+  } // end CountToolButton
+
+// --------------------------
+// Tally what every developer prefix has installed on the menubar and toolbar.
+
+static void CountInstalledItems( void )
+  {
+    AVMenubar   theAVMenubar ;
+    AVMenu      theAVMenu ;
+    ASInt32     theMenuCount ;
+
+    theAVMenubar = AVAppGetMenubar() ;
+    if ( theAVMenubar != NULL )
+      {
+        theMenuCount = AVMenubarGetNumMenus( theAVMenubar ) ;
+        for ( ASInt32 index = 0 ; index < theMenuCount ; index++ )
+          {
+            theAVMenu = AVMenubarAcquireMenuByIndex( theAVMenubar, index ) ;
+            if ( theAVMenu == NULL )
+              continue ;
+            CountMenuTree( theAVMenu ) ;
+            AVMenuRelease( theAVMenu ) ;
+          }
+      }
+
+    AVToolBarEnumButtons( AVAppGetToolBar(), ASCallbackCreateProto( AVToolButtonEnumProc, &CountToolButton ), NULL ) ;
+
+  } // end CountInstalledItems
+
+// -------------------------
+#pragma mark -- report
+// -------------------------
+
+static ASUns64 GetSpan( const LoadProfile & inProfile, ASInt32 inStartPhase, ASInt32 inEndPhase )
+  {
+    ASUns32 theMask = ( 1 << inStartPhase ) | ( 1 << inEndPhase ) ;
+
+    if ( ( ( inProfile.fMarked & theMask ) != theMask ) || ( inProfile.fMarks[ inEndPhase ] < inProfile.fMarks[ inStartPhase ] ) )
+      return 0 ;
+
+    return inProfile.fMarks[ inEndPhase ] - inProfile.fMarks[ inStartPhase ] ;
+
+  } // end GetSpan
+
+// --------------------------
+
+static bool IsCostlierProfile( const LoadProfile & inLeft, const LoadProfile & inRight )
+  {
+    return ( GetSpan( inLeft, kLoadPhaseImportStart, kLoadPhaseImportEnd ) + GetSpan( inLeft, kLoadPhaseInitStart, kLoadPhaseInitEnd ) ) >
+           ( GetSpan( inRight, kLoadPhaseImportStart, kLoadPhaseImportEnd ) + GetSpan( inRight, kLoadPhaseInitStart, kLoadPhaseInitEnd ) ) ;
+
+  } // end IsCostlierProfile
+
+// --------------------------
+
+static bool IsCostlierOwner( const OwnerCost & inLeft, const OwnerCost & inRight )
+  {
+    return inLeft.fEstimated > inRight.fEstimated ;
+
+  } // end IsCostlierOwner
+
+// --------------------------
+
+static void WriteLoadReport( void )
+  {
+    char                        theString[ 512 ] ;
+    char                        theTimeString[ 256 ] ;
+    ASTimeRec                   theASTimeRec ;
+    std::vector< LoadProfile >  theProfiles ;
+    std::vector< OwnerCost >    theOwners ;
+
+    APReport *  theLog = new APReport( "LoadProfilerReport.txt" ) ;
+    if ( theLog == NULL )
+      return ;
+
+    strcpy( theString, "File generated by the LoadProfiler plug-in for Adobe Acrobat\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+    strcpy( theString, "Copyrighted 2026 Appligent, Inc., http://www.appligent.com\r\n\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    TASUtils::GetLocalTime( &theASTimeRec ) ;
+    memset( theString, 0, sizeof( theString ) ) ;
+    memset( theTimeString, 0, sizeof( theTimeString ) ) ;
+    TASUtils::ASTimeRecToString( &theASTimeRec, theString, theTimeString ) ;
+    strcat( theString, "  " ) ;
+    strcat( theString, theTimeString ) ;
+    strcat( theString, "\r\n\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    snprintf( theString, sizeof( theString ), "%.1f ms from the LoadProfiler handshake to AVAppDidInitialize\r\n\r\n",
+              APTiming::ToMilliseconds( gAppDidInitializeTime - gHandshakeTime ) ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    // plug-ins that reported their own phases
+    for ( std::unordered_map< ASAtom, LoadProfile >::iterator theIter = gProfiles.begin() ; theIter != gProfiles.end() ; ++theIter )
+      theProfiles.push_back( theIter->second ) ;
+    std::sort( theProfiles.begin(), theProfiles.end(), IsCostlierProfile ) ;
+
+    strcpy( theString, "Reported by the plug-ins, ranked by import + init time (ms)\r\n\r\n  rank    import      init  handshake to init end  plug-in\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    for ( size_t index = 0 ; index < theProfiles.size() ; index++ )
+      {
+        snprintf( theString, sizeof( theString ), "  %4d  %8.2f  %8.2f  %21.2f  %s\r\n", ( int )index + 1,
+                  APTiming::ToMilliseconds( GetSpan( theProfiles[ index ], kLoadPhaseImportStart, kLoadPhaseImportEnd ) ),
+                  APTiming::ToMilliseconds( GetSpan( theProfiles[ index ], kLoadPhaseInitStart, kLoadPhaseInitEnd ) ),
+                  APTiming::ToMilliseconds( GetSpan( theProfiles[ index ], kLoadPhaseHandshake, kLoadPhaseInitEnd ) ),
+                  ASAtomGetString( theProfiles[ index ].fExtensionName ) ) ;
+        theLog->Write( theString, strlen( theString ) ) ;
+      }
+
+    // every developer prefix, estimated from menu activity
+    for ( std::unordered_map< ASAtom, OwnerCost >::iterator theIter = gOwners.begin() ; theIter != gOwners.end() ; ++theIter )
+      theOwners.push_back( theIter->second ) ;
+    std::sort( theOwners.begin(), theOwners.end(), IsCostlierOwner ) ;
+
+    strcpy( theString, "\r\nEstimated from menu activity during init, ranked by time (ms)\r\n\r\n  rank  estimated  events  menus  items  buttons  owner\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    for ( size_t index = 0 ; index < theOwners.size() ; index++ )
+      {
+        snprintf( theString, sizeof( theString ), "  %4d  %9.2f  %6d  %5d  %5d  %7d  %s\r\n", ( int )index + 1,
+                  APTiming::ToMilliseconds( theOwners[ index ].fEstimated ), ( int )theOwners[ index ].fEvents,
+                  ( int )theOwners[ index ].fMenus, ( int )theOwners[ index ].fMenuItems, ( int )theOwners[ index ].fToolButtons,
+                  ASAtomGetString( theOwners[ index ].fOwner ) ) ;
+        theLog->Write( theString, strlen( theString ) ) ;
+      }
+
+    delete( theLog ) ;
+
+  } // end WriteLoadReport
+
+// --------------------------
+// Rebuild the counts, since plug-ins may have changed the menus since startup.
+
+static ACCB1 void ACCB2 DoLoadProfile( void * data )
+  {
+    DURING
+
+      gOwners.clear() ;
+      AttributeMenuEvents() ;
+      CountInstalledItems() ;
+      WriteLoadReport() ;
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "writing the load profile" ) ;
+      APDiagnostics::Shared().ShowSummary() ;
+    END_HANDLER
+
+  } // end DoLoadProfile
+
+// --------------------------
+// Startup is over; stop recording and write the report.
+
+static ACCB1 void ACCB2 DoAVAppDidInitialize( void * data )
+  {
+    gAppDidInitializeTime = APTiming::GetNanoseconds() ;
+    gLoading = false ;
+
+    DoLoadProfile( NULL ) ;
+
+  } // end DoAVAppDidInitialize
+
+// -------------------------
+#pragma mark -- init
+// -------------------------
+
+static const APMenuItemSpec gMenuItemSpecs[] =
+  {
+    { "LoadProfiler...",  "DGAP:AboutLoadProfiler",  "AboutExtensions", NULL, NO_SHORTCUT, 0, NULL, NULL, NULL, &DoAboutLoadProfiler, NULL },
+    { "Load Profile...",  "DGAP:LoadProfile",        "Extensions",      NULL, NO_SHORTCUT, 0, NULL, NULL, NULL, &DoLoadProfile,       NULL }
+  } ;
+
+static ACCB1 boolean ACCB2 InitPlugInMenus( void )
+  {
+    DURING
+
+      if ( APMenuInstaller::Install( gMenuItemSpecs, APMenuItemCount( gMenuItemSpecs ), NULL, NULL ) == 0 )
+        E_RETURN( false ) ;
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "installing the LoadProfiler menu items" ) ;
+    END_HANDLER
+
+    return true ;
+
+  } // end InitPlugInMenus
+
+// -------------------------
+
+static ACCB1 boolean ACCB2 InitPlugIn( void )
+  {
+    boolean   theResult ;
+
+    MarkPhase( ASExtensionGetRegisteredName( gExtensionID ), kLoadPhaseInitStart, APTiming::GetNanoseconds() ) ;
+
+    theResult = InitPlugInMenus() ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+    MarkPhase( ASExtensionGetRegisteredName( gExtensionID ), kLoadPhaseInitEnd, APTiming::GetNanoseconds() ) ;
+
+    return theResult ;
+
+  } // end InitPlugIn
+
+// -------------------------
+
+static ACCB1 boolean ACCB2 UnloadPlugIn( void )
+  {
+    APDiagnostics::Shared().Close() ;
+
+    gProfiles.clear() ;
+    gOwners.clear() ;
+    gMenuEvents.clear() ;
+
+    return true ;
+
+  } // end UnloadPlugIn
+
+// -------------------------
+// Start listening as early as possible; everything after this is the init
+// phase of some plug-in.
+
+static ACCB1 boolean ACCB2 PreInitPlugIn( void )
+  {
+    ASAtom  theExtensionName = ASExtensionGetRegisteredName( gExtensionID ) ;
+
+    MarkPhase( theExtensionName, kLoadPhaseHandshake, gHandshakeTime ) ;
+    MarkPhase( theExtensionName, kLoadPhaseImportStart, APTiming::GetNanoseconds() ) ;
+
+    gMenuEvents.reserve( 4096 ) ;
+
+    APDiagnostics::Shared().SetLogName( "LoadProfilerDiagnostics.txt" ) ;
+
+    AVAppRegisterNotification( AVMenuItemWasAddedToMenuNSEL, gExtensionID, ASCallbackCreateNotification( AVMenuItemWasAddedToMenu, ( void * )DoAVMenuItemWasAddedToMenu ), NULL ) ;
+
+    AVAppRegisterNotification( AVMenuWasAddedToMenubarNSEL, gExtensionID, ASCallbackCreateNotification( AVMenuWasAddedToMenubar, ( void * )DoAVMenuWasAddedToMenubar ), NULL ) ;
+
+    AVAppRegisterNotification( AVAppDidInitializeNSEL, gExtensionID, ASCallbackCreateNotification( AVAppDidInitialize, ( void * )DoAVAppDidInitialize ), NULL ) ;
+
+    MarkPhase( theExtensionName, kLoadPhaseImportEnd, APTiming::GetNanoseconds() ) ;
+
+    return true ;
+
+  } // end PreInitPlugIn
+
+// -------------------------
+// Export LoadProfilerMarkPhase to the plug-ins that report their own phases.
+
+static ACCB1 boolean ACCB2 ExportHFTs( void )
+  {
+    HFTServer   theHFTServer ;
+
+    DURING
+
+      theHFTServer = HFTServerNew( kLoadProfilerHFTName, ASCallbackCreateProto( HFTServerProvideHFTProc, &ProvideLoadProfilerHFT ), NULL, NULL ) ;
+
+      gLoadProfilerHFT = HFTNew( theHFTServer, LoadProfilerNUMSELECTORS ) ;
+
+      HFTReplaceEntry( gLoadProfilerHFT, LoadProfilerMarkPhaseSEL,
+                        ASCallbackCreateReplacement( LoadProfilerMarkPhaseSEL, &DoLoadProfilerMarkPhase ), 0 ) ;
+
+    HANDLER
+      return false ;
+    END_HANDLER
+
+    return true ;
+
+  } // end ExportHFTs
+
+// -------------------------
+
+ACCB1 ASBool ACCB2 PIHandshake( Uns32 handshakeVersion, void *handshakeData )
+  {
+    gHandshakeTime = APTiming::GetNanoseconds() ;
+
+    if ( handshakeVersion == HANDSHAKE_V0200 )
+      {
+        PIHandshakeData_V0200 *hsData = ( PIHandshakeData_V0200 * )handshakeData ;
+
+        hsData->extensionName = ASAtomFromString( "DGAP:LoadProfiler" ) ;
+
+        hsData->exportHFTsCallback = ASCallbackCreateProto( PIExportHFTsProcType, ( void * )ExportHFTs ) ;
+
+        hsData->importReplaceAndRegisterCallback = ASCallbackCreateProto( PIImportReplaceAndRegisterProcType, ( void * )PreInitPlugIn ) ;
+
+        hsData->initCallback = ASCallbackCreateProto( PIInitProcType, ( void * )InitPlugIn ) ;
+
+        hsData->unloadCallback = ASCallbackCreateProto( PIUnloadProcType, ( void * )UnloadPlugIn ) ;
+
+        return true ;
+      }
+
+    return false ;
+
+  } // end PIHandshake
+
+// -------------------------
+
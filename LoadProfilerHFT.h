@@ -0,0 +1,84 @@
+/*
+  File:   LoadProfilerHFT.h
+
+  Contains: Host function table exported by the LoadProfiler plug-in.
+            Plug-ins import it to report exactly when each of their load
+            phases started and finished.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    The table cannot be imported until the importReplaceAndRegisterCallback, so
+    keep the time taken in PIHandshake and report it from there:
+
+      PIHandshake:          gHandshakeTime = APTiming::GetNanoseconds() ;
+      import callback:      theStart = APTiming::GetNanoseconds() ;
+                            gLoadProfilerHFT = ASExtensionMgrGetHFT( ASAtomFromString( kLoadProfilerHFTName ), kLoadProfilerHFTVersion ) ;
+                            ...
+                            LoadProfilerMark( kLoadPhaseHandshake, gHandshakeTime ) ;
+                            LoadProfilerMark( kLoadPhaseImportStart, theStart ) ;
+                            LoadProfilerMark( kLoadPhaseImportEnd, APTiming::GetNanoseconds() ) ;
+      init callback:        LoadProfilerMark( kLoadPhaseInitStart, ... ) and kLoadPhaseInitEnd
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+
+// --------------------------
+
+#define kLoadProfilerHFTName      "DGAP:LoadProfiler"
+#define kLoadProfilerHFTVersion   0x00010000
+
+extern HFT gLoadProfilerHFT ;
+
+// --------------------------
+// Times are APTiming::GetNanoseconds values.
+
+enum
+  {
+    kLoadPhaseHandshake = 0,
+    kLoadPhaseImportStart,
+    kLoadPhaseImportEnd,
+    kLoadPhaseInitStart,
+    kLoadPhaseInitEnd,
+    kLoadPhaseCount
+  } ;
+
+// --------------------------
+
+enum
+  {
+    LoadProfilerDUMMYBLANKSELECTOR,
+    LoadProfilerMarkPhaseSEL,
+    LoadProfilerNUMSELECTORSPlusOne
+  } ;
+
+#define LoadProfilerNUMSELECTORS ( LoadProfilerNUMSELECTORSPlusOne - 1 )
+
+// --------------------------
+
+typedef ACCBPROTO1 void ( ACCBPROTO2 * LoadProfilerMarkPhaseSELPROTO )( ASAtom inExtensionName, ASInt32 inPhase, ASUns64 inTime ) ;
+#define LoadProfilerMarkPhase ( *( ( LoadProfilerMarkPhaseSELPROTO )( gLoadProfilerHFT[ LoadProfilerMarkPhaseSEL ] ) ) )
+
+// --------------------------
+// Report a phase of the calling plug-in; does nothing when LoadProfiler is not loaded.
+
+inline void LoadProfilerMark( ASInt32 inPhase, ASUns64 inTime )
+  {
+    if ( gLoadProfilerHFT != NULL )
+      LoadProfilerMarkPhase( ASExtensionGetRegisteredName( gExtensionID ), inPhase, inTime ) ;
+  }
+
+// --------------------------
@@ -23,168 +23,70 @@
 #include "CosCalls.h"
 #include "ASCalls.h"
 
-// --------------------------
-//
-// Utility functions
-//
-// --------------------------
-// display a simple alert dialog with the error message.
-
-void DisplayErrorAlert( ASInt32 inError, const char * inString )
-  {
-    char          theStringBuffer[128] ;
-    
-    ASGetErrorString( inError, theStringBuffer, sizeof( theStringBuffer ) ) ;
-    
-    strcat( theStringBuffer, " " ) ;
-    strcat( theStringBuffer, inString ) ;
-    
-    AVAlert( ALERT_STOP, theStringBuffer, "OK", ( const char * )NULL, ( const char * )NULL, false ) ;
-    
-    return ;
-    
-  } // end DisplayErrorAlert
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-// --------------------------
-// Routine to handle the majority of menu items.
-// Note: this does not allow for the setting of command or accelerator keys.
-// inTitle is what is displayed in the user interface.
-// inMenuItemName is used internally and is independent of language.
+#include <set>
+#include <string>
+#include <vector>
 
-AVMenuItem CreateMenuItem( AVMenu inAVMenu, const char * inTitle, const char * inMenuItemName, 
-                                      AVComputeEnabledProc inAVComputeEnabledProc, void * inAVComputeEnabledProcData, 
-                                      AVExecuteProc inAVExecuteProc, void * inAVExecuteProcData )
-  {
-    AVMenuItem  theAVMenuItem ;
-          
-    DURING
+#if WIN_ENV
+#include <windows.h>
+#endif
 
-      theAVMenuItem = AVMenuItemNew( inTitle, inMenuItemName, ( AVMenu )NULL, false, NO_SHORTCUT, ( ASInt16 )0, NULL, gExtensionID ) ;
-
-      if ( inAVComputeEnabledProc != NULL )
-        AVMenuItemSetComputeEnabledProc( theAVMenuItem,
-                            ASCallbackCreateProto( AVComputeEnabledProc, inAVComputeEnabledProc ), inAVComputeEnabledProcData ) ;
-
-      if ( inAVExecuteProc != NULL )
-        AVMenuItemSetExecuteProc( theAVMenuItem, ASCallbackCreateProto( AVExecuteProc, inAVExecuteProc ), inAVExecuteProcData ) ;
-      
-    HANDLER
-      DisplayErrorAlert( ERRORCODE, "Error creating new menu item" ) ;
-      return ( AVMenuItem )NULL ;
-    END_HANDLER
-
-    return theAVMenuItem ;
-    
-  } // end CreateMenuItem
+#include "ListMenuNamesHFT.h"
+#include "APTiming.h"
+#include "APMenuInstaller.h"
+#include "APHandle.h"
+#include "APDiagnostics.h"
+#include "APTrace.h"
+#include "APBenchmark.h"
+#include "APReport.h"
+#include "APNotifier.h"
+#include "APTaskPool.h"
+#include "APPDFReverser.h"
+#include "LoadProfilerHFT.h"
 
 // --------------------------
-// Add a newly created menu item to a menu following the given menu item.
 
-void AddAfterMenuItem( const char *inTitle, const char * inMenuItemName, const char * inAfterMenuItemName, 
-                                  AVComputeEnabledProc inAVComputeEnabledProc,  void * inAVComputeEnabledProcData, 
-                                  AVExecuteProc inAVExecuteProc, void * inAVExecuteProcData )
-  {
-    AVMenubar   theAVMenubar ;
-    AVMenu      theAVMenu ;
-    AVMenuItem  theAVMenuItem ;
-    AVMenuItem  theAfterAVMenuItem ;
-    ASInt32     theError = 0 ;
-    ASInt16     index ;
-    
-    DURING
+HFT   gListMenuNamesHFT = NULL ;    // optional, present when the ListMenuNames plug-in is loaded
+HFT   gLoadProfilerHFT  = NULL ;    // optional, present when the LoadProfiler plug-in is loaded
 
-      theAVMenubar  = AVAppGetMenubar() ;
-      if ( theAVMenubar == NULL ) 
-        E_RTRN_VOID ;
+ASUns64   gHandshakeTime = 0 ;
 
-      theAfterAVMenuItem = AVMenubarAcquireMenuItemByName( theAVMenubar, inAfterMenuItemName ) ;
-      
-      theAVMenu = AVMenuItemGetParentMenu ( theAfterAVMenuItem ) ;
+// a document that looks reversed when it opens is offered the fix at idle time
+#define kOfferTicks         15      // 1/4 second
 
-      index = ( ASInt16 ) AVMenuGetMenuItemIndex( theAVMenu, theAfterAVMenuItem ) ;
+AVDoc     gSuspectAVDoc     = NULL ;
+ASInt32   gDocsChecked      = 0 ;
+ASInt32   gDocsSuspected    = 0 ;
+ASUns64   gDetectTime       = 0 ;   // nanoseconds, over gDocsChecked
+ASUns64   gDetectWorstStep  = 0 ;   // on open or in one idle
 
-      theAVMenuItem = CreateMenuItem( theAVMenu, inTitle, inMenuItemName, inAVComputeEnabledProc,
-                                      inAVComputeEnabledProcData, inAVExecuteProc, inAVExecuteProcData ) ;
-      if ( theAVMenuItem == NULL )
-        E_RTRN_VOID ;
-        
-      AVMenuAddMenuItem( theAVMenu, theAVMenuItem, index + 1 ) ;
-      
-      AVMenuItemRelease( theAVMenuItem ) ;
-    
-    HANDLER
-      theError = ERRORCODE ;
-      DisplayErrorAlert( theError, "Error adding new menu item" ) ;
-      ASRaise( theError ) ;
-    END_HANDLER
+// cancels any file still being reversed on a worker thread when the plug-in unloads
+APCancelToken   gReverseFileToken ;
 
-    return ;
-    
-  } // end AddAfterMenuItem
+// the UTF-8 output paths of files being reversed, so a second reverse started
+// before the first is written chooses another name; main thread only
+std::set< std::string >   gReverseFileOutputs ;
 
 // --------------------------
-// Append a newly created menu to the given menu after it creates the menu item.
-
-AVMenuItem AppendMenuItem( AVMenu inAVMenu, const char * inTitle, const char * inMenuItemName, 
-                                    AVComputeEnabledProc inAVComputeEnabledProc, 
-                                    AVExecuteProc inAVExecuteProc, void * inAVExecuteProcData )
-  {
-    AVMenuItem  theAVMenuItem ;
-    ASInt32     theError = 0 ;
-    
-    DURING
-
-      theAVMenuItem = CreateMenuItem( inAVMenu, inTitle, inMenuItemName,
-                                      inAVComputeEnabledProc, NULL, inAVExecuteProc, inAVExecuteProcData ) ;
-      if ( theAVMenuItem == NULL )
-        E_RETURN( ( _t_AVMenuItem * )NULL ) ;
-        
-      AVMenuAddMenuItem( inAVMenu, theAVMenuItem, APPEND_MENUITEM ) ;
-      
-      AVMenuItemRelease( theAVMenuItem ) ;
-    
-    HANDLER
-      theError = ERRORCODE ;
-      DisplayErrorAlert( theError, "Error appending menu item" ) ;
-      ASRaise( theError ) ;
-    END_HANDLER
-
-    return theAVMenuItem ;
-    
-  } // end AppendMenuItem
-  
+//
+// Utility functions
+//
 // --------------------------
-// Append a menu item to the About sub-menu.
+// Anchor lookup for APMenuInstaller through the ListMenuNames menu index when
+// it is available; returning NULL makes the installer walk the menubar.
 
-void AppendToAboutMenu( const char * inTitle, const char * inMenuItemName, AVExecuteProc inAVExecuteProc )
+static AVMenuItem FindAnchorMenuItem( const char * inMenuItemName, AVMenu * outParentAVMenu, ASInt32 * outIndex )
   {
-    AVMenubar   theAVMenubar ;
-    AVMenu      theAboutAVMenu ;
-    ASInt32     theError = 0 ;
-
-    DURING
-
-      theAVMenubar  = AVAppGetMenubar() ;
-      if ( theAVMenubar == NULL ) 
-        E_RTRN_VOID ;
+    if ( gListMenuNamesHFT == NULL )
+      return ( AVMenuItem )NULL ;
 
-      theAboutAVMenu  = AVMenubarAcquireMenuByName( theAVMenubar, "AboutExtensions" ) ;
-      if ( theAboutAVMenu == NULL )
-        E_RTRN_VOID ;
-    
-      AppendMenuItem( theAboutAVMenu, inTitle, inMenuItemName, ( AVComputeEnabledProc )NULL, inAVExecuteProc, NULL ) ;
-      
-      AVMenuRelease( theAboutAVMenu ) ;
-    
-    HANDLER
-      theError = ERRORCODE ;
-      DisplayErrorAlert( theError, "Error adding About Reverse Pages menu item" ) ;
-      ASRaise( theError ) ;
-    END_HANDLER
+    return MenuIndexAcquireMenuItemByName( ASAtomFromString( inMenuItemName ), outParentAVMenu, outIndex ) ;
 
-    return ;
-    
-  } // end AppendToAboutMenu
+  } // end FindAnchorMenuItem
 
 // --------------------------
 //
@@ -207,7 +109,7 @@ static ACCB1 ASBool ACCB2 DoComputeEnabled( void * inPermRequired )
 
     PDPerms theDocPDPerms = PDDocGetPermissions( AVDocGetPDDoc( theAVDoc ) ) ;
     
-    return ( !inPermRequired || ( ( ( PDPerms )inPermRequired & theDocPDPerms ) != 0 ) ) ;
+    return ( !inPermRequired || ( ( ( PDPerms )( size_t )inPermRequired & theDocPDPerms ) != 0 ) ) ;
 
   } // end DoComputeEnabled
 
@@ -225,78 +127,1185 @@ static ACCB1 void ACCB2 DoAboutReversePages( void * ioUserData )
   } // end DoAboutReversePages
 
 // --------------------------
-// Reverse the order of pages in the current active document.
+// Which pages a reverse also turns the right way up.  Odd and even are page
+// numbers as scanned, i.e. before the reverse.
+
+enum
+  {
+    kRotateNone = 0,
+    kRotateAll,
+    kRotateOdd,
+    kRotateEven,
+    kRotateDetected
+  } ;
+
+#define kMinWordsToDetect       8       // fewer words than this say nothing about which way up a page is
+#define kTextRotationUnknown    -1
+
+// --------------------------
+// 180 when most of the page's words run right to left and bottom to top in
+// user space, 0 when most run the usual way, and kTextRotationUnknown when
+// there is too little text to tell, e.g. a scan with no text layer.
+
+static ASInt32 GetTextRotation( PDWordFinder inWordFinder, ASInt32 inPageNum )
+  {
+    PDWord        theWordList ;
+    PDWord        theSortTable ;
+    ASFixedQuad   theQuad ;
+    ASInt32       theNumWords   = 0 ;
+    ASInt32       theUpright    = 0 ;
+    ASInt32       theInverted   = 0 ;
+
+    PDWordFinderAcquireWordList( inWordFinder, inPageNum, &theWordList, &theSortTable, &theNumWords ) ;
+
+    for ( ASInt32 index = 0 ; index < theNumWords ; index++ )
+      {
+        if ( PDWordGetNthCharQuad( PDWordFinderGetNthWord( inWordFinder, index ), 0, &theQuad ) == false )
+          continue ;
+
+        if ( ( theQuad.tr.h > theQuad.tl.h ) && ( theQuad.tl.v > theQuad.bl.v ) )
+          theUpright += 1 ;
+        else if ( ( theQuad.tr.h < theQuad.tl.h ) && ( theQuad.tl.v < theQuad.bl.v ) )
+          theInverted += 1 ;
+      }
+
+    PDWordFinderReleaseWordList( inWordFinder, inPageNum ) ;
+
+    if ( theUpright + theInverted < kMinWordsToDetect )
+      return kTextRotationUnknown ;
+
+    return ( theInverted > theUpright ) ? 180 : 0 ;
+
+  } // end GetTextRotation
+
+// --------------------------
+// Reverse the order of inPDDoc's pages, turning the pages inRule picks
+// through 180 degrees on the way, and return how many pages had too little
+// text to tell which way up they were.  Before step n the page scanned as
+// page n + 1 is still at index n, with the pages before it already reversed
+// in front of it, so each page is rotated and moved in the same walk of the
+// page tree.  A raise is passed on once the page and word finder are released.
+
+static ASInt32 ReversePDDoc( PDDoc inPDDoc, ASInt32 inRule )
+  {
+    ASInt32                 theNumberOfPages ;
+    ASInt32                 theRotate ;
+    ASInt32                 theTextRotation ;
+    ASInt32                 theUnknownPages   = 0 ;
+    ASBool                  theTurn ;
+    PDWordFinder volatile   theWordFinder     = NULL ;    // volatile: set in DURING and read in the HANDLER
+    APPDPageRef             thePDPageRef ;
+
+    DURING
+
+      // get the count of pages in the document
+      theNumberOfPages = PDDocGetNumPages( inPDDoc ) ;
+
+      if ( inRule == kRotateDetected )
+        theWordFinder = PDDocCreateWordFinderUCS( inPDDoc, WF_LATEST_VERSION, 0, NULL ) ;
+
+      // loop through all of the pages changing the page order
+      for ( ASInt32 index = 0 ; index < theNumberOfPages ; index++ )
+        {
+          if ( inRule != kRotateNone )
+            {
+              thePDPageRef.Reset( PDDocAcquirePage( inPDDoc, index ) ) ;
+              theRotate = PDPageGetRotate( thePDPageRef ) ;
+
+              switch ( inRule )
+                {
+                  case kRotateAll :   theTurn = true ;                  break ;
+                  case kRotateOdd :   theTurn = ( ( index & 1 ) == 0 ) ; break ;
+                  case kRotateEven :  theTurn = ( ( index & 1 ) != 0 ) ; break ;
+
+                  default :
+                    theTextRotation = GetTextRotation( theWordFinder, index ) ;
+                    if ( theTextRotation == kTextRotationUnknown )
+                      theUnknownPages += 1 ;
+                    theTurn = ( theTextRotation != kTextRotationUnknown ) && ( ( theTextRotation + theRotate ) % 360 == 180 ) ;
+                    break ;
+                }
+
+              if ( theTurn == true )
+                PDPageSetRotate( thePDPageRef, ( PDRotate )( ( theRotate + 180 ) % 360 ) ) ;
+
+              thePDPageRef.Reset( NULL ) ;
+            }
+
+          if ( index != 0 )
+            PDDocMovePage( inPDDoc, PDBeforeFirstPage, index ) ;
+        }
+
+    HANDLER
+      thePDPageRef.Reset( NULL ) ;
+      if ( theWordFinder != NULL )
+        PDWordFinderDestroy( theWordFinder ) ;
+      RERAISE() ;
+    END_HANDLER
+
+    if ( theWordFinder != NULL )
+      PDWordFinderDestroy( theWordFinder ) ;
+
+    return theUnknownPages ;
+
+  } // end ReversePDDoc
+
+// --------------------------
+// Reverse the order of pages in the current active document, turning the
+// pages ioUserData's rotation rule picks through 180 degrees on the way.
 
 static ACCB1 void ACCB2 DoReversePages( void * ioUserData )
   {
-    AVDoc       theAVDoc ;
-    PDDoc       thePDDoc ;
-    AVPageView  theAVPageView ;
-    AVCursor    theAVCursor ;
-    AVCursor    theWaitAVCursor ;
-    ASInt32     theNumberOfPages = 0 ;
-    ASInt32     index = 0 ;
+    AVDoc             theAVDoc ;
+    PDDoc             thePDDoc ;
+    AVPageView        theAVPageView ;
+    AVCursor          theAVCursor ;
+    AVCursor          theWaitAVCursor ;
+    volatile ASInt32  theUnknownPages   = 0 ;   // volatile: set in DURING and read after it
+    char              theString[ 256 ] ;
+    APPDDocRef        thePDDocRef ;     // outside DURING so it is released even if a page move raises
+    APTraceScope      theTraceScope( "ReversePages" ) ;
     
+    // change the cursor to the wait cursor
+    theAVCursor = AVSysGetCursor() ;
+    theWaitAVCursor = AVSysGetStandardCursor( WAIT_CURSOR ) ;
+    AVSysSetCursor( theWaitAVCursor ) ;
+
     DURING
       
-      // change the cursor to the wait cursor
-      theAVCursor = AVSysGetCursor() ;
-      theWaitAVCursor = AVSysGetStandardCursor( WAIT_CURSOR ) ;
-      AVSysSetCursor( theWaitAVCursor ) ;
-  
       // get the AVDoc for the frontmost document
       theAVDoc = AVAppGetActiveDoc() ;
       
       thePDDoc = AVDocGetPDDoc( theAVDoc ) ;
       
       PDDocAcquire( thePDDoc ) ;
+      thePDDocRef.Reset( thePDDoc ) ;
       
-      // get the count of pages in the document
-      theNumberOfPages = PDDocGetNumPages( thePDDoc ) ;
-  
-      // loop through all of the pages changing the page order
-      for ( index = 1 ; index < theNumberOfPages ; index++ )
-        PDDocMovePage( thePDDoc, PDBeforeFirstPage, index ) ;
+      theUnknownPages = ReversePDDoc( thePDDoc, ( ASInt32 )( size_t )ioUserData ) ;
         
-      PDDocRelease( thePDDoc ) ;
-      
       // display the first page on screen
       theAVPageView = AVDocGetPageView ( theAVDoc ) ;
       AVPageViewGoTo ( theAVPageView, 0 ) ;
-    
-      // change the cursor back to the system cursor
-      AVSysSetCursor( theAVCursor ) ;
   
     HANDLER
-      DisplayErrorAlert( ERRORCODE, "Error reversing pages" ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "reversing pages" ) ;
     END_HANDLER
 
+    // change the cursor back to the system cursor
+    AVSysSetCursor( theAVCursor ) ;
+
+    if ( theUnknownPages != 0 )
+      {
+        snprintf( theString, sizeof( theString ), "%d pages have too little text to tell which way up they are and were left as they were",
+                  ( int )theUnknownPages ) ;
+        APDiagnostics::Shared().Report( 0, theString ) ;
+      }
+
+    APDiagnostics::Shared().ShowSummary() ;
+
     return ;
 
   } // end DoReversePages
 
+// --------------------------
+//
+// Reverse order detection
+//
+// --------------------------
+// Only a few pages at each end of the document are looked at, so the cost is
+// the same for 10 pages as for 10,000.  Each clue gives votes for ascending
+// or descending order; a document is only called reversed when no vote says
+// otherwise, since offering to reverse a good document is worse than missing
+// a reversed one.
+
+#define kSamplePages        3                       // pages looked at each end
+#define kSampleBookmarks    4                       // top-level bookmarks looked at each end
+#define kMarginDivisor      8                       // page numbers are looked for in the top and bottom eighth
+#define kMaxPrintedNumber   99999
+#define kMaxSampleContent   ( 256 * 1024 )          // bytes of page content; bigger pages are not read
+#define kMinReversedVotes   2
+#define kNoPageNumber       -1
+
+struct APOrderVotes
+  {
+    ASInt32   fAscending ;
+    ASInt32   fDescending ;
+  } ;
+
+// a document whose printed page numbers are still being read at idle
+struct APOrderCheck
+  {
+    AVDoc         fAVDoc ;
+    PDWordFinder  fWordFinder ;                     // made when the first page is read
+    ASInt32       fSamples[ 2 * kSamplePages ] ;    // page indexes, in document order
+    ASInt32       fNumbers[ 2 * kSamplePages ] ;    // printed on those pages
+    ASInt32       fNumSamples ;
+    ASInt32       fNumRead ;
+    APOrderVotes  fVotes ;                          // from the labels and bookmarks
+    ASUns64       fTime ;                           // nanoseconds, over every step
+  } ;
+
+std::vector< APOrderCheck >   gOrderChecks ;
+
+// --------------------------
+// inFirst and inSecond are numbers found in document order; a number that
+// goes down is a vote for reversed.
+
+static void VoteOrder( ASInt32 inFirst, ASInt32 inSecond, APOrderVotes & ioVotes )
+  {
+    if ( ( inFirst == kNoPageNumber ) || ( inSecond == kNoPageNumber ) || ( inFirst == inSecond ) )
+      return ;
+
+    if ( inSecond > inFirst )
+      ioVotes.fAscending += 1 ;
+    else
+      ioVotes.fDescending += 1 ;
+
+  } // end VoteOrder
+
+// --------------------------
+// The page indexes looked at, in document order: the first and the last
+// kSamplePages, or every page of a short document.
+
+static ASInt32 GetSamplePages( ASInt32 inNumPages, ASInt32 outPages[ 2 * kSamplePages ] )
+  {
+    ASInt32   theCount = 0 ;
+
+    for ( ASInt32 index = 0 ; ( index < kSamplePages ) && ( index < inNumPages ) ; index++ )
+      outPages[ theCount++ ] = index ;
+
+    for ( ASInt32 index = inNumPages - kSamplePages ; index < inNumPages ; index++ )
+      {
+        if ( index >= kSamplePages )
+          outPages[ theCount++ ] = index ;
+      }
+
+    return theCount ;
+
+  } // end GetSamplePages
+
+// --------------------------
+// Page labels number the pages of each range upward from its start, so two
+// pages in one range always agree with the document order and say nothing.
+// Only labels from different ranges, as left by combining documents or
+// moving labelled pages, are compared.
+
+static void VotePageLabels( PDDoc inPDDoc, const ASInt32 * inPages, ASInt32 inNumPages, APOrderVotes & ioVotes )
+  {
+    PDPageLabel   thePDPageLabel ;
+    ASInt32       theFirstPage ;
+    ASInt32       theLastPage ;
+    ASInt32       theRange ;
+    ASInt32       theNumber ;
+    ASInt32       thePrevRange  = kNoPageNumber ;
+    ASInt32       thePrevNumber = kNoPageNumber ;
+
+    for ( ASInt32 index = 0 ; index < inNumPages ; index++ )
+      {
+        thePDPageLabel = PDDocGetPageLabel( inPDDoc, inPages[ index ], &theFirstPage, &theLastPage ) ;
+        if ( PDPageLabelIsValid( thePDPageLabel ) == false )
+          continue ;
+
+        theRange  = theFirstPage ;
+        theNumber = PDPageLabelGetStart( thePDPageLabel ) + inPages[ index ] - theFirstPage ;
+
+        if ( ( thePrevRange != kNoPageNumber ) && ( theRange != thePrevRange ) )
+          VoteOrder( thePrevNumber, theNumber, ioVotes ) ;
+
+        thePrevRange  = theRange ;
+        thePrevNumber = theNumber ;
+      }
+
+  } // end VotePageLabels
+
+// --------------------------
+// The page index a bookmark goes to, or kNoPageNumber when it goes anywhere
+// else, such as another document or a web page.
+
+static ASInt32 GetBookmarkPage( PDDoc inPDDoc, PDBookmark inPDBookmark )
+  {
+    PDAction            thePDAction ;
+    PDViewDestination   thePDViewDest ;
+    CosObj              thePageCosObj ;
+
+    thePDAction = PDBookmarkGetAction( inPDBookmark ) ;
+    if ( ( PDActionIsValid( thePDAction ) == false ) || ( PDActionGetSubtype( thePDAction ) != ASAtomFromString( "GoTo" ) ) )
+      return kNoPageNumber ;
+
+    thePDViewDest = PDViewDestResolve( PDActionGetDest( thePDAction ), inPDDoc ) ;
+    if ( PDViewDestIsValid( thePDViewDest ) == false )
+      return kNoPageNumber ;
+
+    thePageCosObj = CosArrayGet( PDViewDestGetCosObj( thePDViewDest ), 0 ) ;
+    if ( CosObjGetType( thePageCosObj ) != CosDict )
+      return kNoPageNumber ;
+
+    return PDPageNumFromCosObj( thePageCosObj ) ;
+
+  } // end GetBookmarkPage
+
+// --------------------------
+// Chapters are bookmarked in reading order, so top-level bookmarks whose
+// pages go down the outline point to a reversed document.  Only the first
+// and last kSampleBookmarks are looked at.
+
+static void VoteBookmarks( PDDoc inPDDoc, APOrderVotes & ioVotes )
+  {
+    PDBookmark    theRoot = PDDocGetBookmarkRoot( inPDDoc ) ;
+    PDBookmark    theFront ;
+    PDBookmark    theBack ;
+    ASInt32       theBackPages[ kSampleBookmarks ] ;
+    ASInt32       theNumBack  = 0 ;
+    ASInt32       thePage ;
+    ASInt32       thePrevPage = kNoPageNumber ;
+
+    if ( ( PDBookmarkIsValid( theRoot ) == false ) || ( PDBookmarkHasChildren( theRoot ) == false ) )
+      return ;
+
+    theFront = PDBookmarkGetFirstChild( theRoot ) ;
+    for ( ASInt32 index = 0 ; ( index < kSampleBookmarks ) && PDBookmarkIsValid( theFront ) ; index++ )
+      {
+        thePage = GetBookmarkPage( inPDDoc, theFront ) ;
+        VoteOrder( thePrevPage, thePage, ioVotes ) ;
+        if ( thePage != kNoPageNumber )
+          thePrevPage = thePage ;
+
+        theFront = PDBookmarkGetNext( theFront ) ;
+      }
+
+    // the walk from the end stops where the walk from the front left off
+    if ( PDBookmarkIsValid( theFront ) == false )
+      return ;
+
+    theBack = PDBookmarkGetLastChild( theRoot ) ;
+    while ( ( theNumBack < kSampleBookmarks ) && PDBookmarkIsValid( theBack ) )
+      {
+        theBackPages[ theNumBack++ ] = GetBookmarkPage( inPDDoc, theBack ) ;
+
+        if ( PDBookmarkEqual( theBack, theFront ) )
+          break ;
+
+        theBack = PDBookmarkGetPrev( theBack ) ;
+      }
+
+    for ( ASInt32 index = theNumBack - 1 ; index >= 0 ; index-- )
+      {
+        VoteOrder( thePrevPage, theBackPages[ index ], ioVotes ) ;
+        if ( theBackPages[ index ] != kNoPageNumber )
+          thePrevPage = theBackPages[ index ] ;
+      }
+
+  } // end VoteBookmarks
+
+// --------------------------
+// The length of inPDPage's content streams as stored.  Finding a page's words
+// costs about this much, so a page over kMaxSampleContent, such as a large
+// scan with a text layer, is not read.
+
+static ASInt32 GetContentLength( PDPage inPDPage )
+  {
+    CosObj    theContents = CosDictGet( PDPageGetCosObj( inPDPage ), ASAtomFromString( "Contents" ) ) ;
+    CosObj    theStream ;
+    ASInt32   theLength   = 0 ;
+
+    if ( CosObjGetType( theContents ) == CosStream )
+      return CosStreamLength( theContents ) ;
+
+    if ( CosObjGetType( theContents ) != CosArray )
+      return 0 ;
+
+    for ( ASInt32 index = 0 ; index < CosArrayLength( theContents ) ; index++ )
+      {
+        theStream = CosArrayGet( theContents, index ) ;
+        if ( CosObjGetType( theStream ) == CosStream )
+          theLength += CosStreamLength( theStream ) ;
+      }
+
+    return theLength ;
+
+  } // end GetContentLength
+
+// --------------------------
+// The number printed in the top or bottom margin of a page, taken as the
+// all-digit word nearest the edge, or kNoPageNumber when there is none or
+// the page is too big to read.
+
+static ASInt32 GetPrintedPageNumber( PDDoc inPDDoc, PDWordFinder inWordFinder, ASInt32 inPageNum )
+  {
+    PDWord            theWordList ;
+    PDWord            theSortTable ;
+    PDWord            thePDWord ;
+    ASFixedRect       theCropBox ;
+    ASFixedQuad       theQuad ;
+    ASFixed           theBand ;
+    ASFixed           theDistance ;
+    ASFixed           theBestDistance = 0 ;
+    ASInt32           theNumWords     = 0 ;
+    ASInt32           theNumber       = kNoPageNumber ;
+    ASInt32           theLength ;
+    char              theString[ 16 ] ;
+    volatile ASBool   theHaveWords    = false ;     // set in DURING, read in HANDLER
+    APPDPageRef       thePDPageRef ;                // outside DURING; released in HANDLER
+
+    DURING
+
+      thePDPageRef.Reset( PDDocAcquirePage( inPDDoc, inPageNum ) ) ;
+
+      if ( GetContentLength( thePDPageRef ) > kMaxSampleContent )
+        E_RETURN( kNoPageNumber ) ;
+
+      PDPageGetCropBox( thePDPageRef, &theCropBox ) ;
+      theBand = ( theCropBox.top - theCropBox.bottom ) / kMarginDivisor ;
+
+      PDWordFinderAcquireWordList( inWordFinder, inPageNum, &theWordList, &theSortTable, &theNumWords ) ;
+      theHaveWords = true ;
+
+      for ( ASInt32 index = 0 ; index < theNumWords ; index++ )
+        {
+          thePDWord = PDWordFinderGetNthWord( inWordFinder, index ) ;
+
+          if ( PDWordGetNthQuad( thePDWord, 0, &theQuad ) == false )
+            continue ;
+
+          if ( theQuad.bl.v < theCropBox.bottom + theBand )
+            theDistance = theQuad.bl.v - theCropBox.bottom ;
+          else if ( theQuad.tl.v > theCropBox.top - theBand )
+            theDistance = theCropBox.top - theQuad.tl.v ;
+          else
+            continue ;
+
+          if ( ( theNumber != kNoPageNumber ) && ( theDistance >= theBestDistance ) )
+            continue ;
+
+          theLength = PDWordGetString( thePDWord, theString, sizeof( theString ) ) ;
+          if ( ( theLength <= 0 ) || ( theLength >= ( ASInt32 )sizeof( theString ) ) )
+            continue ;
+
+          theString[ theLength ] = 0 ;
+          if ( strspn( theString, "0123456789" ) != ( size_t )theLength )
+            continue ;
+
+          if ( atoi( theString ) > kMaxPrintedNumber )
+            continue ;
+
+          theNumber       = atoi( theString ) ;
+          theBestDistance = theDistance ;
+        }
+
+      theHaveWords = false ;
+      PDWordFinderReleaseWordList( inWordFinder, inPageNum ) ;
+
+    HANDLER
+      if ( theHaveWords )
+        PDWordFinderReleaseWordList( inWordFinder, inPageNum ) ;
+      thePDPageRef.Reset( NULL ) ;
+      RERAISE() ;
+    END_HANDLER
+
+    return theNumber ;
+
+  } // end GetPrintedPageNumber
+
+// --------------------------
+// Labels and bookmarks cost next to nothing and are voted on straight away;
+// the printed page numbers need each sampled page's text, so they are read
+// one page per call to ReadNextSample.  Pages are taken alternately from
+// each end: 0, n - 1, 1, n - 2, ...
+
+static void StartOrderCheck( PDDoc inPDDoc, APOrderCheck & ioCheck )
+  {
+    ioCheck.fWordFinder = NULL ;
+    ioCheck.fNumSamples = 0 ;
+    ioCheck.fNumRead    = 0 ;
+    ioCheck.fVotes.fAscending  = 0 ;
+    ioCheck.fVotes.fDescending = 0 ;
+    ioCheck.fTime       = 0 ;
+
+    ioCheck.fNumSamples = GetSamplePages( PDDocGetNumPages( inPDDoc ), ioCheck.fSamples ) ;
+    for ( ASInt32 index = 0 ; index < ioCheck.fNumSamples ; index++ )
+      ioCheck.fNumbers[ index ] = kNoPageNumber ;
+
+    VotePageLabels( inPDDoc, ioCheck.fSamples, ioCheck.fNumSamples, ioCheck.fVotes ) ;
+    VoteBookmarks( inPDDoc, ioCheck.fVotes ) ;
+
+  } // end StartOrderCheck
+
+// --------------------------
+// Reads the printed number of the next sampled page; false once every
+// sampled page has been read.
+
+static ASBool ReadNextSample( PDDoc inPDDoc, APOrderCheck & ioCheck )
+  {
+    ASInt32   theSlot ;
+    ASInt32   theIndex = ioCheck.fNumRead ;
+
+    if ( theIndex >= ioCheck.fNumSamples )
+      return false ;
+
+    if ( ioCheck.fWordFinder == NULL )
+      ioCheck.fWordFinder = PDDocCreateWordFinder( inPDDoc, NULL, NULL, NULL, WF_LATEST_VERSION, 0, NULL ) ;
+
+    // counted first, so a page that raises is not read again
+    ioCheck.fNumRead += 1 ;
+
+    theSlot = ( ( theIndex & 1 ) == 0 ) ? theIndex / 2 : ioCheck.fNumSamples - 1 - theIndex / 2 ;
+    ioCheck.fNumbers[ theSlot ] = GetPrintedPageNumber( inPDDoc, ioCheck.fWordFinder, ioCheck.fSamples[ theSlot ] ) ;
+
+    return ioCheck.fNumRead < ioCheck.fNumSamples ;
+
+  } // end ReadNextSample
+
+// --------------------------
+// Destroys the check's word finder and gives the verdict.  A document is
+// called reversed on kMinReversedVotes descending votes and no ascending
+// one; the votes may all come from one kind of clue, so a scanned document
+// with printed numbers and no labels or bookmarks can still be caught.
+
+static ASBool EndOrderCheck( APOrderCheck & ioCheck )
+  {
+    APOrderVotes  theVotes      = ioCheck.fVotes ;
+    ASInt32       thePrevNumber = kNoPageNumber ;
+
+    if ( ioCheck.fWordFinder != NULL )
+      {
+        PDWordFinderDestroy( ioCheck.fWordFinder ) ;
+        ioCheck.fWordFinder = NULL ;
+      }
+
+    for ( ASInt32 index = 0 ; index < ioCheck.fNumSamples ; index++ )
+      {
+        VoteOrder( thePrevNumber, ioCheck.fNumbers[ index ], theVotes ) ;
+        if ( ioCheck.fNumbers[ index ] != kNoPageNumber )
+          thePrevNumber = ioCheck.fNumbers[ index ] ;
+      }
+
+    return ( theVotes.fDescending >= kMinReversedVotes ) && ( theVotes.fAscending == 0 ) ;
+
+  } // end EndOrderCheck
+
+// --------------------------
+// Whether inPDDoc's pages are most likely in reverse order, with every
+// sampled page read in one go.  Documents that open are checked a page at a
+// time at idle instead; this is what the benchmark times.
+
+static ASBool LooksReversed( PDDoc inPDDoc )
+  {
+    APOrderCheck      theCheck ;
+    volatile ASBool   theFailed = false ;
+
+    theCheck.fWordFinder = NULL ;
+
+    DURING
+      StartOrderCheck( inPDDoc, theCheck ) ;
+      while ( ReadNextSample( inPDDoc, theCheck ) )
+        ;
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "checking the page order of a document" ) ;
+      theFailed = true ;
+    END_HANDLER
+
+    if ( EndOrderCheck( theCheck ) == false )
+      return false ;
+
+    return ( theFailed == false ) ;
+
+  } // end LooksReversed
+
+// --------------------------
+// DocDidOpen subscriber: only the labels and bookmarks are looked at here.
+// The printed page numbers are read from the idle proc, one page per idle,
+// so neither opening the document nor any one idle waits on more than a
+// single page's text.
+
+static void DoAVDocDidOpen( const APNotification & inNotification, void * data )
+  {
+    APTraceScope      theTraceScope( "CheckPageOrder" ) ;
+    APOrderCheck      theCheck ;
+    ASUns64           theStartTime = APTiming::GetNanoseconds() ;
+    volatile ASBool   theStarted   = false ;
+
+    if ( ( inNotification.fError != 0 ) || ( inNotification.fAVDoc == NULL ) )
+      return ;
+
+    theCheck.fAVDoc = inNotification.fAVDoc ;
+
+    DURING
+      StartOrderCheck( AVDocGetPDDoc( theCheck.fAVDoc ), theCheck ) ;
+      theStarted = true ;
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "checking the page order of a document that opened" ) ;
+    END_HANDLER
+
+    if ( theStarted == false )
+      return ;
+
+    theCheck.fTime = APTiming::GetNanoseconds() - theStartTime ;
+    if ( theCheck.fTime > gDetectWorstStep )
+      gDetectWorstStep = theCheck.fTime ;
+
+    gOrderChecks.push_back( theCheck ) ;
+
+  } // end DoAVDocDidOpen
+
+// --------------------------
+
+static void DoAVDocWillClose( const APNotification & inNotification, void * data )
+  {
+    if ( inNotification.fAVDoc == gSuspectAVDoc )
+      gSuspectAVDoc = NULL ;
+
+    // a check still reading the document's pages is dropped with its word finder
+    for ( size_t index = 0 ; index < gOrderChecks.size() ; index++ )
+      {
+        if ( gOrderChecks[ index ].fAVDoc != inNotification.fAVDoc )
+          continue ;
+
+        DURING
+          EndOrderCheck( gOrderChecks[ index ] ) ;
+        HANDLER
+          APDiagnostics::Shared().Report( ERRORCODE, "dropping the page order check of a closing document" ) ;
+        END_HANDLER
+
+        gOrderChecks.erase( gOrderChecks.begin() + index ) ;
+        break ;
+      }
+
+  } // end DoAVDocWillClose
+
+// --------------------------
+// Reads one sampled page of the oldest pending check, and gives its verdict
+// once every sampled page has been read.
+
+static void StepOrderCheck( void )
+  {
+    ASUns64           theStartTime = APTiming::GetNanoseconds() ;
+    ASUns64           theTime ;
+    volatile ASBool   theMore      = false ;
+    volatile ASBool   theFailed    = false ;
+    volatile ASBool   theReversed  = false ;
+
+    if ( gOrderChecks.empty() )
+      return ;
+
+    APOrderCheck &    theCheck = gOrderChecks.front() ;
+
+    DURING
+      theMore = ReadNextSample( AVDocGetPDDoc( theCheck.fAVDoc ), theCheck ) ;
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "checking the page order of a document that opened" ) ;
+      theFailed = true ;
+    END_HANDLER
+
+    if ( theMore && ( theFailed == false ) )
+      {
+        theTime = APTiming::GetNanoseconds() - theStartTime ;
+        theCheck.fTime += theTime ;
+        if ( theTime > gDetectWorstStep )
+          gDetectWorstStep = theTime ;
+        return ;
+      }
+
+    DURING
+      theReversed = EndOrderCheck( theCheck ) ;
+    HANDLER
+      theFailed = true ;
+    END_HANDLER
+
+    theTime = APTiming::GetNanoseconds() - theStartTime ;
+    theCheck.fTime += theTime ;
+    if ( theTime > gDetectWorstStep )
+      gDetectWorstStep = theTime ;
+
+    if ( theReversed && ( theFailed == false ) && ( gSuspectAVDoc == NULL ) )
+      {
+        gSuspectAVDoc   = theCheck.fAVDoc ;
+        gDocsSuspected += 1 ;
+      }
+
+    gDocsChecked += 1 ;
+    gDetectTime  += theCheck.fTime ;
+
+    gOrderChecks.erase( gOrderChecks.begin() ) ;
+
+  } // end StepOrderCheck
+
+// --------------------------
+// Idle proc: once a document that looks reversed is the front document, ask
+// once whether to reverse it.
+
+static ACCB1 void ACCB2 DoOfferReverse( void * data )
+  {
+    char    theString[ 512 ] ;
+    char *  theTitle ;
+    ASText  theASText ;
+
+    StepOrderCheck() ;
+
+    if ( ( gSuspectAVDoc == NULL ) || ( AVAppGetActiveDoc() != gSuspectAVDoc ) || AVAppIsModal() )
+      return ;
+
+    // cleared first, as the alert runs idle procs of its own
+    gSuspectAVDoc = NULL ;
+
+    theASText = ASTextNew() ;
+    AVWindowGetTitle( AVDocGetAVWindow( AVAppGetActiveDoc() ), theASText ) ;
+    theTitle = ASTextGetEncodedCopy( theASText, ( ASHostEncoding )PDGetHostEncoding() ) ;
+    ASTextDestroy( theASText ) ;
+
+    snprintf( theString, sizeof( theString ), "The pages of %s look like they are in reverse order.  Reverse them now?",
+              ( theTitle != NULL ) ? theTitle : "this document" ) ;
+    ASfree( theTitle ) ;
+
+    if ( AVAlert( ALERT_QUESTION, theString, "Reverse", "Not Now", ( const char * )NULL, true ) == 1 )
+      DoReversePages( ( void * )kRotateNone ) ;
+
+  } // end DoOfferReverse
+
+// --------------------------
+//
+// Reversing the saved file off the main thread
+//
+// --------------------------
+// APPDFReverser makes no Acrobat calls, so it runs on an APTaskPool worker
+// while Acrobat stays responsive, and the new file is opened from the done
+// proc back on the main thread.
+
+#define kMaxOutputNames     100     // "<name> reversed 100.pdf" is the last name tried
+
+struct APReverseFileJob
+  {
+    std::string   fInputPath ;          // UTF-8, for APPDFReverser
+    std::string   fOutputPath ;
+    ASFileSys     fFileSys ;
+    ASPathName    fOutputPathName ;     // to open the result; released with the job
+    int           fResult ;
+    char          fMessage[ 512 ] ;
+  } ;
+
+// --------------------------
+
+static void DeleteReverseFileJob( APReverseFileJob * inJob )
+  {
+    if ( inJob->fOutputPath.empty() == false )
+      gReverseFileOutputs.erase( inJob->fOutputPath ) ;
+
+    if ( inJob->fOutputPathName != NULL )
+      ASFileSysReleasePath( inJob->fFileSys, inJob->fOutputPathName ) ;
+
+    delete inJob ;
+
+  } // end DeleteReverseFileJob
+
+// --------------------------
+// inPathName as a UTF-8 platform path for APPDFReverser.  On Windows the
+// path is taken as UTF-16 and converted, so a name the system code page
+// cannot spell survives; the display text of a path is not guaranteed to
+// be a path that opens.  Elsewhere the POSIX path is UTF-8 already.
+
+static ASBool GetUTF8Path( ASFileSys inFileSys, ASPathName inPathName, std::string & outPath )
+  {
+    ASPlatformPath  thePlatformPath = NULL ;
+
+#if WIN_ENV
+    const wchar_t * theWidePath ;
+    int             theLength ;
+
+    if ( ( ASFileSysAcquirePlatformPath( inFileSys, inPathName, ASAtomFromString( "WinUnicodePath" ), &thePlatformPath ) != 0 )
+         || ( thePlatformPath == NULL ) )
+      return false ;
+
+    // the platform path's data, which for WinUnicodePath is a NUL terminated UTF-16 string
+    theWidePath = ( const wchar_t * )ASPlatformPathGetCstringPtr( thePlatformPath ) ;
+
+    theLength = ( theWidePath != NULL ) ? WideCharToMultiByte( CP_UTF8, 0, theWidePath, -1, NULL, 0, NULL, NULL ) : 0 ;
+    if ( theLength > 1 )
+      {
+        outPath.resize( theLength ) ;
+        WideCharToMultiByte( CP_UTF8, 0, theWidePath, -1, &outPath[ 0 ], theLength, NULL, NULL ) ;
+        outPath.resize( theLength - 1 ) ;
+      }
+    else
+      outPath.clear() ;
+
+    ASFileSysReleasePlatformPath( inFileSys, thePlatformPath ) ;
+#else
+    if ( ( ASFileSysAcquirePlatformPath( inFileSys, inPathName, ASAtomFromString( "POSIXPath" ), &thePlatformPath ) != 0 )
+         || ( thePlatformPath == NULL ) )
+      return false ;
+
+    outPath = ( const char * )ASPlatformPathGetPOSIXPathPtr( thePlatformPath ) ;
+    ASFileSysReleasePlatformPath( inFileSys, thePlatformPath ) ;
+#endif
+
+    return ( outPath.empty() == false ) ;
+
+  } // end GetUTF8Path
+
+// --------------------------
+// The first of "<name> reversed.pdf", "<name> reversed 2.pdf", ... next to
+// inPathName with nothing there yet and not chosen by a reverse still
+// running, so no file is replaced, including one open in Acrobat, and two
+// reverses never write the same file.  outPath is the name as UTF-8.  NULL
+// when every name up to kMaxOutputNames is taken or has no path on disk.
+
+static ASPathName CreateOutputPathName( ASFileSys inFileSys, ASPathName inPathName, std::string & outPath )
+  {
+    ASFileSysItemPropsRec   theProps ;
+    std::string             theStem ;
+    std::string             theName ;
+    char                    theSuffix[ 32 ] ;
+    size_t                  theDot ;
+    ASUTF16Val *            theString   = NULL ;
+    ASText                  theASText   = ASTextNew() ;
+    ASPathName              theFolder   = NULL ;
+    ASPathName volatile     theOutput   = NULL ;      // set in DURING, released in HANDLER
+
+    if ( ASFileSysGetNameFromPathAsASText( inFileSys, inPathName, theASText ) == 0 )
+      theString = ASTextGetUnicodeCopy( theASText, kUTF8 ) ;
+
+    if ( ( theString == NULL ) || ( ASFileSysAcquireParent( inFileSys, inPathName, &theFolder ) != 0 ) || ( theFolder == NULL ) )
+      {
+        if ( theString != NULL )
+          ASfree( theString ) ;
+        ASTextDestroy( theASText ) ;
+        return NULL ;
+      }
+
+    theStem = ( const char * )theString ;
+    ASfree( theString ) ;
+
+    theDot = theStem.find_last_of( '.' ) ;
+    if ( ( theDot != std::string::npos ) && ( theDot > 0 ) )
+      theStem.erase( theDot ) ;
+
+    DURING
+
+      for ( ASInt32 index = 1 ; ( index <= kMaxOutputNames ) && ( theOutput == NULL ) ; index++ )
+        {
+          if ( index == 1 )
+            snprintf( theSuffix, sizeof( theSuffix ), " reversed.pdf" ) ;
+          else
+            snprintf( theSuffix, sizeof( theSuffix ), " reversed %d.pdf", ( int )index ) ;
+
+          theName = theStem + theSuffix ;
+          ASTextSetUnicode( theASText, ( const ASUTF16Val * )theName.c_str(), kUTF8 ) ;
+          theOutput = ASFileSysCreatePathName( inFileSys, ASAtomFromString( "DIPathWithASText" ), theASText, theFolder ) ;
+
+          memset( &theProps, 0, sizeof( theProps ) ) ;
+          theProps.size = sizeof( theProps ) ;
+
+          // anything already there, file or folder, rules the name out
+          if ( ( theOutput != NULL )
+               && ( ( ASFileSysGetItemProps( inFileSys, theOutput, &theProps ) == 0 )
+                    || ( GetUTF8Path( inFileSys, theOutput, outPath ) == false )
+                    || ( gReverseFileOutputs.count( outPath ) != 0 ) ) )
+            {
+              ASFileSysReleasePath( inFileSys, theOutput ) ;
+              theOutput = NULL ;
+            }
+        }
+
+    HANDLER
+      if ( theOutput != NULL )
+        ASFileSysReleasePath( inFileSys, theOutput ) ;
+      ASFileSysReleasePath( inFileSys, theFolder ) ;
+      ASTextDestroy( theASText ) ;
+      outPath.clear() ;
+      RERAISE() ;
+    END_HANDLER
+
+    ASFileSysReleasePath( inFileSys, theFolder ) ;
+    ASTextDestroy( theASText ) ;
+
+    // so the caller never holds, and later frees, a name another reverse has
+    if ( theOutput == NULL )
+      outPath.clear() ;
+
+    return theOutput ;
+
+  } // end CreateOutputPathName
+
+// --------------------------
+
+static bool IsReverseFileCancelled( void * inData )
+  {
+    return ( ( const APCancelToken * )inData )->IsCancelled() ;
+
+  } // end IsReverseFileCancelled
+
+// --------------------------
+// On a worker thread: no Acrobat calls.  The output name was free when it
+// was chosen and is kept from other reverses until this one is done; if
+// another program has put a file there since, it is left alone.
+
+static void DoReverseFileTask( void * inData, const APCancelToken & inToken )
+  {
+    APReverseFileJob *  theJob = ( APReverseFileJob * )inData ;
+    APPDFReverser       theReverser ;
+
+    theReverser.SetCancelProc( &IsReverseFileCancelled, ( void * )&inToken ) ;
+    theReverser.SetReplaceExisting( false ) ;
+
+    theJob->fResult = theReverser.Reverse( theJob->fInputPath.c_str(), theJob->fOutputPath.c_str() ) ;
+    snprintf( theJob->fMessage, sizeof( theJob->fMessage ), "%s", theReverser.GetMessage() ) ;
+
+  } // end DoReverseFileTask
+
+// --------------------------
+// On the main thread, from the task pool's idle proc, while the user may be
+// doing anything else: the result is opened, and a failure is only reported,
+// to go in the diagnostics log and the next summary.  During the unload
+// nothing is opened or reported; the job is only freed.
+
+static void DoReverseFileDone( void * inData, ASInt32 inStatus )
+  {
+    APReverseFileJob *  theJob = ( APReverseFileJob * )inData ;
+    char                theString[ 1024 ] ;
+
+    if ( ( inStatus == kTaskDone ) && ( APTaskPool::Shared().IsStopped() == false ) )
+      {
+        if ( theJob->fResult == kReverserOK )
+          {
+            DURING
+              AVDocOpenFromFile( theJob->fOutputPathName, theJob->fFileSys, NULL ) ;
+            HANDLER
+              APDiagnostics::Shared().Report( ERRORCODE, "opening the reversed file" ) ;
+            END_HANDLER
+          }
+        else if ( theJob->fResult != kReverserCancelled )
+          {
+            snprintf( theString, sizeof( theString ), "reversing %s into a new file: %s", theJob->fInputPath.c_str(), theJob->fMessage ) ;
+            APDiagnostics::Shared().Report( 0, theString ) ;
+          }
+      }
+
+    DeleteReverseFileJob( theJob ) ;
+
+  } // end DoReverseFileDone
+
+// --------------------------
+// Reverse the front document's file, as last saved, into "<name> reversed.pdf"
+// next to it, or the first "<name> reversed <n>.pdf" not yet taken, and open
+// that when it is done.
+
+static ACCB1 void ACCB2 DoReverseToNewFile( void * ioUserData )
+  {
+    PDDoc                         thePDDoc ;
+    ASFile                        theASFile ;
+    ASFileSys volatile            theFileSys  = NULL ;    // set in DURING, used after
+    ASPathName volatile           thePathName = NULL ;
+    APReverseFileJob * volatile   theJob      = NULL ;    // until the task pool has it
+
+    DURING
+
+      thePDDoc    = AVDocGetPDDoc( AVAppGetActiveDoc() ) ;
+      theASFile   = PDDocGetFile( thePDDoc ) ;
+      theFileSys  = ASFileGetFileSys( theASFile ) ;
+      thePathName = ASFileAcquirePathName( theASFile ) ;
+
+      if ( thePathName == NULL )
+        APDiagnostics::Shared().Report( 0, "the front document has no file to reverse" ) ;
+      else
+        {
+          theJob = new APReverseFileJob ;
+          theJob->fFileSys        = theFileSys ;
+          theJob->fOutputPathName = NULL ;
+          theJob->fResult         = kReverserOK ;
+          theJob->fMessage[ 0 ]   = 0 ;
+
+          if ( GetUTF8Path( theFileSys, thePathName, theJob->fInputPath ) == false )
+            APDiagnostics::Shared().Report( 0, "finding the front document's file on disk" ) ;
+          else if ( ( theJob->fOutputPathName = CreateOutputPathName( theFileSys, thePathName, theJob->fOutputPath ) ) == NULL )
+            APDiagnostics::Shared().Report( 0, "choosing a name for the reversed file; every name tried is taken" ) ;
+          else
+            {
+              gReverseFileOutputs.insert( theJob->fOutputPath ) ;
+
+              if ( PDDocGetFlags( thePDDoc ) & PDDocNeedsSave )
+                APDiagnostics::Shared().Report( 0, "the front document has unsaved changes; the file as last saved is reversed" ) ;
+
+              APTaskPool::Shared().Submit( "reverse a PDF file", &DoReverseFileTask, &DoReverseFileDone, theJob, gReverseFileToken ) ;
+              theJob = NULL ;
+            }
+        }
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "starting to reverse the front document's file" ) ;
+    END_HANDLER
+
+    if ( theJob != NULL )
+      DeleteReverseFileJob( theJob ) ;
+
+    if ( thePathName != NULL )
+      ASFileSysReleasePath( theFileSys, thePathName ) ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoReverseToNewFile
+
+// --------------------------
+// The benchmarks that change pages work on a copy of the front document,
+// which is closed afterwards, so the user's document is never touched.
+
+struct APReverseBench
+  {
+    PDDoc     fPDDoc ;
+    ASInt32   fRule ;
+  } ;
+
+// --------------------------
+
+static void BenchReversePages( void * inData, ASInt32 inIteration )
+  {
+    APReverseBench *  theBench = ( APReverseBench * )inData ;
+
+    ReversePDDoc( theBench->fPDDoc, theBench->fRule ) ;
+
+  } // end BenchReversePages
+
+// --------------------------
+// What reversing and rotating cost as two operations: a reverse, then a
+// second walk of the page tree turning every page.
+
+static void BenchReverseThenRotate( void * inData, ASInt32 inIteration )
+  {
+    APReverseBench *  theBench = ( APReverseBench * )inData ;
+    ASInt32           theNumberOfPages ;
+    APPDPageRef       thePDPageRef ;
+
+    ReversePDDoc( theBench->fPDDoc, kRotateNone ) ;
+
+    DURING
+
+      theNumberOfPages = PDDocGetNumPages( theBench->fPDDoc ) ;
+
+      for ( ASInt32 index = 0 ; index < theNumberOfPages ; index++ )
+        {
+          thePDPageRef.Reset( PDDocAcquirePage( theBench->fPDDoc, index ) ) ;
+          PDPageSetRotate( thePDPageRef, ( PDRotate )( ( PDPageGetRotate( thePDPageRef ) + 180 ) % 360 ) ) ;
+        }
+
+    HANDLER
+      thePDPageRef.Reset( NULL ) ;
+      RERAISE() ;
+    END_HANDLER
+
+  } // end BenchReverseThenRotate
+
+// --------------------------
+
+static void BenchLooksReversed( void * inData, ASInt32 inIteration )
+  {
+    LooksReversed( ( PDDoc )inData ) ;
+
+  } // end BenchLooksReversed
+
+// --------------------------
+// Write the time reversing takes on a copy of the front document to
+// ReversePagesBenchmark.txt.  LooksReversed only reads, and needs the page
+// labels and bookmarks a copy would not have, so it runs on the document
+// itself.
+
+static ACCB1 void ACCB2 DoReversePagesBenchmark( void * ioUserData )
+  {
+    APBenchmark             theBenchmark ;
+    APReverseBench          theBench ;
+    PDDoc                   theFrontPDDoc ;
+    PDDoc volatile          theCopyPDDoc = NULL ;     // volatile: set in DURING and read after it
+    char                    theString[ 512 ] ;
+
+    if ( AVAppGetActiveDoc() == NULL )
+      return ;
+
+    DURING
+
+      theFrontPDDoc = AVDocGetPDDoc( AVAppGetActiveDoc() ) ;
+
+      theCopyPDDoc = PDDocCreate() ;
+      PDDocInsertPages( theCopyPDDoc, PDBeforeFirstPage, theFrontPDDoc, 0, PDAllPages, PDInsertAll, NULL, NULL, NULL, NULL ) ;
+
+      theBench.fPDDoc = theCopyPDDoc ;
+
+      theBench.fRule = kRotateNone ;
+      theBenchmark.Run( "ReversePDDoc, on a copy", 4, &BenchReversePages, &theBench ) ;
+      theBench.fRule = kRotateAll ;
+      theBenchmark.Run( "ReversePDDoc, rotating every page in the same pass", 4, &BenchReversePages, &theBench ) ;
+      theBenchmark.Run( "ReversePDDoc, then a second pass rotating every page", 4, &BenchReverseThenRotate, &theBench ) ;
+      theBenchmark.Run( "LooksReversed, every sampled page at once", 100, &BenchLooksReversed, theFrontPDDoc ) ;
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "running the Reverse Pages benchmark" ) ;
+    END_HANDLER
+
+    if ( theCopyPDDoc != NULL )
+      PDDocClose( theCopyPDDoc ) ;
+
+    APReport *  theLog = new APReport( "ReversePagesBenchmark.txt" ) ;
+    if ( theLog != NULL )
+      {
+        theBenchmark.Write( theLog ) ;
+
+        snprintf( theString, sizeof( theString ), "\r\nPage order checked on open\r\n\r\n  %10d  documents\r\n  %10d  looked reversed\r\n  %10.3f  mean per document (ms)\r\n  %10.3f  worst step (ms)\r\n",
+                  ( int )gDocsChecked, ( int )gDocsSuspected,
+                  ( gDocsChecked != 0 ) ? APTiming::ToMilliseconds( gDetectTime ) / gDocsChecked : 0.0,
+                  APTiming::ToMilliseconds( gDetectWorstStep ) ) ;
+        theLog->Write( theString, strlen( theString ) ) ;
+
+        // Reverse Pages to New File runs in the task pool
+        strcpy( theString, "\r\n" ) ;
+        theLog->Write( theString, strlen( theString ) ) ;
+        APTaskPool::Shared().Write( theLog ) ;
+
+        delete( theLog ) ;
+      }
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoReversePagesBenchmark
+
+// --------------------------
+// Write the events in the trace ring to ReversePagesTrace.json.
+
+static ACCB1 void ACCB2 DoWriteTrace( void * data )
+  {
+    if ( APTrace::Shared().Write( "ReversePagesTrace.json", "ReversePages" ) == false )
+      APDiagnostics::Shared().Report( 0, "writing ReversePagesTrace.json" ) ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoWriteTrace
+
 // --------------------------
 //
 // Plug-in setup
 //
 // -------------------------
 
+// Reverse Pages goes after Replace Pages, or at the end of the Document menu
+// when Replace Pages cannot be found.
+
+static const APMenuItemSpec gMenuItemSpecs[] =
+  {
+    { "Reverse Pages...",                     "DGAP:DoAboutReversePages",   "AboutExtensions", NULL,           NO_SHORTCUT, 0, NULL,              NULL, NULL, &DoAboutReversePages,     NULL                      },
+    { "Reverse Pages",                        "DGAP:ReversePages",          "Document",        "ReplacePages", NO_SHORTCUT, 0, &DoComputeEnabled, NULL, NULL, &DoReversePages,          ( void * )kRotateNone     },
+    { "Reverse Pages and Rotate All",         "DGAP:ReverseRotateAll",      "Document",        "ReplacePages", NO_SHORTCUT, 0, &DoComputeEnabled, NULL, NULL, &DoReversePages,          ( void * )kRotateAll      },
+    { "Reverse Pages and Rotate Odd",         "DGAP:ReverseRotateOdd",      "Document",        "ReplacePages", NO_SHORTCUT, 0, &DoComputeEnabled, NULL, NULL, &DoReversePages,          ( void * )kRotateOdd      },
+    { "Reverse Pages and Rotate Even",        "DGAP:ReverseRotateEven",     "Document",        "ReplacePages", NO_SHORTCUT, 0, &DoComputeEnabled, NULL, NULL, &DoReversePages,          ( void * )kRotateEven     },
+    { "Reverse Pages and Rotate Upside-Down", "DGAP:ReverseRotateDetected", "Document",        "ReplacePages", NO_SHORTCUT, 0, &DoComputeEnabled, NULL, NULL, &DoReversePages,          ( void * )kRotateDetected },
+    { "Reverse Pages to New File",            "DGAP:ReverseToNewFile",      "Document",        "ReplacePages", NO_SHORTCUT, 0, &DoComputeEnabled, NULL, NULL, &DoReverseToNewFile,      NULL                      },
+    { "Reverse Pages Trace...",               "DGAP:ReversePagesTrace",     "Extensions",      NULL,           NO_SHORTCUT, 0, NULL,              NULL, NULL, &DoWriteTrace,            NULL                      },
+    { "Reverse Pages Benchmark...",           "DGAP:ReversePagesBenchmark", "Extensions",      NULL,           NO_SHORTCUT, 0, &DoComputeEnabled, NULL, NULL, &DoReversePagesBenchmark, NULL                      }
+  } ;
+
 static ACCB1 ASBool ACCB2 InitPlugInMenus( void )
   {
-    AVMenubar     theAVMenubar ;
-    
     DURING
     
-      theAVMenubar  = AVAppGetMenubar() ;   // get the main menu
-      if ( theAVMenubar == NULL ) 
+      if ( APMenuInstaller::Install( gMenuItemSpecs, APMenuItemCount( gMenuItemSpecs ), &FindAnchorMenuItem, NULL ) == 0 )
         E_RETURN( false ) ;
-        
-      AppendToAboutMenu( "Reverse Pages...", "NAME_DoAboutReversePages", &DoAboutReversePages ) ;
-      
-      AddAfterMenuItem( "Reverse Pages", "NAME_ReversePages", "ReplacePages", &DoComputeEnabled,  NULL, &DoReversePages, NULL ) ;
                                               
     HANDLER
-      DisplayErrorAlert( ERRORCODE, "Error installing Reverse Pages menu items" ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "installing the Reverse Pages menu items" ) ;
     END_HANDLER
     
     return true ;
@@ -312,10 +1321,15 @@ static ACCB1 ASBool ACCB2 InitPlugIn( void )
   {
     ASBool    theResult ;
     
+    LoadProfilerMark( kLoadPhaseInitStart, APTiming::GetNanoseconds() ) ;
+
     theResult = InitPlugInMenus() ;
-    if ( theResult == false )
-      return theResult ;
-      
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+    // on failure too, so a failed init is still ranked by what it cost
+    LoadProfilerMark( kLoadPhaseInitEnd, APTiming::GetNanoseconds() ) ;
+
     return theResult ;
     
   } // end InitPlugIn
@@ -325,6 +1339,15 @@ static ACCB1 ASBool ACCB2 InitPlugIn( void )
  
 static ACCB1 ASBool ACCB2 UnloadPlugIn( void )
   {
+    APNotifier::Shared().UnregisterAll() ;
+
+    // a file still being reversed stops at its next check rather than holding up the unload
+    gReverseFileToken.Cancel() ;
+    APTaskPool::Shared().Stop() ;
+
+    APHandleReportLeaks() ;
+    APDiagnostics::Shared().Close() ;
+
     return true ;
     
   } // end UnloadPlugIn
@@ -339,6 +1362,23 @@ static ACCB1 ASBool ACCB2 UnloadPlugIn( void )
 
 static ACCB1 ASBool ACCB2 PreInitPlugIn( void )
   {
+    ASUns64   theImportStart = APTiming::GetNanoseconds() ;
+
+    APDiagnostics::Shared().SetLogName( "ReversePagesDiagnostics.txt" ) ;
+
+    gLoadProfilerHFT = ASExtensionMgrGetHFT( ASAtomFromString( kLoadProfilerHFTName ), kLoadProfilerHFTVersion ) ;
+
+    // not an error if ListMenuNames is not installed; FindAnchorMenuItem falls back to the menubar
+    gListMenuNamesHFT = ASExtensionMgrGetHFT( ASAtomFromString( kListMenuNamesHFTName ), kListMenuNamesHFTVersion ) ;
+
+    APNotifier::Shared().Subscribe( kNotifyDocDidOpen,   kNotifyAllChanges, "DoAVDocDidOpen", &DoAVDocDidOpen, NULL ) ;
+    APNotifier::Shared().Subscribe( kNotifyDocWillClose, kNotifyAllChanges, "DoAVDocWillClose", &DoAVDocWillClose, NULL ) ;
+
+    AVAppRegisterIdleProc( ASCallbackCreateProto( AVIdleProc, &DoOfferReverse ), NULL, kOfferTicks ) ;
+
+    LoadProfilerMark( kLoadPhaseHandshake, gHandshakeTime ) ;
+    LoadProfilerMark( kLoadPhaseImportStart, theImportStart ) ;
+    LoadProfilerMark( kLoadPhaseImportEnd, APTiming::GetNanoseconds() ) ;
 
     return true ;
     
@@ -349,6 +1389,8 @@ static ACCB1 ASBool ACCB2 PreInitPlugIn( void )
 
 ACCB1 ASBool ACCB2 PIHandshake( Uns32 handshakeVersion, void * handshakeData )
   {
+    gHandshakeTime = APTiming::GetNanoseconds() ;
+
     if ( handshakeVersion == HANDSHAKE_V0200 )
       {
         PIHandshakeData_V0200 *hsData = ( PIHandshakeData_V0200 * )handshakeData ;
@@ -357,7 +1399,7 @@ ACCB1 ASBool ACCB2 PIHandshake( Uns32 handshakeVersion, void * handshakeData )
     
         hsData->exportHFTsCallback = NULL ;
         
-        hsData->importReplaceAndRegisterCallback = NULL ;
+        hsData->importReplaceAndRegisterCallback = ASCallbackCreateProto( PIImportReplaceAndRegisterProcType, ( void * )PreInitPlugIn ) ;
         
         hsData->initCallback = ASCallbackCreateProto( PIInitProcType, ( void * )InitPlugIn ) ;
       
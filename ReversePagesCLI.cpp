@@ -0,0 +1,101 @@
+/*
+  File:   ReversePagesCLI.cpp
+
+  Contains: reversepages, a command line tool that reverses the page order
+            of a PDF file without Acrobat; see APPDFReverser.h.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Build:
+      c++ -std=c++11 -O2 -o reversepages ReversePagesCLI.cpp APPDFReverser.cpp
+
+    or on Windows:
+
+      cl /EHsc /O2 /Fereversepages.exe ReversePagesCLI.cpp APPDFReverser.cpp shell32.lib
+
+*/
+
+#include <stdio.h>
+
+#include <string>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#include <shellapi.h>
+#endif
+
+#include "APPDFReverser.h"
+
+// --------------------------
+// Argument inIndex as UTF-8.  On Windows argv holds only what the system
+// code page can spell, so the arguments are taken from the wide command
+// line instead.
+
+static std::string GetPathArg( char * inArgv[], int inIndex )
+  {
+#if defined( _WIN32 )
+    std::string   thePath ;
+    LPWSTR *      theArgs ;
+    int           theNumArgs  = 0 ;
+    int           theLength ;
+
+    theArgs = CommandLineToArgvW( GetCommandLineW(), &theNumArgs ) ;
+    if ( theArgs == NULL )
+      return inArgv[ inIndex ] ;
+
+    if ( inIndex < theNumArgs )
+      {
+        theLength = WideCharToMultiByte( CP_UTF8, 0, theArgs[ inIndex ], -1, NULL, 0, NULL, NULL ) ;
+        if ( theLength > 1 )
+          {
+            thePath.resize( ( size_t )theLength ) ;
+            WideCharToMultiByte( CP_UTF8, 0, theArgs[ inIndex ], -1, &thePath[ 0 ], theLength, NULL, NULL ) ;
+            thePath.resize( ( size_t )theLength - 1 ) ;
+          }
+      }
+
+    LocalFree( theArgs ) ;
+
+    return thePath ;
+#else
+    return inArgv[ inIndex ] ;
+#endif
+
+  } // end GetPathArg
+
+// --------------------------
+
+int main( int argc, char * argv[] )
+  {
+    APPDFReverser   theReverser ;
+
+    if ( argc != 3 )
+      {
+        fprintf( stderr, "usage: reversepages <input.pdf> <output.pdf>\n" ) ;
+        return 2 ;
+      }
+
+    if ( theReverser.Reverse( GetPathArg( argv, 1 ).c_str(), GetPathArg( argv, 2 ).c_str() ) != kReverserOK )
+      {
+        fprintf( stderr, "reversepages: %s\n", theReverser.GetMessage() ) ;
+        return 1 ;
+      }
+
+    printf( "%lld pages reversed, %lld page tree nodes rewritten, %lld bytes appended to %lld\n",
+            theReverser.GetNumPages(), theReverser.GetNumNodes(), theReverser.GetUpdateSize(), theReverser.GetInputSize() ) ;
+
+    return 0 ;
+
+  } // end main
+
+// --------------------------
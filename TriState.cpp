@@ -43,6 +43,23 @@ extern HINSTANCE gHINSTANCE ;
 #include "TASUtils.h"
 #include "TAVUtils.h"
 
+#include <stdio.h>
+#include <string.h>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "APReport.h"
+#include "APTiming.h"
+#include "APIconCache.h"
+#include "APMenuInstaller.h"
+#include "APDiagnostics.h"
+#include "APTrace.h"
+#include "APBenchmark.h"
+#include "APEventLog.h"
+#include "APNotifier.h"
+#include "APCycleGroup.h"
+#include "LoadProfilerHFT.h"
+
 // --------------------------
 
 #define kUseNoneIcon      13101
@@ -54,42 +71,138 @@ extern HINSTANCE gHINSTANCE ;
 
 // --------------------------
 
+HFT     gLoadProfilerHFT  = NULL ;
+ASUns64 gHandshakeTime    = 0 ;
+
 ASAtom  gProductASAtom ;
-ASAtom  gUseNoneASAtom ;
-ASAtom  gUseBookmarksASAtom ;
-ASAtom  gUseThumbsASAtom ;
-ASAtom  gEndPageModeGroupASAtom ;
-ASAtom  gZoom100ASAtom ;
-ASAtom  gFitPageASAtom ;
-ASAtom  gFitVisibleASAtom ;
-ASAtom  gEndZoomGroupASAtom ;
 
-AVToolButton  gUseNoneToolButton            = NULL ;
-AVToolButton  gUseBookmarksToolButton       = NULL ;
-AVToolButton  gUseThumbsToolButton          = NULL ;
-AVToolButton  gEndPageModeGroupToolButton   = NULL ;
+// the document the toolbar currently reflects
+AVDoc   gAppliedAVDoc     = NULL ;
+
+// page view changes are collected here and applied at idle time
+#define kCoalesceTicks      1     // 1/60 second, about one frame
+
+std::unordered_set< AVDoc > gDirtyAVDocs ;
+ASInt32 gCoalescedUpdates   = 0 ;   // documents queried at idle time
+ASInt32 gPageViewSubscriber = 0 ;   // DoAVPageViewDidChange's index in APNotifier
+
+// the buttons are built when the first document opens rather than at launch
+ASBool  gToolBarInstalled   = false ;
+ASUns64 gInitTime           = 0 ;
+ASUns64 gToolBarTime        = 0 ;
+
+// time from a zoom button click until the page view has been drawn
+ASBool  gAwaitingZoomFrame  = false ;
+ASInt32 gZoomFrameCount     = 0 ;
+ASUns64 gZoomFrameTime      = 0 ;
+
+// notifications recorded for replay
+#define kEventLogFileName   "TriStateEvents.bin"
+
+APEventLog  gEventLog ;
+
+// -------------------------
+#pragma mark -- cycle groups
+// -------------------------
+// Each group of Acrobat buttons collapsed into one button is a table entry;
+// the table order is the order a click cycles through the states.
+
+static ASInt32 ProbePageMode( AVDoc inAVDoc )
+  {
+    return ( ASInt32 )AVDocGetViewMode ( inAVDoc ) ;
+
+  } // end ProbePageMode
+
+// --------------------------
+
+static ASInt32 ProbeZoomType( AVDoc inAVDoc )
+  {
+    return ( ASInt32 )AVPageViewGetZoomType ( AVDocGetPageView ( inAVDoc ) ) ;
+
+  } // end ProbeZoomType
+
+// --------------------------
+// Every group's last known state for each open document, so switching to a
+// document does not have to query it again.
+
+enum
+  {
+    kPageModeGroup = 0,
+    kZoomGroup,
+    kNumCycleGroups
+  } ;
+
+struct DocViewState
+  {
+    ASInt32   fStates[ kNumCycleGroups ] ;
+  } ;
+
+std::unordered_map< AVDoc, DocViewState >  gDocViewStates ;
+
+// --------------------------
+// A click changes the front document; remember the state it was left in.
+
+static void RememberSelection( ASInt32 inGroup, ASInt32 inState )
+  {
+    std::unordered_map< AVDoc, DocViewState >::iterator theFound = gDocViewStates.find( gAppliedAVDoc ) ;
+    if ( theFound != gDocViewStates.end() )
+      theFound->second.fStates[ inGroup ] = inState ;
+
+  } // end RememberSelection
+
+// --------------------------
+
+static void DidSelectPageMode( ASInt32 inState )
+  {
+    RememberSelection( kPageModeGroup, inState ) ;
+
+  } // end DidSelectPageMode
+
+// --------------------------
+// With the navigation pane open Acrobat does not redraw the page view after
+// a zoom change made through the original buttons.  Only the page view shows
+// the new zoom, so it alone is invalidated rather than the whole window
+// interior, which also redrew the navigation pane.
+
+static void DidSelectZoom( ASInt32 inState )
+  {
+    RememberSelection( kZoomGroup, inState ) ;
+
+    AVDoc theAVDoc = AVAppGetActiveDoc() ;
+    if ( theAVDoc == NULL )
+      return ;
+      
+    ASInt16 theSplitterPosition = AVDocGetSplitterPosition ( theAVDoc ) ;
+    if ( theSplitterPosition != 0 )
+      AVPageViewInvalidateRect ( AVDocGetPageView ( theAVDoc ), NULL ) ;
 
-AVToolButton  gDAUseNoneToolButton ;
-AVToolButton  gDAUseBookmarksToolButton ;
-AVToolButton  gDAUseThumbsToolButton ;
+    gAwaitingZoomFrame = true ;
 
-AVToolButton  gCurrentPageModeToolButton ;
+  } // end DidSelectZoom
 
-AVToolButton  gZoom100ToolButton            = NULL ;
-AVToolButton  gFitPageToolButton            = NULL ;
-AVToolButton  gFitVisibleToolButton         = NULL ;
-AVToolButton  gEndZoomGroupToolButton       = NULL ;
+// --------------------------
 
-AVToolButton  gDAZoom100ToolButton ;
-AVToolButton  gDAFitPageToolButton ;
-AVToolButton  gDAFitVisibleToolButton ;
+static const APCycleState gPageModeStates[] =
+  {
+    { PDUseNone,              kUseNoneIcon,       "UseNone",       "Page Only",    NULL,             0 },
+    { PDUseBookmarks,         kUseBookmarksIcon,  "UseBookmarks",  "Bookmarks",    "ShowBookmarks",  0 },
+    { PDUseThumbs,            kUseThumbsIcon,     "UseThumbs",     "Thumbnails",   "ShowThumbs",     kCycleUpdateButtonStates }
+  } ;
 
-AVToolButton  gCurrentViewToolButton ;
+static const APCycleState gZoomStates[] =
+  {
+    { AVZoomNoVary,           kZoom100Icon,       "Zoom100",       "Actual Size",  NULL,             0 },
+    { AVZoomFitPage,          kFitPageIcon,       "FitPage",       "Fit Page",     NULL,             0 },
+    { AVZoomFitVisibleWidth,  kFitVisibleIcon,    "FitVisible",    "Fit Visible",  NULL,             0 }
+  } ;
 
-AVMenuItem    gUseBookmarksMenuItem ;
-AVMenuItem    gUseThumbsMenuItem ;
+static const APCycleGroupDef gCycleGroupDefs[ kNumCycleGroups ] =
+  {
+    { "DGAP:PageMode",  "endPageModeGroup", &ProbePageMode, &DidSelectPageMode, APCycleCount( gPageModeStates ), gPageModeStates },
+    { "DGAP:Zoom",      "endZoomGroup",     &ProbeZoomType, &DidSelectZoom,     APCycleCount( gZoomStates ),     gZoomStates }
+  } ;
 
-static AVToolRec  gPageModeTSAVToolRec ;
+APCycleGroup  gCycleGroups[ kNumCycleGroups ] ;
 
 // --------------------------
 // Display the About box for the Print Page plug-in
@@ -104,246 +217,564 @@ static ACCB1 void ACCB2 DoAboutTriState( void * data )
   } // end DoAboutTriState
 
 // --------------------------
+// Bring every button in line with a state; a group only touches the toolbar
+// when its state differs from the one it already shows.
 
-static ACCB1 void ACCB2 DoPageModeTriState( ASInt32 inData )
+static void ApplyDocViewState( const DocViewState & inDocViewState )
   {
-    ASInt32 theButtonType ;
-    
-    theButtonType = inData ;
-    
-    DURING
-      
-      AVToolBar theAVToolBar = AVAppGetToolBar() ;
-
-      switch ( theButtonType )
-        {
-          case kUseNoneIcon :   // switch to Bookmark view
-            AVToolButtonExecute ( gUseBookmarksToolButton ) ;
-            AVToolButtonRemove ( gCurrentPageModeToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAUseBookmarksToolButton, true, gEndPageModeGroupToolButton ) ;
-            gCurrentPageModeToolButton = gDAUseBookmarksToolButton ;
-            break ;
-            
-          case kUseBookmarksIcon :  // switch to Thumbnail view
-            AVToolButtonExecute( gUseThumbsToolButton ) ;
-            AVToolButtonRemove ( gCurrentPageModeToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAUseThumbsToolButton, true, gEndPageModeGroupToolButton ) ;
-            gCurrentPageModeToolButton = gDAUseThumbsToolButton ;
-            AVToolBarUpdateButtonStates ( theAVToolBar ) ;
-            break ;
-            
-          case kUseThumbsIcon :   // switch to None view
-            AVToolButtonExecute( gUseNoneToolButton ) ;
-            AVToolButtonRemove ( gCurrentPageModeToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAUseNoneToolButton, true, gEndPageModeGroupToolButton ) ;
-            gCurrentPageModeToolButton = gDAUseNoneToolButton ;
-            break ;
-            
-        } // end switch
-        
-    HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
-    END_HANDLER
+    for ( ASInt32 index = 0 ; index < kNumCycleGroups ; index++ )
+      gCycleGroups[ index ].Apply( inDocViewState.fStates[ index ] ) ;
 
-    return ;
-
-  } // end DoPageModeTriState
+  } // end ApplyDocViewState
 
 // --------------------------
+// Query the document, remember what it is showing and, when it is the
+// front document, update the buttons to match.
 
-static ACCB1 void ACCB2 UpdatePageModeTriState( AVDoc inAVDoc, void *data )
+static void UpdateCycleGroups( AVDoc inAVDoc )
   {
-    AVToolBar     theAVToolBar ;
-    PDPageMode    thePDPageMode ;
-    
     DURING
       
-      theAVToolBar = AVAppGetToolBar() ;
-
-      thePDPageMode = AVDocGetViewMode ( inAVDoc ) ;
+      DocViewState & theDocViewState = gDocViewStates[ inAVDoc ] ;
       
-      switch ( thePDPageMode )
-        {
-          case PDUseNone :    // switch to None view
-            AVToolButtonRemove ( gCurrentPageModeToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAUseNoneToolButton, true, gEndPageModeGroupToolButton ) ;
-            gCurrentPageModeToolButton = gDAUseNoneToolButton ;
-            break ;
-            
-          case PDUseBookmarks :   // switch to Bookmark view
-            AVToolButtonRemove ( gCurrentPageModeToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAUseBookmarksToolButton, true, gEndPageModeGroupToolButton ) ;
-            gCurrentPageModeToolButton = gDAUseBookmarksToolButton ;
-            break ;
-            
-          case PDUseThumbs :  // switch to Thumbnail view
-            AVToolButtonRemove ( gCurrentPageModeToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAUseThumbsToolButton, true, gEndPageModeGroupToolButton ) ;
-            gCurrentPageModeToolButton = gDAUseThumbsToolButton ;
-            break ;
-            
-        } // end switch
+      for ( ASInt32 index = 0 ; index < kNumCycleGroups ; index++ )
+        theDocViewState.fStates[ index ] = gCycleGroups[ index ].Probe( inAVDoc ) ;
+
+      if ( inAVDoc == gAppliedAVDoc )
+        ApplyDocViewState( theDocViewState ) ;
 
     HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "updating the toolbar for a document" ) ;
     END_HANDLER
 
     return ;
     
-  } // end UpdatePageModeTriState
+  } // end UpdateCycleGroups
 
 // --------------------------
+// Nothing on the toolbar needs TriState until there is a document to show,
+// so the Acrobat buttons are looked up and replaced, and the icons loaded,
+// the first time one opens instead of while Acrobat is launching.  A missing
+// button is reported once and its group left as Acrobat made it.
 
-static ACCB1 void ACCB2 DoViewTriState( ASInt32 inData )
+static void InstallToolBar( void )
   {
-    AVToolBar     theAVToolBar ;
-    AVRect        theAVRect ;
-    ASInt32       theButtonType ;
-    
-    theButtonType = inData ;
-    
-    DURING
+    ASBool        theProblem      = false ;
+    ASUns64       theStart ;
+
+    if ( gToolBarInstalled == true )
+      return ;
       
-      theAVToolBar = AVAppGetToolBar() ;
+    APTraceScope  theTraceScope( "InstallToolBar" ) ;
 
-      switch ( theButtonType )
-        {
-          case kZoom100Icon :   // switch to FitPage view
-            AVToolButtonExecute ( gFitPageToolButton ) ;
-            AVToolButtonRemove ( gCurrentViewToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAFitPageToolButton, true, gEndZoomGroupToolButton ) ;
-            gCurrentViewToolButton = gDAFitPageToolButton ;
-            break ;
-            
-          case kFitPageIcon : // switch to FitVisible view
-            AVToolButtonExecute( gFitVisibleToolButton ) ;
-            AVToolButtonRemove ( gCurrentViewToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAFitVisibleToolButton, true, gEndZoomGroupToolButton ) ;
-            gCurrentViewToolButton = gDAFitVisibleToolButton ;
-            break ;
-            
-          case kFitVisibleIcon :    // switch to 100% Zoom view
-            AVToolButtonExecute( gZoom100ToolButton ) ;
-            AVToolButtonRemove ( gCurrentViewToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAZoom100ToolButton, true, gEndZoomGroupToolButton ) ;
-            gCurrentViewToolButton = gDAZoom100ToolButton ;
-            break ;
-            
-        } // end switch
-        
-      AVDoc theAVDoc = AVAppGetActiveDoc() ;
-      ASInt16 theSplitterPosition = AVDocGetSplitterPosition ( theAVDoc ) ;
-      if ( theSplitterPosition != 0 )
+    gToolBarInstalled = true ;    // whatever happens, only try once
+    theStart          = APTiming::GetNanoseconds() ;
+
+    DURING
+      
+      AVToolBar theAVToolBar = AVAppGetToolBar() ;
+      AVMenubar theAVMenubar = AVAppGetMenubar() ;
+      
+      for ( ASInt32 index = 0 ; index < kNumCycleGroups ; index++ )
         {
-          AVWindow theAVWindow = AVDocGetAVWindow ( theAVDoc ) ;
-          AVWindowGetInterior ( theAVWindow, &theAVRect ) ;
-          AVWindowInvalidateRect ( theAVWindow, &theAVRect ) ;
+          if ( gCycleGroups[ index ].Install( theAVToolBar, &gCycleGroupDefs[ index ] ) == false )
+            theProblem = true ;
+          else
+            gCycleGroups[ index ].AttachMenuItems( theAVMenubar ) ;
         }
+      
+      if ( theProblem == true )
+        APDiagnostics::Shared().Report( 0, "TriState could not find a required toolbar button; those buttons were left unchanged" ) ;
         
     HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "installing the TriState toolbar buttons" ) ;
     END_HANDLER
 
+    gToolBarTime = APTiming::GetNanoseconds() - theStart ;
+
     return ;
+        
+  } // end InstallToolBar
 
-  } // end DoViewTriState
+// --------------------------
+// Every notification TriState receives, before its handler sees it, so the
+// scrolls the page view handler's mask filters out are recorded as well.
+
+static void RecordNotification( const APNotification & inNotification, void * data )
+  {
+    if ( gEventLog.IsRecording() == false )
+      return ;
+
+    switch ( inNotification.fType )
+      {
+        case kNotifyDocDidOpen :
+          gEventLog.Record( kLoggedDocDidOpen, inNotification.fAVDoc, 0, 0, 0, 0 ) ;
+          break ;
+
+        case kNotifyFrontDocDidChange :
+          gEventLog.Record( kLoggedFrontDocDidChange, inNotification.fAVDoc, 0, 0, 0, 0 ) ;
+          break ;
+
+        case kNotifyPageViewDidChange :
+          if ( inNotification.fAVPageView != NULL )
+            gEventLog.Record( kLoggedPageViewDidChange, AVPageViewGetAVDoc( inNotification.fAVPageView ), ( ASInt16 )inNotification.fChanges, 0, 0, 0 ) ;
+          break ;
+      }
+
+  } // end RecordNotification
 
 // --------------------------
+// This is used in addition to AVAppFrontDocDidChange because the notification is not sent in the 
+// case of the document first being opened.
 
-static ACCB1 void ACCB2 UpdateViewTriState( AVDoc inAVDoc, void *data )
+static void DoAVDocDidOpen( const APNotification & inNotification, void *data )
   {
-    AVToolBar     theAVToolBar ;
-    AVPageView    theAVPageView ;
-    AVZoomType    theAVZoomType ;
+    APTraceScope  theTraceScope( "AVDocDidOpen" ) ;
+
+    if ( inNotification.fAVDoc == NULL )    // if there is no frontmost document (e.g.,the last document was just closed)
+      return ;
     
-    DURING
-      
-      theAVToolBar = AVAppGetToolBar() ;
+    gAppliedAVDoc = inNotification.fAVDoc ;
+    
+    InstallToolBar() ;
+    
+    UpdateCycleGroups( inNotification.fAVDoc ) ;
 
-      theAVPageView = AVDocGetPageView ( inAVDoc ) ;
-      theAVZoomType = AVPageViewGetZoomType ( theAVPageView ) ;
-      
-      switch ( theAVZoomType )
-        {
-          case AVZoomNoVary :   // switch to FitPage view
-            AVToolButtonRemove ( gCurrentViewToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAZoom100ToolButton, true, gEndZoomGroupToolButton ) ;
-            gCurrentViewToolButton = gDAZoom100ToolButton ;
-            break ;
-            
-          case AVZoomFitPage :    // switch to FitVisible view
-            AVToolButtonRemove ( gCurrentViewToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAFitPageToolButton, true, gEndZoomGroupToolButton ) ;
-            gCurrentViewToolButton = gDAFitPageToolButton ;
-            break ;
-            
-          case AVZoomFitVisibleWidth :  // switch to 100% Zoom view
-            AVToolButtonRemove ( gCurrentViewToolButton ) ;
-            AVToolBarAddButton ( theAVToolBar, gDAFitVisibleToolButton, true, gEndZoomGroupToolButton ) ;
-            gCurrentViewToolButton = gDAFitVisibleToolButton ;
-            break ;
-            
-        } // end switch
+    return ;
+    
+  } // end DoAVDocDidOpen
+
+// --------------------------
+// A document already seen is switched to from the table without asking it
+// anything; only a group whose state differs changes its button.
+
+static void DoAVAppFrontDocDidChange( const APNotification & inNotification, void *data )
+  {
+    AVDoc         theAVDoc = inNotification.fAVDoc ;
+    APTraceScope  theTraceScope( "AVAppFrontDocDidChange" ) ;
 
+    gAppliedAVDoc = theAVDoc ;
+    
+    if ( theAVDoc == NULL )    // if there is no frontmost document (e.g.,the last document was just closed)
+      return ;
+    
+    InstallToolBar() ;
+    
+    std::unordered_map< AVDoc, DocViewState >::const_iterator theFound = gDocViewStates.find( theAVDoc ) ;
+    if ( ( theFound == gDocViewStates.end() ) || ( gDirtyAVDocs.erase( theAVDoc ) != 0 ) )
+      {
+        UpdateCycleGroups( theAVDoc ) ;
+        return ;
+      }
+      
+    DURING
+      ApplyDocViewState( theFound->second ) ;
     HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "switching to the front document" ) ;
     END_HANDLER
 
     return ;
     
-  } // end UpdateViewTriState
+  } // end DoAVAppFrontDocDidChange
 
 // --------------------------
-// This is used in addition to AVAppFrontDocDidChange because the notification is not sent in the 
-// case of the document first being opened.
 
-static ACCB1 void ACCB2 DoAVDocDidOpen( AVDoc inAVDoc, ASInt32 outError, void *data )
+static void DoAVDocWillClose( const APNotification & inNotification, void *data )
   {
-    if ( inAVDoc == NULL )    // if there is no frontmost document (e.g.,the last document was just closed)
-      return ;
-    
-    UpdatePageModeTriState( inAVDoc, data ) ;
+    APTraceScope  theTraceScope( "AVDocWillClose" ) ;
 
-    UpdateViewTriState( inAVDoc, data ) ;
+    gDocViewStates.erase( inNotification.fAVDoc ) ;
+    gDirtyAVDocs.erase( inNotification.fAVDoc ) ;
+    
+    if ( inNotification.fAVDoc == gAppliedAVDoc )
+      gAppliedAVDoc = NULL ;
 
     return ;
     
-  } // end DoAVDocDidOpen
+  } // end DoAVDocWillClose
 
 // --------------------------
+// Subscribed for size and zoom changes only; scrolling and paging cannot
+// change the page mode or zoom type.  These arrive in bursts while the user
+// zooms or resizes a window, so the document is only marked here and
+// queried once from DoCoalescedUpdates.
 
-static ACCB1 void ACCB2 DoAVAppFrontDocDidChange( AVDoc inAVDoc, void *data )
+static void DoAVPageViewDidChange( const APNotification & inNotification, void *data )
   {
-    if ( inAVDoc == NULL )    // if there is no frontmost document (e.g.,the last document was just closed)
-      return ;
-    
-    UpdatePageModeTriState( inAVDoc, data ) ;
+    APTraceScope  theTraceScope( "AVPageViewDidChange" ) ;
 
-    UpdateViewTriState( inAVDoc, data ) ;
+    if ( inNotification.fAVPageView == NULL )   // if there is no frontmost document (e.g.,the last document was just closed)
+      return ;
+      
+    gDirtyAVDocs.insert( AVPageViewGetAVDoc ( inNotification.fAVPageView ) ) ;
 
     return ;
     
-  } // end DoAVAppFrontDocDidChange
+  } // end DoAVPageViewDidChange
 
 // --------------------------
+// Idle proc: bring each document that changed since the last idle up to date,
+// which updates the buttons when it is the front document.
 
-static ACCB1 void ACCB2 DoAVPageViewDidChange( AVPageView inAVPageView, ASInt16 inHowChanged, void *data )
+static ACCB1 void ACCB2 DoCoalescedUpdates( void *data )
   {
-    if ( inAVPageView == NULL )   // if there is no frontmost document (e.g.,the last document was just closed)
+    if ( gDirtyAVDocs.empty() )
       return ;
       
-    //if ( ( inHowChanged == PAGEVIEW_UPDATE_PAGESIZE ) || ( inHowChanged == PAGEVIEW_UPDATE_ZOOM ) )
-      {
-        AVDoc theAVDoc = AVPageViewGetAVDoc ( inAVPageView ) ;
-        
-        UpdatePageModeTriState( theAVDoc, data ) ;
+    APTraceScope  theTraceScope( "CoalescedUpdates" ) ;
 
-        UpdateViewTriState( theAVDoc, data ) ;
+    gEventLog.Record( kLoggedIdleUpdate, NULL, 0, 0, 0, 0 ) ;
+
+    for ( std::unordered_set< AVDoc >::const_iterator theIter = gDirtyAVDocs.begin() ; theIter != gDirtyAVDocs.end() ; ++theIter )
+      {
+        UpdateCycleGroups( *theIter ) ;
+        gCoalescedUpdates += 1 ;
       }
+      
+    gDirtyAVDocs.clear() ;
 
     return ;
     
-  } // end DoAVPageViewDidChange
+  } // end DoCoalescedUpdates
+
+// --------------------------
+// Write what the buttons have cost so far to TriStateReport.txt.
+
+static ACCB1 void ACCB2 DoTriStateReport( void * data )
+  {
+    char          theString[ 512 ] ;
+    char          theTimeString[ 256 ] ;
+    ASTimeRec     theASTimeRec ;
+
+    APReport *  theLog = new APReport( "TriStateReport.txt" ) ;
+    if ( theLog == NULL )
+      return ;
+
+    strcpy( theString, "File generated by the TriState plug-in for Adobe Acrobat\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+    strcpy( theString, "Copyrighted 2026 Appligent, Inc., http://www.appligent.com\r\n\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    TASUtils::GetLocalTime( &theASTimeRec ) ;
+    memset( theString, 0, sizeof( theString ) ) ;
+    memset( theTimeString, 0, sizeof( theTimeString ) ) ;
+    TASUtils::ASTimeRecToString( &theASTimeRec, theString, theTimeString ) ;
+    strcat( theString, "  " ) ;
+    strcat( theString, theTimeString ) ;
+    strcat( theString, "\r\n\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    snprintf( theString, sizeof( theString ), "Launch: %.3f ms in init\r\n", APTiming::ToMilliseconds( gInitTime ) ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    if ( gToolBarInstalled == true )
+      snprintf( theString, sizeof( theString ), "Toolbar: %.3f ms to build when the first document opened\r\n\r\n", APTiming::ToMilliseconds( gToolBarTime ) ) ;
+    else
+      strcpy( theString, "Toolbar: not built, no document has been opened\r\n\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    strcpy( theString, "Button state changes\r\n\r\n  changes  total (ms)  per change (us)  button\r\n" ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    for ( ASInt32 index = 0 ; index < kNumCycleGroups ; index++ )
+      {
+        const APCycleGroup &  theGroup = gCycleGroups[ index ] ;
+        ASInt32               theCount = theGroup.GetTransitionCount() ;
+
+        snprintf( theString, sizeof( theString ), "  %7d  %10.3f  %15.2f  %s\r\n", ( int )theCount,
+                  APTiming::ToMilliseconds( theGroup.GetTransitionTime() ),
+                  ( theCount != 0 ) ? APTiming::ToMicroseconds( theGroup.GetTransitionTime() ) / theCount : 0.0,
+                  theGroup.GetName() ) ;
+        theLog->Write( theString, strlen( theString ) ) ;
+      }
+
+    APIconCache & theIconCache = APIconCache::Shared() ;
+    snprintf( theString, sizeof( theString ), "\r\nIcons\r\n\r\n  %7d  loaded in %.3f ms\r\n  %7d  requests served from the cache\r\n",
+              ( int )theIconCache.GetNumLoads(),
+              APTiming::ToMilliseconds( theIconCache.GetLoadTime() ), ( int )theIconCache.GetNumHits() ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    snprintf( theString, sizeof( theString ), "\r\nPage view changes\r\n\r\n  %7d  received\r\n  %7d  changed the size or zoom\r\n  %7d  documents updated at idle time\r\n\r\n",
+              ( int )APNotifier::Shared().GetNumReceived( kNotifyPageViewDidChange ),
+              ( int )APNotifier::Shared().GetSubscriber( gPageViewSubscriber ).fCalls, ( int )gCoalescedUpdates ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    APNotifier::Shared().Write( theLog ) ;
+
+    snprintf( theString, sizeof( theString ), "\r\nZoom clicks until the page view was drawn\r\n\r\n   clicks  total (ms)  per click (ms)\r\n  %7d  %10.3f  %14.3f\r\n",
+              ( int )gZoomFrameCount, APTiming::ToMilliseconds( gZoomFrameTime ),
+              ( gZoomFrameCount != 0 ) ? APTiming::ToMilliseconds( gZoomFrameTime ) / gZoomFrameCount : 0.0 ) ;
+    theLog->Write( theString, strlen( theString ) ) ;
+
+    delete( theLog ) ;
+
+    // anything reported while the toolbar was being kept up to date
+    APDiagnostics::Shared().ShowSummary() ;
+
+    return ;
+
+  } // end DoTriStateReport
+
+// -------------------------
+#pragma mark -- event recording
+// -------------------------
+// The notifications, and the idle updates they lead to, are recorded in
+// order so a real session's storm can be replayed into the same callbacks.
+
+static ACCB1 void ACCB2 DoRecordEvents( void * data )
+  {
+    if ( gEventLog.IsRecording() == false )
+      {
+        gEventLog.Start() ;
+        return ;
+      }
+
+    gEventLog.Stop() ;
+
+    if ( gEventLog.Save( kEventLogFileName ) == false )
+      APDiagnostics::Shared().Report( 0, "saving the recorded events to " kEventLogFileName ) ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoRecordEvents
+
+// --------------------------
+
+static ACCB1 ASBool ACCB2 IsRecordingEvents( void * data )
+  {
+    return gEventLog.IsRecording() ;
+
+  } // end IsRecordingEvents
+
+// --------------------------
+// Called through APBenchmark::Replay, so inIteration is the event's place
+// in the recording and each event is fed in once, in order.
+
+static void ReplayEvent( void * inData, ASInt32 inIteration )
+  {
+    const APLoggedEvent &   theEvent  = gEventLog.GetEvent( inIteration ) ;
+    AVDoc                   theAVDoc  = gEventLog.GetReplayDoc( theEvent.fDoc ) ;
+
+    switch ( theEvent.fKind )
+      {
+        case kLoggedPageViewDidChange :
+          APNotifier::PageViewDidChange( ( theAVDoc != NULL ) ? AVDocGetPageView( theAVDoc ) : NULL, theEvent.fArg, NULL ) ;
+          break ;
+
+        case kLoggedFrontDocDidChange :
+          APNotifier::FrontDocDidChange( theAVDoc, NULL ) ;
+          break ;
+
+        case kLoggedDocDidOpen :
+          APNotifier::DocDidOpen( theAVDoc, 0, NULL ) ;
+          break ;
+
+        case kLoggedIdleUpdate :
+          DoCoalescedUpdates( NULL ) ;
+          break ;
+      }
+
+  } // end ReplayEvent
+
+// --------------------------
+// Feed the last recording into the callbacks as fast as they take it and
+// write the time each event took to TriStateReplay.txt.  The buttons are put
+// back to match the front document afterwards.
+
+static ACCB1 void ACCB2 DoReplayEvents( void * data )
+  {
+    APBenchmark   theBenchmark ;
+    char          theString[ 256 ] ;
+    ASInt32       theNumDocs ;
+
+    DURING
+
+      if ( gEventLog.Load( kEventLogFileName ) == false )
+        APDiagnostics::Shared().Report( 0, "reading the recorded events from " kEventLogFileName ) ;
+      else if ( gEventLog.GetNumEvents() == 0 )
+        APDiagnostics::Shared().Report( 0, "no events were recorded" ) ;
+      else if ( ( theNumDocs = gEventLog.BeginReplay() ) != 0 )
+        {
+          theBenchmark.Replay( "replayed event", gEventLog.GetNumEvents(), &ReplayEvent, NULL ) ;
+
+          DoCoalescedUpdates( NULL ) ;
+          APNotifier::FrontDocDidChange( AVAppGetActiveDoc(), NULL ) ;
+
+          APReport *  theLog = new APReport( "TriStateReplay.txt" ) ;
+          if ( theLog != NULL )
+            {
+              snprintf( theString, sizeof( theString ), "%d events replayed against %d open documents\r\n\r\n",
+                        ( int )gEventLog.GetNumEvents(), ( int )theNumDocs ) ;
+              theLog->Write( theString, strlen( theString ) ) ;
+
+              theBenchmark.Write( theLog ) ;
+              delete( theLog ) ;
+            }
+        }
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "replaying the recorded events" ) ;
+    END_HANDLER
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoReplayEvents
+
+// -------------------------
+#pragma mark -- benchmarks
+// -------------------------
+// Each benchmark drives the real callback against the front document and
+// leaves the document and the toolbar as it found them.
+
+static void BenchPageViewScroll( void * inData, ASInt32 inIteration )
+  {
+    APNotifier::PageViewDidChange( ( AVPageView )inData, PAGEVIEW_UPDATE_SCROLL, NULL ) ;
+
+  } // end BenchPageViewScroll
+
+// --------------------------
+
+static void BenchPageViewZoom( void * inData, ASInt32 inIteration )
+  {
+    APNotifier::PageViewDidChange( ( AVPageView )inData, PAGEVIEW_UPDATE_ZOOM, NULL ) ;
+
+  } // end BenchPageViewZoom
+
+// --------------------------
+// A zoom burst followed by the idle proc that settles it.
+
+static void BenchCoalescedUpdate( void * inData, ASInt32 inIteration )
+  {
+    APNotifier::PageViewDidChange( ( AVPageView )inData, PAGEVIEW_UPDATE_ZOOM, NULL ) ;
+    DoCoalescedUpdates( NULL ) ;
+
+  } // end BenchCoalescedUpdate
+
+// --------------------------
+
+static void BenchFrontDocDidChange( void * inData, ASInt32 inIteration )
+  {
+    APNotifier::FrontDocDidChange( ( AVDoc )inData, NULL ) ;
+
+  } // end BenchFrontDocDidChange
+
+// --------------------------
+// Alternate the zoom button between its first two states: one icon and tool
+// tip swap per call.
+
+static void BenchIconSwap( void * inData, ASInt32 inIteration )
+  {
+    gCycleGroups[ kZoomGroup ].Apply( gCycleGroupDefs[ kZoomGroup ].fStates[ inIteration & 1 ].fState ) ;
+
+  } // end BenchIconSwap
+
+// --------------------------
+// What a state change cost before the buttons were swapped in place: take a
+// button off the toolbar and put it back, so the toolbar is laid out again.
+
+struct ButtonReAddBench
+  {
+    AVToolBar       fAVToolBar ;
+    AVToolButton    fAVToolButton ;
+    AVToolButton    fBeforeAVToolButton ;
+  } ;
+
+static void BenchButtonReAdd( void * inData, ASInt32 inIteration )
+  {
+    ButtonReAddBench *  theBench = ( ButtonReAddBench * )inData ;
+
+    AVToolButtonRemove( theBench->fAVToolButton ) ;
+    AVToolBarAddButton( theBench->fAVToolBar, theBench->fAVToolButton, true, theBench->fBeforeAVToolButton ) ;
+
+  } // end BenchButtonReAdd
+
+// --------------------------
+// Write the cost per call of each TriState callback to TriStateBenchmark.txt.
+
+static ACCB1 void ACCB2 DoTriStateBenchmark( void * data )
+  {
+    APBenchmark         theBenchmark ;
+    ButtonReAddBench    theReAddBench ;
+    AVDoc               theAVDoc      = AVAppGetActiveDoc() ;
+    AVPageView          theAVPageView ;
+    ASInt32             theZoomState ;
+
+    if ( theAVDoc == NULL )
+      return ;
+
+    memset( &theReAddBench, 0, sizeof( theReAddBench ) ) ;
+
+    DURING
+
+      theAVPageView = AVDocGetPageView( theAVDoc ) ;
+
+      theBenchmark.Run( "AVPageViewDidChange, scroll", 100000, &BenchPageViewScroll, theAVPageView ) ;
+      theBenchmark.Run( "AVPageViewDidChange, zoom", 100000, &BenchPageViewZoom, theAVPageView ) ;
+      theBenchmark.Run( "AVPageViewDidChange, zoom, then idle update", 10000, &BenchCoalescedUpdate, theAVPageView ) ;
+      theBenchmark.Run( "AVAppFrontDocDidChange, cached", 100000, &BenchFrontDocDidChange, theAVDoc ) ;
+
+      if ( gCycleGroups[ kZoomGroup ].IsInstalled() )
+        {
+          theZoomState = gCycleGroups[ kZoomGroup ].GetAppliedState() ;
+          theBenchmark.Run( "zoom button, swap icon in place", 1000, &BenchIconSwap, NULL ) ;
+          gCycleGroups[ kZoomGroup ].Apply( theZoomState ) ;
+
+          theReAddBench.fAVToolBar          = AVAppGetToolBar() ;
+          theReAddBench.fBeforeAVToolButton = AVToolBarGetButtonByName( theReAddBench.fAVToolBar, ASAtomFromString( gCycleGroupDefs[ kZoomGroup ].fEndGroupName ) ) ;
+          theReAddBench.fAVToolButton       = AVToolButtonNew( ASAtomFromString( "DGAP:BenchmarkButton" ),
+                                                               APIconCache::Shared().GetIcon( kZoom100Icon ), false, false ) ;
+          AVToolBarAddButton( theReAddBench.fAVToolBar, theReAddBench.fAVToolButton, true, theReAddBench.fBeforeAVToolButton ) ;
+
+          theBenchmark.Run( "toolbar button, remove and add again", 1000, &BenchButtonReAdd, &theReAddBench ) ;
+        }
+
+    HANDLER
+      APDiagnostics::Shared().Report( ERRORCODE, "running the TriState benchmarks" ) ;
+    END_HANDLER
+
+    if ( theReAddBench.fAVToolButton != NULL )
+      {
+        AVToolButtonRemove( theReAddBench.fAVToolButton ) ;
+        AVToolButtonDestroy( theReAddBench.fAVToolButton ) ;
+      }
+
+    APReport *  theLog = new APReport( "TriStateBenchmark.txt" ) ;
+    if ( theLog != NULL )
+      {
+        theBenchmark.Write( theLog ) ;
+        delete( theLog ) ;
+      }
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoTriStateBenchmark
+
+// --------------------------
+// Write the events in the trace ring to TriStateTrace.json.
+
+static ACCB1 void ACCB2 DoWriteTrace( void * data )
+  {
+    if ( APTrace::Shared().Write( "TriStateTrace.json", "TriState" ) == false )
+      APDiagnostics::Shared().Report( 0, "writing TriStateTrace.json" ) ;
+
+    APDiagnostics::Shared().ShowSummary() ;
+
+  } // end DoWriteTrace
+
+// --------------------------
+// Called after every page view draw; the first one after a zoom click
+// completes that click's frame.
+
+static ACCB1 void ACCB2 DoPageViewDrawing( AVPageView inAVPageView, AVDevRect * inUpdateRect, void * data )
+  {
+    if ( gAwaitingZoomFrame == false )
+      return ;
+      
+    gAwaitingZoomFrame = false ;
+    gZoomFrameTime    += APTiming::GetNanoseconds() - gCycleGroups[ kZoomGroup ].GetSelectStart() ;
+    gZoomFrameCount   += 1 ;
+
+  } // end DoPageViewDrawing
 
 // -------------------------
 #pragma mark -- init
@@ -356,17 +787,8 @@ static ACCB1 boolean ACCB2 InitASAtoms( void )
   DURING
   
     gProductASAtom          = ASAtomFromString( "Product" ) ;           // used to test Exchange, LE or Reader
-    gUseNoneASAtom          = ASAtomFromString( "UseNone" ) ;           // Displays only the document, but neither bookmarks nor thumbnail images.
-    gUseBookmarksASAtom     = ASAtomFromString( "UseBookmarks" ) ;      // Displays the document and bookmarks.
-    gUseThumbsASAtom        = ASAtomFromString( "UseThumbs" ) ;         // Displays the document and thumbnail images.
-    gEndPageModeGroupASAtom = ASAtomFromString( "endPageModeGroup" ) ;  // Separator
-    gZoom100ASAtom          = ASAtomFromString( "Zoom100" ) ;           // Sets the zoom factor to 100% (i.e., actual size).
-    gFitPageASAtom          = ASAtomFromString( "FitPage" ) ;           // Sets the zoom factor to fit the entire page into the window.
-    gFitVisibleASAtom       = ASAtomFromString( "FitVisible" ) ;        // Sets the zoom factor to fit the portion of the page on which drawing appears into the window.
-    gEndZoomGroupASAtom     = ASAtomFromString( "endZoomGroup" ) ;      // Separator
-
   HANDLER
-    TASUtils::DisplayErrorAlert( ERRORCODE ) ;
+    APDiagnostics::Shared().Report( ERRORCODE, "creating the TriState atoms" ) ;
     return false ;
   END_HANDLER
   
@@ -376,131 +798,25 @@ static ACCB1 boolean ACCB2 InitASAtoms( void )
 
 // --------------------------
 
-static boolean InitPlugInToolBar( void )
+static const APMenuItemSpec gMenuItemSpecs[] =
   {
-    ASInt32       theButtonType ;
-    ASBool        theProblem      = false ;
-
-    DURING
-      
-      AVToolBar theAVToolBar = AVAppGetToolBar() ;
-      
-      gUseNoneToolButton          = AVToolBarGetButtonByName ( theAVToolBar, gUseNoneASAtom ) ;
-      if ( ! gUseNoneToolButton )
-        theProblem = true ;
-      gUseBookmarksToolButton     = AVToolBarGetButtonByName ( theAVToolBar, gUseBookmarksASAtom ) ;
-      if ( ! gUseBookmarksToolButton )
-        theProblem = true ;
-      gUseThumbsToolButton        = AVToolBarGetButtonByName ( theAVToolBar, gUseThumbsASAtom ) ;
-      if ( ! gUseThumbsToolButton )
-        theProblem = true ;
-      gEndPageModeGroupToolButton = AVToolBarGetButtonByName ( theAVToolBar, gEndPageModeGroupASAtom ) ;
-      if ( ! gEndPageModeGroupToolButton )
-        theProblem = true ;
-      
-      gZoom100ToolButton          = AVToolBarGetButtonByName ( theAVToolBar, gZoom100ASAtom ) ;
-      if ( ! gZoom100ToolButton )
-        theProblem = true ;
-      gFitPageToolButton          = AVToolBarGetButtonByName ( theAVToolBar, gFitPageASAtom ) ;
-      if ( ! gFitPageToolButton )
-        theProblem = true ;
-      gFitVisibleToolButton       = AVToolBarGetButtonByName ( theAVToolBar, gFitVisibleASAtom ) ;
-      if ( ! gFitVisibleToolButton )
-        theProblem = true ;
-      gEndZoomGroupToolButton     = AVToolBarGetButtonByName ( theAVToolBar, gEndZoomGroupASAtom ) ;
-      if ( ! gEndZoomGroupToolButton )
-        theProblem = true ;
-      
-      if ( theProblem == true )
-        {
-          TASUtils::DisplayErrorAlert( "TriState failed to load because it could not find a required toolbar button." ) ;
-          return false ;
-        }
-        
-      gDAUseNoneToolButton        = AVToolButtonNew( ASAtomFromString( "DGAP:UseNone" ),      TAVUtils::GetButtonIcon( kUseNoneIcon ),      false, false ) ;
-      gDAUseBookmarksToolButton   = AVToolButtonNew( ASAtomFromString( "DGAP:UseBookmarks" ), TAVUtils::GetButtonIcon( kUseBookmarksIcon ), false, false ) ;
-      gDAUseThumbsToolButton      = AVToolButtonNew( ASAtomFromString( "DGAP:UseThumbs" ),    TAVUtils::GetButtonIcon( kUseThumbsIcon ),    false, false ) ;
-                                                  
-      gDAZoom100ToolButton        = AVToolButtonNew( ASAtomFromString( "DGAP:Zoom100" ),      TAVUtils::GetButtonIcon( kZoom100Icon ),      false, false ) ;
-      gDAFitPageToolButton        = AVToolButtonNew( ASAtomFromString( "DGAP:FitPage" ),      TAVUtils::GetButtonIcon( kFitPageIcon ),      false, false ) ;
-      gDAFitVisibleToolButton     = AVToolButtonNew( ASAtomFromString( "DGAP:FitVisible" ),   TAVUtils::GetButtonIcon( kFitVisibleIcon ),   false, false ) ;
-                                                  
-      // add the new useNone button after the initial 3 state buttons
-      AVToolBarAddButton( theAVToolBar, gDAUseNoneToolButton, true, gEndPageModeGroupToolButton ) ;
-      gCurrentPageModeToolButton = gDAUseNoneToolButton ;
-      
-      AVToolBarAddButton( theAVToolBar, gDAZoom100ToolButton, true, gEndZoomGroupToolButton ) ;
-      gCurrentViewToolButton = gDAZoom100ToolButton ;
-      
-      // now remove the initial 3 state buttons
-      AVToolButtonRemove ( gUseNoneToolButton ) ;
-      AVToolButtonRemove ( gUseBookmarksToolButton ) ;
-      AVToolButtonRemove ( gUseThumbsToolButton ) ;
-      
-      AVToolButtonRemove ( gZoom100ToolButton ) ;
-      AVToolButtonRemove ( gFitPageToolButton ) ;
-      AVToolButtonRemove ( gFitVisibleToolButton ) ;
-      
-      theButtonType = kUseNoneIcon ;
-      AVToolButtonSetExecuteProc( gDAUseNoneToolButton, ASCallbackCreateProto( AVExecuteProc, &DoPageModeTriState ), ( void * )theButtonType ) ;
-      AVToolButtonSetComputeEnabledProc( gDAUseNoneToolButton, ASCallbackCreateProto( AVComputeEnabledProc, TAVUtils::ComputeEnabled ), NULL ) ;
-    
-      theButtonType = kUseBookmarksIcon ;
-      AVToolButtonSetExecuteProc( gDAUseBookmarksToolButton, ASCallbackCreateProto( AVExecuteProc, &DoPageModeTriState ), ( void * )theButtonType ) ;
-      AVToolButtonSetComputeEnabledProc( gDAUseBookmarksToolButton, ASCallbackCreateProto( AVComputeEnabledProc, TAVUtils::ComputeEnabled ), NULL ) ;
-    
-      theButtonType = kUseThumbsIcon ;
-      AVToolButtonSetExecuteProc( gDAUseThumbsToolButton, ASCallbackCreateProto( AVExecuteProc, &DoPageModeTriState ), ( void * )theButtonType ) ;
-      AVToolButtonSetComputeEnabledProc( gDAUseThumbsToolButton, ASCallbackCreateProto( AVComputeEnabledProc, TAVUtils::ComputeEnabled ), NULL ) ;
-    
-      theButtonType = kZoom100Icon ;
-      AVToolButtonSetExecuteProc( gDAZoom100ToolButton, ASCallbackCreateProto( AVExecuteProc, &DoViewTriState ), ( void * )theButtonType ) ;
-      AVToolButtonSetComputeEnabledProc( gDAZoom100ToolButton, ASCallbackCreateProto( AVComputeEnabledProc, TAVUtils::ComputeEnabled ), NULL ) ;
-    
-      theButtonType = kFitPageIcon ;
-      AVToolButtonSetExecuteProc( gDAFitPageToolButton, ASCallbackCreateProto( AVExecuteProc, &DoViewTriState ), ( void * )theButtonType ) ;
-      AVToolButtonSetComputeEnabledProc( gDAFitPageToolButton, ASCallbackCreateProto( AVComputeEnabledProc, TAVUtils::ComputeEnabled ), NULL ) ;
-    
-      theButtonType = kFitVisibleIcon ;
-      AVToolButtonSetExecuteProc( gDAFitVisibleToolButton, ASCallbackCreateProto( AVExecuteProc, &DoViewTriState ), ( void * )theButtonType ) ;
-      AVToolButtonSetComputeEnabledProc( gDAFitVisibleToolButton, ASCallbackCreateProto( AVComputeEnabledProc, TAVUtils::ComputeEnabled ), NULL ) ;
-    
-    HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
-    END_HANDLER
-
-    return true ;
-        
-  } // end InitPlugInToolBar
-
-// -------------------------
+    { "TriState...",               "DGAP:DoAboutTriState",      "AboutExtensions", NULL, NO_SHORTCUT, 0, NULL,                     NULL, NULL,               &DoAboutTriState,     NULL },
+    { "TriState Report...",        "DGAP:TriStateReport",       "Extensions",      NULL, NO_SHORTCUT, 0, NULL,                     NULL, NULL,               &DoTriStateReport,    NULL },
+    { "TriState Trace...",         "DGAP:TriStateTrace",        "Extensions",      NULL, NO_SHORTCUT, 0, NULL,                     NULL, NULL,               &DoWriteTrace,        NULL },
+    { "TriState Benchmark...",     "DGAP:TriStateBenchmark",    "Extensions",      NULL, NO_SHORTCUT, 0, TAVUtils::ComputeEnabled, NULL, NULL,               &DoTriStateBenchmark, NULL },
+    { "TriState Record Events",    "DGAP:TriStateRecordEvents", "Extensions",      NULL, NO_SHORTCUT, 0, NULL,                     NULL, &IsRecordingEvents, &DoRecordEvents,      NULL },
+    { "TriState Replay Events...", "DGAP:TriStateReplayEvents", "Extensions",      NULL, NO_SHORTCUT, 0, TAVUtils::ComputeEnabled, NULL, NULL,               &DoReplayEvents,      NULL }
+  } ;
 
 static ACCB1 boolean ACCB2 InitPlugInMenus( void )
   {
-    AVMenubar     theAVMenubar ;
-    AVMenuItem    theAVMenuItem ;
-    ASInt32       theButtonType ;
-    
     DURING
     
-      theAVMenubar  = AVAppGetMenubar() ;   // get the main menu
-      if ( ! theAVMenubar ) 
+      if ( APMenuInstaller::Install( gMenuItemSpecs, APMenuItemCount( gMenuItemSpecs ), NULL, NULL ) == 0 )
         E_RETURN( false ) ;
-        
-      TAVUtils::AppendToAboutMenu( "TriState...", "DGAP:DoAboutTriState", &DoAboutTriState ) ;
       
-      theAVMenuItem = AVMenubarAcquireMenuItemByName ( theAVMenubar, "ShowBookmarks" ) ;
-  
-      theButtonType = kUseNoneIcon ;
-      AVMenuItemSetExecuteProc( theAVMenuItem, ASCallbackCreateProto( AVExecuteProc, &DoPageModeTriState ), ( void * )theButtonType ) ;
-    
-      theAVMenuItem = AVMenubarAcquireMenuItemByName ( theAVMenubar, "ShowThumbs" ) ;
-  
-      theButtonType = kUseBookmarksIcon ;
-      AVMenuItemSetExecuteProc( theAVMenuItem, ASCallbackCreateProto( AVExecuteProc, &DoPageModeTriState ), ( void * )theButtonType ) ;
-    
     HANDLER
-      TASUtils::DisplayErrorAlert( ERRORCODE ) ;
+      APDiagnostics::Shared().Report( ERRORCODE, "installing the TriState menu items" ) ;
     END_HANDLER
     
     return true ;
@@ -512,17 +828,23 @@ static ACCB1 boolean ACCB2 InitPlugInMenus( void )
 static ACCB1 boolean ACCB2 InitPlugIn( void )
   {
     boolean   theResult ;
+    ASUns64   theStart = APTiming::GetNanoseconds() ;
     
+    LoadProfilerMark( kLoadPhaseInitStart, theStart ) ;
+
     theResult = InitASAtoms() ;
-    if ( theResult == false )
-      return theResult ;
+    if ( theResult == true )
+      theResult = InitPlugInMenus() ;
 
-    theResult = InitPlugInMenus() ;
-    if ( theResult == false )
-      return theResult ;
-      
-    theResult = InitPlugInToolBar() ;
+    APDiagnostics::Shared().ShowSummary() ;
+
+    // the toolbar is left alone until the first document opens; see InstallToolBar
     
+    // on failure too, so a failed init is still ranked by what it cost
+    gInitTime = APTiming::GetNanoseconds() - theStart ;
+
+    LoadProfilerMark( kLoadPhaseInitEnd, theStart + gInitTime ) ;
+
     return theResult ;
     
   } // end InitPlugIn
@@ -531,6 +853,9 @@ static ACCB1 boolean ACCB2 InitPlugIn( void )
 
 static ACCB1 boolean ACCB2 UnloadPlugIn( void )
   {
+    APNotifier::Shared().UnregisterAll() ;
+    APDiagnostics::Shared().Close() ;
+
     return true ;
     
   } // end UnloadPlugIn
@@ -545,12 +870,33 @@ static ACCB1 boolean ACCB2 UnloadPlugIn( void )
 
 static ACCB1 boolean ACCB2 PreInitPlugIn( void )
   {
+    ASUns64   theImportStart = APTiming::GetNanoseconds() ;
+
+    APDiagnostics::Shared().SetLogName( "TriStateDiagnostics.txt" ) ;
+
+    gLoadProfilerHFT = ASExtensionMgrGetHFT( ASAtomFromString( kLoadProfilerHFTName ), kLoadProfilerHFTVersion ) ;
+
+    APNotifier &  theNotifier = APNotifier::Shared() ;
 
-    AVAppRegisterNotification( AVDocDidOpenNSEL, gExtensionID, ASCallbackCreateNotification( AVDocDidOpen, ( void * )DoAVDocDidOpen ), NULL ) ;
+    // the recorder comes first so it sees each notification before the handler does
+    theNotifier.Subscribe( kNotifyDocDidOpen,        kNotifyAllChanges, "RecordNotification", &RecordNotification, NULL ) ;
+    theNotifier.Subscribe( kNotifyFrontDocDidChange, kNotifyAllChanges, "RecordNotification", &RecordNotification, NULL ) ;
+    theNotifier.Subscribe( kNotifyPageViewDidChange, kNotifyAllChanges, "RecordNotification", &RecordNotification, NULL ) ;
 
-    AVAppRegisterNotification( AVAppFrontDocDidChangeNSEL, gExtensionID, ASCallbackCreateNotification( AVAppFrontDocDidChange, ( void * )DoAVAppFrontDocDidChange ), NULL ) ;
+    theNotifier.Subscribe( kNotifyDocDidOpen,        kNotifyAllChanges, "DoAVDocDidOpen", &DoAVDocDidOpen, NULL ) ;
+    theNotifier.Subscribe( kNotifyDocWillClose,      kNotifyAllChanges, "DoAVDocWillClose", &DoAVDocWillClose, NULL ) ;
+    theNotifier.Subscribe( kNotifyFrontDocDidChange, kNotifyAllChanges, "DoAVAppFrontDocDidChange", &DoAVAppFrontDocDidChange, NULL ) ;
 
-    AVAppRegisterNotification( AVPageViewDidChangeNSEL, gExtensionID, ASCallbackCreateNotification( AVPageViewDidChange, ( void * )DoAVPageViewDidChange ), NULL ) ;
+    gPageViewSubscriber = theNotifier.Subscribe( kNotifyPageViewDidChange, PAGEVIEW_UPDATE_PAGESIZE | PAGEVIEW_UPDATE_ZOOM,
+                                                 "DoAVPageViewDidChange", &DoAVPageViewDidChange, NULL ) ;
+
+    AVAppRegisterIdleProc( ASCallbackCreateProto( AVIdleProc, &DoCoalescedUpdates ), NULL, kCoalesceTicks ) ;
+
+    AVAppRegisterForPageViewDrawing( ASCallbackCreateProto( AVPageViewDrawProc, &DoPageViewDrawing ), NULL ) ;
+
+    LoadProfilerMark( kLoadPhaseHandshake, gHandshakeTime ) ;
+    LoadProfilerMark( kLoadPhaseImportStart, theImportStart ) ;
+    LoadProfilerMark( kLoadPhaseImportEnd, APTiming::GetNanoseconds() ) ;
 
     return true ;
     
@@ -560,6 +906,8 @@ static ACCB1 boolean ACCB2 PreInitPlugIn( void )
 
 ACCB1 boolean ACCB2 PIHandshake( Uns32 handshakeVersion, void *handshakeData )
   {
+    gHandshakeTime = APTiming::GetNanoseconds() ;
+
     if ( handshakeVersion == HANDSHAKE_V0200 )
       {
         PIHandshakeData_V0200 *hsData = ( PIHandshakeData_V0200 * )handshakeData ;
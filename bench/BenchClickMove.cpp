@@ -0,0 +1,109 @@
+/*
+  File:   BenchClickMove.cpp
+
+  Contains: benchClickMove, which loads ClickMove into the simulated host
+            and times its page view click proc, as Acrobat calls it.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      benchClickMove [calls]
+
+    Writes the cost per call to standard output, and fails when a click is
+    not handled or the page view does not end where it started.
+
+*/
+
+#include "ClickMove.cpp"
+
+#include <stdlib.h>
+
+#include "SimHost.h"
+
+// --------------------------
+
+#define kBenchPages     200
+#define kBenchCalls     100000
+
+// --------------------------
+// Through the host, as Acrobat dispatches a click: a single click on even
+// calls steps forward, a double click on odd calls steps back.
+
+static void BenchSimClick( void * inData, ASInt32 inIteration )
+  {
+    SimClick( ( AVPageView )inData, 0, ( inIteration & 1 ) ? 2 : 1 ) ;
+
+  } // end BenchSimClick
+
+// --------------------------
+
+int main( int argc, char * argv[] )
+  {
+    APBenchmark   theBenchmark ;
+    ASInt32       theCalls    = ( argc > 1 ) ? atoi( argv[ 1 ] ) : kBenchCalls ;
+    ASInt32       theAcquired ;
+    AVDoc         theAVDoc ;
+    AVPageView    theAVPageView ;
+    int           theResult   = 0 ;
+
+    SimHostInit() ;
+    if ( SimLoadPlugIn( &PIHandshake ) == false )
+      {
+        fprintf( stderr, "ClickMove did not load\n" ) ;
+        return 1 ;
+      }
+
+    theAVDoc      = SimOpenDoc( "ClickMove", kBenchPages ) ;
+    theAVPageView = AVDocGetPageView( theAVDoc ) ;
+    theAcquired   = SimGetNumAcquired() ;
+    theCalls     += theCalls & 1 ;
+
+    theBenchmark.SetAllocationCounter( &SimGetAllocations ) ;
+
+    SimSetFullScreen( true ) ;
+    if ( SimClick( theAVPageView, 0, 1 ) == false )
+      {
+        fprintf( stderr, "a full screen click was not handled\n" ) ;
+        theResult = 1 ;
+      }
+    SimClick( theAVPageView, 0, 2 ) ;
+
+    theBenchmark.Run( "AVPageViewClick, full screen", theCalls, &BenchSimClick, theAVPageView ) ;
+    theBenchmark.Run( "find the target page, navigation cache", theCalls, &BenchFindTargetCached, theAVPageView ) ;
+
+    SimSetFullScreen( false ) ;
+    theBenchmark.Run( "AVPageViewClick, not full screen", theCalls, &BenchSimClick, theAVPageView ) ;
+
+    APReport  theReport( "-" ) ;
+    theBenchmark.Write( &theReport ) ;
+
+    if ( AVPageViewGetPageNum( theAVPageView ) != 0 )
+      {
+        fprintf( stderr, "the page view ended on page %d, not 0\n", ( int )AVPageViewGetPageNum( theAVPageView ) ) ;
+        theResult = 1 ;
+      }
+
+    if ( SimGetNumAcquired() != theAcquired )
+      {
+        fprintf( stderr, "%d objects acquired and not released\n", ( int )( SimGetNumAcquired() - theAcquired ) ) ;
+        theResult = 1 ;
+      }
+
+    SimCloseDoc( theAVDoc ) ;
+    SimUnloadPlugIn() ;
+
+    return theResult ;
+
+  } // end main
+
+// --------------------------
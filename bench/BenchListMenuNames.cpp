@@ -0,0 +1,87 @@
+/*
+  File:   BenchListMenuNames.cpp
+
+  Contains: benchListMenuNames, which loads ListMenuNames into the simulated
+            host and times the menu listing against its menubar.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      benchListMenuNames [calls]
+
+    Writes the cost per call to standard output and the menu listings to
+    ListMenuNamesBenchmarkScratch.txt, and fails when something acquired
+    is not released.
+
+*/
+
+#include "ListMenuNames.cpp"
+
+#include <stdlib.h>
+
+#include "SimHost.h"
+
+// --------------------------
+
+#define kBenchCalls     1000
+
+// --------------------------
+
+int main( int argc, char * argv[] )
+  {
+    APBenchmark   theBenchmark ;
+    ASInt32       theCalls    = ( argc > 1 ) ? atoi( argv[ 1 ] ) : kBenchCalls ;
+    ASInt32       theAcquired ;
+    AVDoc         theAVDoc ;
+    int           theResult   = 0 ;
+
+    SimHostInit() ;
+    if ( SimLoadPlugIn( &PIHandshake ) == false )
+      {
+        fprintf( stderr, "ListMenuNames did not load\n" ) ;
+        return 1 ;
+      }
+
+    theAVDoc    = SimOpenDoc( "ListMenuNames", 1 ) ;
+
+    // the menu index is built on the first lookup and keeps a reference on
+    // every menu and menu item, so it is built before the count is taken
+    BenchMenuIndexLookup( ( void * )( size_t )ASAtomFromString( kBenchAnchorName ), 0 ) ;
+    theAcquired = SimGetNumAcquired() ;
+
+    theBenchmark.SetAllocationCounter( &SimGetAllocations ) ;
+
+    APReport *  theScratch = new APReport( "ListMenuNamesBenchmarkScratch.txt" ) ;
+    theBenchmark.Run( "ListAllMenus", theCalls, &BenchListAllMenus, theScratch ) ;
+    delete( theScratch ) ;
+
+    theBenchmark.Run( "find a menu item, menubar", theCalls * 10, &BenchMenubarLookup, NULL ) ;
+    theBenchmark.Run( "find a menu item, menu index", theCalls * 10, &BenchMenuIndexLookup, ( void * )( size_t )ASAtomFromString( kBenchAnchorName ) ) ;
+
+    APReport  theReport( "-" ) ;
+    theBenchmark.Write( &theReport ) ;
+
+    if ( SimGetNumAcquired() != theAcquired )
+      {
+        fprintf( stderr, "%d objects acquired and not released\n", ( int )( SimGetNumAcquired() - theAcquired ) ) ;
+        theResult = 1 ;
+      }
+
+    SimCloseDoc( theAVDoc ) ;
+    SimUnloadPlugIn() ;
+
+    return theResult ;
+
+  } // end main
+
+// --------------------------
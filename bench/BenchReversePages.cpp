@@ -0,0 +1,105 @@
+/*
+  File:   BenchReversePages.cpp
+
+  Contains: benchReversePages, which loads ReversePages into the simulated
+            host and times its menu commands, chosen from the menubar as
+            the user would.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      benchReversePages [calls]
+
+    Writes the cost per call to standard output, and fails when the pages
+    are not back in their first order and rotation after an even number of
+    reverses, or something acquired is not released.
+
+*/
+
+#include "ReversePages.cpp"
+
+#include <stdlib.h>
+
+#include "SimHost.h"
+
+// --------------------------
+
+#define kBenchPages     500
+#define kBenchCalls     100
+
+// --------------------------
+
+static void BenchSimMenuItem( void * inData, ASInt32 inIteration )
+  {
+    SimExecuteMenuItem( ( const char * )inData ) ;
+
+  } // end BenchSimMenuItem
+
+// --------------------------
+
+int main( int argc, char * argv[] )
+  {
+    APBenchmark   theBenchmark ;
+    ASInt32       theCalls    = ( argc > 1 ) ? atoi( argv[ 1 ] ) : kBenchCalls ;
+    ASInt32       theAcquired ;
+    AVDoc         theAVDoc ;
+    PDDoc         thePDDoc ;
+    int           theResult   = 0 ;
+
+    SimHostInit() ;
+    if ( SimLoadPlugIn( &PIHandshake ) == false )
+      {
+        fprintf( stderr, "ReversePages did not load\n" ) ;
+        return 1 ;
+      }
+
+    theAVDoc    = SimOpenDoc( "ReversePages", kBenchPages ) ;
+    thePDDoc    = AVDocGetPDDoc( theAVDoc ) ;
+    SimRunIdle() ;
+    theAcquired = SimGetNumAcquired() ;
+    theCalls   += theCalls & 1 ;
+
+    theBenchmark.SetAllocationCounter( &SimGetAllocations ) ;
+
+    theBenchmark.Run( "Reverse Pages, 500 pages", theCalls, &BenchSimMenuItem, ( void * )"DGAP:ReversePages" ) ;
+    theBenchmark.Run( "Reverse Pages and Rotate All, 500 pages", theCalls, &BenchSimMenuItem, ( void * )"DGAP:ReverseRotateAll" ) ;
+
+    APReport  theReport( "-" ) ;
+    theBenchmark.Write( &theReport ) ;
+
+    for ( ASInt32 index = 0 ; index < kBenchPages ; index++ )
+      {
+        APPDPageRef   thePDPage( PDDocAcquirePage( thePDDoc, index ) ) ;
+
+        if ( ( SimGetOriginalPageNum( thePDDoc, index ) != index ) || ( PDPageGetRotate( thePDPage ) != 0 ) )
+          {
+            fprintf( stderr, "page %d is out of place or turned after an even number of reverses\n", ( int )index ) ;
+            theResult = 1 ;
+            break ;
+          }
+      }
+
+    if ( SimGetNumAcquired() != theAcquired )
+      {
+        fprintf( stderr, "%d objects acquired and not released\n", ( int )( SimGetNumAcquired() - theAcquired ) ) ;
+        theResult = 1 ;
+      }
+
+    SimCloseDoc( theAVDoc ) ;
+    SimUnloadPlugIn() ;
+
+    return theResult ;
+
+  } // end main
+
+// --------------------------
@@ -0,0 +1,122 @@
+/*
+  File:   BenchTriState.cpp
+
+  Contains: benchTriState, which loads TriState into the simulated host and
+            times its page view notification and the idle update that
+            follows it, as Acrobat sends them.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      benchTriState [calls]
+
+    Writes the cost per call to standard output, and fails when the zoom
+    button does not follow the zoom or something acquired is not released.
+
+*/
+
+#include "TriState.cpp"
+
+#include <stdlib.h>
+
+#include "SimHost.h"
+
+// --------------------------
+
+#define kBenchPages     50
+#define kBenchCalls     100000
+
+// --------------------------
+// Through the host's notification, which APNotifier passes on to
+// DoAVPageViewDidChange for a zoom and filters out for a scroll.
+
+static void BenchSimScroll( void * inData, ASInt32 inIteration )
+  {
+    SimPageViewDidChange( ( AVPageView )inData, PAGEVIEW_UPDATE_SCROLL ) ;
+
+  } // end BenchSimScroll
+
+// --------------------------
+
+static void BenchSimZoom( void * inData, ASInt32 inIteration )
+  {
+    SimPageViewDidChange( ( AVPageView )inData, PAGEVIEW_UPDATE_ZOOM ) ;
+
+  } // end BenchSimZoom
+
+// --------------------------
+
+static void BenchSimZoomThenIdle( void * inData, ASInt32 inIteration )
+  {
+    SimPageViewDidChange( ( AVPageView )inData, PAGEVIEW_UPDATE_ZOOM ) ;
+    SimRunIdle() ;
+
+  } // end BenchSimZoomThenIdle
+
+// --------------------------
+
+int main( int argc, char * argv[] )
+  {
+    APBenchmark   theBenchmark ;
+    ASInt32       theCalls    = ( argc > 1 ) ? atoi( argv[ 1 ] ) : kBenchCalls ;
+    ASInt32       theAcquired ;
+    AVDoc         theAVDoc ;
+    AVPageView    theAVPageView ;
+    int           theResult   = 0 ;
+
+    SimHostInit() ;
+    if ( SimLoadPlugIn( &PIHandshake ) == false )
+      {
+        fprintf( stderr, "TriState did not load\n" ) ;
+        return 1 ;
+      }
+
+    theAVDoc      = SimOpenDoc( "TriState", kBenchPages ) ;
+    theAVPageView = AVDocGetPageView( theAVDoc ) ;
+    SimRunIdle() ;
+    theAcquired   = SimGetNumAcquired() ;
+
+    theBenchmark.SetAllocationCounter( &SimGetAllocations ) ;
+
+    theBenchmark.Run( "AVPageViewDidChange, scroll", theCalls, &BenchSimScroll, theAVPageView ) ;
+    theBenchmark.Run( "AVPageViewDidChange, zoom", theCalls, &BenchSimZoom, theAVPageView ) ;
+    SimRunIdle() ;
+    theBenchmark.Run( "AVPageViewDidChange, zoom, then idle update", theCalls, &BenchSimZoomThenIdle, theAVPageView ) ;
+
+    APReport  theReport( "-" ) ;
+    theBenchmark.Write( &theReport ) ;
+
+    // a click on the zoom button moves on to the next zoom, and the idle update follows it
+    AVToolButtonExecute( AVToolBarGetButtonByName( AVAppGetToolBar(), ASAtomFromString( "DGAP:Zoom" ) ) ) ;
+    SimRunIdle() ;
+    if ( ( gCycleGroups[ kZoomGroup ].IsInstalled() == false )
+         || ( gCycleGroups[ kZoomGroup ].GetAppliedState() != ProbeZoomType( theAVDoc ) ) )
+      {
+        fprintf( stderr, "the zoom button does not show the zoom\n" ) ;
+        theResult = 1 ;
+      }
+
+    if ( SimGetNumAcquired() != theAcquired )
+      {
+        fprintf( stderr, "%d objects acquired and not released\n", ( int )( SimGetNumAcquired() - theAcquired ) ) ;
+        theResult = 1 ;
+      }
+
+    SimCloseDoc( theAVDoc ) ;
+    SimUnloadPlugIn() ;
+
+    return theResult ;
+
+  } // end main
+
+// --------------------------
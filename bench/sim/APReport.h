@@ -0,0 +1,48 @@
+/*
+  File:   APReport.h
+
+  Contains: The simulated host's stand-in for APReport, which writes a
+            plug-in's text report.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    Reports are written to the current folder, where Acrobat would use the
+    temporary folder; the name "-" writes to standard output.
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+
+#include <stdio.h>
+
+// --------------------------
+
+class APReport
+  {
+    public:
+      APReport( const char * inFileName ) ;
+      ~APReport() ;
+
+      void    Write( const char * inText, size_t inLength ) ;
+
+    private:
+      FILE *  mFile ;
+
+      APReport( const APReport & ) ;
+      APReport & operator=( const APReport & ) ;
+  } ;
+
+// --------------------------
@@ -0,0 +1,232 @@
+/*
+  File:   ASCalls.h
+
+  Contains: The simulated host's atoms, callbacks, host function tables,
+            fixed point math, text and file system calls.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "CorCalls.h"
+
+// --------------------------
+// Atoms
+
+typedef ASUns32     ASAtom ;
+
+#define ASAtomNull  ( ( ASAtom )-1 )
+
+ASAtom        ASAtomFromString( const char * inString ) ;
+const char *  ASAtomGetString( ASAtom inAtom ) ;
+
+// --------------------------
+// Callbacks are the procedures themselves.
+
+typedef void *      ASCallback ;
+
+#define ASCallbackCreate( inProc )                              ( ( void * )( inProc ) )
+#define ASCallbackCreateProto( inType, inProc )                 ( ( inType )( inProc ) )
+#define ASCallbackCreateNotification( inNotification, inProc )  ( ( void * )( inProc ) )
+#define ASCallbackCreateReplacement( inSelector, inProc )       ( ( void * )( inProc ) )
+#define ASCallbackDestroy( inCallback )                         ( ( void )( inCallback ) )
+
+// --------------------------
+// Extensions and host function tables
+
+typedef struct _t_ASExtension *   ASExtension ;
+typedef struct _t_HFTServer *     HFTServer ;
+typedef void *                    HFTEntry ;
+typedef HFTEntry *                HFT ;
+
+// the calling plug-in, set by the simulated host before its handshake
+extern ASExtension  gExtensionID ;
+
+typedef ACCBPROTO1 HFT ( ACCBPROTO2 * HFTServerProvideHFTProc )( HFTServer inServer, ASUns32 inVersion, void * inRock ) ;
+typedef ACCBPROTO1 void ( ACCBPROTO2 * HFTServerDestroyProc )( HFTServer inServer, void * inRock ) ;
+
+#define HFTEntryReplaceable   0x00000001
+
+ASAtom      ASExtensionGetRegisteredName( ASExtension inExtension ) ;
+HFT         ASExtensionMgrGetHFT( ASAtom inName, ASUns32 inVersion ) ;
+HFTServer   HFTServerNew( const char * inName, HFTServerProvideHFTProc inProvideProc, HFTServerDestroyProc inDestroyProc, void * inRock ) ;
+HFT         HFTNew( HFTServer inServer, ASUns32 inNumSelectors ) ;
+void        HFTReplaceEntry( HFT inHFT, ASUns32 inSelector, HFTEntry inEntry, ASUns32 inFlags ) ;
+
+// --------------------------
+// Memory and errors
+
+void *      ASmalloc( size_t inSize ) ;
+void        ASfree( void * inPointer ) ;
+void        ASGetErrorString( ASErrorCode inError, char * outBuffer, ASInt32 inBufferSize ) ;
+
+// --------------------------
+// Fixed point, 16.16
+
+typedef ASInt32     ASFixed ;
+
+#define fixedZero   ( ( ASFixed )0 )
+#define fixedOne    ( ( ASFixed )0x00010000 )
+
+#define ASInt32ToFixed( inValue )   ( ( ASFixed )( ( inValue ) << 16 ) )
+
+struct ASFixedPoint
+  {
+    ASFixed   h ;
+    ASFixed   v ;
+  } ;
+
+struct ASFixedRect
+  {
+    ASFixed   left ;
+    ASFixed   top ;
+    ASFixed   right ;
+    ASFixed   bottom ;
+  } ;
+
+struct ASFixedQuad
+  {
+    ASFixedPoint  tl ;
+    ASFixedPoint  tr ;
+    ASFixedPoint  bl ;
+    ASFixedPoint  br ;
+  } ;
+
+struct ASFixedMatrix
+  {
+    ASFixed   a ;
+    ASFixed   b ;
+    ASFixed   c ;
+    ASFixed   d ;
+    ASFixed   h ;
+    ASFixed   v ;
+  } ;
+
+ASFixed     ASFixedMul( ASFixed inA, ASFixed inB ) ;
+ASFixed     ASFixedDiv( ASFixed inA, ASFixed inB ) ;
+ASInt32     ASFixedRoundToInt32( ASFixed inValue ) ;
+
+// --------------------------
+// Text
+
+typedef struct _t_ASText *  ASText ;
+typedef ASUns16             ASUTF16Val ;
+typedef ASInt32             ASHostEncoding ;
+
+enum ASUnicodeFormat
+  {
+    kUTF16BigEndian,
+    kUTF16HostEndian,
+    kUTF8,
+    kUTF32BigEndian,
+    kUTF32HostEndian
+  } ;
+
+ASText        ASTextNew( void ) ;
+void          ASTextDestroy( ASText inText ) ;
+void          ASTextSetUnicode( ASText inText, const ASUTF16Val * inString, ASUnicodeFormat inFormat ) ;
+ASUTF16Val *  ASTextGetUnicodeCopy( ASText inText, ASUnicodeFormat inFormat ) ;   // free with ASfree
+char *        ASTextGetEncodedCopy( ASText inText, ASHostEncoding inEncoding ) ;   // free with ASfree
+
+// --------------------------
+// Time
+
+struct ASTimeRec
+  {
+    ASInt16   year ;
+    ASInt16   month ;
+    ASInt16   date ;
+    ASInt16   hour ;
+    ASInt16   minute ;
+    ASInt16   second ;
+    ASInt16   millisecond ;
+    ASInt16   day ;
+    ASInt16   gmtOffset ;
+  } ;
+
+// --------------------------
+// Files; the simulated host's one file system is the process's own, and a
+// DI path is a POSIX path.
+
+typedef struct _t_ASFileSys *       ASFileSys ;
+typedef struct _t_ASPathName *      ASPathName ;
+typedef struct _t_ASFile *          ASFile ;
+typedef struct _t_ASPlatformPath *  ASPlatformPath ;
+typedef ASInt32                     ASFileSysItemType ;
+typedef ASInt64                     ASFilePos64 ;
+
+#define ASFILE_READ     0x0001
+#define ASFILE_WRITE    0x0002
+#define ASFILE_CREATE   0x0004
+
+enum
+  {
+    kASFileSysFile,
+    kASFileSysFolder
+  } ;
+
+struct ASFileSysItemPropsRec
+  {
+    ASInt32             size ;
+    ASBool              isThere ;
+    ASFileSysItemType   type ;
+    ASInt32             fileSizeHigh ;
+    ASInt32             fileSizeLow ;
+  } ;
+
+typedef ASFileSysItemPropsRec * ASFileSysItemProps ;
+
+ASFileSys       ASGetDefaultFileSys( void ) ;
+
+ASPathName      ASFileSysCreatePathName( ASFileSys inFileSys, ASAtom inPathSpecType, const void * inPathSpec, const void * inMoreInfo ) ;
+ASPathName      ASFileSysCreatePathFromDIPath( ASFileSys inFileSys, const char * inDIPath, ASPathName inRelativeToThisPath ) ;
+char *          ASFileSysDIPathFromPath( ASFileSys inFileSys, ASPathName inPathName, ASPathName inRelativeToThisPath ) ;  // free with ASfree
+void            ASFileSysReleasePath( ASFileSys inFileSys, ASPathName inPathName ) ;
+ASErrorCode     ASFileSysAcquireParent( ASFileSys inFileSys, ASPathName inPathName, ASPathName * outParent ) ;
+ASErrorCode     ASFileSysGetNameFromPathAsASText( ASFileSys inFileSys, ASPathName inPathName, ASText outText ) ;
+ASErrorCode     ASFileSysDisplayASTextFromPath( ASFileSys inFileSys, ASPathName inPathName, ASText outText ) ;
+ASErrorCode     ASFileSysGetItemProps( ASFileSys inFileSys, ASPathName inPathName, ASFileSysItemProps outProps ) ;
+ASErrorCode     ASFileSysAcquirePlatformPath( ASFileSys inFileSys, ASPathName inPathName, ASAtom inPlatformPathType, ASPlatformPath * outPlatformPath ) ;
+void            ASFileSysReleasePlatformPath( ASFileSys inFileSys, ASPlatformPath inPlatformPath ) ;
+const char *    ASPlatformPathGetPOSIXPathPtr( ASPlatformPath inPlatformPath ) ;
+ASErrorCode     ASFileSysOpenFile( ASFileSys inFileSys, ASPathName inPathName, ASUns16 inMode, ASFile * outFile ) ;
+
+ASInt32         ASFileRead( ASFile inFile, char * outBuffer, ASInt32 inCount ) ;
+ASInt32         ASFileGetEOF( ASFile inFile ) ;
+ASErrorCode     ASFileClose( ASFile inFile ) ;
+ASFileSys       ASFileGetFileSys( ASFile inFile ) ;
+ASPathName      ASFileAcquirePathName( ASFile inFile ) ;
+
+// --------------------------
+// Plug-in handshake
+
+#define HANDSHAKE_V0200   0x00020000
+
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * PIExportHFTsProcType )( void ) ;
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * PIImportReplaceAndRegisterProcType )( void ) ;
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * PIInitProcType )( void ) ;
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * PIUnloadProcType )( void ) ;
+
+struct PIHandshakeData_V0200
+  {
+    ASUns32                               handshakeVersion ;
+    ASAtom                                extensionName ;
+    PIExportHFTsProcType                  exportHFTsCallback ;
+    PIImportReplaceAndRegisterProcType    importReplaceAndRegisterCallback ;
+    PIInitProcType                        initCallback ;
+    PIUnloadProcType                      unloadCallback ;
+  } ;
+
+// --------------------------
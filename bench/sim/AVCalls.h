@@ -0,0 +1,215 @@
+/*
+  File:   AVCalls.h
+
+  Contains: The simulated host's viewer calls: the application, menus,
+            documents, page views, toolbar and notifications.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+#include "PDCalls.h"
+
+// --------------------------
+
+typedef struct _t_AVMenubar *     AVMenubar ;
+typedef struct _t_AVMenu *        AVMenu ;
+typedef struct _t_AVMenuItem *    AVMenuItem ;
+typedef struct _t_AVDoc *         AVDoc ;
+typedef struct _t_AVPageView *    AVPageView ;
+typedef struct _t_AVWindow *      AVWindow ;
+typedef struct _t_AVToolBar *     AVToolBar ;
+typedef struct _t_AVToolButton *  AVToolButton ;
+typedef struct _t_AVCursor *      AVCursor ;
+typedef void *                    AVIcon ;
+typedef ASUns16                   AVFlagBits16 ;
+typedef ASInt32                   AVPageIndex ;
+
+struct AVRect
+  {
+    ASInt32   left ;
+    ASInt32   top ;
+    ASInt32   right ;
+    ASInt32   bottom ;
+  } ;
+
+typedef AVRect  AVDevRect ;
+
+enum AVZoomType
+  {
+    AVZoomNoVary,
+    AVZoomFitPage,
+    AVZoomFitWidth,
+    AVZoomFitHeight,
+    AVZoomFitVisibleWidth,
+    AVZoomPreferred
+  } ;
+
+// --------------------------
+
+#define NO_SHORTCUT             0
+#define AV_SHIFT                0x0001
+#define AV_OPTION               0x0002
+#define AV_COMMAND              0x0004
+#define AV_CONTROL              0x0008
+
+#define APPEND_MENUITEM         10000
+#define PREPEND_MENUITEM        -1
+
+#define ALERT_STOP              0
+#define ALERT_CAUTION           1
+#define ALERT_NOTE              2
+#define ALERT_QUESTION          3
+
+#define WAIT_CURSOR             1
+
+#define PAGEVIEW_UPDATE_SCROLL      0x0001
+#define PAGEVIEW_UPDATE_PAGENUM     0x0002
+#define PAGEVIEW_UPDATE_PAGESIZE    0x0004
+#define PAGEVIEW_UPDATE_ZOOM        0x0008
+
+// --------------------------
+// Callback types
+
+typedef ACCBPROTO1 void   ( ACCBPROTO2 * AVExecuteProc )( void * inData ) ;
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * AVComputeEnabledProc )( void * inData ) ;
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * AVComputeMarkedProc )( void * inData ) ;
+typedef ACCBPROTO1 void   ( ACCBPROTO2 * AVIdleProc )( void * inData ) ;
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * AVDocEnumProc )( AVDoc inAVDoc, void * inData ) ;
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * AVPageViewClickProc )( AVPageView inAVPageView, ASInt16 inX, ASInt16 inY,
+                                                                ASInt16 inFlags, ASInt16 inClickNumber, void * inData ) ;
+typedef ACCBPROTO1 void   ( ACCBPROTO2 * AVPageViewDrawProc )( AVPageView inAVPageView, AVDevRect * inUpdateRect, void * inData ) ;
+
+// --------------------------
+// Notifications; the callback of each is given to AVAppRegisterNotification
+// as a void *, and must take the arguments shown.
+
+enum NSelector
+  {
+    AVAppDidInitializeNSEL,               // ( void * inData )
+    AVAppFrontDocDidChangeNSEL,           // ( AVDoc, void * )
+    AVDocDidOpenNSEL,                     // ( AVDoc, ASInt32 inError, void * )
+    AVDocWillCloseNSEL,                   // ( AVDoc, void * )
+    AVPageViewDidChangeNSEL,              // ( AVPageView, ASInt16 inHowChanged, void * )
+    AVMenuItemWasAddedToMenuNSEL,         // ( AVMenuItem, AVMenu, void * )
+    AVMenuItemWasRemovedNSEL,             // ( AVMenuItem, void * )
+    AVMenuWasAddedToMenubarNSEL,          // ( AVMenu, void * )
+    AVMenuWasRemovedNSEL,                 // ( AVMenu, void * )
+    PDDocDidInsertPagesNSEL,              // ( PDDoc, ASInt32, ASInt32, PDDoc, ASInt32, ASInt32, ASInt32 inError, void * )
+    PDDocDidDeletePagesNSEL,              // ( PDDoc, ASInt32 inFromPage, ASInt32 inToPage, ASInt32 inError, void * )
+    kSimNumNotifications
+  } ;
+
+void          AVAppRegisterNotification( NSelector inSelector, ASExtension inOwner, void * inProc, void * inData ) ;
+void          AVAppUnregisterNotification( NSelector inSelector, ASExtension inOwner, void * inProc, void * inData ) ;
+
+// --------------------------
+// Application
+
+AVMenubar     AVAppGetMenubar( void ) ;
+AVToolBar     AVAppGetToolBar( void ) ;
+AVDoc         AVAppGetActiveDoc( void ) ;
+void          AVAppEnumDocs( AVDocEnumProc inProc, void * inData ) ;
+ASBool        AVAppIsModal( void ) ;
+ASBool        AVAppDoingFullScreen( void ) ;
+ASBool        AVAppBeginFullScreen( void * inColors ) ;
+void          AVAppRegisterIdleProc( AVIdleProc inProc, void * inData, ASUns32 inPeriod ) ;
+void          AVAppUnregisterIdleProc( AVIdleProc inProc, void * inData ) ;
+void          AVAppRegisterForPageViewClicks( AVPageViewClickProc inProc, void * inData ) ;
+void          AVAppRegisterForPageViewDrawing( AVPageViewDrawProc inProc, void * inData ) ;
+
+ASInt32       AVAlert( ASInt32 inIconType, const char * inMessage, const char * inButton1,
+                       const char * inButton2, const char * inButton3, ASBool inBeep ) ;
+char *        AVAlertGetString( const char * inPrompt, const char * inDefault, ASBool inPassword ) ;    // free with ASfree
+
+void          AVSysBeep( ASInt32 inDuration ) ;
+AVCursor      AVSysGetCursor( void ) ;
+AVCursor      AVSysGetStandardCursor( ASInt32 inCursorID ) ;
+void          AVSysSetCursor( AVCursor inCursor ) ;
+
+// --------------------------
+// Menus
+
+ASInt32       AVMenubarGetNumMenus( AVMenubar inMenubar ) ;
+AVMenu        AVMenubarAcquireMenuByIndex( AVMenubar inMenubar, ASInt32 inIndex ) ;
+AVMenu        AVMenubarAcquireMenuByName( AVMenubar inMenubar, const char * inName ) ;
+AVMenuItem    AVMenubarAcquireMenuItemByName( AVMenubar inMenubar, const char * inName ) ;
+
+AVMenu        AVMenuNew( const char * inTitle, const char * inName, ASExtension inOwner ) ;
+AVMenu        AVMenuAcquire( AVMenu inMenu ) ;
+void          AVMenuRelease( AVMenu inMenu ) ;
+ASAtom        AVMenuGetName( AVMenu inMenu ) ;
+ASInt32       AVMenuGetNumMenuItems( AVMenu inMenu ) ;
+AVMenuItem    AVMenuAcquireMenuItemByIndex( AVMenu inMenu, ASInt32 inIndex ) ;
+ASInt32       AVMenuGetMenuItemIndex( AVMenu inMenu, AVMenuItem inMenuItem ) ;
+void          AVMenuAddMenuItem( AVMenu inMenu, AVMenuItem inMenuItem, ASInt32 inBeforeIndex ) ;
+ASInt32       AVMenuDoPopUp( AVMenu inMenu, ASInt16 inX, ASInt16 inY, ASBool inRightButton, ASInt32 inChoice ) ;
+
+AVMenuItem    AVMenuItemNew( const char * inTitle, const char * inName, AVMenu inSubmenu, ASBool inLongMenusOnly,
+                             char inShortcut, AVFlagBits16 inFlags, AVIcon inIcon, ASExtension inOwner ) ;
+AVMenuItem    AVMenuItemAcquire( AVMenuItem inMenuItem ) ;
+void          AVMenuItemRelease( AVMenuItem inMenuItem ) ;
+void          AVMenuItemRemove( AVMenuItem inMenuItem ) ;
+ASAtom        AVMenuItemGetName( AVMenuItem inMenuItem ) ;
+ASInt32       AVMenuItemGetTitle( AVMenuItem inMenuItem, char * outBuffer, ASInt32 inBufferSize ) ;
+AVMenu        AVMenuItemGetParentMenu( AVMenuItem inMenuItem ) ;
+AVMenu        AVMenuItemAcquireSubmenu( AVMenuItem inMenuItem ) ;
+ASBool        AVMenuItemIsEnabled( AVMenuItem inMenuItem ) ;
+void          AVMenuItemExecute( AVMenuItem inMenuItem ) ;
+void          AVMenuItemSetExecuteProc( AVMenuItem inMenuItem, AVExecuteProc inProc, void * inData ) ;
+void          AVMenuItemSetComputeEnabledProc( AVMenuItem inMenuItem, AVComputeEnabledProc inProc, void * inData ) ;
+void          AVMenuItemSetComputeMarkedProc( AVMenuItem inMenuItem, AVComputeMarkedProc inProc, void * inData ) ;
+
+// --------------------------
+// Documents, windows and page views
+
+PDDoc         AVDocGetPDDoc( AVDoc inAVDoc ) ;
+AVPageView    AVDocGetPageView( AVDoc inAVDoc ) ;
+AVWindow      AVDocGetAVWindow( AVDoc inAVDoc ) ;
+PDPageMode    AVDocGetViewMode( AVDoc inAVDoc ) ;
+ASInt16       AVDocGetSplitterPosition( AVDoc inAVDoc ) ;
+AVDoc         AVDocOpenFromFile( ASPathName inPathName, ASFileSys inFileSys, const char * inTempTitle ) ;
+AVDoc         AVDocOpenFromPDDoc( PDDoc inPDDoc, const char * inTempTitle ) ;
+ASBool        AVDocClose( AVDoc inAVDoc, ASBool inNoSave ) ;
+
+void          AVWindowGetTitle( AVWindow inWindow, ASText outTitle ) ;
+void          AVWindowBringToFront( AVWindow inWindow ) ;
+
+AVDoc         AVPageViewGetAVDoc( AVPageView inAVPageView ) ;
+PDPageNumber  AVPageViewGetPageNum( AVPageView inAVPageView ) ;
+void          AVPageViewGoTo( AVPageView inAVPageView, PDPageNumber inPageNum ) ;
+AVZoomType    AVPageViewGetZoomType( AVPageView inAVPageView ) ;
+void          AVPageViewGetAperture( AVPageView inAVPageView, AVDevRect * outRect ) ;
+void          AVPageViewInvalidateRect( AVPageView inAVPageView, AVDevRect * inRect ) ;
+void          AVPageViewDrawNow( AVPageView inAVPageView ) ;
+
+// --------------------------
+// Toolbar
+
+AVToolButton  AVToolBarGetButtonByName( AVToolBar inToolBar, ASAtom inName ) ;
+void          AVToolBarAddButton( AVToolBar inToolBar, AVToolButton inButton, ASBool inBefore, AVToolButton inOtherButton ) ;
+void          AVToolBarUpdateButtonStates( AVToolBar inToolBar ) ;
+
+AVToolButton  AVToolButtonNew( ASAtom inName, AVIcon inIcon, ASBool inPullDown, ASBool inIsLabel ) ;
+void          AVToolButtonDestroy( AVToolButton inButton ) ;
+void          AVToolButtonRemove( AVToolButton inButton ) ;
+void          AVToolButtonExecute( AVToolButton inButton ) ;
+void          AVToolButtonSetIcon( AVToolButton inButton, AVIcon inIcon ) ;
+void          AVToolButtonSetHelpText( AVToolButton inButton, const char * inText ) ;
+void          AVToolButtonSetExecuteProc( AVToolButton inButton, AVExecuteProc inProc, void * inData ) ;
+void          AVToolButtonSetComputeEnabledProc( AVToolButton inButton, AVComputeEnabledProc inProc, void * inData ) ;
+
+// --------------------------
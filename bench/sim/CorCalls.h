@@ -0,0 +1,105 @@
+/*
+  File:   CorCalls.h
+
+  Contains: The simulated host's core types and its DURING/HANDLER
+            exception frames, for building the plug-ins outside Acrobat.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    The headers in bench/sim stand in for the Acrobat SDK headers of the same
+    names.  They declare only what the plug-ins in this collection call, with
+    the SDK's names and argument order, so the plug-in sources build against
+    them unchanged.  The calls are implemented by the simulated host in
+    SimHost.cpp; see SimHost.h.
+
+    DURING/HANDLER work as in Acrobat: a raise longjmps to the innermost
+    frame, skipping destructors, and E_RETURN must be used to return from
+    inside DURING.
+
+*/
+
+#pragma once
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// --------------------------
+
+#define ACCB1
+#define ACCB2
+#define ACCBPROTO1
+#define ACCBPROTO2
+#define ACEX1
+#define ACEX2
+
+typedef int8_t      ASInt8 ;
+typedef uint8_t     ASUns8 ;
+typedef int16_t     ASInt16 ;
+typedef uint16_t    ASUns16 ;
+typedef int32_t     ASInt32 ;
+typedef uint32_t    ASUns32 ;
+typedef int64_t     ASInt64 ;
+typedef uint64_t    ASUns64 ;
+
+typedef ASUns16     ASBool ;
+typedef ASBool      boolean ;
+
+typedef ASInt8      Int8 ;
+typedef ASUns8      Uns8 ;
+typedef ASInt16     Int16 ;
+typedef ASUns16     Uns16 ;
+typedef ASInt32     Int32 ;
+typedef ASUns32     Uns32 ;
+
+typedef ASInt32     ASErrorCode ;
+
+// --------------------------
+// Error codes; the severity and system bits of the SDK's codes are left out.
+
+#define genErrNoMemory          1
+#define genErrBadParm           2
+#define genErrGeneral           3
+#define fileErrIO               4
+#define fileErrFNF              5
+#define pdErrBadPageNum         6
+
+// --------------------------
+
+struct SimExceptionFrame
+  {
+    SimExceptionFrame *   fPrev ;
+    jmp_buf               fJmpBuf ;
+    ASInt32               fError ;
+  } ;
+
+extern thread_local SimExceptionFrame *   gSimExceptionFrame ;
+
+// Raise to the innermost DURING; with none, the simulated host aborts.
+void ASRaise( ASErrorCode inError ) ;
+
+#define DURING        { SimExceptionFrame _simFrame ; \
+                        _simFrame.fPrev = gSimExceptionFrame ; \
+                        _simFrame.fError = 0 ; \
+                        gSimExceptionFrame = &_simFrame ; \
+                        if ( setjmp( _simFrame.fJmpBuf ) == 0 ) {
+#define HANDLER           gSimExceptionFrame = _simFrame.fPrev ; } else {
+#define END_HANDLER   } }
+
+#define ERRORCODE     ( _simFrame.fError )
+#define RERAISE()     ASRaise( ERRORCODE )
+#define E_RETURN( x ) { gSimExceptionFrame = _simFrame.fPrev ; return ( x ) ; }
+#define E_RTRN_VOID   { gSimExceptionFrame = _simFrame.fPrev ; return ; }
+
+// --------------------------
@@ -0,0 +1,54 @@
+/*
+  File:   CosCalls.h
+
+  Contains: The simulated host's few Cos object calls.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+
+// --------------------------
+// A simulated document keeps no object graph; the only objects handed out
+// are a page's dictionary and its content stream, so a page's /Contents can
+// be measured.
+
+enum CosType
+  {
+    CosNull,
+    CosInteger,
+    CosFixed,
+    CosBoolean,
+    CosName,
+    CosString,
+    CosDict,
+    CosArray,
+    CosStream
+  } ;
+
+struct CosObj
+  {
+    ASInt32   fType ;
+    void *    fData ;
+  } ;
+
+CosType   CosObjGetType( CosObj inObj ) ;
+CosObj    CosDictGet( CosObj inDict, ASAtom inKey ) ;
+ASInt32   CosArrayLength( CosObj inArray ) ;
+CosObj    CosArrayGet( CosObj inArray, ASInt32 inIndex ) ;
+ASInt32   CosStreamLength( CosObj inStream ) ;
+
+// --------------------------
@@ -0,0 +1,142 @@
+/*
+  File:   PDCalls.h
+
+  Contains: The simulated host's document calls: pages, page labels,
+            bookmarks, the word finder and page drawing.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+#include "CosCalls.h"
+
+// --------------------------
+
+typedef struct _t_PDDoc *             PDDoc ;
+typedef struct _t_PDPage *            PDPage ;
+typedef struct _t_PDWordFinder *      PDWordFinder ;
+typedef struct _t_PDWord *            PDWord ;
+typedef struct _t_PDBookmark *        PDBookmark ;
+typedef struct _t_PDAction *          PDAction ;
+typedef struct _t_PDViewDestination * PDViewDestination ;
+typedef struct _t_PDPageLabel *       PDPageLabel ;
+
+typedef ASInt32     PDPageNumber ;
+typedef ASUns32     PDPerms ;
+typedef ASInt16     PDRotate ;
+
+enum PDPageMode
+  {
+    PDDontCare,
+    PDUseNone,
+    PDUseThumbs,
+    PDUseBookmarks,
+    PDFullScreen
+  } ;
+
+#define PDBeforeFirstPage     -1
+#define PDLastPage            -2
+#define PDAllPages            -3
+
+#define PDInsertAll           0x0FFF
+
+#define PDDocNeedsSave        0x0001
+
+#define pdPermOpen            0x0001
+#define pdPermEdit            0x0008
+#define pdPermCopy            0x0010
+
+#define WF_LATEST_VERSION     2
+
+#define kPDPageDoLazyErase    0x0001
+#define kPDPageUseAnnotFaces  0x0002
+
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * CancelProc )( void * inData ) ;
+typedef void *  ProgressMonitor ;
+
+// --------------------------
+// Documents
+
+PDDoc         PDDocCreate( void ) ;
+PDDoc         PDDocOpen( ASPathName inPathName, ASFileSys inFileSys, void * inAuthProc, ASBool inDoRepair ) ;
+void          PDDocClose( PDDoc inPDDoc ) ;
+void          PDDocAcquire( PDDoc inPDDoc ) ;
+void          PDDocRelease( PDDoc inPDDoc ) ;
+ASInt32       PDDocGetNumPages( PDDoc inPDDoc ) ;
+ASInt32       PDDocGetFlags( PDDoc inPDDoc ) ;
+PDPerms       PDDocGetPermissions( PDDoc inPDDoc ) ;
+ASFile        PDDocGetFile( PDDoc inPDDoc ) ;
+PDPage        PDDocAcquirePage( PDDoc inPDDoc, PDPageNumber inPageNum ) ;
+void          PDDocMovePage( PDDoc inPDDoc, PDPageNumber inMoveToAfterThisPage, PDPageNumber inPageToMove ) ;
+void          PDDocInsertPages( PDDoc inPDDoc, PDPageNumber inInsertAfterThisPage, PDDoc inSourcePDDoc,
+                                PDPageNumber inStartPage, ASInt32 inNumPages, ASUns16 inInsertFlags,
+                                ProgressMonitor inProgressMonitor, void * inProgressMonitorData,
+                                CancelProc inCancelProc, void * inCancelProcData ) ;
+PDPageLabel   PDDocGetPageLabel( PDDoc inPDDoc, PDPageNumber inPageNum, PDPageNumber * outFirstPage, PDPageNumber * outLastPage ) ;
+PDBookmark    PDDocGetBookmarkRoot( PDDoc inPDDoc ) ;
+ASInt32       PDGetHostEncoding( void ) ;
+
+// --------------------------
+// Pages
+
+void          PDPageRelease( PDPage inPDPage ) ;
+PDRotate      PDPageGetRotate( PDPage inPDPage ) ;
+void          PDPageSetRotate( PDPage inPDPage, PDRotate inRotate ) ;
+void          PDPageGetCropBox( PDPage inPDPage, ASFixedRect * outCropBox ) ;
+CosObj        PDPageGetCosObj( PDPage inPDPage ) ;
+PDPageNumber  PDPageNumFromCosObj( CosObj inPageObj ) ;
+ASInt32       PDPageDrawContentsToMemory( PDPage inPDPage, ASUns32 inFlags, ASFixedMatrix * inMatrix, ASFixedRect * inUpdateRect,
+                                          ASUns32 inSmoothFlags, ASAtom inColorSpace, ASInt32 inBitsPerComponent,
+                                          char * outBuffer, ASInt32 inBufferSize, CancelProc inCancelProc, void * inCancelProcData ) ;
+
+ASBool        PDPageLabelIsValid( PDPageLabel inLabel ) ;
+ASInt32       PDPageLabelGetStart( PDPageLabel inLabel ) ;
+
+// --------------------------
+// Bookmarks and destinations
+
+ASBool              PDBookmarkIsValid( PDBookmark inBookmark ) ;
+ASBool              PDBookmarkEqual( PDBookmark inBookmark1, PDBookmark inBookmark2 ) ;
+ASBool              PDBookmarkHasChildren( PDBookmark inBookmark ) ;
+PDBookmark          PDBookmarkGetFirstChild( PDBookmark inBookmark ) ;
+PDBookmark          PDBookmarkGetLastChild( PDBookmark inBookmark ) ;
+PDBookmark          PDBookmarkGetNext( PDBookmark inBookmark ) ;
+PDBookmark          PDBookmarkGetPrev( PDBookmark inBookmark ) ;
+PDAction            PDBookmarkGetAction( PDBookmark inBookmark ) ;
+
+ASBool              PDActionIsValid( PDAction inAction ) ;
+ASAtom              PDActionGetSubtype( PDAction inAction ) ;
+PDViewDestination   PDActionGetDest( PDAction inAction ) ;
+PDViewDestination   PDViewDestResolve( PDViewDestination inDest, PDDoc inPDDoc ) ;
+ASBool              PDViewDestIsValid( PDViewDestination inDest ) ;
+CosObj              PDViewDestGetCosObj( PDViewDestination inDest ) ;
+
+// --------------------------
+// Word finder
+
+PDWordFinder  PDDocCreateWordFinder( PDDoc inPDDoc, void * outEncInfo, void * outEncVec, void * inLigatureTable,
+                                     ASInt16 inAlgVersion, ASUns16 inFlags, void * inClientData ) ;
+PDWordFinder  PDDocCreateWordFinderUCS( PDDoc inPDDoc, ASInt16 inAlgVersion, ASUns16 inFlags, void * inClientData ) ;
+void          PDWordFinderDestroy( PDWordFinder inWordFinder ) ;
+void          PDWordFinderAcquireWordList( PDWordFinder inWordFinder, PDPageNumber inPageNum, PDWord * outWordList,
+                                           PDWord * outSortTable, ASInt32 * outNumWords ) ;
+void          PDWordFinderReleaseWordList( PDWordFinder inWordFinder, PDPageNumber inPageNum ) ;
+PDWord        PDWordFinderGetNthWord( PDWordFinder inWordFinder, ASInt32 inIndex ) ;
+ASBool        PDWordGetNthQuad( PDWord inWord, ASInt32 inIndex, ASFixedQuad * outQuad ) ;
+ASBool        PDWordGetNthCharQuad( PDWord inWord, ASInt32 inIndex, ASFixedQuad * outQuad ) ;
+ASInt32       PDWordGetString( PDWord inWord, char * outBuffer, ASInt32 inBufferSize ) ;
+
+// --------------------------
@@ -0,0 +1,147 @@
+/*
+  File:   SimAllocations.cpp
+
+  Contains: The bench build's global operator new, which counts every
+            allocation the plug-in, the simulated host and the C++ library
+            make, for APBenchmark's allocations per call.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+    Compiled into each bench executable itself rather than a library, so
+    the linker always takes these in place of the C++ library's own.
+    ASmalloc and malloc are not counted; the plug-ins use them only for
+    text and path copies the SDK hands back.
+
+*/
+
+#include "SimHost.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <new>
+
+// --------------------------
+
+static std::atomic< ASUns64 >   sAllocations( 0 ) ;
+
+// --------------------------
+
+static void * Allocate( size_t inSize )
+  {
+    void *  thePointer ;
+
+    sAllocations.fetch_add( 1, std::memory_order_relaxed ) ;
+
+    thePointer = malloc( ( inSize > 0 ) ? inSize : 1 ) ;
+    if ( thePointer == NULL )
+      throw std::bad_alloc() ;
+
+    return thePointer ;
+
+  } // end Allocate
+
+// --------------------------
+
+void * operator new( size_t inSize )
+  {
+    return Allocate( inSize ) ;
+
+  } // end operator new
+
+// --------------------------
+
+void * operator new[]( size_t inSize )
+  {
+    return Allocate( inSize ) ;
+
+  } // end operator new[]
+
+// --------------------------
+
+void * operator new( size_t inSize, const std::nothrow_t & ) noexcept
+  {
+    sAllocations.fetch_add( 1, std::memory_order_relaxed ) ;
+
+    return malloc( ( inSize > 0 ) ? inSize : 1 ) ;
+
+  } // end operator new
+
+// --------------------------
+
+void * operator new[]( size_t inSize, const std::nothrow_t & ) noexcept
+  {
+    sAllocations.fetch_add( 1, std::memory_order_relaxed ) ;
+
+    return malloc( ( inSize > 0 ) ? inSize : 1 ) ;
+
+  } // end operator new[]
+
+// --------------------------
+
+void operator delete( void * inPointer ) noexcept
+  {
+    free( inPointer ) ;
+
+  } // end operator delete
+
+// --------------------------
+
+void operator delete[]( void * inPointer ) noexcept
+  {
+    free( inPointer ) ;
+
+  } // end operator delete[]
+
+// --------------------------
+
+void operator delete( void * inPointer, size_t ) noexcept
+  {
+    free( inPointer ) ;
+
+  } // end operator delete
+
+// --------------------------
+
+void operator delete[]( void * inPointer, size_t ) noexcept
+  {
+    free( inPointer ) ;
+
+  } // end operator delete[]
+
+// --------------------------
+
+void operator delete( void * inPointer, const std::nothrow_t & ) noexcept
+  {
+    free( inPointer ) ;
+
+  } // end operator delete
+
+// --------------------------
+
+void operator delete[]( void * inPointer, const std::nothrow_t & ) noexcept
+  {
+    free( inPointer ) ;
+
+  } // end operator delete[]
+
+// --------------------------
+
+ASUns64 SimGetAllocations( void )
+  {
+    return sAllocations.load( std::memory_order_relaxed ) ;
+
+  } // end SimGetAllocations
+
+// --------------------------
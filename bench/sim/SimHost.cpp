@@ -0,0 +1,2166 @@
+/*
+  File:   SimHost.cpp
+
+  Contains: The simulated Acrobat: application, menus, toolbar, documents,
+            page views and notifications.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "AVCalls.h"
+#include "PDCalls.h"
+#include "CosCalls.h"
+#include "ASCalls.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "SimHost.h"
+#include "SimPrivate.h"
+
+// --------------------------
+
+#define kSimPageWidth         612
+#define kSimPageHeight        792
+#define kSimContentLength     4096
+#define kSimApertureWidth     1024
+#define kSimApertureHeight    768
+
+struct SimCallback
+  {
+    void *    fProc ;       // NULL once unregistered
+    void *    fData ;
+  } ;
+
+struct _t_ASExtension
+  {
+    ASAtom    fName ;
+  } ;
+
+struct _t_HFTServer
+  {
+    ASAtom                    fName ;
+    HFTServerProvideHFTProc   fProvideProc ;
+    void *                    fRock ;
+  } ;
+
+struct _t_AVMenu
+  {
+    ASAtom                      fName ;
+    std::string                 fTitle ;
+    std::vector< AVMenuItem >   fItems ;
+    AVMenuItem                  fParentItem ;       // the item it is the submenu of
+    ASInt32                     fRefCount ;
+  } ;
+
+struct _t_AVMenuItem
+  {
+    ASAtom                  fName ;
+    std::string             fTitle ;
+    AVMenu                  fSubmenu ;
+    AVMenu                  fParent ;
+    AVExecuteProc           fExecute ;
+    void *                  fExecuteData ;
+    AVComputeEnabledProc    fComputeEnabled ;
+    void *                  fComputeEnabledData ;
+    AVComputeMarkedProc     fComputeMarked ;
+    void *                  fComputeMarkedData ;
+    ASInt32                 fRefCount ;
+  } ;
+
+struct _t_AVMenubar
+  {
+    std::vector< AVMenu >   fMenus ;
+  } ;
+
+struct _t_AVToolButton
+  {
+    ASAtom                  fName ;
+    AVIcon                  fIcon ;
+    std::string             fHelpText ;
+    AVExecuteProc           fExecute ;
+    void *                  fExecuteData ;
+    AVComputeEnabledProc    fComputeEnabled ;
+    void *                  fComputeEnabledData ;
+    AVToolBar               fToolBar ;
+  } ;
+
+struct _t_AVToolBar
+  {
+    std::vector< AVToolButton >   fButtons ;
+  } ;
+
+struct _t_PDPage
+  {
+    PDDoc       fPDDoc ;
+    ASInt32     fOriginalNum ;
+    PDRotate    fRotate ;
+    ASInt32     fRefCount ;
+  } ;
+
+struct _t_PDDoc
+  {
+    std::vector< PDPage >   fPages ;
+    ASInt32                 fFlags ;
+    ASInt32                 fRefCount ;
+    _t_ASFile               fFile ;             // fPathName NULL when the document was made in memory
+  } ;
+
+struct _t_AVPageView
+  {
+    AVDoc           fAVDoc ;
+    PDPageNumber    fPageNum ;
+    AVZoomType      fZoomType ;
+  } ;
+
+struct _t_AVWindow
+  {
+    AVDoc           fAVDoc ;
+  } ;
+
+struct _t_AVDoc
+  {
+    PDDoc           fPDDoc ;
+    std::string     fTitle ;
+    PDPageMode      fViewMode ;
+    _t_AVPageView   fPageView ;
+    _t_AVWindow     fWindow ;
+  } ;
+
+struct _t_AVCursor
+  {
+    ASInt32         fID ;
+  } ;
+
+struct _t_PDWordFinder
+  {
+    PDDoc           fPDDoc ;
+  } ;
+
+// --------------------------
+
+ASExtension   gExtensionID    = NULL ;
+
+static _t_AVMenubar                 sMenubar ;
+static _t_AVToolBar                 sToolBar ;
+static std::vector< AVDoc >         sDocs ;
+static AVDoc                        sActiveDoc        = NULL ;
+static ASBool                       sFullScreen       = false ;
+static ASInt32                      sNumAlerts        = 0 ;
+static ASInt32                      sNumAcquired      = 0 ;
+static _t_AVCursor                  sCursors[ 2 ]     = { { 0 }, { WAIT_CURSOR } } ;
+static AVCursor                     sCursor           = &sCursors[ 0 ] ;
+
+static std::vector< SimCallback >   sNotifications[ kSimNumNotifications ] ;
+static std::vector< SimCallback >   sIdleProcs ;
+static std::vector< SimCallback >   sClickProcs ;
+static std::vector< SimCallback >   sDrawProcs ;
+static ASInt32                      sCallingOut       = 0 ;
+
+static std::vector< HFTServer >     sHFTServers ;
+static PIHandshakeData_V0200        sHandshakeData ;
+
+// --------------------------
+#pragma mark -- callbacks
+// --------------------------
+// A callback unregistered while the host is calling out is only cleared, so
+// the lists are never shortened under a loop walking them; the cleared
+// entries are dropped once the host is back from the outermost call.
+
+static void Register( std::vector< SimCallback > & ioList, void * inProc, void * inData )
+  {
+    SimCallback   theCallback ;
+
+    theCallback.fProc = inProc ;
+    theCallback.fData = inData ;
+
+    ioList.push_back( theCallback ) ;
+
+  } // end Register
+
+// --------------------------
+
+static void Unregister( std::vector< SimCallback > & ioList, void * inProc, void * inData )
+  {
+    for ( size_t index = 0 ; index < ioList.size() ; index++ )
+      if ( ( ioList[ index ].fProc == inProc ) && ( ioList[ index ].fData == inData ) )
+        {
+          ioList[ index ].fProc = NULL ;
+          break ;
+        }
+
+  } // end Unregister
+
+// --------------------------
+
+static bool IsCleared( const SimCallback & inCallback )
+  {
+    return ( inCallback.fProc == NULL ) ;
+
+  } // end IsCleared
+
+// --------------------------
+
+static void EndCallOut( void )
+  {
+    sCallingOut -= 1 ;
+    if ( sCallingOut > 0 )
+      return ;
+
+    for ( ASInt32 index = 0 ; index < kSimNumNotifications ; index++ )
+      sNotifications[ index ].erase( std::remove_if( sNotifications[ index ].begin(), sNotifications[ index ].end(), &IsCleared ),
+                                     sNotifications[ index ].end() ) ;
+
+    sIdleProcs.erase( std::remove_if( sIdleProcs.begin(), sIdleProcs.end(), &IsCleared ), sIdleProcs.end() ) ;
+
+  } // end EndCallOut
+
+// Call every proc registered for inSelector, as inProcType, with the given
+// arguments followed by its client data.
+#define SIM_NOTIFY( inSelector, inProcType, ... )                                         \
+  {                                                                                       \
+    sCallingOut += 1 ;                                                                    \
+    for ( size_t theIndex = 0 ; theIndex < sNotifications[ inSelector ].size() ; theIndex++ ) \
+      {                                                                                   \
+        SimCallback theCallback = sNotifications[ inSelector ][ theIndex ] ;              \
+        if ( theCallback.fProc != NULL )                                                  \
+          ( ( inProcType )theCallback.fProc )( __VA_ARGS__, theCallback.fData ) ;         \
+      }                                                                                   \
+    EndCallOut() ;                                                                        \
+  }
+
+typedef ACCBPROTO1 void ( ACCBPROTO2 * SimAppProc )( void * ) ;
+typedef ACCBPROTO1 void ( ACCBPROTO2 * SimDocProc )( AVDoc, void * ) ;
+typedef ACCBPROTO1 void ( ACCBPROTO2 * SimDocErrorProc )( AVDoc, ASInt32, void * ) ;
+typedef ACCBPROTO1 void ( ACCBPROTO2 * SimPageViewProc )( AVPageView, ASInt16, void * ) ;
+typedef ACCBPROTO1 void ( ACCBPROTO2 * SimMenuItemMenuProc )( AVMenuItem, AVMenu, void * ) ;
+typedef ACCBPROTO1 void ( ACCBPROTO2 * SimMenuItemProc )( AVMenuItem, void * ) ;
+typedef ACCBPROTO1 void ( ACCBPROTO2 * SimMenuProc )( AVMenu, void * ) ;
+typedef ACCBPROTO1 void ( ACCBPROTO2 * SimInsertPagesProc )( PDDoc, ASInt32, ASInt32, PDDoc, ASInt32, ASInt32, ASInt32, void * ) ;
+
+// --------------------------
+
+void AVAppRegisterNotification( NSelector inSelector, ASExtension inOwner, void * inProc, void * inData )
+  {
+    if ( ( inSelector >= 0 ) && ( inSelector < kSimNumNotifications ) && ( inProc != NULL ) )
+      Register( sNotifications[ inSelector ], inProc, inData ) ;
+
+  } // end AVAppRegisterNotification
+
+// --------------------------
+
+void AVAppUnregisterNotification( NSelector inSelector, ASExtension inOwner, void * inProc, void * inData )
+  {
+    if ( ( inSelector >= 0 ) && ( inSelector < kSimNumNotifications ) )
+      Unregister( sNotifications[ inSelector ], inProc, inData ) ;
+
+    sCallingOut += 1 ;
+    EndCallOut() ;
+
+  } // end AVAppUnregisterNotification
+
+// --------------------------
+
+void AVAppRegisterIdleProc( AVIdleProc inProc, void * inData, ASUns32 inPeriod )
+  {
+    Register( sIdleProcs, ( void * )inProc, inData ) ;
+
+  } // end AVAppRegisterIdleProc
+
+// --------------------------
+
+void AVAppUnregisterIdleProc( AVIdleProc inProc, void * inData )
+  {
+    Unregister( sIdleProcs, ( void * )inProc, inData ) ;
+
+    sCallingOut += 1 ;
+    EndCallOut() ;
+
+  } // end AVAppUnregisterIdleProc
+
+// --------------------------
+
+void AVAppRegisterForPageViewClicks( AVPageViewClickProc inProc, void * inData )
+  {
+    Register( sClickProcs, ( void * )inProc, inData ) ;
+
+  } // end AVAppRegisterForPageViewClicks
+
+// --------------------------
+
+void AVAppRegisterForPageViewDrawing( AVPageViewDrawProc inProc, void * inData )
+  {
+    Register( sDrawProcs, ( void * )inProc, inData ) ;
+
+  } // end AVAppRegisterForPageViewDrawing
+
+// --------------------------
+#pragma mark -- extensions and host function tables
+// --------------------------
+
+ASAtom ASExtensionGetRegisteredName( ASExtension inExtension )
+  {
+    return ( inExtension != NULL ) ? inExtension->fName : ASAtomNull ;
+
+  } // end ASExtensionGetRegisteredName
+
+// --------------------------
+
+HFTServer HFTServerNew( const char * inName, HFTServerProvideHFTProc inProvideProc, HFTServerDestroyProc inDestroyProc, void * inRock )
+  {
+    HFTServer   theServer = new _t_HFTServer ;
+
+    theServer->fName        = ASAtomFromString( inName ) ;
+    theServer->fProvideProc = inProvideProc ;
+    theServer->fRock        = inRock ;
+
+    sHFTServers.push_back( theServer ) ;
+
+    return theServer ;
+
+  } // end HFTServerNew
+
+// --------------------------
+// Entries are numbered from 1, as the selectors are.
+
+HFT HFTNew( HFTServer inServer, ASUns32 inNumSelectors )
+  {
+    HFT   theHFT = new HFTEntry[ inNumSelectors + 1 ] ;
+
+    memset( theHFT, 0, sizeof( HFTEntry ) * ( inNumSelectors + 1 ) ) ;
+
+    return theHFT ;
+
+  } // end HFTNew
+
+// --------------------------
+
+void HFTReplaceEntry( HFT inHFT, ASUns32 inSelector, HFTEntry inEntry, ASUns32 inFlags )
+  {
+    if ( inHFT != NULL )
+      inHFT[ inSelector ] = inEntry ;
+
+  } // end HFTReplaceEntry
+
+// --------------------------
+// Only the tables of the plug-ins loaded into this host are found, so a
+// plug-in sees the others as not installed and takes its fallback path.
+
+HFT ASExtensionMgrGetHFT( ASAtom inName, ASUns32 inVersion )
+  {
+    for ( size_t index = 0 ; index < sHFTServers.size() ; index++ )
+      if ( sHFTServers[ index ]->fName == inName )
+        return sHFTServers[ index ]->fProvideProc( sHFTServers[ index ], inVersion, sHFTServers[ index ]->fRock ) ;
+
+    return NULL ;
+
+  } // end ASExtensionMgrGetHFT
+
+// --------------------------
+#pragma mark -- application
+// --------------------------
+
+AVMenubar AVAppGetMenubar( void )
+  {
+    return &sMenubar ;
+
+  } // end AVAppGetMenubar
+
+// --------------------------
+
+AVToolBar AVAppGetToolBar( void )
+  {
+    return &sToolBar ;
+
+  } // end AVAppGetToolBar
+
+// --------------------------
+
+AVDoc AVAppGetActiveDoc( void )
+  {
+    return sActiveDoc ;
+
+  } // end AVAppGetActiveDoc
+
+// --------------------------
+
+void AVAppEnumDocs( AVDocEnumProc inProc, void * inData )
+  {
+    for ( size_t index = 0 ; index < sDocs.size() ; index++ )
+      if ( inProc( sDocs[ index ], inData ) == false )
+        break ;
+
+  } // end AVAppEnumDocs
+
+// --------------------------
+
+ASBool AVAppIsModal( void )
+  {
+    return false ;
+
+  } // end AVAppIsModal
+
+// --------------------------
+
+ASBool AVAppDoingFullScreen( void )
+  {
+    return sFullScreen ;
+
+  } // end AVAppDoingFullScreen
+
+// --------------------------
+
+ASBool AVAppBeginFullScreen( void * inColors )
+  {
+    sFullScreen = true ;
+
+    return true ;
+
+  } // end AVAppBeginFullScreen
+
+// --------------------------
+
+ASInt32 AVAlert( ASInt32 inIconType, const char * inMessage, const char * inButton1,
+                 const char * inButton2, const char * inButton3, ASBool inBeep )
+  {
+    sNumAlerts += 1 ;
+
+    return 1 ;
+
+  } // end AVAlert
+
+// --------------------------
+
+char * AVAlertGetString( const char * inPrompt, const char * inDefault, ASBool inPassword )
+  {
+    sNumAlerts += 1 ;
+
+    return NULL ;
+
+  } // end AVAlertGetString
+
+// --------------------------
+
+void AVSysBeep( ASInt32 inDuration )
+  {
+  } // end AVSysBeep
+
+// --------------------------
+
+AVCursor AVSysGetCursor( void )
+  {
+    return sCursor ;
+
+  } // end AVSysGetCursor
+
+// --------------------------
+
+AVCursor AVSysGetStandardCursor( ASInt32 inCursorID )
+  {
+    return ( inCursorID == WAIT_CURSOR ) ? &sCursors[ 1 ] : &sCursors[ 0 ] ;
+
+  } // end AVSysGetStandardCursor
+
+// --------------------------
+
+void AVSysSetCursor( AVCursor inCursor )
+  {
+    sCursor = ( inCursor != NULL ) ? inCursor : &sCursors[ 0 ] ;
+
+  } // end AVSysSetCursor
+
+// --------------------------
+#pragma mark -- menus
+// --------------------------
+// A menu or menu item is deleted when the last reference to it goes; the
+// menubar holds one on each of its menus, a menu on each of its items and
+// an item on its submenu.  Only the references handed out to the plug-in
+// are counted in sNumAcquired.
+
+static void ReleaseMenu( AVMenu inMenu ) ;
+
+static void ReleaseMenuItem( AVMenuItem inMenuItem )
+  {
+    if ( ( inMenuItem == NULL ) || ( --inMenuItem->fRefCount > 0 ) )
+      return ;
+
+    if ( inMenuItem->fSubmenu != NULL )
+      {
+        inMenuItem->fSubmenu->fParentItem = NULL ;
+        ReleaseMenu( inMenuItem->fSubmenu ) ;
+      }
+
+    delete inMenuItem ;
+
+  } // end ReleaseMenuItem
+
+// --------------------------
+
+static void ReleaseMenu( AVMenu inMenu )
+  {
+    if ( ( inMenu == NULL ) || ( --inMenu->fRefCount > 0 ) )
+      return ;
+
+    for ( size_t index = 0 ; index < inMenu->fItems.size() ; index++ )
+      {
+        inMenu->fItems[ index ]->fParent = NULL ;
+        ReleaseMenuItem( inMenu->fItems[ index ] ) ;
+      }
+
+    delete inMenu ;
+
+  } // end ReleaseMenu
+
+// --------------------------
+
+static AVMenu FindMenu( AVMenu inMenu, ASAtom inName )
+  {
+    if ( inMenu->fName == inName )
+      return inMenu ;
+
+    for ( size_t index = 0 ; index < inMenu->fItems.size() ; index++ )
+      if ( inMenu->fItems[ index ]->fSubmenu != NULL )
+        {
+          AVMenu  theMenu = FindMenu( inMenu->fItems[ index ]->fSubmenu, inName ) ;
+          if ( theMenu != NULL )
+            return theMenu ;
+        }
+
+    return NULL ;
+
+  } // end FindMenu
+
+// --------------------------
+
+static AVMenuItem FindMenuItem( AVMenu inMenu, ASAtom inName )
+  {
+    for ( size_t index = 0 ; index < inMenu->fItems.size() ; index++ )
+      {
+        AVMenuItem  theMenuItem = inMenu->fItems[ index ] ;
+
+        if ( theMenuItem->fName == inName )
+          return theMenuItem ;
+
+        if ( theMenuItem->fSubmenu != NULL )
+          {
+            theMenuItem = FindMenuItem( theMenuItem->fSubmenu, inName ) ;
+            if ( theMenuItem != NULL )
+              return theMenuItem ;
+          }
+      }
+
+    return NULL ;
+
+  } // end FindMenuItem
+
+// --------------------------
+
+ASInt32 AVMenubarGetNumMenus( AVMenubar inMenubar )
+  {
+    return ( inMenubar != NULL ) ? ( ASInt32 )inMenubar->fMenus.size() : 0 ;
+
+  } // end AVMenubarGetNumMenus
+
+// --------------------------
+
+AVMenu AVMenubarAcquireMenuByIndex( AVMenubar inMenubar, ASInt32 inIndex )
+  {
+    if ( ( inMenubar == NULL ) || ( inIndex < 0 ) || ( inIndex >= ( ASInt32 )inMenubar->fMenus.size() ) )
+      return NULL ;
+
+    return AVMenuAcquire( inMenubar->fMenus[ inIndex ] ) ;
+
+  } // end AVMenubarAcquireMenuByIndex
+
+// --------------------------
+
+AVMenu AVMenubarAcquireMenuByName( AVMenubar inMenubar, const char * inName )
+  {
+    ASAtom  theName = ASAtomFromString( inName ) ;
+
+    if ( inMenubar == NULL )
+      return NULL ;
+
+    for ( size_t index = 0 ; index < inMenubar->fMenus.size() ; index++ )
+      {
+        AVMenu  theMenu = FindMenu( inMenubar->fMenus[ index ], theName ) ;
+        if ( theMenu != NULL )
+          return AVMenuAcquire( theMenu ) ;
+      }
+
+    return NULL ;
+
+  } // end AVMenubarAcquireMenuByName
+
+// --------------------------
+
+AVMenuItem AVMenubarAcquireMenuItemByName( AVMenubar inMenubar, const char * inName )
+  {
+    ASAtom  theName = ASAtomFromString( inName ) ;
+
+    if ( inMenubar == NULL )
+      return NULL ;
+
+    for ( size_t index = 0 ; index < inMenubar->fMenus.size() ; index++ )
+      {
+        AVMenuItem  theMenuItem = FindMenuItem( inMenubar->fMenus[ index ], theName ) ;
+        if ( theMenuItem != NULL )
+          return AVMenuItemAcquire( theMenuItem ) ;
+      }
+
+    return NULL ;
+
+  } // end AVMenubarAcquireMenuItemByName
+
+// --------------------------
+
+AVMenu AVMenuNew( const char * inTitle, const char * inName, ASExtension inOwner )
+  {
+    AVMenu  theMenu = new _t_AVMenu ;
+
+    theMenu->fName        = ASAtomFromString( inName ) ;
+    theMenu->fTitle       = ( inTitle != NULL ) ? inTitle : "" ;
+    theMenu->fParentItem  = NULL ;
+    theMenu->fRefCount    = 1 ;
+
+    sNumAcquired += 1 ;
+
+    return theMenu ;
+
+  } // end AVMenuNew
+
+// --------------------------
+
+AVMenu AVMenuAcquire( AVMenu inMenu )
+  {
+    if ( inMenu == NULL )
+      return NULL ;
+
+    inMenu->fRefCount += 1 ;
+    sNumAcquired += 1 ;
+
+    return inMenu ;
+
+  } // end AVMenuAcquire
+
+// --------------------------
+
+void AVMenuRelease( AVMenu inMenu )
+  {
+    if ( inMenu == NULL )
+      return ;
+
+    sNumAcquired -= 1 ;
+    ReleaseMenu( inMenu ) ;
+
+  } // end AVMenuRelease
+
+// --------------------------
+
+ASAtom AVMenuGetName( AVMenu inMenu )
+  {
+    return ( inMenu != NULL ) ? inMenu->fName : ASAtomNull ;
+
+  } // end AVMenuGetName
+
+// --------------------------
+
+ASInt32 AVMenuGetNumMenuItems( AVMenu inMenu )
+  {
+    return ( inMenu != NULL ) ? ( ASInt32 )inMenu->fItems.size() : 0 ;
+
+  } // end AVMenuGetNumMenuItems
+
+// --------------------------
+
+AVMenuItem AVMenuAcquireMenuItemByIndex( AVMenu inMenu, ASInt32 inIndex )
+  {
+    if ( ( inMenu == NULL ) || ( inIndex < 0 ) || ( inIndex >= ( ASInt32 )inMenu->fItems.size() ) )
+      return NULL ;
+
+    return AVMenuItemAcquire( inMenu->fItems[ inIndex ] ) ;
+
+  } // end AVMenuAcquireMenuItemByIndex
+
+// --------------------------
+
+ASInt32 AVMenuGetMenuItemIndex( AVMenu inMenu, AVMenuItem inMenuItem )
+  {
+    if ( inMenu == NULL )
+      return -1 ;
+
+    for ( size_t index = 0 ; index < inMenu->fItems.size() ; index++ )
+      if ( inMenu->fItems[ index ] == inMenuItem )
+        return ( ASInt32 )index ;
+
+    return -1 ;
+
+  } // end AVMenuGetMenuItemIndex
+
+// --------------------------
+
+void AVMenuAddMenuItem( AVMenu inMenu, AVMenuItem inMenuItem, ASInt32 inBeforeIndex )
+  {
+    if ( ( inMenu == NULL ) || ( inMenuItem == NULL ) || ( inMenuItem->fParent != NULL ) )
+      ASRaise( genErrBadParm ) ;
+
+    if ( ( inBeforeIndex < 0 ) || ( inBeforeIndex > ( ASInt32 )inMenu->fItems.size() ) )
+      inBeforeIndex = ( inBeforeIndex < 0 ) ? 0 : ( ASInt32 )inMenu->fItems.size() ;
+
+    inMenuItem->fRefCount += 1 ;
+    inMenuItem->fParent = inMenu ;
+    inMenu->fItems.insert( inMenu->fItems.begin() + inBeforeIndex, inMenuItem ) ;
+
+    SIM_NOTIFY( AVMenuItemWasAddedToMenuNSEL, SimMenuItemMenuProc, inMenuItem, inMenu ) ;
+
+  } // end AVMenuAddMenuItem
+
+// --------------------------
+// Nothing is chosen; the pop-up is dismissed.
+
+ASInt32 AVMenuDoPopUp( AVMenu inMenu, ASInt16 inX, ASInt16 inY, ASBool inRightButton, ASInt32 inChoice )
+  {
+    return -1 ;
+
+  } // end AVMenuDoPopUp
+
+// --------------------------
+
+AVMenuItem AVMenuItemNew( const char * inTitle, const char * inName, AVMenu inSubmenu, ASBool inLongMenusOnly,
+                          char inShortcut, AVFlagBits16 inFlags, AVIcon inIcon, ASExtension inOwner )
+  {
+    AVMenuItem  theMenuItem = new _t_AVMenuItem ;
+
+    memset( ( void * )&theMenuItem->fSubmenu, 0, ( char * )&theMenuItem->fRefCount - ( char * )&theMenuItem->fSubmenu ) ;
+    theMenuItem->fName      = ASAtomFromString( inName ) ;
+    theMenuItem->fTitle     = ( inTitle != NULL ) ? inTitle : "" ;
+    theMenuItem->fRefCount  = 1 ;
+
+    if ( inSubmenu != NULL )
+      {
+        inSubmenu->fRefCount += 1 ;
+        inSubmenu->fParentItem  = theMenuItem ;
+        theMenuItem->fSubmenu   = inSubmenu ;
+      }
+
+    sNumAcquired += 1 ;
+
+    return theMenuItem ;
+
+  } // end AVMenuItemNew
+
+// --------------------------
+
+AVMenuItem AVMenuItemAcquire( AVMenuItem inMenuItem )
+  {
+    if ( inMenuItem == NULL )
+      return NULL ;
+
+    inMenuItem->fRefCount += 1 ;
+    sNumAcquired += 1 ;
+
+    return inMenuItem ;
+
+  } // end AVMenuItemAcquire
+
+// --------------------------
+
+void AVMenuItemRelease( AVMenuItem inMenuItem )
+  {
+    if ( inMenuItem == NULL )
+      return ;
+
+    sNumAcquired -= 1 ;
+    ReleaseMenuItem( inMenuItem ) ;
+
+  } // end AVMenuItemRelease
+
+// --------------------------
+// The item is passed to AVMenuItemWasRemoved before the menu's reference to
+// it goes, so it is still valid there.
+
+void AVMenuItemRemove( AVMenuItem inMenuItem )
+  {
+    AVMenu  theMenu ;
+
+    if ( ( inMenuItem == NULL ) || ( inMenuItem->fParent == NULL ) )
+      return ;
+
+    theMenu = inMenuItem->fParent ;
+    theMenu->fItems.erase( std::find( theMenu->fItems.begin(), theMenu->fItems.end(), inMenuItem ) ) ;
+    inMenuItem->fParent = NULL ;
+
+    SIM_NOTIFY( AVMenuItemWasRemovedNSEL, SimMenuItemProc, inMenuItem ) ;
+
+    ReleaseMenuItem( inMenuItem ) ;
+
+  } // end AVMenuItemRemove
+
+// --------------------------
+
+ASAtom AVMenuItemGetName( AVMenuItem inMenuItem )
+  {
+    return ( inMenuItem != NULL ) ? inMenuItem->fName : ASAtomNull ;
+
+  } // end AVMenuItemGetName
+
+// --------------------------
+
+ASInt32 AVMenuItemGetTitle( AVMenuItem inMenuItem, char * outBuffer, ASInt32 inBufferSize )
+  {
+    if ( inMenuItem == NULL )
+      return 0 ;
+
+    if ( ( outBuffer != NULL ) && ( inBufferSize > 0 ) )
+      snprintf( outBuffer, inBufferSize + 1, "%s", inMenuItem->fTitle.c_str() ) ;
+
+    return ( ASInt32 )inMenuItem->fTitle.size() ;
+
+  } // end AVMenuItemGetTitle
+
+// --------------------------
+
+AVMenu AVMenuItemGetParentMenu( AVMenuItem inMenuItem )
+  {
+    return ( inMenuItem != NULL ) ? inMenuItem->fParent : NULL ;
+
+  } // end AVMenuItemGetParentMenu
+
+// --------------------------
+
+AVMenu AVMenuItemAcquireSubmenu( AVMenuItem inMenuItem )
+  {
+    if ( inMenuItem == NULL )
+      return NULL ;
+
+    return AVMenuAcquire( inMenuItem->fSubmenu ) ;
+
+  } // end AVMenuItemAcquireSubmenu
+
+// --------------------------
+
+ASBool AVMenuItemIsEnabled( AVMenuItem inMenuItem )
+  {
+    if ( inMenuItem == NULL )
+      return false ;
+
+    if ( inMenuItem->fComputeEnabled == NULL )
+      return true ;
+
+    return inMenuItem->fComputeEnabled( inMenuItem->fComputeEnabledData ) ;
+
+  } // end AVMenuItemIsEnabled
+
+// --------------------------
+
+void AVMenuItemExecute( AVMenuItem inMenuItem )
+  {
+    if ( ( inMenuItem == NULL ) || ( inMenuItem->fExecute == NULL ) || ( AVMenuItemIsEnabled( inMenuItem ) == false ) )
+      return ;
+
+    sCallingOut += 1 ;
+    inMenuItem->fExecute( inMenuItem->fExecuteData ) ;
+    EndCallOut() ;
+
+  } // end AVMenuItemExecute
+
+// --------------------------
+
+void AVMenuItemSetExecuteProc( AVMenuItem inMenuItem, AVExecuteProc inProc, void * inData )
+  {
+    if ( inMenuItem == NULL )
+      return ;
+
+    inMenuItem->fExecute      = inProc ;
+    inMenuItem->fExecuteData  = inData ;
+
+  } // end AVMenuItemSetExecuteProc
+
+// --------------------------
+
+void AVMenuItemSetComputeEnabledProc( AVMenuItem inMenuItem, AVComputeEnabledProc inProc, void * inData )
+  {
+    if ( inMenuItem == NULL )
+      return ;
+
+    inMenuItem->fComputeEnabled     = inProc ;
+    inMenuItem->fComputeEnabledData = inData ;
+
+  } // end AVMenuItemSetComputeEnabledProc
+
+// --------------------------
+
+void AVMenuItemSetComputeMarkedProc( AVMenuItem inMenuItem, AVComputeMarkedProc inProc, void * inData )
+  {
+    if ( inMenuItem == NULL )
+      return ;
+
+    inMenuItem->fComputeMarked      = inProc ;
+    inMenuItem->fComputeMarkedData  = inData ;
+
+  } // end AVMenuItemSetComputeMarkedProc
+
+// --------------------------
+#pragma mark -- toolbar
+// --------------------------
+
+AVToolButton AVToolBarGetButtonByName( AVToolBar inToolBar, ASAtom inName )
+  {
+    if ( inToolBar == NULL )
+      return NULL ;
+
+    for ( size_t index = 0 ; index < inToolBar->fButtons.size() ; index++ )
+      if ( inToolBar->fButtons[ index ]->fName == inName )
+        return inToolBar->fButtons[ index ] ;
+
+    return NULL ;
+
+  } // end AVToolBarGetButtonByName
+
+// --------------------------
+
+void AVToolBarAddButton( AVToolBar inToolBar, AVToolButton inButton, ASBool inBefore, AVToolButton inOtherButton )
+  {
+    std::vector< AVToolButton >::iterator   theIter ;
+
+    if ( ( inToolBar == NULL ) || ( inButton == NULL ) || ( inButton->fToolBar != NULL ) )
+      ASRaise( genErrBadParm ) ;
+
+    theIter = std::find( inToolBar->fButtons.begin(), inToolBar->fButtons.end(), inOtherButton ) ;
+    if ( ( theIter != inToolBar->fButtons.end() ) && ( inBefore == false ) )
+      ++theIter ;
+
+    inToolBar->fButtons.insert( theIter, inButton ) ;
+    inButton->fToolBar = inToolBar ;
+
+  } // end AVToolBarAddButton
+
+// --------------------------
+
+void AVToolBarUpdateButtonStates( AVToolBar inToolBar )
+  {
+    if ( inToolBar == NULL )
+      return ;
+
+    for ( size_t index = 0 ; index < inToolBar->fButtons.size() ; index++ )
+      if ( inToolBar->fButtons[ index ]->fComputeEnabled != NULL )
+        inToolBar->fButtons[ index ]->fComputeEnabled( inToolBar->fButtons[ index ]->fComputeEnabledData ) ;
+
+  } // end AVToolBarUpdateButtonStates
+
+// --------------------------
+
+AVToolButton AVToolButtonNew( ASAtom inName, AVIcon inIcon, ASBool inPullDown, ASBool inIsLabel )
+  {
+    AVToolButton  theButton = new _t_AVToolButton ;
+
+    theButton->fName                = inName ;
+    theButton->fIcon                = inIcon ;
+    theButton->fExecute             = NULL ;
+    theButton->fExecuteData         = NULL ;
+    theButton->fComputeEnabled      = NULL ;
+    theButton->fComputeEnabledData  = NULL ;
+    theButton->fToolBar             = NULL ;
+
+    return theButton ;
+
+  } // end AVToolButtonNew
+
+// --------------------------
+
+void AVToolButtonRemove( AVToolButton inButton )
+  {
+    if ( ( inButton == NULL ) || ( inButton->fToolBar == NULL ) )
+      return ;
+
+    std::vector< AVToolButton > & theButtons = inButton->fToolBar->fButtons ;
+    theButtons.erase( std::find( theButtons.begin(), theButtons.end(), inButton ) ) ;
+    inButton->fToolBar = NULL ;
+
+  } // end AVToolButtonRemove
+
+// --------------------------
+
+void AVToolButtonDestroy( AVToolButton inButton )
+  {
+    AVToolButtonRemove( inButton ) ;
+    delete inButton ;
+
+  } // end AVToolButtonDestroy
+
+// --------------------------
+
+void AVToolButtonExecute( AVToolButton inButton )
+  {
+    if ( ( inButton == NULL ) || ( inButton->fExecute == NULL ) )
+      return ;
+
+    if ( ( inButton->fComputeEnabled != NULL ) && ( inButton->fComputeEnabled( inButton->fComputeEnabledData ) == false ) )
+      return ;
+
+    sCallingOut += 1 ;
+    inButton->fExecute( inButton->fExecuteData ) ;
+    EndCallOut() ;
+
+  } // end AVToolButtonExecute
+
+// --------------------------
+
+void AVToolButtonSetIcon( AVToolButton inButton, AVIcon inIcon )
+  {
+    if ( inButton != NULL )
+      inButton->fIcon = inIcon ;
+
+  } // end AVToolButtonSetIcon
+
+// --------------------------
+
+void AVToolButtonSetHelpText( AVToolButton inButton, const char * inText )
+  {
+    if ( inButton != NULL )
+      inButton->fHelpText = ( inText != NULL ) ? inText : "" ;
+
+  } // end AVToolButtonSetHelpText
+
+// --------------------------
+
+void AVToolButtonSetExecuteProc( AVToolButton inButton, AVExecuteProc inProc, void * inData )
+  {
+    if ( inButton == NULL )
+      return ;
+
+    inButton->fExecute      = inProc ;
+    inButton->fExecuteData  = inData ;
+
+  } // end AVToolButtonSetExecuteProc
+
+// --------------------------
+
+void AVToolButtonSetComputeEnabledProc( AVToolButton inButton, AVComputeEnabledProc inProc, void * inData )
+  {
+    if ( inButton == NULL )
+      return ;
+
+    inButton->fComputeEnabled     = inProc ;
+    inButton->fComputeEnabledData = inData ;
+
+  } // end AVToolButtonSetComputeEnabledProc
+
+// --------------------------
+#pragma mark -- documents
+// --------------------------
+// The host's own reference to a document, held by its AVDoc, is not counted
+// in sNumAcquired; PDDocCreate, PDDocOpen and PDDocAcquire are.
+
+static PDDoc NewPDDoc( ASInt32 inNumPages, const char * inPath )
+  {
+    PDDoc   thePDDoc = new _t_PDDoc ;
+
+    thePDDoc->fFlags            = 0 ;
+    thePDDoc->fRefCount         = 1 ;
+    thePDDoc->fFile.fFile       = NULL ;
+    thePDDoc->fFile.fPathName   = ( inPath != NULL ) ? SimNewPathName( inPath ) : NULL ;
+
+    thePDDoc->fPages.reserve( inNumPages ) ;
+    for ( ASInt32 index = 0 ; index < inNumPages ; index++ )
+      {
+        PDPage  thePDPage = new _t_PDPage ;
+
+        thePDPage->fPDDoc       = thePDDoc ;
+        thePDPage->fOriginalNum = index ;
+        thePDPage->fRotate      = 0 ;
+        thePDPage->fRefCount    = 1 ;
+
+        thePDDoc->fPages.push_back( thePDPage ) ;
+      }
+
+    return thePDDoc ;
+
+  } // end NewPDDoc
+
+// --------------------------
+
+static void ReleasePage( PDPage inPDPage )
+  {
+    if ( --inPDPage->fRefCount == 0 )
+      delete inPDPage ;
+
+  } // end ReleasePage
+
+// --------------------------
+
+static void ReleasePDDoc( PDDoc inPDDoc )
+  {
+    if ( --inPDDoc->fRefCount > 0 )
+      return ;
+
+    for ( size_t index = 0 ; index < inPDDoc->fPages.size() ; index++ )
+      ReleasePage( inPDDoc->fPages[ index ] ) ;
+
+    delete inPDDoc->fFile.fPathName ;
+    delete inPDDoc ;
+
+  } // end ReleasePDDoc
+
+// --------------------------
+
+static PDPage GetPage( PDDoc inPDDoc, PDPageNumber inPageNum )
+  {
+    if ( ( inPDDoc == NULL ) || ( inPageNum < 0 ) || ( inPageNum >= ( PDPageNumber )inPDDoc->fPages.size() ) )
+      ASRaise( pdErrBadPageNum ) ;
+
+    return inPDDoc->fPages[ inPageNum ] ;
+
+  } // end GetPage
+
+// --------------------------
+
+PDDoc PDDocCreate( void )
+  {
+    sNumAcquired += 1 ;
+
+    return NewPDDoc( 0, NULL ) ;
+
+  } // end PDDocCreate
+
+// --------------------------
+
+PDDoc PDDocOpen( ASPathName inPathName, ASFileSys inFileSys, void * inAuthProc, ASBool inDoRepair )
+  {
+    ASInt32   theNumPages ;
+
+    if ( inPathName == NULL )
+      ASRaise( genErrBadParm ) ;
+
+    theNumPages = SimCountPages( inPathName->fPath.c_str() ) ;
+    if ( theNumPages == 0 )
+      ASRaise( fileErrFNF ) ;
+
+    sNumAcquired += 1 ;
+
+    return NewPDDoc( theNumPages, inPathName->fPath.c_str() ) ;
+
+  } // end PDDocOpen
+
+// --------------------------
+
+void PDDocClose( PDDoc inPDDoc )
+  {
+    PDDocRelease( inPDDoc ) ;
+
+  } // end PDDocClose
+
+// --------------------------
+
+void PDDocAcquire( PDDoc inPDDoc )
+  {
+    if ( inPDDoc == NULL )
+      return ;
+
+    inPDDoc->fRefCount += 1 ;
+    sNumAcquired += 1 ;
+
+  } // end PDDocAcquire
+
+// --------------------------
+
+void PDDocRelease( PDDoc inPDDoc )
+  {
+    if ( inPDDoc == NULL )
+      return ;
+
+    sNumAcquired -= 1 ;
+    ReleasePDDoc( inPDDoc ) ;
+
+  } // end PDDocRelease
+
+// --------------------------
+
+ASInt32 PDDocGetNumPages( PDDoc inPDDoc )
+  {
+    if ( inPDDoc == NULL )
+      ASRaise( genErrBadParm ) ;
+
+    return ( ASInt32 )inPDDoc->fPages.size() ;
+
+  } // end PDDocGetNumPages
+
+// --------------------------
+
+ASInt32 PDDocGetFlags( PDDoc inPDDoc )
+  {
+    return ( inPDDoc != NULL ) ? inPDDoc->fFlags : 0 ;
+
+  } // end PDDocGetFlags
+
+// --------------------------
+
+PDPerms PDDocGetPermissions( PDDoc inPDDoc )
+  {
+    return pdPermOpen | pdPermEdit | pdPermCopy ;
+
+  } // end PDDocGetPermissions
+
+// --------------------------
+
+ASFile PDDocGetFile( PDDoc inPDDoc )
+  {
+    if ( ( inPDDoc == NULL ) || ( inPDDoc->fFile.fPathName == NULL ) )
+      return NULL ;
+
+    return &inPDDoc->fFile ;
+
+  } // end PDDocGetFile
+
+// --------------------------
+
+PDPage PDDocAcquirePage( PDDoc inPDDoc, PDPageNumber inPageNum )
+  {
+    PDPage  thePDPage = GetPage( inPDDoc, inPageNum ) ;
+
+    thePDPage->fRefCount += 1 ;
+    sNumAcquired += 1 ;
+
+    return thePDPage ;
+
+  } // end PDDocAcquirePage
+
+// --------------------------
+// The page is moved in the page list itself, so a move costs as much as
+// moving the pointers after it; Acrobat's page tree is cheaper for a large
+// document, but has the same order of calls.
+
+void PDDocMovePage( PDDoc inPDDoc, PDPageNumber inMoveToAfterThisPage, PDPageNumber inPageToMove )
+  {
+    PDPage          thePDPage = GetPage( inPDDoc, inPageToMove ) ;
+    PDPageNumber    theTarget ;
+
+    if ( inMoveToAfterThisPage == PDLastPage )
+      inMoveToAfterThisPage = ( PDPageNumber )inPDDoc->fPages.size() - 1 ;
+
+    if ( ( inMoveToAfterThisPage < PDBeforeFirstPage ) || ( inMoveToAfterThisPage >= ( PDPageNumber )inPDDoc->fPages.size() ) )
+      ASRaise( pdErrBadPageNum ) ;
+
+    theTarget = ( inMoveToAfterThisPage < inPageToMove ) ? inMoveToAfterThisPage + 1 : inMoveToAfterThisPage ;
+
+    inPDDoc->fPages.erase( inPDDoc->fPages.begin() + inPageToMove ) ;
+    inPDDoc->fPages.insert( inPDDoc->fPages.begin() + theTarget, thePDPage ) ;
+    inPDDoc->fFlags |= PDDocNeedsSave ;
+
+  } // end PDDocMovePage
+
+// --------------------------
+
+void PDDocInsertPages( PDDoc inPDDoc, PDPageNumber inInsertAfterThisPage, PDDoc inSourcePDDoc,
+                       PDPageNumber inStartPage, ASInt32 inNumPages, ASUns16 inInsertFlags,
+                       ProgressMonitor inProgressMonitor, void * inProgressMonitorData,
+                       CancelProc inCancelProc, void * inCancelProcData )
+  {
+    ASInt32   theFirst ;
+
+    if ( ( inPDDoc == NULL ) || ( inSourcePDDoc == NULL ) )
+      ASRaise( genErrBadParm ) ;
+
+    if ( inNumPages == PDAllPages )
+      inNumPages = ( ASInt32 )inSourcePDDoc->fPages.size() - inStartPage ;
+
+    if ( inInsertAfterThisPage == PDLastPage )
+      inInsertAfterThisPage = ( PDPageNumber )inPDDoc->fPages.size() - 1 ;
+
+    if ( ( inStartPage < 0 ) || ( inNumPages < 0 ) || ( inStartPage + inNumPages > ( ASInt32 )inSourcePDDoc->fPages.size() )
+         || ( inInsertAfterThisPage < PDBeforeFirstPage ) || ( inInsertAfterThisPage >= ( PDPageNumber )inPDDoc->fPages.size() ) )
+      ASRaise( pdErrBadPageNum ) ;
+
+    theFirst = inInsertAfterThisPage + 1 ;
+
+    for ( ASInt32 index = 0 ; index < inNumPages ; index++ )
+      {
+        PDPage  thePDPage = new _t_PDPage ;
+
+        *thePDPage = *inSourcePDDoc->fPages[ inStartPage + index ] ;
+        thePDPage->fPDDoc     = inPDDoc ;
+        thePDPage->fRefCount  = 1 ;
+
+        inPDDoc->fPages.insert( inPDDoc->fPages.begin() + theFirst + index, thePDPage ) ;
+      }
+
+    inPDDoc->fFlags |= PDDocNeedsSave ;
+
+    SIM_NOTIFY( PDDocDidInsertPagesNSEL, SimInsertPagesProc, inPDDoc, inInsertAfterThisPage, inNumPages,
+                inSourcePDDoc, inStartPage, inStartPage + inNumPages - 1, 0 ) ;
+
+  } // end PDDocInsertPages
+
+// --------------------------
+
+PDPageLabel PDDocGetPageLabel( PDDoc inPDDoc, PDPageNumber inPageNum, PDPageNumber * outFirstPage, PDPageNumber * outLastPage )
+  {
+    if ( outFirstPage != NULL )
+      *outFirstPage = 0 ;
+    if ( outLastPage != NULL )
+      *outLastPage = 0 ;
+
+    return NULL ;
+
+  } // end PDDocGetPageLabel
+
+// --------------------------
+
+PDBookmark PDDocGetBookmarkRoot( PDDoc inPDDoc )
+  {
+    return NULL ;
+
+  } // end PDDocGetBookmarkRoot
+
+// --------------------------
+
+ASInt32 PDGetHostEncoding( void )
+  {
+    return 0 ;
+
+  } // end PDGetHostEncoding
+
+// --------------------------
+#pragma mark -- pages
+// --------------------------
+
+void PDPageRelease( PDPage inPDPage )
+  {
+    if ( inPDPage == NULL )
+      return ;
+
+    sNumAcquired -= 1 ;
+    ReleasePage( inPDPage ) ;
+
+  } // end PDPageRelease
+
+// --------------------------
+
+PDRotate PDPageGetRotate( PDPage inPDPage )
+  {
+    return ( inPDPage != NULL ) ? inPDPage->fRotate : 0 ;
+
+  } // end PDPageGetRotate
+
+// --------------------------
+
+void PDPageSetRotate( PDPage inPDPage, PDRotate inRotate )
+  {
+    if ( ( inPDPage == NULL ) || ( ( inRotate % 90 ) != 0 ) )
+      ASRaise( genErrBadParm ) ;
+
+    inPDPage->fRotate = ( PDRotate )( ( ( inRotate % 360 ) + 360 ) % 360 ) ;
+    inPDPage->fPDDoc->fFlags |= PDDocNeedsSave ;
+
+  } // end PDPageSetRotate
+
+// --------------------------
+
+void PDPageGetCropBox( PDPage inPDPage, ASFixedRect * outCropBox )
+  {
+    outCropBox->left    = 0 ;
+    outCropBox->bottom  = 0 ;
+    outCropBox->right   = ASInt32ToFixed( kSimPageWidth ) ;
+    outCropBox->top     = ASInt32ToFixed( kSimPageHeight ) ;
+
+  } // end PDPageGetCropBox
+
+// --------------------------
+
+CosObj PDPageGetCosObj( PDPage inPDPage )
+  {
+    CosObj  theObj ;
+
+    theObj.fType = ( inPDPage != NULL ) ? CosDict : CosNull ;
+    theObj.fData = inPDPage ;
+
+    return theObj ;
+
+  } // end PDPageGetCosObj
+
+// --------------------------
+
+PDPageNumber PDPageNumFromCosObj( CosObj inPageObj )
+  {
+    PDPage  thePDPage = ( PDPage )inPageObj.fData ;
+
+    if ( ( inPageObj.fType != CosDict ) || ( thePDPage == NULL ) )
+      return -1 ;
+
+    std::vector< PDPage > & thePages = thePDPage->fPDDoc->fPages ;
+
+    return ( PDPageNumber )( std::find( thePages.begin(), thePages.end(), thePDPage ) - thePages.begin() ) ;
+
+  } // end PDPageNumFromCosObj
+
+// --------------------------
+// Nothing is drawn; the buffer is only cleared, as the lazy erase would.
+
+ASInt32 PDPageDrawContentsToMemory( PDPage inPDPage, ASUns32 inFlags, ASFixedMatrix * inMatrix, ASFixedRect * inUpdateRect,
+                                    ASUns32 inSmoothFlags, ASAtom inColorSpace, ASInt32 inBitsPerComponent,
+                                    char * outBuffer, ASInt32 inBufferSize, CancelProc inCancelProc, void * inCancelProcData )
+  {
+    if ( ( outBuffer != NULL ) && ( inBufferSize > 0 ) )
+      memset( outBuffer, 0xFF, inBufferSize ) ;
+
+    return inBufferSize ;
+
+  } // end PDPageDrawContentsToMemory
+
+// --------------------------
+
+ASBool PDPageLabelIsValid( PDPageLabel inLabel )
+  {
+    return ( inLabel != NULL ) ;
+
+  } // end PDPageLabelIsValid
+
+// --------------------------
+
+ASInt32 PDPageLabelGetStart( PDPageLabel inLabel )
+  {
+    return 1 ;
+
+  } // end PDPageLabelGetStart
+
+// --------------------------
+#pragma mark -- Cos objects
+// --------------------------
+// A page's dictionary has a /Contents stream and nothing else.
+
+CosType CosObjGetType( CosObj inObj )
+  {
+    return ( CosType )inObj.fType ;
+
+  } // end CosObjGetType
+
+// --------------------------
+
+CosObj CosDictGet( CosObj inDict, ASAtom inKey )
+  {
+    CosObj  theObj ;
+
+    theObj.fType = CosNull ;
+    theObj.fData = NULL ;
+
+    if ( ( inDict.fType == CosDict ) && ( inKey == ASAtomFromString( "Contents" ) ) )
+      {
+        theObj.fType = CosStream ;
+        theObj.fData = inDict.fData ;
+      }
+
+    return theObj ;
+
+  } // end CosDictGet
+
+// --------------------------
+
+ASInt32 CosArrayLength( CosObj inArray )
+  {
+    return 0 ;
+
+  } // end CosArrayLength
+
+// --------------------------
+
+CosObj CosArrayGet( CosObj inArray, ASInt32 inIndex )
+  {
+    CosObj  theObj ;
+
+    theObj.fType = CosNull ;
+    theObj.fData = NULL ;
+
+    return theObj ;
+
+  } // end CosArrayGet
+
+// --------------------------
+
+ASInt32 CosStreamLength( CosObj inStream )
+  {
+    return ( inStream.fType == CosStream ) ? kSimContentLength : 0 ;
+
+  } // end CosStreamLength
+
+// --------------------------
+#pragma mark -- bookmarks and destinations
+// --------------------------
+// A simulated document has no bookmarks, so there is nothing to walk.
+
+ASBool PDBookmarkIsValid( PDBookmark inBookmark )                     { return ( inBookmark != NULL ) ; }
+ASBool PDBookmarkEqual( PDBookmark inBookmark1, PDBookmark inBookmark2 ) { return ( inBookmark1 == inBookmark2 ) ; }
+ASBool PDBookmarkHasChildren( PDBookmark inBookmark )                 { return false ; }
+PDBookmark PDBookmarkGetFirstChild( PDBookmark inBookmark )           { return NULL ; }
+PDBookmark PDBookmarkGetLastChild( PDBookmark inBookmark )            { return NULL ; }
+PDBookmark PDBookmarkGetNext( PDBookmark inBookmark )                 { return NULL ; }
+PDBookmark PDBookmarkGetPrev( PDBookmark inBookmark )                 { return NULL ; }
+PDAction PDBookmarkGetAction( PDBookmark inBookmark )                 { return NULL ; }
+
+ASBool PDActionIsValid( PDAction inAction )                           { return ( inAction != NULL ) ; }
+ASAtom PDActionGetSubtype( PDAction inAction )                        { return ASAtomNull ; }
+PDViewDestination PDActionGetDest( PDAction inAction )                { return NULL ; }
+PDViewDestination PDViewDestResolve( PDViewDestination inDest, PDDoc inPDDoc ) { return NULL ; }
+ASBool PDViewDestIsValid( PDViewDestination inDest )                  { return ( inDest != NULL ) ; }
+
+CosObj PDViewDestGetCosObj( PDViewDestination inDest )
+  {
+    CosObj  theObj ;
+
+    theObj.fType = CosNull ;
+    theObj.fData = NULL ;
+
+    return theObj ;
+
+  } // end PDViewDestGetCosObj
+
+// --------------------------
+#pragma mark -- word finder
+// --------------------------
+// A simulated page has no text.
+
+PDWordFinder PDDocCreateWordFinder( PDDoc inPDDoc, void * outEncInfo, void * outEncVec, void * inLigatureTable,
+                                    ASInt16 inAlgVersion, ASUns16 inFlags, void * inClientData )
+  {
+    PDWordFinder  theWordFinder = new _t_PDWordFinder ;
+
+    theWordFinder->fPDDoc = inPDDoc ;
+
+    return theWordFinder ;
+
+  } // end PDDocCreateWordFinder
+
+// --------------------------
+
+PDWordFinder PDDocCreateWordFinderUCS( PDDoc inPDDoc, ASInt16 inAlgVersion, ASUns16 inFlags, void * inClientData )
+  {
+    return PDDocCreateWordFinder( inPDDoc, NULL, NULL, NULL, inAlgVersion, inFlags, inClientData ) ;
+
+  } // end PDDocCreateWordFinderUCS
+
+// --------------------------
+
+void PDWordFinderDestroy( PDWordFinder inWordFinder )
+  {
+    delete inWordFinder ;
+
+  } // end PDWordFinderDestroy
+
+// --------------------------
+
+void PDWordFinderAcquireWordList( PDWordFinder inWordFinder, PDPageNumber inPageNum, PDWord * outWordList,
+                                  PDWord * outSortTable, ASInt32 * outNumWords )
+  {
+    GetPage( inWordFinder->fPDDoc, inPageNum ) ;
+
+    if ( outWordList != NULL )
+      *outWordList = NULL ;
+    if ( outSortTable != NULL )
+      *outSortTable = NULL ;
+    *outNumWords = 0 ;
+
+  } // end PDWordFinderAcquireWordList
+
+// --------------------------
+
+void PDWordFinderReleaseWordList( PDWordFinder inWordFinder, PDPageNumber inPageNum )
+  {
+  } // end PDWordFinderReleaseWordList
+
+// --------------------------
+
+PDWord PDWordFinderGetNthWord( PDWordFinder inWordFinder, ASInt32 inIndex )
+  {
+    ASRaise( genErrBadParm ) ;
+
+    return NULL ;
+
+  } // end PDWordFinderGetNthWord
+
+// --------------------------
+
+ASBool PDWordGetNthQuad( PDWord inWord, ASInt32 inIndex, ASFixedQuad * outQuad )     { return false ; }
+ASBool PDWordGetNthCharQuad( PDWord inWord, ASInt32 inIndex, ASFixedQuad * outQuad ) { return false ; }
+ASInt32 PDWordGetString( PDWord inWord, char * outBuffer, ASInt32 inBufferSize )      { return 0 ; }
+
+// --------------------------
+#pragma mark -- views
+// --------------------------
+
+static void SetActiveDoc( AVDoc inAVDoc )
+  {
+    if ( inAVDoc == sActiveDoc )
+      return ;
+
+    sActiveDoc = inAVDoc ;
+
+    SIM_NOTIFY( AVAppFrontDocDidChangeNSEL, SimDocProc, inAVDoc ) ;
+
+  } // end SetActiveDoc
+
+// --------------------------
+
+PDDoc AVDocGetPDDoc( AVDoc inAVDoc )
+  {
+    return ( inAVDoc != NULL ) ? inAVDoc->fPDDoc : NULL ;
+
+  } // end AVDocGetPDDoc
+
+// --------------------------
+
+AVPageView AVDocGetPageView( AVDoc inAVDoc )
+  {
+    return ( inAVDoc != NULL ) ? &inAVDoc->fPageView : NULL ;
+
+  } // end AVDocGetPageView
+
+// --------------------------
+
+AVWindow AVDocGetAVWindow( AVDoc inAVDoc )
+  {
+    return ( inAVDoc != NULL ) ? &inAVDoc->fWindow : NULL ;
+
+  } // end AVDocGetAVWindow
+
+// --------------------------
+
+PDPageMode AVDocGetViewMode( AVDoc inAVDoc )
+  {
+    return ( inAVDoc != NULL ) ? inAVDoc->fViewMode : PDUseNone ;
+
+  } // end AVDocGetViewMode
+
+// --------------------------
+
+ASInt16 AVDocGetSplitterPosition( AVDoc inAVDoc )
+  {
+    return ( ( inAVDoc != NULL ) && ( inAVDoc->fViewMode != PDUseNone ) ) ? 200 : 0 ;
+
+  } // end AVDocGetSplitterPosition
+
+// --------------------------
+
+AVDoc AVDocOpenFromPDDoc( PDDoc inPDDoc, const char * inTempTitle )
+  {
+    AVDoc   theAVDoc ;
+
+    if ( inPDDoc == NULL )
+      ASRaise( genErrBadParm ) ;
+
+    theAVDoc = new _t_AVDoc ;
+    theAVDoc->fPDDoc                = inPDDoc ;
+    theAVDoc->fTitle                = ( inTempTitle != NULL ) ? inTempTitle : "Untitled" ;
+    theAVDoc->fViewMode             = PDUseNone ;
+    theAVDoc->fPageView.fAVDoc      = theAVDoc ;
+    theAVDoc->fPageView.fPageNum    = 0 ;
+    theAVDoc->fPageView.fZoomType   = AVZoomNoVary ;
+    theAVDoc->fWindow.fAVDoc        = theAVDoc ;
+
+    inPDDoc->fRefCount += 1 ;
+    sDocs.push_back( theAVDoc ) ;
+
+    SIM_NOTIFY( AVDocDidOpenNSEL, SimDocErrorProc, theAVDoc, 0 ) ;
+    SetActiveDoc( theAVDoc ) ;
+
+    return theAVDoc ;
+
+  } // end AVDocOpenFromPDDoc
+
+// --------------------------
+
+AVDoc AVDocOpenFromFile( ASPathName inPathName, ASFileSys inFileSys, const char * inTempTitle )
+  {
+    PDDoc   thePDDoc = PDDocOpen( inPathName, inFileSys, NULL, true ) ;
+    AVDoc   theAVDoc ;
+
+    theAVDoc = AVDocOpenFromPDDoc( thePDDoc, inTempTitle ) ;
+    PDDocRelease( thePDDoc ) ;
+
+    return theAVDoc ;
+
+  } // end AVDocOpenFromFile
+
+// --------------------------
+
+ASBool AVDocClose( AVDoc inAVDoc, ASBool inNoSave )
+  {
+    if ( inAVDoc == NULL )
+      return false ;
+
+    SIM_NOTIFY( AVDocWillCloseNSEL, SimDocProc, inAVDoc ) ;
+
+    sDocs.erase( std::find( sDocs.begin(), sDocs.end(), inAVDoc ) ) ;
+    if ( inAVDoc == sActiveDoc )
+      SetActiveDoc( sDocs.empty() ? NULL : sDocs.back() ) ;
+
+    ReleasePDDoc( inAVDoc->fPDDoc ) ;
+    delete inAVDoc ;
+
+    return true ;
+
+  } // end AVDocClose
+
+// --------------------------
+
+void AVWindowGetTitle( AVWindow inWindow, ASText outTitle )
+  {
+    if ( inWindow != NULL )
+      ASTextSetUnicode( outTitle, ( const ASUTF16Val * )inWindow->fAVDoc->fTitle.c_str(), kUTF8 ) ;
+
+  } // end AVWindowGetTitle
+
+// --------------------------
+
+void AVWindowBringToFront( AVWindow inWindow )
+  {
+    if ( inWindow != NULL )
+      SetActiveDoc( inWindow->fAVDoc ) ;
+
+  } // end AVWindowBringToFront
+
+// --------------------------
+
+AVDoc AVPageViewGetAVDoc( AVPageView inAVPageView )
+  {
+    return ( inAVPageView != NULL ) ? inAVPageView->fAVDoc : NULL ;
+
+  } // end AVPageViewGetAVDoc
+
+// --------------------------
+
+PDPageNumber AVPageViewGetPageNum( AVPageView inAVPageView )
+  {
+    return ( inAVPageView != NULL ) ? inAVPageView->fPageNum : 0 ;
+
+  } // end AVPageViewGetPageNum
+
+// --------------------------
+
+void AVPageViewGoTo( AVPageView inAVPageView, PDPageNumber inPageNum )
+  {
+    if ( inAVPageView == NULL )
+      return ;
+
+    GetPage( inAVPageView->fAVDoc->fPDDoc, inPageNum ) ;
+
+    if ( inAVPageView->fPageNum == inPageNum )
+      return ;
+
+    inAVPageView->fPageNum = inPageNum ;
+
+    SIM_NOTIFY( AVPageViewDidChangeNSEL, SimPageViewProc, inAVPageView, ( ASInt16 )PAGEVIEW_UPDATE_PAGENUM ) ;
+
+  } // end AVPageViewGoTo
+
+// --------------------------
+
+AVZoomType AVPageViewGetZoomType( AVPageView inAVPageView )
+  {
+    return ( inAVPageView != NULL ) ? inAVPageView->fZoomType : AVZoomNoVary ;
+
+  } // end AVPageViewGetZoomType
+
+// --------------------------
+
+void AVPageViewGetAperture( AVPageView inAVPageView, AVDevRect * outRect )
+  {
+    outRect->left   = 0 ;
+    outRect->top    = 0 ;
+    outRect->right  = kSimApertureWidth ;
+    outRect->bottom = kSimApertureHeight ;
+
+  } // end AVPageViewGetAperture
+
+// --------------------------
+
+void AVPageViewInvalidateRect( AVPageView inAVPageView, AVDevRect * inRect )
+  {
+  } // end AVPageViewInvalidateRect
+
+// --------------------------
+
+void AVPageViewDrawNow( AVPageView inAVPageView )
+  {
+    AVDevRect   theRect ;
+
+    if ( inAVPageView == NULL )
+      return ;
+
+    AVPageViewGetAperture( inAVPageView, &theRect ) ;
+
+    sCallingOut += 1 ;
+    for ( size_t index = 0 ; index < sDrawProcs.size() ; index++ )
+      ( ( AVPageViewDrawProc )sDrawProcs[ index ].fProc )( inAVPageView, &theRect, sDrawProcs[ index ].fData ) ;
+    EndCallOut() ;
+
+  } // end AVPageViewDrawNow
+
+// --------------------------
+#pragma mark -- the host menus and buttons
+// --------------------------
+
+static ACCB1 void ACCB2 DoSetViewMode( void * inData )
+  {
+    if ( sActiveDoc != NULL )
+      sActiveDoc->fViewMode = ( PDPageMode )( size_t )inData ;
+
+  } // end DoSetViewMode
+
+// --------------------------
+
+static ACCB1 void ACCB2 DoSetZoomType( void * inData )
+  {
+    if ( sActiveDoc == NULL )
+      return ;
+
+    sActiveDoc->fPageView.fZoomType = ( AVZoomType )( size_t )inData ;
+
+    SIM_NOTIFY( AVPageViewDidChangeNSEL, SimPageViewProc, &sActiveDoc->fPageView, ( ASInt16 )PAGEVIEW_UPDATE_ZOOM ) ;
+
+  } // end DoSetZoomType
+
+// --------------------------
+
+struct SimMenuItemDef
+  {
+    const char *    fName ;
+    const char *    fTitle ;
+    ASInt32         fSubmenu ;        // index of the submenu's first item in the table, or 0
+    AVExecuteProc   fExecute ;
+    ASInt32         fExecuteData ;
+  } ;
+
+struct SimMenuDef
+  {
+    const char *    fName ;
+    const char *    fTitle ;
+    const char *    fItemNames ;      // space separated; each is also its title
+  } ;
+
+// The top-level menus in Acrobat's order, with the menu items the plug-ins
+// look for by name among the usual ones; a name ending in ">" has a
+// submenu of that name, listed after the top-level menus.
+static const SimMenuDef gSimMenus[] =
+  {
+    { "File",             "File",       "Open OpenAsPDF> Close Save SaveAs SaveAsOther> Revert Export> AttachFile CreatePDF> "
+                                        "Email DocInfo PrintSetup Print RecentFiles> Quit" },
+    { "Edit",             "Edit",       "Undo Redo Cut Copy Paste Clear SelectAll DeselectAll CopyFileToClipboard TakeSnapshot "
+                                        "CheckSpelling> Find Search AdvancedSearch Preferences" },
+    { "View",             "View",       "RotateView> PageNavigation> PageDisplay> Zoom100 FitPage FitWidth FitVisible ZoomTo "
+                                        "ShowBookmarks ShowThumbs ShowLayers Toolbars> ShowHideRulers ReadOutLoud> FullScreen" },
+    { "Document",         "Document",   "InsertPages ExtractPages ReplacePages DeletePages CropPages RotatePages SplitDocument "
+                                        "NumberPages HeaderFooter> Watermark> Background> Attachments ScanOptimize OCR> Security>" },
+    { "Comments",         "Comments",   "AddStickyNote ShowCommentingToolbar ShowMarkupToolbar ReviewAndComment Summarize ImportComments "
+                                        "ExportComments> MigrateComments CommentsList" },
+    { "Forms",            "Forms",      "StartFormWizard EditFields> DistributeForm TrackForms HighlightFields ManageFormData>" },
+    { "Tools",            "Tools",      "Customize> SelectAndZoom> Measuring> Typewriter> Multimedia> Advanced>" },
+    { "Advanced",         "Advanced",   "AccessibilityCheck PrintProduction> Preflight JavaScript> DocumentProcessing> BatchProcessing "
+                                        "WebCapture> Digitize> Overprint" },
+    { "Window",           "Window",     "NewWindow Cascade TileHorizontal TileVertical CloseAll SplitView SpreadsheetSplit" },
+    { "Help",             "Help",       "HelpAcrobat HowTo> OnlineSupport> AboutAcrobat AboutExtensions> Updates Registration" },
+    { "Extensions",       "Plug-Ins",   "" }
+  } ;
+
+#define kSimSubmenuItems    6
+
+// --------------------------
+
+static AVMenu AddMenu( AVMenu inParentMenu, const char * inName, const char * inTitle, const char * inItemNames ) ;
+
+static void AddMenuItems( AVMenu inMenu, const char * inItemNames )
+  {
+    std::string   theNames( inItemNames ) ;
+    size_t        theStart = 0 ;
+
+    while ( theStart < theNames.size() )
+      {
+        size_t        theEnd  = theNames.find( ' ', theStart ) ;
+        std::string   theName = theNames.substr( theStart, ( theEnd == std::string::npos ) ? std::string::npos : theEnd - theStart ) ;
+        AVMenu        theSubmenu = NULL ;
+
+        theStart = ( theEnd == std::string::npos ) ? theNames.size() : theEnd + 1 ;
+        if ( theName.empty() )
+          continue ;
+
+        if ( theName[ theName.size() - 1 ] == '>' )
+          {
+            std::string   theSubmenuItems ;
+
+            theName.erase( theName.size() - 1 ) ;
+
+            // AboutExtensions is filled by the plug-ins; other submenus get a few items of their own
+            if ( theName != "AboutExtensions" )
+              for ( ASInt32 index = 0 ; index < kSimSubmenuItems ; index++ )
+                theSubmenuItems += theName + ":" + ( char )( 'A' + index ) + " " ;
+
+            theSubmenu = AddMenu( NULL, theName.c_str(), theName.c_str(), theSubmenuItems.c_str() ) ;
+          }
+
+        AVMenuItem  theMenuItem = AVMenuItemNew( theName.c_str(), theName.c_str(), theSubmenu, false, NO_SHORTCUT, 0, NULL, NULL ) ;
+
+        if ( theName == "ShowBookmarks" )
+          AVMenuItemSetExecuteProc( theMenuItem, &DoSetViewMode, ( void * )( size_t )PDUseBookmarks ) ;
+        else if ( theName == "ShowThumbs" )
+          AVMenuItemSetExecuteProc( theMenuItem, &DoSetViewMode, ( void * )( size_t )PDUseThumbs ) ;
+
+        AVMenuAddMenuItem( inMenu, theMenuItem, APPEND_MENUITEM ) ;
+        AVMenuItemRelease( theMenuItem ) ;
+
+        if ( theSubmenu != NULL )
+          AVMenuRelease( theSubmenu ) ;
+      }
+
+  } // end AddMenuItems
+
+// --------------------------
+
+static AVMenu AddMenu( AVMenu inParentMenu, const char * inName, const char * inTitle, const char * inItemNames )
+  {
+    AVMenu  theMenu = AVMenuNew( inTitle, inName, NULL ) ;
+
+    AddMenuItems( theMenu, inItemNames ) ;
+
+    return theMenu ;
+
+  } // end AddMenu
+
+// --------------------------
+
+struct SimButtonDef
+  {
+    const char *    fName ;
+    AVExecuteProc   fExecute ;
+    ASInt32         fExecuteData ;
+  } ;
+
+static const SimButtonDef gSimButtons[] =
+  {
+    { "Open",               NULL,             0 },
+    { "Save",               NULL,             0 },
+    { "Print",              NULL,             0 },
+    { "endFileGroup",       NULL,             0 },
+    { "UseNone",            &DoSetViewMode,   PDUseNone },
+    { "UseBookmarks",       &DoSetViewMode,   PDUseBookmarks },
+    { "UseThumbs",          &DoSetViewMode,   PDUseThumbs },
+    { "endPageModeGroup",   NULL,             0 },
+    { "Zoom100",            &DoSetZoomType,   AVZoomNoVary },
+    { "FitPage",            &DoSetZoomType,   AVZoomFitPage },
+    { "FitVisible",         &DoSetZoomType,   AVZoomFitVisibleWidth },
+    { "endZoomGroup",       NULL,             0 },
+    { "Hand",               NULL,             0 },
+    { "Select",             NULL,             0 },
+    { "endToolsGroup",      NULL,             0 }
+  } ;
+
+// --------------------------
+
+void SimHostInit( void )
+  {
+    for ( size_t index = 0 ; index < sizeof( gSimMenus ) / sizeof( gSimMenus[ 0 ] ) ; index++ )
+      sMenubar.fMenus.push_back( AddMenu( NULL, gSimMenus[ index ].fName, gSimMenus[ index ].fTitle, gSimMenus[ index ].fItemNames ) ) ;
+
+    for ( size_t index = 0 ; index < sizeof( gSimButtons ) / sizeof( gSimButtons[ 0 ] ) ; index++ )
+      {
+        AVToolButton  theButton = AVToolButtonNew( ASAtomFromString( gSimButtons[ index ].fName ), NULL, false, false ) ;
+
+        AVToolButtonSetExecuteProc( theButton, gSimButtons[ index ].fExecute, ( void * )( size_t )gSimButtons[ index ].fExecuteData ) ;
+        AVToolBarAddButton( &sToolBar, theButton, false, NULL ) ;
+      }
+
+    // the menubar's references are the host's own
+    sNumAcquired = 0 ;
+
+  } // end SimHostInit
+
+// --------------------------
+#pragma mark -- what the driver does
+// --------------------------
+
+ASBool SimLoadPlugIn( SimHandshakeProc inHandshake )
+  {
+    ASBool    theResult = true ;
+
+    memset( &sHandshakeData, 0, sizeof( sHandshakeData ) ) ;
+    sHandshakeData.handshakeVersion = HANDSHAKE_V0200 ;
+
+    gExtensionID = new _t_ASExtension ;
+    gExtensionID->fName = ASAtomNull ;
+
+    if ( inHandshake( HANDSHAKE_V0200, &sHandshakeData ) == false )
+      return false ;
+
+    gExtensionID->fName = sHandshakeData.extensionName ;
+
+    sCallingOut += 1 ;
+
+    if ( sHandshakeData.exportHFTsCallback != NULL )
+      theResult = sHandshakeData.exportHFTsCallback() ;
+
+    if ( ( theResult == true ) && ( sHandshakeData.importReplaceAndRegisterCallback != NULL ) )
+      theResult = sHandshakeData.importReplaceAndRegisterCallback() ;
+
+    if ( ( theResult == true ) && ( sHandshakeData.initCallback != NULL ) )
+      theResult = sHandshakeData.initCallback() ;
+
+    EndCallOut() ;
+
+    if ( theResult == true )
+      {
+        sCallingOut += 1 ;
+        for ( size_t index = 0 ; index < sNotifications[ AVAppDidInitializeNSEL ].size() ; index++ )
+          {
+            SimCallback theCallback = sNotifications[ AVAppDidInitializeNSEL ][ index ] ;
+            if ( theCallback.fProc != NULL )
+              ( ( SimAppProc )theCallback.fProc )( theCallback.fData ) ;
+          }
+        EndCallOut() ;
+      }
+
+    return theResult ;
+
+  } // end SimLoadPlugIn
+
+// --------------------------
+
+void SimUnloadPlugIn( void )
+  {
+    if ( sHandshakeData.unloadCallback == NULL )
+      return ;
+
+    sCallingOut += 1 ;
+    sHandshakeData.unloadCallback() ;
+    EndCallOut() ;
+
+  } // end SimUnloadPlugIn
+
+// --------------------------
+
+AVDoc SimOpenDoc( const char * inTitle, ASInt32 inNumPages )
+  {
+    PDDoc   thePDDoc  = NewPDDoc( inNumPages, NULL ) ;
+    AVDoc   theAVDoc  = AVDocOpenFromPDDoc( thePDDoc, inTitle ) ;
+
+    ReleasePDDoc( thePDDoc ) ;
+
+    return theAVDoc ;
+
+  } // end SimOpenDoc
+
+// --------------------------
+
+void SimCloseDoc( AVDoc inAVDoc )
+  {
+    AVDocClose( inAVDoc, true ) ;
+
+  } // end SimCloseDoc
+
+// --------------------------
+
+ASInt32 SimGetOriginalPageNum( PDDoc inPDDoc, PDPageNumber inPageNum )
+  {
+    if ( ( inPDDoc == NULL ) || ( inPageNum < 0 ) || ( inPageNum >= ( PDPageNumber )inPDDoc->fPages.size() ) )
+      return -1 ;
+
+    return inPDDoc->fPages[ inPageNum ]->fOriginalNum ;
+
+  } // end SimGetOriginalPageNum
+
+// --------------------------
+
+void SimSetFullScreen( ASBool inFullScreen )
+  {
+    sFullScreen = inFullScreen ;
+
+  } // end SimSetFullScreen
+
+// --------------------------
+
+ASBool SimClick( AVPageView inAVPageView, ASInt16 inFlags, ASInt16 inClickNumber )
+  {
+    ASBool    theHandled = false ;
+
+    sCallingOut += 1 ;
+    for ( size_t index = 0 ; ( index < sClickProcs.size() ) && ( theHandled == false ) ; index++ )
+      theHandled = ( ( AVPageViewClickProc )sClickProcs[ index ].fProc )( inAVPageView, kSimApertureWidth / 2, kSimApertureHeight / 2,
+                                                                          inFlags, inClickNumber, sClickProcs[ index ].fData ) ;
+    EndCallOut() ;
+
+    return theHandled ;
+
+  } // end SimClick
+
+// --------------------------
+
+void SimPageViewDidChange( AVPageView inAVPageView, ASInt16 inHowChanged )
+  {
+    SIM_NOTIFY( AVPageViewDidChangeNSEL, SimPageViewProc, inAVPageView, inHowChanged ) ;
+
+  } // end SimPageViewDidChange
+
+// --------------------------
+
+void SimRunIdle( void )
+  {
+    sCallingOut += 1 ;
+    for ( size_t index = 0 ; index < sIdleProcs.size() ; index++ )
+      {
+        SimCallback theCallback = sIdleProcs[ index ] ;
+        if ( theCallback.fProc != NULL )
+          ( ( AVIdleProc )theCallback.fProc )( theCallback.fData ) ;
+      }
+    EndCallOut() ;
+
+  } // end SimRunIdle
+
+// --------------------------
+
+ASBool SimExecuteMenuItem( const char * inName )
+  {
+    AVMenuItem  theMenuItem = AVMenubarAcquireMenuItemByName( &sMenubar, inName ) ;
+    ASBool      theEnabled ;
+
+    if ( theMenuItem == NULL )
+      return false ;
+
+    theEnabled = AVMenuItemIsEnabled( theMenuItem ) ;
+    if ( theEnabled == true )
+      AVMenuItemExecute( theMenuItem ) ;
+
+    AVMenuItemRelease( theMenuItem ) ;
+
+    return theEnabled ;
+
+  } // end SimExecuteMenuItem
+
+// --------------------------
+
+ASInt32 SimGetNumAlerts( void )
+  {
+    return sNumAlerts ;
+
+  } // end SimGetNumAlerts
+
+// --------------------------
+
+ASInt32 SimGetNumAcquired( void )
+  {
+    return sNumAcquired ;
+
+  } // end SimGetNumAcquired
+
+// --------------------------
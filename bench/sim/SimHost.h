@@ -0,0 +1,102 @@
+/*
+  File:   SimHost.h
+
+  Contains: A simulated Acrobat for running a plug-in's callbacks outside
+            Acrobat: the calls the bench drivers make in Acrobat's place.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+  Usage:
+      #include "ClickMove.cpp"        // the plug-in, built against bench/sim
+      #include "SimHost.h"
+
+      SimHostInit() ;
+      SimLoadPlugIn( &PIHandshake ) ;
+
+      AVDoc theAVDoc = SimOpenDoc( "Deck", 200 ) ;
+      SimClick( AVDocGetPageView( theAVDoc ), 0, 1 ) ;
+      ...
+      SimUnloadPlugIn() ;
+
+    The host holds one menubar, toolbar and set of documents, in memory, and
+    calls back into the plug-in the way Acrobat does: notifications when
+    documents open and close, page views change and menu items come and go,
+    idle procs from SimRunIdle, page view click procs from SimClick and
+    execute procs from SimExecuteMenuItem.  The menubar and toolbar start
+    with the menus, menu items and buttons the plug-ins look for by name.
+
+    A simulated document has pages but no content: no text, labels or
+    bookmarks, and every page has the same crop box and a 4 KB content
+    stream.  Alerts answer with their first button and prompts are
+    cancelled.
+
+    Nothing here is thread safe; as in Acrobat, only the main thread may
+    make these calls.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+// --------------------------
+
+typedef ACCBPROTO1 ASBool ( ACCBPROTO2 * SimHandshakeProc )( ASUns32 inHandshakeVersion, void * inHandshakeData ) ;
+
+// Build the menubar and toolbar; call once, before anything else.
+void        SimHostInit( void ) ;
+
+// Acrobat's launch sequence for one plug-in: the handshake, then the
+// export, import and init callbacks, then AVAppDidInitialize.  False when
+// the handshake or a callback returns false.
+ASBool      SimLoadPlugIn( SimHandshakeProc inHandshake ) ;
+void        SimUnloadPlugIn( void ) ;
+
+// Open a document of inNumPages pages and bring it to the front, sending
+// AVDocDidOpen and AVAppFrontDocDidChange.  The pages start in order, with
+// page n remembering n as its original number.
+AVDoc       SimOpenDoc( const char * inTitle, ASInt32 inNumPages ) ;
+void        SimCloseDoc( AVDoc inAVDoc ) ;
+
+// The original number of the page now at inPageNum, i.e. where it was when
+// the document opened.
+ASInt32     SimGetOriginalPageNum( PDDoc inPDDoc, PDPageNumber inPageNum ) ;
+
+void        SimSetFullScreen( ASBool inFullScreen ) ;
+
+// A click in inAVPageView, passed to the click procs in the order they
+// registered until one returns true.
+ASBool      SimClick( AVPageView inAVPageView, ASInt16 inFlags, ASInt16 inClickNumber ) ;
+
+// AVPageViewDidChange, as when the user scrolls or zooms.
+void        SimPageViewDidChange( AVPageView inAVPageView, ASInt16 inHowChanged ) ;
+
+// Call every idle proc once, whatever its period.
+void        SimRunIdle( void ) ;
+
+// Choose the menu item named inName, as the user would: false when there is
+// no such item or its compute enabled proc says no.
+ASBool      SimExecuteMenuItem( const char * inName ) ;
+
+ASInt32     SimGetNumAlerts( void ) ;
+
+// Menus, menu items, documents and pages still acquired by someone other
+// than the host; a plug-in that releases what it acquires leaves these as
+// they were before it ran.
+ASInt32     SimGetNumAcquired( void ) ;
+
+// Every operator new since the process started, on any thread; the bench
+// build replaces operator new to count them.
+ASUns64     SimGetAllocations( void ) ;
+
+// --------------------------
@@ -0,0 +1,49 @@
+/*
+  File:   SimPrivate.h
+
+  Contains: What the parts of the simulated host share with each other and
+            with no one else.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+#include <stdio.h>
+
+#include <string>
+
+// --------------------------
+
+struct _t_ASPathName
+  {
+    std::string   fPath ;
+  } ;
+
+struct _t_ASFile
+  {
+    FILE *        fFile ;       // NULL for a document's file, which is only named
+    ASPathName    fPathName ;
+  } ;
+
+// a copy of inPath, released with ASFileSysReleasePath
+ASPathName    SimNewPathName( const std::string & inPath ) ;
+
+// the number of pages in the PDF file at inPath, by counting its page
+// objects; 0 when it cannot be read
+ASInt32       SimCountPages( const char * inPath ) ;
+
+// --------------------------
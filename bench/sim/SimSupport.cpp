@@ -0,0 +1,712 @@
+/*
+  File:   SimSupport.cpp
+
+  Contains: The simulated host's atoms, exceptions, fixed point math, text
+            and file system, and the helper classes the plug-ins use.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#include "CorCalls.h"
+#include "ASCalls.h"
+#include "AVCalls.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+#include "TAVUtils.h"
+#include "TASUtils.h"
+#include "APReport.h"
+#include "SimPrivate.h"
+
+// --------------------------
+
+thread_local SimExceptionFrame *  gSimExceptionFrame = NULL ;
+
+struct _t_ASText
+  {
+    std::string   fUTF8 ;
+  } ;
+
+struct _t_ASPlatformPath
+  {
+    std::string   fPath ;
+  } ;
+
+static struct _t_ASFileSys { int fUnused ; }  sFileSys ;
+
+// --------------------------
+#pragma mark -- exceptions and memory
+// --------------------------
+
+void ASRaise( ASErrorCode inError )
+  {
+    SimExceptionFrame * theFrame = gSimExceptionFrame ;
+
+    if ( theFrame == NULL )
+      {
+        fprintf( stderr, "simulated host: error %d raised outside DURING\n", ( int )inError ) ;
+        abort() ;
+      }
+
+    gSimExceptionFrame  = theFrame->fPrev ;
+    theFrame->fError    = inError ;
+
+    longjmp( theFrame->fJmpBuf, 1 ) ;
+
+  } // end ASRaise
+
+// --------------------------
+
+void * ASmalloc( size_t inSize )
+  {
+    return malloc( inSize ) ;
+
+  } // end ASmalloc
+
+// --------------------------
+
+void ASfree( void * inPointer )
+  {
+    free( inPointer ) ;
+
+  } // end ASfree
+
+// --------------------------
+
+void ASGetErrorString( ASErrorCode inError, char * outBuffer, ASInt32 inBufferSize )
+  {
+    if ( ( outBuffer == NULL ) || ( inBufferSize < 1 ) )
+      return ;
+
+    snprintf( outBuffer, inBufferSize, "simulated host error %d", ( int )inError ) ;
+
+  } // end ASGetErrorString
+
+// --------------------------
+#pragma mark -- atoms
+// --------------------------
+// The strings live in a deque, which never moves them, so the map can key
+// on their characters and a lookup of an existing atom allocates nothing.
+
+struct SimStringHash
+  {
+    size_t operator()( const char * inString ) const
+      {
+        size_t  theHash = 2166136261u ;
+
+        for ( ; *inString != 0 ; inString++ )
+          theHash = ( theHash ^ ( unsigned char )*inString ) * 16777619u ;
+
+        return theHash ;
+      }
+  } ;
+
+struct SimStringEqual
+  {
+    bool operator()( const char * inA, const char * inB ) const { return strcmp( inA, inB ) == 0 ; }
+  } ;
+
+static std::deque< std::string > &  GetAtomStrings( void )
+  {
+    static std::deque< std::string >  sStrings ;
+
+    return sStrings ;
+  }
+
+static std::unordered_map< const char *, ASAtom, SimStringHash, SimStringEqual > &  GetAtoms( void )
+  {
+    static std::unordered_map< const char *, ASAtom, SimStringHash, SimStringEqual >  sAtoms ;
+
+    return sAtoms ;
+  }
+
+// --------------------------
+
+ASAtom ASAtomFromString( const char * inString )
+  {
+    if ( inString == NULL )
+      return ASAtomNull ;
+
+    std::unordered_map< const char *, ASAtom, SimStringHash, SimStringEqual >::iterator theIter = GetAtoms().find( inString ) ;
+    if ( theIter != GetAtoms().end() )
+      return theIter->second ;
+
+    GetAtomStrings().push_back( inString ) ;
+
+    ASAtom  theAtom = ( ASAtom )( GetAtomStrings().size() - 1 ) ;
+    GetAtoms()[ GetAtomStrings().back().c_str() ] = theAtom ;
+
+    return theAtom ;
+
+  } // end ASAtomFromString
+
+// --------------------------
+
+const char * ASAtomGetString( ASAtom inAtom )
+  {
+    if ( inAtom >= GetAtomStrings().size() )
+      return "" ;
+
+    return GetAtomStrings()[ inAtom ].c_str() ;
+
+  } // end ASAtomGetString
+
+// --------------------------
+#pragma mark -- fixed point
+// --------------------------
+
+ASFixed ASFixedMul( ASFixed inA, ASFixed inB )
+  {
+    return ( ASFixed )( ( ( ASInt64 )inA * inB ) >> 16 ) ;
+
+  } // end ASFixedMul
+
+// --------------------------
+
+ASFixed ASFixedDiv( ASFixed inA, ASFixed inB )
+  {
+    if ( inB == 0 )
+      return ( inA < 0 ) ? INT32_MIN : INT32_MAX ;
+
+    return ( ASFixed )( ( ( ASInt64 )inA << 16 ) / inB ) ;
+
+  } // end ASFixedDiv
+
+// --------------------------
+
+ASInt32 ASFixedRoundToInt32( ASFixed inValue )
+  {
+    return ( ASInt32 )( ( ( ASInt64 )inValue + 0x8000 ) >> 16 ) ;
+
+  } // end ASFixedRoundToInt32
+
+// --------------------------
+#pragma mark -- text
+// --------------------------
+
+ASText ASTextNew( void )
+  {
+    return new _t_ASText ;
+
+  } // end ASTextNew
+
+// --------------------------
+
+void ASTextDestroy( ASText inText )
+  {
+    delete inText ;
+
+  } // end ASTextDestroy
+
+// --------------------------
+// UTF-8 is kept as given; host-endian UTF-16 is converted, surrogate pairs
+// included.  The other formats are not used by the plug-ins.
+
+void ASTextSetUnicode( ASText inText, const ASUTF16Val * inString, ASUnicodeFormat inFormat )
+  {
+    if ( inText == NULL )
+      return ;
+
+    inText->fUTF8.clear() ;
+
+    if ( inString == NULL )
+      return ;
+
+    if ( inFormat == kUTF8 )
+      {
+        inText->fUTF8 = ( const char * )inString ;
+        return ;
+      }
+
+    for ( ; *inString != 0 ; inString++ )
+      {
+        ASUns32   theChar = *inString ;
+
+        if ( ( theChar >= 0xD800 ) && ( theChar < 0xDC00 ) && ( inString[ 1 ] >= 0xDC00 ) && ( inString[ 1 ] < 0xE000 ) )
+          {
+            theChar = 0x10000 + ( ( theChar - 0xD800 ) << 10 ) + ( inString[ 1 ] - 0xDC00 ) ;
+            inString++ ;
+          }
+
+        if ( theChar < 0x80 )
+          inText->fUTF8 += ( char )theChar ;
+        else if ( theChar < 0x800 )
+          {
+            inText->fUTF8 += ( char )( 0xC0 | ( theChar >> 6 ) ) ;
+            inText->fUTF8 += ( char )( 0x80 | ( theChar & 0x3F ) ) ;
+          }
+        else if ( theChar < 0x10000 )
+          {
+            inText->fUTF8 += ( char )( 0xE0 | ( theChar >> 12 ) ) ;
+            inText->fUTF8 += ( char )( 0x80 | ( ( theChar >> 6 ) & 0x3F ) ) ;
+            inText->fUTF8 += ( char )( 0x80 | ( theChar & 0x3F ) ) ;
+          }
+        else
+          {
+            inText->fUTF8 += ( char )( 0xF0 | ( theChar >> 18 ) ) ;
+            inText->fUTF8 += ( char )( 0x80 | ( ( theChar >> 12 ) & 0x3F ) ) ;
+            inText->fUTF8 += ( char )( 0x80 | ( ( theChar >> 6 ) & 0x3F ) ) ;
+            inText->fUTF8 += ( char )( 0x80 | ( theChar & 0x3F ) ) ;
+          }
+      }
+
+  } // end ASTextSetUnicode
+
+// --------------------------
+
+static char * CopyString( const std::string & inString )
+  {
+    char *  theCopy = ( char * )ASmalloc( inString.size() + 1 ) ;
+
+    if ( theCopy != NULL )
+      memcpy( theCopy, inString.c_str(), inString.size() + 1 ) ;
+
+    return theCopy ;
+
+  } // end CopyString
+
+// --------------------------
+// Only UTF-8 is given out.
+
+ASUTF16Val * ASTextGetUnicodeCopy( ASText inText, ASUnicodeFormat inFormat )
+  {
+    if ( ( inText == NULL ) || ( inFormat != kUTF8 ) )
+      return NULL ;
+
+    return ( ASUTF16Val * )CopyString( inText->fUTF8 ) ;
+
+  } // end ASTextGetUnicodeCopy
+
+// --------------------------
+// The host encoding is UTF-8.
+
+char * ASTextGetEncodedCopy( ASText inText, ASHostEncoding inEncoding )
+  {
+    if ( inText == NULL )
+      return NULL ;
+
+    return CopyString( inText->fUTF8 ) ;
+
+  } // end ASTextGetEncodedCopy
+
+// --------------------------
+#pragma mark -- files
+// --------------------------
+
+ASPathName SimNewPathName( const std::string & inPath )
+  {
+    ASPathName  thePathName = new _t_ASPathName ;
+
+    thePathName->fPath = inPath ;
+
+    return thePathName ;
+
+  } // end SimNewPathName
+
+// --------------------------
+// Page objects are counted as "/Type /Page" or "/Type/Page" not followed by
+// an "s", which is near enough for the files a bench opens.
+
+ASInt32 SimCountPages( const char * inPath )
+  {
+    std::string   theText ;
+    char          theBuffer[ 65536 ] ;
+    size_t        theLength ;
+    ASInt32       theCount  = 0 ;
+    FILE *        theFile   = fopen( inPath, "rb" ) ;
+
+    if ( theFile == NULL )
+      return 0 ;
+
+    while ( ( theLength = fread( theBuffer, 1, sizeof( theBuffer ), theFile ) ) > 0 )
+      theText.append( theBuffer, theLength ) ;
+    fclose( theFile ) ;
+
+    for ( size_t thePos = theText.find( "/Type" ) ; thePos != std::string::npos ; thePos = theText.find( "/Type", thePos + 5 ) )
+      {
+        size_t  theName = thePos + 5 ;
+
+        while ( ( theName < theText.size() ) && ( theText[ theName ] == ' ' ) )
+          theName++ ;
+
+        if ( ( theText.compare( theName, 5, "/Page" ) == 0 ) && ( ( theName + 5 >= theText.size() ) || ( theText[ theName + 5 ] != 's' ) ) )
+          theCount += 1 ;
+      }
+
+    return theCount ;
+
+  } // end SimCountPages
+
+// --------------------------
+
+ASFileSys ASGetDefaultFileSys( void )
+  {
+    return &sFileSys ;
+
+  } // end ASGetDefaultFileSys
+
+// --------------------------
+
+static std::string JoinPath( ASPathName inFolder, const char * inPath )
+  {
+    if ( ( inFolder == NULL ) || ( inPath[ 0 ] == '/' ) )
+      return inPath ;
+
+    return inFolder->fPath + "/" + inPath ;
+
+  } // end JoinPath
+
+// --------------------------
+// "DIPath" and "Cstring" take a char *, "DIPathWithASText" an ASText; a
+// relative path is taken from inMoreInfo, a folder's path name.
+
+ASPathName ASFileSysCreatePathName( ASFileSys inFileSys, ASAtom inPathSpecType, const void * inPathSpec, const void * inMoreInfo )
+  {
+    const char *  thePath ;
+
+    if ( inPathSpec == NULL )
+      return NULL ;
+
+    if ( inPathSpecType == ASAtomFromString( "DIPathWithASText" ) )
+      thePath = ( ( ASText )inPathSpec )->fUTF8.c_str() ;
+    else if ( ( inPathSpecType == ASAtomFromString( "DIPath" ) ) || ( inPathSpecType == ASAtomFromString( "Cstring" ) ) )
+      thePath = ( const char * )inPathSpec ;
+    else
+      return NULL ;
+
+    return SimNewPathName( JoinPath( ( ASPathName )inMoreInfo, thePath ) ) ;
+
+  } // end ASFileSysCreatePathName
+
+// --------------------------
+
+ASPathName ASFileSysCreatePathFromDIPath( ASFileSys inFileSys, const char * inDIPath, ASPathName inRelativeToThisPath )
+  {
+    if ( inDIPath == NULL )
+      return NULL ;
+
+    return SimNewPathName( JoinPath( inRelativeToThisPath, inDIPath ) ) ;
+
+  } // end ASFileSysCreatePathFromDIPath
+
+// --------------------------
+
+char * ASFileSysDIPathFromPath( ASFileSys inFileSys, ASPathName inPathName, ASPathName inRelativeToThisPath )
+  {
+    if ( inPathName == NULL )
+      return NULL ;
+
+    if ( ( inRelativeToThisPath != NULL ) && ( inPathName->fPath.compare( 0, inRelativeToThisPath->fPath.size() + 1, inRelativeToThisPath->fPath + "/" ) == 0 ) )
+      return CopyString( inPathName->fPath.substr( inRelativeToThisPath->fPath.size() + 1 ) ) ;
+
+    return CopyString( inPathName->fPath ) ;
+
+  } // end ASFileSysDIPathFromPath
+
+// --------------------------
+
+void ASFileSysReleasePath( ASFileSys inFileSys, ASPathName inPathName )
+  {
+    delete inPathName ;
+
+  } // end ASFileSysReleasePath
+
+// --------------------------
+
+ASErrorCode ASFileSysAcquireParent( ASFileSys inFileSys, ASPathName inPathName, ASPathName * outParent )
+  {
+    size_t  theSlash ;
+
+    *outParent = NULL ;
+
+    if ( inPathName == NULL )
+      return genErrBadParm ;
+
+    theSlash = inPathName->fPath.find_last_of( '/' ) ;
+    if ( theSlash == std::string::npos )
+      *outParent = SimNewPathName( "." ) ;
+    else
+      *outParent = SimNewPathName( ( theSlash == 0 ) ? "/" : inPathName->fPath.substr( 0, theSlash ) ) ;
+
+    return 0 ;
+
+  } // end ASFileSysAcquireParent
+
+// --------------------------
+
+ASErrorCode ASFileSysGetNameFromPathAsASText( ASFileSys inFileSys, ASPathName inPathName, ASText outText )
+  {
+    if ( ( inPathName == NULL ) || ( outText == NULL ) )
+      return genErrBadParm ;
+
+    size_t  theSlash = inPathName->fPath.find_last_of( '/' ) ;
+
+    outText->fUTF8 = ( theSlash == std::string::npos ) ? inPathName->fPath : inPathName->fPath.substr( theSlash + 1 ) ;
+
+    return 0 ;
+
+  } // end ASFileSysGetNameFromPathAsASText
+
+// --------------------------
+
+ASErrorCode ASFileSysDisplayASTextFromPath( ASFileSys inFileSys, ASPathName inPathName, ASText outText )
+  {
+    if ( ( inPathName == NULL ) || ( outText == NULL ) )
+      return genErrBadParm ;
+
+    outText->fUTF8 = inPathName->fPath ;
+
+    return 0 ;
+
+  } // end ASFileSysDisplayASTextFromPath
+
+// --------------------------
+
+ASErrorCode ASFileSysGetItemProps( ASFileSys inFileSys, ASPathName inPathName, ASFileSysItemProps outProps )
+  {
+    struct stat   theStat ;
+
+    if ( ( inPathName == NULL ) || ( outProps == NULL ) )
+      return genErrBadParm ;
+
+    if ( stat( inPathName->fPath.c_str(), &theStat ) != 0 )
+      return fileErrFNF ;
+
+    outProps->isThere       = true ;
+    outProps->type          = S_ISDIR( theStat.st_mode ) ? kASFileSysFolder : kASFileSysFile ;
+    outProps->fileSizeHigh  = ( ASInt32 )( ( ASUns64 )theStat.st_size >> 32 ) ;
+    outProps->fileSizeLow   = ( ASInt32 )( theStat.st_size & 0xFFFFFFFF ) ;
+
+    return 0 ;
+
+  } // end ASFileSysGetItemProps
+
+// --------------------------
+
+ASErrorCode ASFileSysAcquirePlatformPath( ASFileSys inFileSys, ASPathName inPathName, ASAtom inPlatformPathType, ASPlatformPath * outPlatformPath )
+  {
+    *outPlatformPath = NULL ;
+
+    if ( ( inPathName == NULL ) || ( inPlatformPathType != ASAtomFromString( "POSIXPath" ) ) )
+      return genErrBadParm ;
+
+    *outPlatformPath = new _t_ASPlatformPath ;
+    ( *outPlatformPath )->fPath = inPathName->fPath ;
+
+    return 0 ;
+
+  } // end ASFileSysAcquirePlatformPath
+
+// --------------------------
+
+void ASFileSysReleasePlatformPath( ASFileSys inFileSys, ASPlatformPath inPlatformPath )
+  {
+    delete inPlatformPath ;
+
+  } // end ASFileSysReleasePlatformPath
+
+// --------------------------
+
+const char * ASPlatformPathGetPOSIXPathPtr( ASPlatformPath inPlatformPath )
+  {
+    return ( inPlatformPath != NULL ) ? inPlatformPath->fPath.c_str() : NULL ;
+
+  } // end ASPlatformPathGetPOSIXPathPtr
+
+// --------------------------
+// Files are only opened for reading.
+
+ASErrorCode ASFileSysOpenFile( ASFileSys inFileSys, ASPathName inPathName, ASUns16 inMode, ASFile * outFile )
+  {
+    FILE *  theFile ;
+
+    *outFile = NULL ;
+
+    if ( ( inPathName == NULL ) || ( inMode != ASFILE_READ ) )
+      return genErrBadParm ;
+
+    theFile = fopen( inPathName->fPath.c_str(), "rb" ) ;
+    if ( theFile == NULL )
+      return fileErrFNF ;
+
+    *outFile = new _t_ASFile ;
+    ( *outFile )->fFile     = theFile ;
+    ( *outFile )->fPathName = SimNewPathName( inPathName->fPath ) ;
+
+    return 0 ;
+
+  } // end ASFileSysOpenFile
+
+// --------------------------
+
+ASInt32 ASFileRead( ASFile inFile, char * outBuffer, ASInt32 inCount )
+  {
+    if ( ( inFile == NULL ) || ( inFile->fFile == NULL ) || ( inCount <= 0 ) )
+      return 0 ;
+
+    return ( ASInt32 )fread( outBuffer, 1, inCount, inFile->fFile ) ;
+
+  } // end ASFileRead
+
+// --------------------------
+
+ASInt32 ASFileGetEOF( ASFile inFile )
+  {
+    struct stat   theStat ;
+
+    if ( ( inFile == NULL ) || ( stat( inFile->fPathName->fPath.c_str(), &theStat ) != 0 ) )
+      return 0 ;
+
+    return ( ASInt32 )theStat.st_size ;
+
+  } // end ASFileGetEOF
+
+// --------------------------
+
+ASErrorCode ASFileClose( ASFile inFile )
+  {
+    if ( inFile == NULL )
+      return genErrBadParm ;
+
+    if ( inFile->fFile != NULL )
+      fclose( inFile->fFile ) ;
+    delete inFile->fPathName ;
+    delete inFile ;
+
+    return 0 ;
+
+  } // end ASFileClose
+
+// --------------------------
+
+ASFileSys ASFileGetFileSys( ASFile inFile )
+  {
+    return &sFileSys ;
+
+  } // end ASFileGetFileSys
+
+// --------------------------
+
+ASPathName ASFileAcquirePathName( ASFile inFile )
+  {
+    if ( inFile == NULL )
+      return NULL ;
+
+    return SimNewPathName( inFile->fPathName->fPath ) ;
+
+  } // end ASFileAcquirePathName
+
+// --------------------------
+#pragma mark -- helper classes
+// --------------------------
+
+void TAVUtils::SimpleAlert( ASInt32 inDialogID )
+  {
+    AVAlert( ALERT_NOTE, "", "OK", NULL, NULL, false ) ;
+
+  } // end SimpleAlert
+
+// --------------------------
+
+ACCB1 ASBool ACCB2 TAVUtils::ComputeEnabled( void * inData )
+  {
+    return ( AVAppGetActiveDoc() != NULL ) ;
+
+  } // end ComputeEnabled
+
+// --------------------------
+
+AVIcon TAVUtils::GetButtonIcon( ASInt32 inIconID )
+  {
+    return ( AVIcon )( size_t )( inIconID + 1 ) ;
+
+  } // end GetButtonIcon
+
+// --------------------------
+
+ASInt32 TASUtils::GetLocalTime( ASTimeRec * outTime )
+  {
+    time_t      theTime = time( NULL ) ;
+    struct tm   theLocal ;
+
+    memset( outTime, 0, sizeof( *outTime ) ) ;
+
+    if ( localtime_r( &theTime, &theLocal ) == NULL )
+      return genErrGeneral ;
+
+    outTime->year   = ( ASInt16 )( theLocal.tm_year + 1900 ) ;
+    outTime->month  = ( ASInt16 )( theLocal.tm_mon + 1 ) ;
+    outTime->date   = ( ASInt16 )theLocal.tm_mday ;
+    outTime->hour   = ( ASInt16 )theLocal.tm_hour ;
+    outTime->minute = ( ASInt16 )theLocal.tm_min ;
+    outTime->second = ( ASInt16 )theLocal.tm_sec ;
+    outTime->day    = ( ASInt16 )theLocal.tm_wday ;
+
+    return 0 ;
+
+  } // end GetLocalTime
+
+// --------------------------
+
+ASInt32 TASUtils::ASTimeRecToString( const ASTimeRec * inTime, char * outDate, char * outTime )
+  {
+    snprintf( outDate, 64, "%04d-%02d-%02d", ( int )inTime->year, ( int )inTime->month, ( int )inTime->date ) ;
+    snprintf( outTime, 64, "%02d:%02d:%02d", ( int )inTime->hour, ( int )inTime->minute, ( int )inTime->second ) ;
+
+    return 0 ;
+
+  } // end ASTimeRecToString
+
+// --------------------------
+// "-" is the standard output.
+
+APReport::APReport( const char * inFileName )
+  : mFile( NULL )
+  {
+    if ( strcmp( inFileName, "-" ) == 0 )
+      mFile = stdout ;
+    else
+      mFile = fopen( inFileName, "wb" ) ;
+
+  } // end APReport
+
+// --------------------------
+
+APReport::~APReport()
+  {
+    if ( ( mFile != NULL ) && ( mFile != stdout ) )
+      fclose( mFile ) ;
+    else if ( mFile == stdout )
+      fflush( stdout ) ;
+
+  } // end ~APReport
+
+// --------------------------
+
+void APReport::Write( const char * inText, size_t inLength )
+  {
+    if ( mFile != NULL )
+      fwrite( inText, 1, inLength, mFile ) ;
+
+  } // end Write
+
+// --------------------------
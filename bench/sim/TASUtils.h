@@ -0,0 +1,36 @@
+/*
+  File:   TASUtils.h
+
+  Contains: The simulated host's stand-in for the TASUtils support helpers
+            the plug-ins call.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "ASCalls.h"
+
+// --------------------------
+
+class TASUtils
+  {
+    public:
+      static ASInt32    GetLocalTime( ASTimeRec * outTime ) ;
+
+      // outDate and outTime must hold 64 characters each
+      static ASInt32    ASTimeRecToString( const ASTimeRec * inTime, char * outDate, char * outTime ) ;
+  } ;
+
+// --------------------------
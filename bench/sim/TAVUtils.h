@@ -0,0 +1,40 @@
+/*
+  File:   TAVUtils.h
+
+  Contains: The simulated host's stand-in for the TAVUtils viewer helpers
+            the plug-ins call.
+
+  Written by: Mark Gavin
+              Appligent, Inc.
+              22 East Baltimore Avenue
+              Lansdowne, PA 19050
+              ( 610 ) 284-4006
+
+  Copyright:  2026 by Appligent, Inc.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this
+  file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+*/
+
+#pragma once
+
+#include "AVCalls.h"
+
+// --------------------------
+
+class TAVUtils
+  {
+    public:
+      // no dialog resources here; the alert is only counted
+      static void                     SimpleAlert( ASInt32 inDialogID ) ;
+
+      // true when a document is open
+      static ACCB1 ASBool ACCB2       ComputeEnabled( void * inData ) ;
+
+      // a distinct icon per resource ID
+      static AVIcon                   GetButtonIcon( ASInt32 inIconID ) ;
+  } ;
+
+// --------------------------